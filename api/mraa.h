@@ -37,6 +37,7 @@ extern "C" {
 #include "mraa/uart.h"
 #include "mraa/uart_ow.h"
 #include "mraa/led.h"
+#include "mraa/stats.h"
 
 #ifdef __cplusplus
 }
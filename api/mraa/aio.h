@@ -62,6 +62,16 @@ typedef struct _aio* mraa_aio_context;
  */
 mraa_aio_context mraa_aio_init(unsigned int pin);
 
+/**
+ * Initialise an Analog input context for several pins, all read with a single
+ * call to mraa_aio_read_multi(). The pins must belong to the same platform.
+ *
+ * @param pins Pin array, as for mraa_aio_init()
+ * @param num_pins Number of pins - must be the same as the pins array length
+ * @returns aio context or NULL
+ */
+mraa_aio_context mraa_aio_init_multi(int pins[], int num_pins);
+
 /**
  * Read the input voltage. By default mraa will shift the raw value up or down
  * to a 10 bit value.
@@ -80,6 +90,29 @@ int mraa_aio_read(mraa_aio_context dev);
  */
 float mraa_aio_read_float(mraa_aio_context dev);
 
+/**
+ * Read all pins of a context created by mraa_aio_init_multi(), scaled as by
+ * mraa_aio_read(). When the ADC sits behind IIO the values come from the
+ * newest buffered scan, provided the device has a running trigger. Otherwise
+ * the channels are read one after the other, or all at once by sub platforms
+ * that support it.
+ *
+ * @param dev The AIO context
+ * @param values Array with one element per pin, in the order given at init
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_read_multi(mraa_aio_context dev, int values[]);
+
+/**
+ * Read all pins of a context created by mraa_aio_init_multi() as normalized
+ * floats (0.0f-1.0f)
+ *
+ * @param dev The AIO context
+ * @param values Array with one element per pin, in the order given at init
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_read_float_multi(mraa_aio_context dev, float values[]);
+
 /**
  * Close the analog input context, this will free the memory for the context
  *
@@ -106,6 +139,72 @@ mraa_result_t mraa_aio_set_bit(mraa_aio_context dev, int bits);
  */
 int mraa_aio_get_bit(mraa_aio_context dev);
 
+/**
+ * Counters of a continuous acquisition
+ */
+typedef struct {
+    uint64_t scans;        /**< scans received from the ADC */
+    uint64_t delivered;    /**< scans returned by mraa_aio_stream_read() */
+    uint64_t overflows;    /**< scans dropped because the ring was full */
+    unsigned int max_fill; /**< highest number of scans waiting in the ring */
+} mraa_aio_stream_stats_t;
+
+/**
+ * Start continuous acquisition of one or more channels of the ADC. The
+ * channels are enabled as IIO scan elements, the samples are read in binary
+ * form from the buffered IIO character device by a background thread and
+ * stored in the caller's ring, scaled the same way as mraa_aio_read().
+ *
+ * The stream belongs to devs[0], the other contexts only name the channels
+ * to scan and may be closed while streaming. The IIO buffer of the ADC is
+ * taken over, scan elements of other channels are disabled. When the ring
+ * is full the oldest scans are kept and the newer ones counted as overflows.
+ *
+ * @param devs The AIO contexts of the channels, in the order values are stored
+ * @param num_devs Number of contexts
+ * @param trigger Name of the IIO trigger to use, NULL keeps the current one
+ * @param ring Storage for ring_scans * num_devs values, must stay valid until
+ * the stream is stopped
+ * @param ring_scans Capacity of the ring in scans
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_start(mraa_aio_context* devs,
+                                    unsigned int num_devs,
+                                    const char* trigger,
+                                    int* ring,
+                                    unsigned int ring_scans);
+
+/**
+ * Take the oldest scans out of the ring of a stream
+ *
+ * @param dev The AIO context owning the stream
+ * @param values Destination, max_scans * number of channels values, one scan
+ * after the other
+ * @param max_scans Maximum number of scans to return
+ * @param timeout_ms Time to wait for a first scan, 0 returns immediately, -1
+ * waits forever
+ * @return Number of scans returned or -1 on error
+ */
+int mraa_aio_stream_read(mraa_aio_context dev, int* values, unsigned int max_scans, int timeout_ms);
+
+/**
+ * Get the counters of a stream
+ *
+ * @param dev The AIO context owning the stream
+ * @param stats Filled with the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_stats(mraa_aio_context dev, mraa_aio_stream_stats_t* stats);
+
+/**
+ * Stop continuous acquisition and disable the IIO buffer. Closing the owning
+ * context stops the stream as well.
+ *
+ * @param dev The AIO context owning the stream
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_stop(mraa_aio_context dev);
+
 #ifdef __cplusplus
 }
 #endif
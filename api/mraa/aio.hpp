@@ -27,6 +27,8 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include "aio.h"
 #include "types.hpp"
 
@@ -49,7 +51,7 @@ class Aio
      *
      * @param pin channel number to read ADC inputs
      */
-    Aio(int pin)
+    Aio(int pin) : m_pins(1)
     {
         m_aio = mraa_aio_init(pin);
         if (m_aio == NULL) {
@@ -64,13 +66,27 @@ class Aio
      *
      * @param aio_context void * to an AIO context
      */
-    Aio(void* aio_context)
+    Aio(void* aio_context) : m_pins(1)
     {
         m_aio = (mraa_aio_context) aio_context;
         if (m_aio == NULL) {
             throw std::invalid_argument("Invalid AIO context");
         }
     }
+#ifndef SWIG
+    /**
+     * Aio Constructor for several pins read together with readMulti()
+     *
+     * @param pins channel numbers to read ADC inputs
+     */
+    Aio(std::vector<int> pins) : m_pins(pins.size())
+    {
+        m_aio = mraa_aio_init_multi(pins.data(), pins.size());
+        if (m_aio == NULL) {
+            throw std::invalid_argument("Invalid AIO pins specified - do you have an ADC?");
+        }
+    }
+#endif
     /**
      * Aio destructor
      */
@@ -131,7 +147,112 @@ class Aio
         return mraa_aio_get_bit(m_aio);
     }
 
+#ifndef SWIG
+    /**
+     * Read all pins of an Aio constructed from several pins, see
+     * mraa_aio_read_multi()
+     *
+     * @throws std::runtime_error in case of error
+     * @returns One value per pin, in constructor order
+     */
+    std::vector<int>
+    readMulti()
+    {
+        std::vector<int> values(m_pins);
+        if (mraa_aio_read_multi(m_aio, values.data()) != MRAA_SUCCESS) {
+            throw std::runtime_error("Unknown error in Aio::readMulti()");
+        }
+        return values;
+    }
+
+    /**
+     * Read all pins of an Aio constructed from several pins as normalized
+     * floats (0.0f-1.0f)
+     *
+     * @throws std::runtime_error in case of error
+     * @returns One value per pin, in constructor order
+     */
+    std::vector<float>
+    readFloatMulti()
+    {
+        std::vector<float> values(m_pins);
+        if (mraa_aio_read_float_multi(m_aio, values.data()) != MRAA_SUCCESS) {
+            throw std::runtime_error("Unknown error in Aio::readFloatMulti()");
+        }
+        return values;
+    }
+
+    /**
+     * Start continuous acquisition of this channel and optionally more
+     * channels of the same ADC, see mraa_aio_stream_start()
+     *
+     * @param ring Storage for ringScans scans, must stay valid until the
+     * stream is stopped
+     * @param ringScans Capacity of the ring in scans
+     * @param others Further channels scanned after this one
+     * @param trigger Name of the IIO trigger, empty keeps the current one
+     * @return Result of operation
+     */
+    Result
+    streamStart(int* ring, unsigned int ringScans, const std::vector<Aio*>& others = {}, const std::string& trigger = "")
+    {
+        std::vector<mraa_aio_context> devs(1, m_aio);
+        for (Aio* aio : others) {
+            devs.push_back(aio->m_aio);
+        }
+        return (Result) mraa_aio_stream_start(devs.data(), devs.size(), trigger.empty() ? NULL : trigger.c_str(),
+                                              ring, ringScans);
+    }
+
+    /**
+     * Take the oldest scans out of the ring
+     *
+     * @param values Destination for maxScans scans
+     * @param maxScans Maximum number of scans to return
+     * @param timeoutMs Time to wait for a first scan, -1 waits forever
+     * @throws std::runtime_error if the context is not streaming
+     * @return Number of scans returned
+     */
+    int
+    streamRead(int* values, unsigned int maxScans, int timeoutMs = -1)
+    {
+        int num = mraa_aio_stream_read(m_aio, values, maxScans, timeoutMs);
+        if (num < 0) {
+            throw std::runtime_error("Aio::streamRead(): not streaming");
+        }
+        return num;
+    }
+
+    /**
+     * Get the counters of the stream
+     *
+     * @throws std::runtime_error if the context is not streaming
+     * @return stream counters
+     */
+    mraa_aio_stream_stats_t
+    streamStats()
+    {
+        mraa_aio_stream_stats_t stats;
+        if (mraa_aio_stream_stats(m_aio, &stats) != MRAA_SUCCESS) {
+            throw std::runtime_error("Aio::streamStats(): not streaming");
+        }
+        return stats;
+    }
+#endif
+
+    /**
+     * Stop continuous acquisition
+     *
+     * @return Result of operation
+     */
+    Result
+    streamStop()
+    {
+        return (Result) mraa_aio_stream_stop(m_aio);
+    }
+
   private:
     mraa_aio_context m_aio;
+    unsigned int m_pins;
 };
 }
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @file
+ * @brief Asynchronous bus requests
+ *
+ * I2C and SPI transfers can be submitted to a per-bus queue served by a
+ * worker thread, see mraa_i2c_transfer_async() and
+ * mraa_spi_transfer_batch_async(). Requests on the same bus are executed in
+ * submission order. Completion is reported through an optional callback,
+ * called on the worker thread, and through a pollable eventfd per bus that is
+ * incremented once for every completed request.
+ *
+ * SPI requests queued back to back on the same context may be merged into a
+ * single bus transaction, in which case they all complete with the same
+ * result. I2C requests are never merged, each one ends with a STOP.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/**
+ * Opaque pointer definition to the internal struct _async_request
+ */
+typedef struct _async_request* mraa_async_request_t;
+
+/**
+ * Completion callback of an asynchronous request, called on the worker thread
+ * of the bus. The callback must not wait for requests of the same bus.
+ *
+ * @param request The completed request
+ * @param result Result of the transfer
+ * @param args Argument passed at submission
+ */
+typedef void (*mraa_async_callback_t)(mraa_async_request_t request, mraa_result_t result, void* args);
+
+/**
+ * Check whether a request has completed
+ *
+ * @param request The request
+ * @return mraa_boolean_t true once the transfer is done
+ */
+mraa_boolean_t mraa_async_done(mraa_async_request_t request);
+
+/**
+ * Block until a request has completed
+ *
+ * @param request The request
+ * @return Result of the transfer
+ */
+mraa_result_t mraa_async_wait(mraa_async_request_t request);
+
+/**
+ * Release a request handle. Every handle returned by a submission must be
+ * released, pending requests are still executed.
+ *
+ * @param request The request
+ * @return Result of operation
+ */
+mraa_result_t mraa_async_free(mraa_async_request_t request);
+
+#ifdef __cplusplus
+}
+#endif
@@ -82,20 +82,15 @@ typedef unsigned int mraa_boolean_t;
 /**
  * Initialise MRAA
  *
- * Detects running platform and attempts to use included pinmap, this is run on
- * module/library init/load but is handy to rerun to check board initialised
- * correctly. MRAA_SUCCESS inidicates correct initialisation.
+ * Detects running platform and attempts to use included pinmap. This runs on
+ * the first call that needs the platform, calling it is handy to check the
+ * board initialised correctly or to move the detection to a chosen moment.
+ * It is thread safe and cheap once done. MRAA_SUCCESS inidicates correct
+ * initialisation.
  *
  * @return Result of operation
  */
-#if (defined SWIGPYTHON) || (defined SWIG)
 mraa_result_t mraa_init();
-#else
-// this sets a compiler attribute (supported by GCC & clang) to have mraa_init()
-// be called as a constructor make sure your libc supports this!  uclibc needs
-// to be compiled with UCLIBC_CTOR_DTOR
-mraa_result_t mraa_init() __attribute__((constructor));
-#endif
 
 /**
  * De-Initilise MRAA
@@ -288,7 +283,10 @@ unsigned int mraa_get_platform_pin_count(uint8_t platform_offset);
 char* mraa_get_pin_name(int pin);
 
 /**
-* Get GPIO index by pin name, board must be initialised.
+* Get GPIO index by pin name, board must be initialised. This and the other
+* lookups below use a hash index of the names built once per platform. Names
+* of the main platform come first, names only a sub platform has give a sub
+* platform index.
 *
 * @param pin_name: GPIO pin name. Eg: IO0
 * @return int of MRAA index for GPIO or -1 if not found.
@@ -27,10 +27,13 @@
 #pragma once
 
 #include "common.h"
+#include "stats.h"
 #include "types.hpp"
+#include <cstdlib>
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 /**
  * @namespace mraa namespace
@@ -237,14 +240,16 @@ getPinName(int pin)
 }
 
 /**
-* Get GPIO index by pin name, board must be initialised.
+* Get GPIO index by pin name, board must be initialised. Names are looked up
+* in an index built once per platform, names of a sub platform give a sub
+* platform index.
 *
 * @param pin_name: GPIO pin name. Eg: IO0
 * @throws std::invalid_argument if name is not found
 * @return int of MRAA index for GPIO
 */
 inline int
-getGpioLookup(std::string pin_name)
+getGpioLookup(const std::string& pin_name)
 {
     int index = mraa_gpio_lookup(pin_name.c_str());
 
@@ -265,7 +270,7 @@ getGpioLookup(std::string pin_name)
 * @return int of MRAA index for I2C bus
 */
 inline int
-getI2cLookup(std::string i2c_name)
+getI2cLookup(const std::string& i2c_name)
 {
     int index = mraa_i2c_lookup(i2c_name.c_str());
 
@@ -286,7 +291,7 @@ getI2cLookup(std::string i2c_name)
 * @return int of MRAA index for SPI bus
 */
 inline int
-getSpiLookup(std::string spi_name)
+getSpiLookup(const std::string& spi_name)
 {
     int index = mraa_spi_lookup(spi_name.c_str());
 
@@ -307,7 +312,7 @@ getSpiLookup(std::string spi_name)
  * @return int of MRAA index for PWM
  */
 inline int
-getPwmLookup(std::string pwm_name)
+getPwmLookup(const std::string& pwm_name)
 {
     int index = mraa_pwm_lookup(pwm_name.c_str());
 
@@ -328,7 +333,7 @@ getPwmLookup(std::string pwm_name)
  * @return MRAA index for the UART
  */
 inline int
-getUartLookup(std::string uart_name)
+getUartLookup(const std::string& uart_name)
 {
     int index = mraa_uart_lookup(uart_name.c_str());
 
@@ -475,4 +480,78 @@ initJsonPlatform(std::string path)
     return (Result) mraa_init_json_platform(path.c_str());
 }
 
+/**
+ * Turn per-context I/O statistics on or off, see stats.h
+ *
+ * @param enable true to start collecting
+ * @return Result of operation
+ */
+inline Result
+setStatsEnabled(bool enable)
+{
+    return (Result) mraa_stats_enable(enable);
+}
+
+/**
+ * Check whether I/O statistics are being collected
+ *
+ * @return bool true if collection is on
+ */
+inline bool
+statsEnabled()
+{
+    return static_cast<bool>(mraa_stats_enabled());
+}
+
+/**
+ * Format the I/O statistics of all open contexts as a text table
+ *
+ * @throws std::runtime_error if statistics are not available
+ * @return One line per context and operation, after a header line
+ */
+inline std::string
+getStatsSnapshot()
+{
+    char* text = mraa_stats_snapshot();
+    if (text == NULL) {
+        throw std::runtime_error("I/O statistics are not available");
+    }
+    std::string ret(text);
+    free(text);
+    return ret;
+}
+
+/**
+ * Clear the I/O statistics of all open contexts
+ *
+ * @return Result of operation
+ */
+inline Result
+resetStats()
+{
+    return (Result) mraa_stats_reset();
+}
+
+#ifndef SWIG
+/**
+ * Get the I/O statistics of all open contexts
+ *
+ * @throws std::runtime_error if statistics are not available
+ * @return One record per context and operation
+ */
+inline std::vector<mraa_stats_record_t>
+getStats()
+{
+    int count = mraa_stats_get(NULL, 0);
+    if (count < 0) {
+        throw std::runtime_error("I/O statistics are not available");
+    }
+    std::vector<mraa_stats_record_t> records(count);
+    count = mraa_stats_get(records.data(), records.size());
+    if (count < (int) records.size()) {
+        records.resize(count < 0 ? 0 : count);
+    }
+    return records;
+}
+#endif
 }
@@ -42,6 +42,7 @@ extern "C" {
 #endif
 
 #include "common.h"
+#include "i2c.h"
 
 /**
  * Opaque pointer definition to the internal struct _firmata. This context
@@ -98,6 +99,38 @@ mraa_result_t mraa_firmata_response_stop(mraa_firmata_context dev);
  */
 mraa_result_t mraa_firmata_close(mraa_firmata_context dev);
 
+/**
+ * Set how often the firmata board samples its analog inputs and continuous
+ * I2C reads
+ *
+ * @param millis sampling interval in milliseconds, 1 to 16383
+ * @return Result of operation
+ */
+mraa_result_t mraa_firmata_set_sampling_interval(unsigned int millis);
+
+/**
+ * Ask the firmata board to read registers of the context's address every
+ * sampling interval and report them unasked. mraa_i2c_read_byte_data(),
+ * mraa_i2c_read_word_data() and mraa_i2c_read_bytes_data() within that
+ * range then return the last reported values without a round trip. The
+ * board serves at most 8 continuous reads
+ *
+ * @param dev firmata i2c context, with the address set
+ * @param command first register to read
+ * @param length number of registers to read
+ * @return Result of operation
+ */
+mraa_result_t mraa_firmata_i2c_read_continuous(mraa_i2c_context dev, uint8_t command, int length);
+
+/**
+ * Stop all continuous reads of the context's address, also done by
+ * mraa_i2c_stop()
+ *
+ * @param dev firmata i2c context
+ * @return Result of operation
+ */
+mraa_result_t mraa_firmata_i2c_stop_reading(mraa_i2c_context dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -106,6 +106,14 @@ typedef enum {
     MRAA_GPIO_PUSH_PULL = 1,  /**< Push Pull Configuration */
 } mraa_gpio_out_driver_mode_t;
 
+/**
+ * Gpio interrupt dispatch modes
+ */
+typedef enum {
+    MRAA_GPIO_ISR_DISPATCH_THREAD = 0, /**< Default. One handler thread per context */
+    MRAA_GPIO_ISR_DISPATCH_SHARED = 1  /**< Shared epoll event loop(s) for all contexts */
+} mraa_gpio_isr_dispatch_t;
+
 typedef long long unsigned int mraa_timestamp_t;
 
 /**
@@ -118,6 +126,25 @@ typedef struct {
 
 typedef mraa_gpio_event* mraa_gpio_events_t;
 
+/**
+ * Edge event record of an event stream
+ */
+typedef struct {
+    int pin;                    /**< pin the edge occurred on, as used at init */
+    mraa_gpio_edge_t edge;      /**< MRAA_GPIO_EDGE_RISING or MRAA_GPIO_EDGE_FALLING */
+    mraa_timestamp_t timestamp; /**< kernel timestamp in nanoseconds */
+} mraa_gpio_edge_event_t;
+
+/**
+ * Counters of an event stream
+ */
+typedef struct {
+    uint64_t received;     /**< events drained from the kernel */
+    uint64_t delivered;    /**< events returned by mraa_gpio_event_stream_read() */
+    uint64_t overflows;    /**< events dropped because the ring buffer was full */
+    unsigned int max_fill; /**< highest number of events held in the ring buffer */
+} mraa_gpio_event_stats_t;
+
 /**
  * Initialise gpio_context, based on board number
  *
@@ -192,6 +219,91 @@ mraa_gpio_events_t mraa_gpio_get_events(mraa_gpio_context dev);
  */
 mraa_result_t mraa_gpio_isr_exit(mraa_gpio_context dev);
 
+/**
+ * Select how interrupt handlers set up by mraa_gpio_isr() are served. In
+ * MRAA_GPIO_ISR_DISPATCH_SHARED mode the event file descriptors of all
+ * contexts are watched by a small pool of epoll event loops instead of one
+ * thread per context. Contexts whose isr is already running keep their current
+ * dispatcher, see mraa_gpio_isr_dispatch_join().
+ *
+ * @param mode The dispatch mode
+ * @param num_loops Number of shared event loops, 0 keeps the current value
+ * (1 by default). It can only be changed while no context uses the dispatcher.
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_isr_dispatch_mode(mraa_gpio_isr_dispatch_t mode, unsigned int num_loops);
+
+/**
+ * Get the dispatch mode used for new interrupt handlers.
+ *
+ * @return The current dispatch mode
+ */
+mraa_gpio_isr_dispatch_t mraa_gpio_get_isr_dispatch_mode();
+
+/**
+ * Move the running interrupt handler of a context onto the shared dispatcher.
+ * Edges occurring while the handler is being moved may be missed.
+ *
+ * @param dev The Gpio context, with an isr set
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_isr_dispatch_join(mraa_gpio_context dev);
+
+/**
+ * Move the interrupt handler of a context off the shared dispatcher and back
+ * onto a dedicated thread. Edges occurring while the handler is being moved
+ * may be missed.
+ *
+ * @param dev The Gpio context, with an isr set
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_isr_dispatch_leave(mraa_gpio_context dev);
+
+/**
+ * Start streaming the edge events of all pins of a context into a ring
+ * buffer. A background thread drains the kernel event queues in bulk so that
+ * edges are not lost while the application is busy. A context can either
+ * stream events or have an isr, not both. Needs a chardev capable platform.
+ *
+ * @param dev The Gpio context
+ * @param mode Edges to record, MRAA_GPIO_EDGE_NONE is not allowed
+ * @param capacity Number of events the ring buffer can hold
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_event_stream_start(mraa_gpio_context dev, mraa_gpio_edge_t mode, unsigned int capacity);
+
+/**
+ * Take events out of the ring buffer, oldest first.
+ *
+ * @param dev The Gpio context
+ * @param events Array receiving the events
+ * @param max_events Size of the events array
+ * @param timeout_ms Time to wait for a first event, 0 to return at once and
+ * negative to wait forever
+ * @return number of events, 0 on timeout or -1 on error
+ */
+int mraa_gpio_event_stream_read(mraa_gpio_context dev,
+                                mraa_gpio_edge_event_t* events,
+                                unsigned int max_events,
+                                int timeout_ms);
+
+/**
+ * Get the counters of an event stream
+ *
+ * @param dev The Gpio context
+ * @param stats Receives the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_event_stream_stats(mraa_gpio_context dev, mraa_gpio_event_stats_t* stats);
+
+/**
+ * Stop an event stream, events still in the ring buffer are discarded
+ *
+ * @param dev The Gpio context
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_event_stream_stop(mraa_gpio_context dev);
+
 /**
  * Set Gpio(s) Output Mode,
  *
@@ -278,15 +390,16 @@ mraa_result_t mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[]);
 mraa_result_t mraa_gpio_owner(mraa_gpio_context dev, mraa_boolean_t owner);
 
 /**
- * Enable using memory mapped io instead of sysfs, chardev based I/O can be
- * considered memorymapped
+ * Enable using memory mapped io instead of sysfs or chardev. Reads and writes
+ * then access the GPIO controller registers directly, through /dev/gpiomem or
+ * /dev/mem, and need the pin to be configured beforehand. Only available on
+ * platforms with a register description, see the platform documentation.
  *
- * @deprecated
  * @param dev The Gpio context
  * @param mmap Use mmap instead of sysfs
  * @return Result of operation
  */
-DEPRECATED mraa_result_t mraa_gpio_use_mmaped(mraa_gpio_context dev, mraa_boolean_t mmap);
+mraa_result_t mraa_gpio_use_mmaped(mraa_gpio_context dev, mraa_boolean_t mmap);
 
 /**
  * Get a pin number of the gpio, invalid will return -1
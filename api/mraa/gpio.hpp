@@ -87,6 +87,38 @@ typedef enum {
     MODE_OUT_PUSH_PULL = 1,  /**< Push Pull Configuration */
 } OutputMode;
 
+/**
+ * Gpio interrupt dispatch modes
+ */
+typedef enum {
+    ISR_DISPATCH_THREAD = 0, /**< One thread per interrupt handler */
+    ISR_DISPATCH_SHARED = 1  /**< Handlers share a pool of event loops */
+} IsrDispatch;
+
+/**
+ * Select how interrupt handlers set up from now on are served
+ *
+ * @param mode The dispatch mode
+ * @param loops Number of shared event loops, 0 keeps the current value
+ * @return Result of operation
+ */
+inline Result
+setIsrDispatchMode(IsrDispatch mode, unsigned int loops = 0)
+{
+    return (Result) mraa_gpio_isr_dispatch_mode((mraa_gpio_isr_dispatch_t) mode, loops);
+}
+
+/**
+ * Get the dispatch mode used for new interrupt handlers
+ *
+ * @return The current dispatch mode
+ */
+inline IsrDispatch
+getIsrDispatchMode()
+{
+    return (IsrDispatch) mraa_gpio_get_isr_dispatch_mode();
+}
+
 /**
  * @brief API to General Purpose IO
  *
@@ -247,6 +279,81 @@ class Gpio
 #endif
         return (Result) mraa_gpio_isr_exit(m_gpio);
     }
+
+    /**
+     * Move the running isr onto the shared dispatcher
+     *
+     * @return Result of operation
+     */
+    Result
+    isrDispatchJoin()
+    {
+        return (Result) mraa_gpio_isr_dispatch_join(m_gpio);
+    }
+
+    /**
+     * Move the running isr back onto a dedicated thread
+     *
+     * @return Result of operation
+     */
+    Result
+    isrDispatchLeave()
+    {
+        return (Result) mraa_gpio_isr_dispatch_leave(m_gpio);
+    }
+
+    /**
+     * Start recording the edge events of the pin(s) into a ring buffer
+     *
+     * @param mode The edges to record
+     * @param capacity Number of events the ring buffer can hold
+     * @return Result of operation
+     */
+    Result
+    eventStreamStart(Edge mode, unsigned int capacity)
+    {
+        return (Result) mraa_gpio_event_stream_start(m_gpio, (mraa_gpio_edge_t) mode, capacity);
+    }
+
+#ifndef SWIG
+    /**
+     * Take recorded events out of the ring buffer, oldest first
+     *
+     * @param events Array receiving the events
+     * @param maxEvents Size of the events array
+     * @param timeoutMs Time to wait for a first event, negative to wait forever
+     * @return number of events, 0 on timeout or -1 on error
+     */
+    int
+    eventStreamRead(mraa_gpio_edge_event_t* events, unsigned int maxEvents, int timeoutMs = -1)
+    {
+        return mraa_gpio_event_stream_read(m_gpio, events, maxEvents, timeoutMs);
+    }
+
+    /**
+     * Get the counters of the event stream
+     *
+     * @return counters, all zero if the context is not streaming
+     */
+    mraa_gpio_event_stats_t
+    eventStreamStats()
+    {
+        mraa_gpio_event_stats_t stats = {};
+        mraa_gpio_event_stream_stats(m_gpio, &stats);
+        return stats;
+    }
+#endif
+
+    /**
+     * Stop recording edge events
+     *
+     * @return Result of operation
+     */
+    Result
+    eventStreamStop()
+    {
+        return (Result) mraa_gpio_event_stream_stop(m_gpio);
+    }
     /**
      * Change Gpio mode
      *
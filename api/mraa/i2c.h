@@ -46,6 +46,7 @@ extern "C" {
 #include <fcntl.h>
 #include <stdint.h>
 
+#include "async.h"
 #include "common.h"
 #include "gpio.h"
 
@@ -54,6 +55,31 @@ extern "C" {
  */
 typedef struct _i2c* mraa_i2c_context;
 
+/**
+ * Maximum number of messages in a combined transfer
+ */
+#define MRAA_I2C_MAX_MSGS 42
+
+/**
+ * Flags of a message in a combined transfer
+ */
+typedef enum {
+    MRAA_I2C_MSG_WRITE = 0,   /**< write data to the slave */
+    MRAA_I2C_MSG_READ = 1,    /**< read data from the slave */
+    MRAA_I2C_MSG_NOSTART = 2, /**< continue the previous message without a repeated start,
+                                   needs I2C_FUNC_NOSTART support from the adapter */
+} mraa_i2c_msg_flags_t;
+
+/**
+ * One message of a combined transfer, see mraa_i2c_transfer()
+ */
+typedef struct {
+    uint16_t addr;  /**< 7-bit slave address */
+    uint16_t flags; /**< combination of mraa_i2c_msg_flags_t */
+    uint16_t len;   /**< length of the message in bytes */
+    uint8_t* buf;   /**< data to write or buffer for the data read */
+} mraa_i2c_msg_t;
+
 /**
  * Initialise i2c context, using board defintions
  *
@@ -166,6 +192,45 @@ mraa_result_t mraa_i2c_write_byte_data(mraa_i2c_context dev, const uint8_t data,
  */
 mraa_result_t mraa_i2c_write_word_data(mraa_i2c_context dev, const uint16_t data, const uint8_t command);
 
+/**
+ * Perform a combined transfer: all messages are sent in order, separated by
+ * repeated starts, with a single stop at the end. Messages may address
+ * different slaves and the context's address is left unchanged.
+ *
+ * @param dev The i2c context
+ * @param msgs array of messages to transfer, in order
+ * @param num_msgs number of messages, at most MRAA_I2C_MAX_MSGS
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_transfer(mraa_i2c_context dev, mraa_i2c_msg_t* msgs, unsigned int num_msgs);
+
+/**
+ * Queue a combined transfer on the worker thread of the bus, see async.h.
+ * The message array is copied, the data buffers must stay valid until the
+ * request completes.
+ *
+ * @param dev The i2c context
+ * @param msgs array of messages to transfer, in order
+ * @param num_msgs number of messages, at most MRAA_I2C_MAX_MSGS
+ * @param cb completion callback, may be NULL
+ * @param args argument passed to the callback
+ * @return request handle to release with mraa_async_free() or NULL
+ */
+mraa_async_request_t mraa_i2c_transfer_async(mraa_i2c_context dev,
+                                             const mraa_i2c_msg_t* msgs,
+                                             unsigned int num_msgs,
+                                             mraa_async_callback_t cb,
+                                             void* args);
+
+/**
+ * Get the eventfd signalled for every completed asynchronous request of the
+ * context's bus
+ *
+ * @param dev The i2c context
+ * @return file descriptor or -1
+ */
+int mraa_i2c_async_fd(mraa_i2c_context dev);
+
 /**
  * Sets the i2c slave address.
  *
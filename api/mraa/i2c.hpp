@@ -29,10 +29,90 @@
 #include "i2c.h"
 #include "types.hpp"
 #include <stdexcept>
+#include <vector>
 
 namespace mraa
 {
 
+#ifndef SWIG
+/**
+ * @brief Builder for combined I2C transfers
+ *
+ * Messages are queued with write() and read() and transferred in one go by
+ * I2c::transfer(I2cTransaction&). The buffers must stay valid until then.
+ */
+class I2cTransaction
+{
+  public:
+    /**
+     * Queue a write message
+     *
+     * @param address 7-bit slave address
+     * @param data data to write
+     * @param length length of the message in bytes
+     * @param noStart continue the previous message without a repeated start
+     * @return the transaction, to chain calls
+     */
+    I2cTransaction&
+    write(uint8_t address, const uint8_t* data, uint16_t length, bool noStart = false)
+    {
+        return add(address, MRAA_I2C_MSG_WRITE, const_cast<uint8_t*>(data), length, noStart);
+    }
+
+    /**
+     * Queue a read message
+     *
+     * @param address 7-bit slave address
+     * @param data buffer for the data read
+     * @param length length of the message in bytes
+     * @param noStart continue the previous message without a repeated start
+     * @return the transaction, to chain calls
+     */
+    I2cTransaction&
+    read(uint8_t address, uint8_t* data, uint16_t length, bool noStart = false)
+    {
+        return add(address, MRAA_I2C_MSG_READ, data, length, noStart);
+    }
+
+    /**
+     * Remove all queued messages
+     */
+    void
+    clear()
+    {
+        m_msgs.clear();
+    }
+
+    /**
+     * Number of queued messages
+     *
+     * @return number of messages
+     */
+    size_t
+    size() const
+    {
+        return m_msgs.size();
+    }
+
+  private:
+    friend class I2c;
+
+    I2cTransaction&
+    add(uint8_t address, uint16_t flags, uint8_t* data, uint16_t length, bool noStart)
+    {
+        mraa_i2c_msg_t msg;
+        msg.addr = address;
+        msg.flags = flags | (noStart ? MRAA_I2C_MSG_NOSTART : 0);
+        msg.len = length;
+        msg.buf = data;
+        m_msgs.push_back(msg);
+        return *this;
+    }
+
+    std::vector<mraa_i2c_msg_t> m_msgs;
+};
+#endif
+
 /**
  * @brief API to Inter-Integrated Circuit
  *
@@ -246,6 +326,55 @@ class I2c
         return (Result) mraa_i2c_write_word_data(m_i2c, data, reg);
     }
 
+#ifndef SWIG
+    /**
+     * Transfer all messages of a transaction in a single call
+     *
+     * @param transaction messages to transfer
+     * @return Result of operation
+     */
+    Result
+    transfer(I2cTransaction& transaction)
+    {
+        if (transaction.m_msgs.empty()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return (Result) mraa_i2c_transfer(m_i2c, transaction.m_msgs.data(), transaction.m_msgs.size());
+    }
+
+    /**
+     * Queue the messages of a transaction on the worker thread of the bus.
+     * The transaction can be reused right away, the data buffers must stay
+     * valid until the request completes.
+     *
+     * @param transaction messages to transfer
+     * @param cb completion callback, may be NULL
+     * @param args argument passed to the callback
+     * @return request handle to release with mraa_async_free() or NULL
+     */
+    mraa_async_request_t
+    transferAsync(I2cTransaction& transaction, mraa_async_callback_t cb = NULL, void* args = NULL)
+    {
+        if (transaction.m_msgs.empty()) {
+            return NULL;
+        }
+        return mraa_i2c_transfer_async(m_i2c, transaction.m_msgs.data(),
+                                       transaction.m_msgs.size(), cb, args);
+    }
+
+    /**
+     * Get the eventfd signalled for every completed asynchronous request
+     * of the bus
+     *
+     * @return file descriptor or -1
+     */
+    int
+    asyncFd()
+    {
+        return mraa_i2c_async_fd(m_i2c);
+    }
+#endif
+
   private:
     mraa_i2c_context m_i2c;
 };
@@ -55,6 +55,18 @@ typedef struct {
     unsigned int location;
 } mraa_iio_channel;
 
+/** Statistics of a buffer capture, see mraa_iio_capture_start() */
+typedef struct {
+    /** Scans read from the device */
+    uint64_t scans;
+    /** Scans returned by mraa_iio_capture_read() */
+    uint64_t delivered;
+    /** Scans dropped because the ring was full */
+    uint64_t overflows;
+    /** Highest number of scans waiting in the ring */
+    unsigned int max_fill;
+} mraa_iio_capture_stats_t;
+
 /** Mraa Iio Event */
 typedef struct {
     /** Event name */
@@ -88,6 +100,12 @@ extern "C" {
  */
 typedef struct _iio* mraa_iio_context;
 
+/**
+ * Opaque pointer definition to a prepared attribute of an iio device, valid
+ * until the device is closed
+ */
+typedef struct _iio_attr* mraa_iio_attr;
+
 /**
  * Initialise iio context
  *
@@ -97,7 +115,9 @@ typedef struct _iio* mraa_iio_context;
 mraa_iio_context mraa_iio_init(int device);
 
 /**
- * Trigger buffer
+ * Trigger buffer. The callback gets one raw scan per call: the enabled
+ * channels in index order, each at its channel location, padded to the
+ * alignment of the largest channel.
  *
  * @param dev The iio context
  * @param fptr Callback
@@ -106,6 +126,127 @@ mraa_iio_context mraa_iio_init(int device);
  */
 mraa_result_t mraa_iio_trigger_buffer(mraa_iio_context dev, void (*fptr)(char*, void*), void* args);
 
+/**
+ * Start capturing the buffer of the device into a ring of raw scans.
+ *
+ * The scan elements to capture have to be enabled and a trigger set before.
+ * The kernel buffer gets enabled if it is not already, with a watermark so
+ * that scans are drained in large reads going straight into the ring.
+ * Cannot be combined with mraa_iio_trigger_buffer() on the same device.
+ *
+ * @param dev The iio context
+ * @param ring_scans Capacity of the ring in scans, scans arriving while it is
+ * full are dropped and counted as overflows
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_capture_start(mraa_iio_context dev, unsigned int ring_scans);
+
+/**
+ * Take scans out of the capture ring, decoded into one array per channel.
+ *
+ * channels is indexed like mraa_iio_get_channels(). For every enabled channel
+ * with a non NULL entry the sign extended values are stored in the array,
+ * as int64_t for 8 byte channels (e.g. the timestamp) and as int32_t for the
+ * others. Scans are consumed even for channels without an array. Only one
+ * thread should read a capture.
+ *
+ * @param dev The iio context
+ * @param channels One array of max_scans values per channel, or NULL
+ * @param max_scans Maximum number of scans to take
+ * @param timeout_ms How long to wait for a scan, 0 to return immediately, -1
+ * to wait forever
+ * @return Number of scans taken, -1 on error
+ */
+int mraa_iio_capture_read(mraa_iio_context dev, void* channels[], unsigned int max_scans, int timeout_ms);
+
+/**
+ * Get the statistics of a capture
+ *
+ * @param dev The iio context
+ * @param stats Filled with the current statistics
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_capture_stats(mraa_iio_context dev, mraa_iio_capture_stats_t* stats);
+
+/**
+ * Stop a capture. The kernel buffer is disabled again if the capture enabled
+ * it. Scans still in the ring are discarded.
+ *
+ * @param dev The iio context
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_capture_stop(mraa_iio_context dev);
+
+/**
+ * Prepare an attribute for repeated access. The attribute file is opened
+ * once and read with pread() from then on. Preparing the same attribute
+ * again returns the same handle; mraa_iio_read_int() and friends share them.
+ *
+ * @param dev The iio context
+ * @param attr_name Attribute name relative to the device, e.g. "in_accel_x_raw"
+ * @return attribute handle or NULL if the attribute does not exist
+ */
+mraa_iio_attr mraa_iio_attr_prepare(mraa_iio_context dev, const char* attr_name);
+
+/**
+ * Read the content of an attribute as is, no terminator is added.
+ *
+ * @param attr The attribute handle
+ * @param data Buffer to fill
+ * @param max_len Size of the buffer
+ * @return Number of bytes read, -1 on error
+ */
+int mraa_iio_attr_read(mraa_iio_attr attr, char* data, int max_len);
+
+/**
+ * Write raw bytes to an attribute
+ *
+ * @param attr The attribute handle
+ * @param data Bytes to write
+ * @param len Number of bytes
+ * @return Number of bytes written, -1 on error
+ */
+int mraa_iio_attr_write(mraa_iio_attr attr, const char* data, int len);
+
+/**
+ * Read an integer attribute
+ *
+ * @param attr The attribute handle
+ * @param data Value read
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_attr_read_int(mraa_iio_attr attr, int* data);
+
+/**
+ * Read a float attribute
+ *
+ * @param attr The attribute handle
+ * @param data Value read
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_attr_read_float(mraa_iio_attr attr, float* data);
+
+/**
+ * Read a raw channel attribute converted to SI units, (raw + offset) * scale.
+ * Scale and offset come from the matching _scale and _offset attributes of
+ * the channel or of its type (e.g. in_accel_x_scale, then in_accel_scale),
+ * looked up once so the conversion is a single multiply-add.
+ *
+ * @param attr The attribute handle of a _raw attribute
+ * @param data Converted value
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_attr_read_scaled(mraa_iio_attr attr, double* data);
+
+/**
+ * Look scale and offset of a raw attribute up again, after they were
+ * changed.
+ *
+ * @param attr The attribute handle of a _raw attribute
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_attr_update_scale(mraa_iio_attr attr);
+
 /**
  * Get device name
  *
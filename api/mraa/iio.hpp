@@ -190,6 +190,29 @@ class Iio
         return value;
     }
 
+    /**
+     * Read a raw channel attribute converted to SI units with the scale and
+     * offset of the channel, see mraa_iio_attr_read_scaled().
+     *
+     * @param attributeName raw attribute name, e.g. in_accel_x_raw
+     *
+     * @returns The converted value
+     *
+     * @throws std::invalid_argument if read fails
+     */
+    double
+    readScaled(const std::string& attributeName) const
+    {
+        double value;
+        mraa_iio_attr attr = mraa_iio_attr_prepare(m_iio, attributeName.c_str());
+        if (mraa_iio_attr_read_scaled(attr, &value) != MRAA_SUCCESS) {
+            std::ostringstream oss;
+            oss << "IIO readScaled for attibute " << attributeName << " failed";
+            throw std::runtime_error(oss.str());
+        }
+        return value;
+    }
+
     /**
      * Write an int value to specified attribute.
      *
@@ -244,6 +267,73 @@ class Iio
         }
     }
 
+    /**
+     * Start capturing the buffer of the device, see mraa_iio_capture_start()
+     *
+     * @param ringScans Capacity of the capture ring in scans
+     *
+     * @throws std::runtime_error on failure
+     */
+    void
+    captureStart(unsigned int ringScans) const
+    {
+        if (mraa_iio_capture_start(m_iio, ringScans) != MRAA_SUCCESS) {
+            throw std::runtime_error("IIO captureStart failed");
+        }
+    }
+
+#ifndef SWIG
+    /**
+     * Take captured scans decoded per channel, see mraa_iio_capture_read()
+     *
+     * @param channels One array per channel, or NULL
+     * @param maxScans Maximum number of scans to take
+     * @param timeoutMs Time to wait for a scan, 0 to poll, -1 to wait forever
+     * @return Number of scans taken
+     *
+     * @throws std::runtime_error on failure
+     */
+    int
+    captureRead(void* channels[], unsigned int maxScans, int timeoutMs = -1) const
+    {
+        int num = mraa_iio_capture_read(m_iio, channels, maxScans, timeoutMs);
+        if (num < 0) {
+            throw std::runtime_error("IIO captureRead failed");
+        }
+        return num;
+    }
+
+    /**
+     * Get the statistics of the capture
+     *
+     * @return Scans, delivered scans, overflows and highest ring fill
+     *
+     * @throws std::runtime_error on failure
+     */
+    mraa_iio_capture_stats_t
+    captureStats() const
+    {
+        mraa_iio_capture_stats_t stats;
+        if (mraa_iio_capture_stats(m_iio, &stats) != MRAA_SUCCESS) {
+            throw std::runtime_error("IIO captureStats failed");
+        }
+        return stats;
+    }
+#endif
+
+    /**
+     * Stop the capture, see mraa_iio_capture_stop()
+     *
+     * @throws std::runtime_error on failure
+     */
+    void
+    captureStop() const
+    {
+        if (mraa_iio_capture_stop(m_iio) != MRAA_SUCCESS) {
+            throw std::runtime_error("IIO captureStop failed");
+        }
+    }
+
   private:
     static void
     private_event_handler(iio_event_data* data, void* args)
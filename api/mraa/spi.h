@@ -47,6 +47,7 @@ extern "C" {
 #include <fcntl.h>
 #include <stdint.h>
 
+#include "async.h"
 #include "common.h"
 
 /**
@@ -68,6 +69,25 @@ typedef enum {
  */
 typedef struct _spi* mraa_spi_context;
 
+/**
+ * Maximum number of segments in a batched transfer
+ */
+#define MRAA_SPI_MAX_SEGMENTS 64
+
+/**
+ * One segment of a batched SPI transfer, see mraa_spi_transfer_batch()
+ */
+typedef struct {
+    const uint8_t* tx_buf;    /**< data to send, NULL to send zeros */
+    uint8_t* rx_buf;          /**< buffer for the received data, may be NULL */
+    unsigned int len;         /**< length of the segment in bytes */
+    unsigned int speed_hz;    /**< clock for this segment, 0 for the context's frequency */
+    uint8_t bits_per_word;    /**< word size for this segment, 0 for the context's */
+    uint16_t delay_usecs;     /**< delay after this segment */
+    mraa_boolean_t cs_change; /**< deselect the device after this segment, on the last
+                                   segment keep it selected after the transfer */
+} mraa_spi_segment_t;
+
 /**
  * Initialise SPI_context, uses board mapping. Sets the muxes
  *
@@ -143,6 +163,30 @@ uint8_t* mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length);
  */
 uint16_t* mraa_spi_write_buf_word(mraa_spi_context dev, uint16_t* data, int length);
 
+/**
+ * Write Buffer of bytes to the SPI device without allocating per call. The
+ * received data is stored in a buffer owned by the context, which only grows
+ * when a longer transfer is requested. The returned pointer must not be
+ * free'd and is only valid until the next *_reuse call or mraa_spi_stop().
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param length elements within buffer, Max 4096
+ * @return Data received on the miso line or NULL in case of error
+ */
+const uint8_t* mraa_spi_write_buf_reuse(mraa_spi_context dev, uint8_t* data, int length);
+
+/**
+ * Write Buffer of uint16 to the SPI device without allocating per call, see
+ * mraa_spi_write_buf_reuse().
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param length elements (in bytes) within buffer, Max 4096
+ * @return Data received on the miso line or NULL in case of error
+ */
+const uint16_t* mraa_spi_write_buf_word_reuse(mraa_spi_context dev, uint16_t* data, int length);
+
 /**
  * Transfer Buffer of bytes to the SPI device. Both send and recv buffers
  * are passed in
@@ -167,6 +211,46 @@ mraa_result_t mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t
  */
 mraa_result_t mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
 
+/**
+ * Perform several transfers as a single transaction. Segments are clocked
+ * back to back with the device selected, unless a segment asks for a chip
+ * select change, and are submitted to the kernel in one call.
+ *
+ * @param dev The Spi context
+ * @param segments array of segments to transfer, in order
+ * @param num_segments number of segments, at most MRAA_SPI_MAX_SEGMENTS
+ * @return Result of operation
+ */
+mraa_result_t
+mraa_spi_transfer_batch(mraa_spi_context dev, mraa_spi_segment_t* segments, unsigned int num_segments);
+
+/**
+ * Queue a batched transfer on the worker thread of the bus, see async.h.
+ * The segment array is copied, the data buffers must stay valid until the
+ * request completes.
+ *
+ * @param dev The Spi context
+ * @param segments array of segments to transfer, in order
+ * @param num_segments number of segments, at most MRAA_SPI_MAX_SEGMENTS
+ * @param cb completion callback, may be NULL
+ * @param args argument passed to the callback
+ * @return request handle to release with mraa_async_free() or NULL
+ */
+mraa_async_request_t mraa_spi_transfer_batch_async(mraa_spi_context dev,
+                                                   const mraa_spi_segment_t* segments,
+                                                   unsigned int num_segments,
+                                                   mraa_async_callback_t cb,
+                                                   void* args);
+
+/**
+ * Get the eventfd signalled for every completed asynchronous request of the
+ * context's bus
+ *
+ * @param dev The Spi context
+ * @return file descriptor or -1
+ */
+int mraa_spi_async_fd(mraa_spi_context dev);
+
 /**
  * Change the SPI lsb mode
  *
@@ -29,6 +29,7 @@
 #include "spi.h"
 #include "types.hpp"
 #include <stdexcept>
+#include <vector>
 
 namespace mraa
 {
@@ -48,6 +49,75 @@ typedef enum {
 } Spi_Mode;
 
 
+#ifndef SWIG
+/**
+ * @brief Builder for batched SPI transfers
+ *
+ * Segments are queued with add() and transferred in one go by
+ * Spi::transfer(SpiTransaction&). The buffers must stay valid until then.
+ */
+class SpiTransaction
+{
+  public:
+    /**
+     * Queue a segment
+     *
+     * @param txBuf data to send, NULL to send zeros
+     * @param rxBuf buffer for the received data, may be NULL
+     * @param length length of the segment in bytes
+     * @param speedHz clock for this segment, 0 for the bus frequency
+     * @param bitsPerWord word size for this segment, 0 for the bus setting
+     * @param delayUsecs delay after this segment
+     * @param csChange deselect the device after this segment
+     * @return the transaction, to chain calls
+     */
+    SpiTransaction&
+    add(const uint8_t* txBuf,
+        uint8_t* rxBuf,
+        unsigned int length,
+        unsigned int speedHz = 0,
+        uint8_t bitsPerWord = 0,
+        uint16_t delayUsecs = 0,
+        bool csChange = false)
+    {
+        mraa_spi_segment_t segment;
+        segment.tx_buf = txBuf;
+        segment.rx_buf = rxBuf;
+        segment.len = length;
+        segment.speed_hz = speedHz;
+        segment.bits_per_word = bitsPerWord;
+        segment.delay_usecs = delayUsecs;
+        segment.cs_change = csChange;
+        m_segments.push_back(segment);
+        return *this;
+    }
+
+    /**
+     * Remove all queued segments
+     */
+    void
+    clear()
+    {
+        m_segments.clear();
+    }
+
+    /**
+     * Number of queued segments
+     *
+     * @return number of segments
+     */
+    size_t
+    size() const
+    {
+        return m_segments.size();
+    }
+
+  private:
+    friend class Spi;
+    std::vector<mraa_spi_segment_t> m_segments;
+};
+#endif
+
 /**
 * @brief API to Serial Peripheral Interface
 *
@@ -172,6 +242,40 @@ class Spi
         return mraa_spi_write_buf(m_spi, txBuf, length);
     }
 
+#ifndef SWIG
+    /**
+     * Write buffer of bytes to SPI device into a caller provided receive
+     * buffer, without any allocation
+     *
+     * @param txBuf buffer to send
+     * @param rxBuf buffer for the data received on the miso line, at least
+     * length bytes, may be NULL
+     * @param length size of buffer to send
+     * @return Result of operation
+     */
+    Result
+    write(const uint8_t* txBuf, uint8_t* rxBuf, int length)
+    {
+        return (Result) mraa_spi_transfer_buf(m_spi, const_cast<uint8_t*>(txBuf), rxBuf, length);
+    }
+
+    /**
+     * Write buffer of bytes to SPI device, receiving into a buffer owned by
+     * the Spi object. The buffer is reused by later calls and must not be
+     * free'd.
+     *
+     * @param txBuf buffer to send
+     * @param length size of buffer to send
+     * @return data received on the miso line, valid until the next call, or
+     * NULL in case of error
+     */
+    const uint8_t*
+    writeReuse(const uint8_t* txBuf, int length)
+    {
+        return mraa_spi_write_buf_reuse(m_spi, const_cast<uint8_t*>(txBuf), length);
+    }
+#endif
+
 #ifndef SWIG
     /**
      * Write buffer of bytes to SPI device The pointer return has to be
@@ -219,6 +323,54 @@ class Spi
     {
         return (Result) mraa_spi_transfer_buf_word(m_spi, txBuf, rxBuf, length);
     }
+
+    /**
+     * Transfer all segments of a transaction in a single call
+     *
+     * @param transaction segments to transfer
+     * @return Result of operation
+     */
+    Result
+    transfer(SpiTransaction& transaction)
+    {
+        if (transaction.m_segments.empty()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return (Result) mraa_spi_transfer_batch(m_spi, transaction.m_segments.data(),
+                                                transaction.m_segments.size());
+    }
+
+    /**
+     * Queue the segments of a transaction on the worker thread of the bus.
+     * The transaction can be reused right away, the data buffers must stay
+     * valid until the request completes.
+     *
+     * @param transaction segments to transfer
+     * @param cb completion callback, may be NULL
+     * @param args argument passed to the callback
+     * @return request handle to release with mraa_async_free() or NULL
+     */
+    mraa_async_request_t
+    transferAsync(SpiTransaction& transaction, mraa_async_callback_t cb = NULL, void* args = NULL)
+    {
+        if (transaction.m_segments.empty()) {
+            return NULL;
+        }
+        return mraa_spi_transfer_batch_async(m_spi, transaction.m_segments.data(),
+                                             transaction.m_segments.size(), cb, args);
+    }
+
+    /**
+     * Get the eventfd signalled for every completed asynchronous request
+     * of the bus
+     *
+     * @return file descriptor or -1
+     */
+    int
+    asyncFd()
+    {
+        return mraa_spi_async_fd(m_spi);
+    }
 #endif
 
     /**
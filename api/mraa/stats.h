@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @file
+ * @brief I/O statistics
+ *
+ * When enabled with mraa_stats_enable(), every gpio, i2c, spi and uart
+ * context counts the calls, transferred bytes and errors of its I/O
+ * operations and keeps a latency histogram of them. Contexts register in a
+ * global table on their first measured operation and leave it when closed.
+ *
+ * Collection is off by default and costs a single branch per operation while
+ * off. Building with -DIOSTATS=OFF removes it entirely, in which case the
+ * functions below report MRAA_ERROR_FEATURE_NOT_SUPPORTED.
+ *
+ * Latencies are kept in buckets of a quarter power of two, percentiles are
+ * reported as the upper bound of the bucket they fall in.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+
+/**
+ * Measured operations
+ */
+typedef enum {
+    MRAA_STATS_GPIO_WRITE = 0,   /**< mraa_gpio_write() */
+    MRAA_STATS_I2C_READ = 1,     /**< mraa_i2c_read() and mraa_i2c_read_*() */
+    MRAA_STATS_SPI_TRANSFER = 2, /**< mraa_spi_write*() and mraa_spi_transfer*() */
+    MRAA_STATS_UART_READ = 3,    /**< mraa_uart_read() */
+    MRAA_STATS_UART_WRITE = 4,   /**< mraa_uart_write() */
+    MRAA_STATS_OP_COUNT = 5
+} mraa_stats_op_t;
+
+/**
+ * Statistics of one operation on one context
+ */
+typedef struct {
+    mraa_stats_op_t op;  /**< the operation */
+    int id;              /**< gpio pin, bus or uart index of the context */
+    unsigned int serial; /**< distinguishes contexts sharing the same id */
+    uint64_t calls;      /**< number of calls */
+    uint64_t bytes;      /**< bytes transferred by successful calls */
+    uint64_t errors;     /**< number of failed calls */
+    uint64_t total_ns;   /**< sum of all latencies */
+    uint64_t p50_ns;     /**< median latency */
+    uint64_t p99_ns;     /**< 99th percentile latency */
+    uint64_t max_ns;     /**< largest latency */
+} mraa_stats_record_t;
+
+/**
+ * Turn statistics collection on or off. Counters are kept when turned off.
+ *
+ * @param enable true to start collecting
+ * @return Result of operation
+ */
+mraa_result_t mraa_stats_enable(mraa_boolean_t enable);
+
+/**
+ * Check whether statistics are being collected
+ *
+ * @return mraa_boolean_t true if collection is on
+ */
+mraa_boolean_t mraa_stats_enabled();
+
+/**
+ * Copy the statistics of all open contexts. Operations a context never
+ * performed are left out.
+ *
+ * @param records Destination array, may be NULL if max_records is 0
+ * @param max_records Size of records
+ * @return Number of records available, which may exceed max_records, or -1
+ */
+int mraa_stats_get(mraa_stats_record_t* records, unsigned int max_records);
+
+/**
+ * Format the statistics of all open contexts as a text table, one line per
+ * context and operation.
+ *
+ * @return Allocated string that must be freed by the caller, or NULL
+ */
+char* mraa_stats_snapshot();
+
+/**
+ * Clear the counters and histograms of all open contexts
+ *
+ * @return Result of operation
+ */
+mraa_result_t mraa_stats_reset();
+
+/**
+ * Get the name of an operation, as used in snapshots
+ *
+ * @param op The operation
+ * @return Name such as "i2c_read", or NULL for an invalid value
+ */
+const char* mraa_stats_op_name(mraa_stats_op_t op);
+
+#ifdef __cplusplus
+}
+#endif
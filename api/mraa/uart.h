@@ -50,6 +50,59 @@ extern "C" {
 /** Mraa Uart Context */
 typedef struct _uart* mraa_uart_context;
 
+/**
+ * How the receive engine cuts the incoming bytes into frames
+ */
+typedef enum {
+    MRAA_UART_FRAME_DELIMITER = 0,      /**< frames end with the byte given as param, which is stripped */
+    MRAA_UART_FRAME_FIXED = 1,          /**< frames are param bytes long */
+    MRAA_UART_FRAME_LENGTH_PREFIXED = 2 /**< a big endian length of param (1 or 2) bytes precedes the payload */
+} mraa_uart_frame_t;
+
+/**
+ * Framing of the receive engine, see mraa_uart_rx_start()
+ */
+typedef struct {
+    mraa_uart_frame_t type; /**< framing method */
+    unsigned int param;     /**< delimiter, frame length or size of the length prefix */
+    void (*callback)(const char* frame, size_t length, void* args); /**< called for every complete frame */
+    void* args; /**< passed to the callback */
+} mraa_uart_framer_t;
+
+/**
+ * Counters of the receive engine
+ */
+typedef struct {
+    uint64_t bytes;          /**< bytes received */
+    uint64_t reads;          /**< read() calls made by the engine */
+    uint64_t frames;         /**< frames passed to the callback */
+    uint64_t overruns;       /**< bytes dropped because the ring was full */
+    uint64_t framing_errors; /**< frames dropped for not fitting the frame buffer */
+    uint64_t hw_overruns;    /**< overruns reported by the serial driver, 0 if unknown */
+    uint64_t latency_avg_ns; /**< average time from reception to delivery */
+    uint64_t latency_max_ns; /**< longest time from reception to delivery */
+} mraa_uart_rx_stats_t;
+
+/**
+ * One segment of a scatter-gather write, see mraa_uart_writev()
+ */
+typedef struct {
+    const char* data; /**< start of the segment */
+    size_t length;    /**< size of the segment in bytes */
+} mraa_uart_iovec_t;
+
+/**
+ * Counters of the transmit engine
+ */
+typedef struct {
+    uint64_t bytes;       /**< bytes handed to the driver */
+    uint64_t writes;      /**< write calls made by the engine */
+    uint64_t requests;    /**< writes queued by the application */
+    uint64_t would_block; /**< times the driver buffer was full on a non blocking port */
+    uint64_t drains;      /**< times the queue ran empty and was drained */
+    size_t max_fill;      /**< highest number of bytes queued at once */
+} mraa_uart_tx_stats_t;
+
 /**
  * Initialise uart_context, uses board mapping
  *
@@ -90,7 +143,9 @@ mraa_result_t mraa_uart_sendbreak(mraa_uart_context dev, int duration);
 /**
  * Set the baudrate.
  * Takes an int and will attempt to decide what baudrate  is
- * to be used on the UART hardware.
+ * to be used on the UART hardware. Rates without a termios constant, e.g.
+ * 250000 or 12000000, are passed to the driver as is where the kernel
+ * supports it; check the achieved rate with mraa_uart_get_baudrate().
  *
  * @param dev The UART context
  * @param baud unsigned int of baudrate i.e. 9600
@@ -98,6 +153,16 @@ mraa_result_t mraa_uart_sendbreak(mraa_uart_context dev, int duration);
  */
 mraa_result_t mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud);
 
+/**
+ * Get the baudrate the UART hardware actually runs at, which can differ
+ * from the requested one depending on the clock divisors.
+ *
+ * @param dev The UART context
+ * @param baud Filled with the baudrate
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_get_baudrate(mraa_uart_context dev, unsigned int* baud);
+
 /**
  * Set the transfer mode
  * For example setting the mode to 8N1 would be
@@ -134,7 +199,9 @@ mraa_result_t mraa_uart_set_flowcontrol(mraa_uart_context dev, mraa_boolean_t xo
 mraa_result_t mraa_uart_set_timeout(mraa_uart_context dev, int read, int write, int interchar);
 
 /**
- * Set the blocking state for write operations
+ * Set the blocking state for read and write operations. A non blocking
+ * mraa_uart_read() returns -1 with errno set to EAGAIN when nothing was
+ * received, also when it is served by the receive engine.
  *
  * @param dev The UART context
  * @param nonblock new nonblocking state
@@ -167,7 +234,7 @@ const char* mraa_uart_get_dev_path(mraa_uart_context dev);
  * @param index uart index to look up, if negative, *devpath will be used instead
  * @param devpath points to the device path of the UART, eg: /dev/ttyS0
  * @param name outparameter that on return will point to the name of the UART
- * @param baudrate pointer to an integer to contain the current baudrate (0--4M)
+ * @param baudrate pointer to an integer to contain the current baudrate
  * @param databits pointer to an integer to contain the number databits (5--8)
  * @param stopbits pointer to an integer to contain the number stopbits (1--2)
  * @param parity will contain the current parity mode
@@ -214,6 +281,19 @@ int mraa_uart_read(mraa_uart_context dev, char* buf, size_t length);
  */
 int mraa_uart_write(mraa_uart_context dev, const char* buf, size_t length);
 
+/**
+ * Write several buffers in one go. Without a transmit engine the segments
+ * are passed to the driver with writev(), and partial writes as well as a
+ * full driver buffer on a non blocking port are retried until everything
+ * is written. With a transmit engine the segments are queued back to back.
+ *
+ * @param dev uart context
+ * @param iov segments to write
+ * @param iovcnt number of segments
+ * @return the number of bytes written, -1 on error
+ */
+int mraa_uart_writev(mraa_uart_context dev, const mraa_uart_iovec_t* iov, unsigned int iovcnt);
+
 /**
  * Check to see if data is available on the device for reading
  *
@@ -223,6 +303,89 @@ int mraa_uart_write(mraa_uart_context dev, const char* buf, size_t length);
  */
 mraa_boolean_t mraa_uart_data_available(mraa_uart_context dev, unsigned int millis);
 
+/**
+ * Start a background receive engine. A thread drains the UART into a ring
+ * as soon as data arrives. mraa_uart_read() and mraa_uart_data_available()
+ * are then served from the ring without system calls; mraa_uart_read()
+ * waits for data when the ring is empty, unless the context was set non
+ * blocking. Bytes arriving while the ring is
+ * full are dropped and counted as overruns.
+ *
+ * With a framer, the engine cuts the data into frames and calls the framer
+ * callback from its thread for every complete frame instead, and
+ * mraa_uart_read() is not available.
+ *
+ * @param dev uart context
+ * @param ring_size Size of the ring in bytes, or of the largest frame when
+ * framing
+ * @param framer Framing to apply, NULL to fill the ring
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_start(mraa_uart_context dev, size_t ring_size, const mraa_uart_framer_t* framer);
+
+/**
+ * Get the counters of the receive engine
+ *
+ * @param dev uart context
+ * @param stats Filled with the current counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_stats(mraa_uart_context dev, mraa_uart_rx_stats_t* stats);
+
+/**
+ * Stop the receive engine. Data still in the ring is discarded.
+ *
+ * @param dev uart context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_stop(mraa_uart_context dev);
+
+/**
+ * Start a background transmit engine. mraa_uart_write() and
+ * mraa_uart_writev() then copy the data into a queue, waiting only when
+ * it is full, and a thread passes everything queued in the meantime to the
+ * driver with a single writev(). Partial writes and a full driver buffer
+ * on a non blocking port are handled by the engine.
+ *
+ * Whenever the queue runs empty the engine waits with tcdrain() until the
+ * data left the wire, then signals the eventfd from mraa_uart_tx_drain_fd()
+ * and calls the drained callback from its thread. mraa_uart_flush() waits
+ * for the data queued before the call.
+ *
+ * @param dev uart context
+ * @param queue_size Size of the queue in bytes
+ * @param drained Called after every drain, may be NULL
+ * @param args Passed to the callback
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_start(mraa_uart_context dev, size_t queue_size, void (*drained)(void* args), void* args);
+
+/**
+ * Get the eventfd of the transmit engine, which becomes readable after
+ * each drain. Reading it returns the number of drains since the last read.
+ *
+ * @param dev uart context
+ * @return the file descriptor, -1 if no transmit engine is running
+ */
+int mraa_uart_tx_drain_fd(mraa_uart_context dev);
+
+/**
+ * Get the counters of the transmit engine
+ *
+ * @param dev uart context
+ * @param stats Filled with the current counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_stats(mraa_uart_context dev, mraa_uart_tx_stats_t* stats);
+
+/**
+ * Stop the transmit engine, after it sent and drained what is queued.
+ *
+ * @param dev uart context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_stop(mraa_uart_context dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,9 @@
 #include <stdlib.h>
 #include <stdexcept>
 #include <cstring>
+#ifndef SWIG
+#include <vector>
+#endif
 
 namespace mraa
 {
@@ -228,6 +231,22 @@ class Uart
         return (Result) mraa_uart_set_baudrate(m_uart, baud);
     }
 
+    /**
+     * Get the baudrate the hardware actually runs at
+     *
+     * @throws std::runtime_error if the baudrate cannot be read
+     * @return Baudrate
+     */
+    unsigned int
+    getBaudRate()
+    {
+        unsigned int baud;
+        if (mraa_uart_get_baudrate(m_uart, &baud) != MRAA_SUCCESS) {
+            throw std::runtime_error("Unable to read the Uart baudrate");
+        }
+        return baud;
+    }
+
     /**
      * Set the transfer mode
      * For example setting the mode to 8N1 would be
@@ -273,7 +292,7 @@ class Uart
     }
 
     /**
-     * Set the blocking state for write operations
+     * Set the blocking state for read and write operations
      *
      * @param nonblock new nonblocking state
      * @return Result of operation
@@ -284,6 +303,147 @@ class Uart
         return (Result) mraa_uart_set_non_blocking(m_uart, nonblock);
     }
 
+    /**
+     * Start the background receive engine, read() and dataAvailable() are
+     * then served from its ring, see mraa_uart_rx_start()
+     *
+     * @param ringSize Size of the receive ring in bytes
+     * @return Result of operation
+     */
+    Result
+    rxStart(size_t ringSize)
+    {
+        return (Result) mraa_uart_rx_start(m_uart, ringSize, NULL);
+    }
+
+#ifndef SWIG
+    /**
+     * Start the background receive engine with a framer calling back for
+     * every complete frame, see mraa_uart_rx_start()
+     *
+     * @param maxFrame Size of the largest frame in bytes
+     * @param framer Framing method and callback
+     * @return Result of operation
+     */
+    Result
+    rxStart(size_t maxFrame, const mraa_uart_framer_t& framer)
+    {
+        return (Result) mraa_uart_rx_start(m_uart, maxFrame, &framer);
+    }
+
+    /**
+     * Get the counters of the receive engine
+     *
+     * @throws std::runtime_error if the engine is not running
+     * @return Current counters
+     */
+    mraa_uart_rx_stats_t
+    rxStats()
+    {
+        mraa_uart_rx_stats_t stats;
+        if (mraa_uart_rx_stats(m_uart, &stats) != MRAA_SUCCESS) {
+            throw std::runtime_error("Uart receive engine is not running");
+        }
+        return stats;
+    }
+#endif
+
+    /**
+     * Stop the background receive engine
+     *
+     * @return Result of operation
+     */
+    Result
+    rxStop()
+    {
+        return (Result) mraa_uart_rx_stop(m_uart);
+    }
+
+    /**
+     * Start the background transmit engine, writes are then queued and
+     * coalesced, see mraa_uart_tx_start()
+     *
+     * @param queueSize Size of the transmit queue in bytes
+     * @return Result of operation
+     */
+    Result
+    txStart(size_t queueSize)
+    {
+        return (Result) mraa_uart_tx_start(m_uart, queueSize, NULL, NULL);
+    }
+
+#ifndef SWIG
+    /**
+     * Start the background transmit engine calling back whenever the
+     * queued data left the wire, see mraa_uart_tx_start()
+     *
+     * @param queueSize Size of the transmit queue in bytes
+     * @param drained Called from the engine thread after every drain
+     * @param args Passed to the callback
+     * @return Result of operation
+     */
+    Result
+    txStart(size_t queueSize, void (*drained)(void*), void* args)
+    {
+        return (Result) mraa_uart_tx_start(m_uart, queueSize, drained, args);
+    }
+
+    /**
+     * Write several buffers in one go, see mraa_uart_writev()
+     *
+     * @param segments Buffers to write, in order
+     * @return number of bytes written, -1 on error
+     */
+    int
+    writev(const std::vector<std::string>& segments)
+    {
+        std::vector<mraa_uart_iovec_t> iov(segments.size());
+        for (size_t i = 0; i < segments.size(); ++i) {
+            iov[i].data = segments[i].data();
+            iov[i].length = segments[i].size();
+        }
+        return mraa_uart_writev(m_uart, iov.data(), iov.size());
+    }
+
+    /**
+     * Get the counters of the transmit engine
+     *
+     * @throws std::runtime_error if the engine is not running
+     * @return Current counters
+     */
+    mraa_uart_tx_stats_t
+    txStats()
+    {
+        mraa_uart_tx_stats_t stats;
+        if (mraa_uart_tx_stats(m_uart, &stats) != MRAA_SUCCESS) {
+            throw std::runtime_error("Uart transmit engine is not running");
+        }
+        return stats;
+    }
+#endif
+
+    /**
+     * Get the eventfd signalled after every drain of the transmit engine
+     *
+     * @return file descriptor, -1 if the engine is not running
+     */
+    int
+    txDrainFd()
+    {
+        return mraa_uart_tx_drain_fd(m_uart);
+    }
+
+    /**
+     * Stop the background transmit engine after the queue is sent
+     *
+     * @return Result of operation
+     */
+    Result
+    txStop()
+    {
+        return (Result) mraa_uart_tx_stop(m_uart);
+    }
+
   private:
     mraa_uart_context m_uart;
 };
@@ -81,6 +81,12 @@ typedef struct _mraa_uart_ow {
     int LastFamilyDiscrepancy;
     /** Context las device flag */
     mraa_boolean_t LastDeviceFlag;
+    /** Context overdrive speed selected */
+    mraa_boolean_t overdrive;
+    /** rom codes found by mraa_uart_ow_enumerate(), back to back */
+    uint8_t* roms;
+    /** number of rom codes in roms */
+    int rom_count;
 } *mraa_uart_ow_context;
 
 /**
@@ -91,9 +97,20 @@ typedef enum {
     MRAA_UART_OW_CMD_MATCH_ROM = 0x55,        /**< match a specific rom code */
     MRAA_UART_OW_CMD_SKIP_ROM = 0xcc,         /**< skip match/search rom */
     MRAA_UART_OW_CMD_SEARCH_ROM_ALARM = 0xec, /**< search all roms in alarm state */
-    MRAA_UART_OW_CMD_SEARCH_ROM = 0xf0        /**< search all rom codes */
+    MRAA_UART_OW_CMD_SEARCH_ROM = 0xf0,       /**< search all rom codes */
+    MRAA_UART_OW_CMD_OVERDRIVE_SKIP_ROM = 0x3c,  /**< skip rom, switching all devices to overdrive */
+    MRAA_UART_OW_CMD_OVERDRIVE_MATCH_ROM = 0x69  /**< match rom, switching the device to overdrive */
 } mraa_uart_ow_rom_cmd_t;
 
+/**
+ * Reading of a temperature sensor, see mraa_uart_ow_temperature_sweep()
+ */
+typedef struct {
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE]; /**< rom code of the sensor */
+    float celsius;                          /**< temperature in degrees Celsius */
+    mraa_result_t status;                   /**< MRAA_SUCCESS, or why celsius is not valid */
+} mraa_uart_ow_temperature_t;
+
 /**
  * Initialise uart_ow_context, uses UART board mapping
  *
@@ -144,6 +161,40 @@ int mraa_uart_ow_read_byte(mraa_uart_ow_context dev);
  */
 int mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte);
 
+/**
+ * Write a buffer to a 1-wire bus. All bits are sent with a single UART
+ * write per 32 bytes and read back in one go, instead of one round trip
+ * per bit.
+ *
+ * @param dev uart_ow context
+ * @param buf the bytes to write
+ * @param len number of bytes to write
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_write_bytes(mraa_uart_ow_context dev, const uint8_t* buf, size_t len);
+
+/**
+ * Read a buffer from a 1-wire bus, see mraa_uart_ow_write_bytes()
+ *
+ * @param dev uart_ow context
+ * @param buf filled with the bytes read
+ * @param len number of bytes to read
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_read_bytes(mraa_uart_ow_context dev, uint8_t* buf, size_t len);
+
+/**
+ * Write a buffer to a 1-wire bus and get the bytes read back during the
+ * time slots, see mraa_uart_ow_write_bytes()
+ *
+ * @param dev uart_ow context
+ * @param tx the bytes to write, NULL to send read slots (0xff)
+ * @param rx filled with the bytes read back, may be NULL
+ * @param len number of bytes to transfer
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_transfer(mraa_uart_ow_context dev, const uint8_t* tx, uint8_t* rx, size_t len);
+
 /**
  * Write a bit to a 1-wire bus and read a bit corresponding to the
  * time slot back.  This is possible due to the way we wired the TX
@@ -178,6 +229,53 @@ mraa_result_t mraa_uart_ow_reset(mraa_uart_ow_context dev);
  */
 mraa_result_t mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t start, uint8_t* id);
 
+/**
+ * Search the bus for all devices and remember their rom codes in the
+ * context. The search runs only once unless refresh is set.
+ *
+ * @param dev uart_ow context
+ * @param refresh search again even if the rom codes are known
+ * @return number of devices found, -1 on error
+ */
+int mraa_uart_ow_enumerate(mraa_uart_ow_context dev, mraa_boolean_t refresh);
+
+/**
+ * Get a rom code found by mraa_uart_ow_enumerate()
+ *
+ * @param dev uart_ow context
+ * @param index index of the device, 0 to the enumerated count - 1
+ * @param id filled with the 8-byte rom code
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_get_rom(mraa_uart_ow_context dev, int index, uint8_t* id);
+
+/**
+ * Read all DS18B20, DS1822, DS18S20 and compatible temperature sensors on
+ * the bus at once. The bus is enumerated on first use, then a single Skip
+ * ROM Convert T starts the conversion on every sensor, the sweep waits
+ * once for them to finish and reads each scratchpad with one transfer.
+ * Sensors whose scratchpad fails the CRC check get
+ * MRAA_ERROR_UART_OW_DATA_ERROR as status.
+ *
+ * @param dev uart_ow context
+ * @param results filled with one reading per sensor
+ * @param max_results size of results
+ * @return number of readings, -1 on error
+ */
+int mraa_uart_ow_temperature_sweep(mraa_uart_ow_context dev, mraa_uart_ow_temperature_t* results, int max_results);
+
+/**
+ * Switch the bus between standard and overdrive speed. Enabling sends an
+ * Overdrive Skip ROM so every device supporting it follows, disabling
+ * returns them to standard speed with the next reset. Devices without
+ * overdrive support, like the DS18B20, stop responding in overdrive.
+ *
+ * @param dev uart_ow context
+ * @param enable 1 for overdrive, 0 for standard speed
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_set_overdrive(mraa_uart_ow_context dev, mraa_boolean_t enable);
+
 /**
  * Send a command byte to a device on the 1-wire bus
  *
@@ -190,7 +288,8 @@ mraa_result_t mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t s
 mraa_result_t mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id);
 
 /**
- * Perform a Dallas 1-wire compliant CRC8 computation on a buffer
+ * Perform a Dallas 1-wire compliant CRC8 computation on a buffer, one
+ * table lookup per byte
  *
  * @param buffer the buffer containing the data
  * @param length the length of the buffer
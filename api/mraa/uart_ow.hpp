@@ -30,6 +30,9 @@
 #include "uart_ow.h"
 #include <cstring>
 #include <stdexcept>
+#ifndef SWIG
+#include <vector>
+#endif
 
 namespace mraa
 {
@@ -146,6 +149,47 @@ class UartOW
         return (uint8_t) res;
     }
 
+    /**
+     * Write a buffer to a 1-wire bus with a single round trip per 32 bytes
+     *
+     * @param buf the bytes to write
+     * @param len number of bytes to write
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    writeBytes(const uint8_t* buf, size_t len)
+    {
+        return (mraa::Result) mraa_uart_ow_write_bytes(m_uart, buf, len);
+    }
+
+    /**
+     * Read a buffer from a 1-wire bus with a single round trip per 32 bytes
+     *
+     * @param buf filled with the bytes read
+     * @param len number of bytes to read
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    readBytes(uint8_t* buf, size_t len)
+    {
+        return (mraa::Result) mraa_uart_ow_read_bytes(m_uart, buf, len);
+    }
+
+    /**
+     * Write a buffer to a 1-wire bus and get the bytes read back during
+     * the time slots
+     *
+     * @param tx the bytes to write, NULL to send read slots
+     * @param rx filled with the bytes read back, may be NULL
+     * @param len number of bytes to transfer
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    transfer(const uint8_t* tx, uint8_t* rx, size_t len)
+    {
+        return (mraa::Result) mraa_uart_ow_transfer(m_uart, tx, rx, len);
+    }
+
     /**
      * Write a bit to a 1-wire bus and read a bit corresponding to the
      * time slot back.  This is possible due to the way we wired the TX
@@ -262,6 +306,73 @@ class UartOW
         }
     }
 
+    /**
+     * Search the bus for all devices and remember their rom codes, see
+     * mraa_uart_ow_enumerate()
+     *
+     * @param refresh search again even if the rom codes are known
+     * @return number of devices found, -1 on error
+     */
+    int
+    enumerate(bool refresh = false)
+    {
+        return mraa_uart_ow_enumerate(m_uart, (refresh) ? 1 : 0);
+    }
+
+    /**
+     * Get a rom code found by enumerate()
+     *
+     * @param index index of the device
+     * @throws std::invalid_argument if there is no such device
+     * @return the 8-byte rom code
+     */
+    std::string
+    getRom(int index)
+    {
+        uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+        if (mraa_uart_ow_get_rom(m_uart, index, id) != MRAA_SUCCESS) {
+            throw std::invalid_argument("No such 1-wire device");
+        }
+        return std::string((char*) id, MRAA_UART_OW_ROMCODE_SIZE);
+    }
+
+#ifndef SWIG
+    /**
+     * Read all temperature sensors on the bus with a single conversion,
+     * see mraa_uart_ow_temperature_sweep()
+     *
+     * @throws std::invalid_argument in case of error
+     * @return one reading per sensor
+     */
+    std::vector<mraa_uart_ow_temperature_t>
+    temperatureSweep()
+    {
+        int count = mraa_uart_ow_enumerate(m_uart, 0);
+        if (count < 0) {
+            throw std::invalid_argument("Unknown UART_OW error");
+        }
+        std::vector<mraa_uart_ow_temperature_t> results(count);
+        count = mraa_uart_ow_temperature_sweep(m_uart, results.data(), count);
+        if (count < 0) {
+            throw std::invalid_argument("Unknown UART_OW error");
+        }
+        results.resize(count);
+        return results;
+    }
+#endif
+
+    /**
+     * Switch the bus between standard and overdrive speed
+     *
+     * @param enable true for overdrive
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    setOverdrive(bool enable)
+    {
+        return (mraa::Result) mraa_uart_ow_set_overdrive(m_uart, (enable) ? 1 : 0);
+    }
+
     /**
      * Perform a Dallas 1-wire compliant CRC8 computation on a buffer
      *
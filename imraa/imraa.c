@@ -140,7 +140,7 @@ main(int argc, char** argv)
         exit(1);
     }
 
-    // call reduced imraa_init (not that mraa_init) will already have been called
+    // call reduced imraa_init (not mraa_init), the platform is set up here if nothing did yet
     imraa_init();
 
     json_object* jobj = json_tokener_parse(buffer);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Upper bound for the number of channels in a scan. */
+#define MRAA_AIO_STREAM_MAX_CHANNELS 32
+/* Number of scans drained with a single read. */
+#define MRAA_AIO_STREAM_READ_BATCH 64
+
+/**
+ * Position and encoding of one channel in a buffered scan, as described by
+ * the scan_elements/in_voltageN_type attribute.
+ */
+typedef struct _aio_scan_element {
+    unsigned int location;   /**< byte offset in the scan */
+    unsigned int bytes;      /**< storage size in bytes */
+    unsigned int bits;       /**< number of valid bits */
+    unsigned int shift;      /**< right shift applied before masking */
+    mraa_boolean_t is_signed; /**< two's complement value */
+    mraa_boolean_t big_endian; /**< storage byte order */
+} mraa_aio_scan_element_t;
+
+/**
+ * Decode one channel out of a raw scan.
+ *
+ * @param scan Start of the scan
+ * @param element Layout of the channel
+ * @return the sign extended raw value
+ */
+int64_t mraa_aio_scan_decode(const uint8_t* scan, const mraa_aio_scan_element_t* element);
+
+/**
+ * Start continuous acquisition, see mraa_aio_stream_start().
+ *
+ * @param keep_newest Drop the oldest scans when the ring is full instead of
+ * the newest ones
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_open(mraa_aio_context* devs,
+                                   unsigned int num_devs,
+                                   const char* trigger,
+                                   int* ring,
+                                   unsigned int ring_scans,
+                                   mraa_boolean_t keep_newest);
+
+/**
+ * Stop the stream of a context, if any, before it gets closed.
+ *
+ * @param dev The AIO context
+ */
+void mraa_aio_stream_release(mraa_aio_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "async.h"
+#include "mraa_internal.h"
+
+/* Upper bound for the number of bus queues. */
+#define MRAA_ASYNC_MAX_QUEUES 16
+
+typedef enum {
+    MRAA_ASYNC_I2C = 0,
+    MRAA_ASYNC_SPI = 1,
+} mraa_async_bus_type_t;
+
+/**
+ * Queue a transfer on the worker thread of a bus. The message or segment
+ * descriptors are copied, the data buffers they point to are not.
+ *
+ * @param type Bus type
+ * @param busnum Bus number, requests with the same type and number share a queue
+ * @param dev The i2c or spi context
+ * @param items Array of mraa_i2c_msg_t or mraa_spi_segment_t
+ * @param num_items Number of elements in items
+ * @param cb Completion callback, may be NULL
+ * @param args Argument passed to the callback
+ * @return request handle or NULL
+ */
+mraa_async_request_t mraa_async_submit(mraa_async_bus_type_t type,
+                                       int busnum,
+                                       void* dev,
+                                       const void* items,
+                                       unsigned int num_items,
+                                       mraa_async_callback_t cb,
+                                       void* args);
+
+/**
+ * Get the completion eventfd of a bus, starting its queue if needed.
+ *
+ * @param type Bus type
+ * @param busnum Bus number
+ * @return file descriptor or -1
+ */
+int mraa_async_fd(mraa_async_bus_type_t type, int busnum);
+
+/**
+ * Wait until no request of a context is queued or in flight. Called before a
+ * context is closed.
+ *
+ * @param dev The i2c or spi context
+ */
+void mraa_async_flush(void* dev);
+
+/**
+ * Stop all worker threads once their queues are empty.
+ */
+void mraa_async_shutdown();
+
+#ifdef __cplusplus
+}
+#endif
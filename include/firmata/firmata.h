@@ -42,6 +42,7 @@
 #define FIRMATA_I2C_CONFIG 0x78
 #define FIRMATA_I2C_REPLY 0x77
 #define FIRMATA_I2C_REQUEST 0x76
+#define FIRMATA_SAMPLING_INTERVAL 0x7A // set the poll rate of the main loop
 
 #define I2C_MODE_WRITE 0x00
 #define I2C_MODE_READ 0x01
@@ -65,6 +66,8 @@
 #define FIRMATA_SYSEX_REALTIME 0x7F     // MIDI Reserved for realtime messages
 
 #define FIRMATA_MSG_LEN 1024
+#define FIRMATA_PIN_COUNT 128
+#define FIRMATA_I2C_MAX_QUERIES 8 // continuous reads StandardFirmata can serve at once
 
 typedef struct s_pin {
     uint8_t mode;
@@ -73,6 +76,12 @@ typedef struct s_pin {
     uint32_t value;
 } t_pin;
 
+typedef struct s_i2c_query {
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t len;
+} t_i2c_query;
+
 typedef struct s_firmata {
     mraa_uart_context uart;
     t_pin pins[128];
@@ -84,7 +93,11 @@ typedef struct s_firmata {
     char firmware[140];
     uint8_t dev_count;
     struct _firmata** devs;
-    pthread_spinlock_t lock;
+    pthread_mutex_t lock; /**< guards pins, i2cmsg and isr_detected */
+    pthread_cond_t cond;  /**< broadcast whenever a reply or pin change was parsed */
+    uint64_t isr_detected[FIRMATA_PIN_COUNT / 64]; /**< input pins that changed, both edges */
+    t_i2c_query i2c_queries[FIRMATA_I2C_MAX_QUERIES]; /**< registers the board reports continuously */
+    int i2c_query_count;
 } t_firmata;
 
 t_firmata* firmata_new(const char* name);
@@ -92,9 +105,10 @@ void firmata_initPins(t_firmata* firmata);
 int firmata_askFirmware(t_firmata* firmata);
 int firmata_pinMode(t_firmata* firmata, int pin, int mode);
 int firmata_digitalWrite(t_firmata* firmata, int pin, int value);
+int firmata_digitalWritePort(t_firmata* firmata, int port);
 int firmata_analogWrite(t_firmata* firmata, int pin, int value);
 int firmata_analogRead(t_firmata* firmata, int pin);
-int firmata_pull(t_firmata* firmata);
+int firmata_pull(t_firmata* firmata, unsigned int millis);
 void firmata_parse(t_firmata* firmata, const uint8_t* buf, int len);
 void firmata_endParse(t_firmata* firmata);
 void firmata_close(t_firmata* firmata);
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Upper bound for the number of shared interrupt event loops. */
+#define MRAA_GPIO_DISPATCH_MAX_LOOPS 16
+
+mraa_timestamp_t _mraa_gpio_get_timestamp_sysfs();
+
+/**
+ * Check whether new interrupt handlers should be served by the shared
+ * dispatcher rather than by a dedicated thread.
+ *
+ * @return mraa_boolean_t true if the dispatch mode is MRAA_GPIO_ISR_DISPATCH_SHARED
+ */
+mraa_boolean_t mraa_gpio_dispatch_enabled();
+
+/**
+ * Check whether a context can be served by the shared dispatcher. Contexts with
+ * custom interrupt hooks and Java callbacks keep using a dedicated handler
+ * thread.
+ *
+ * @param dev The Gpio context, with isr already set
+ * @return mraa_boolean_t true if the context can join the dispatcher
+ */
+mraa_boolean_t mraa_gpio_dispatch_eligible(mraa_gpio_context dev);
+
+/**
+ * Register the event file descriptors of a context, whose edge mode is already
+ * configured, with the least loaded event loop. Loops are started on demand.
+ *
+ * @param dev The Gpio context
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_dispatch_add(mraa_gpio_context dev);
+
+/**
+ * Remove a context from its event loop. Once this returns the context's isr
+ * is not running and will not be called again, unless the caller is the isr
+ * itself.
+ *
+ * @param dev The Gpio context
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_dispatch_remove(mraa_gpio_context dev);
+
+/**
+ * Change the dispatch mode and the number of event loops used by the shared
+ * dispatcher.
+ *
+ * @param mode Dispatch mode for interrupt handlers set up from now on
+ * @param num_loops Number of event loops, 0 keeps the current value
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_dispatch_configure(mraa_gpio_isr_dispatch_t mode, unsigned int num_loops);
+
+/**
+ * Stop all event loops. Loops still serving contexts are left running.
+ */
+void mraa_gpio_dispatch_shutdown();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Number of kernel event records drained with a single read. */
+#define MRAA_GPIO_EVENT_READ_BATCH 64
+
+/**
+ * Stop the event stream of a context, if any, before it gets closed.
+ *
+ * @param dev The Gpio context
+ */
+void mraa_gpio_event_stream_release(mraa_gpio_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+
+#include "mraa_internal.h"
+
+#define MRAA_GPIO_MMAP_MAX_BANKS 8
+/* Register offset value for SoCs without write-1-to-set/clear registers. */
+#define MRAA_GPIO_MMAP_NO_REG 0xffffffff
+
+/**
+ * Register layout of a SoC GPIO controller. Each bank drives lines_per_bank
+ * lines, 32 per register word, and the set/clear/level/out registers of
+ * consecutive words follow each other 4 bytes apart.
+ */
+typedef struct {
+    const char* name;           /**< SoC name, as used by mraa_gpio_mmap_find_soc() */
+    const char* gpiomem_dev;    /**< unprivileged device mapping bank 0 at offset 0, or NULL */
+    const char* mem_dev;        /**< device mapping physical addresses, usually /dev/mem */
+    unsigned int num_banks;
+    off_t bank_base[MRAA_GPIO_MMAP_MAX_BANKS]; /**< physical address of each bank */
+    unsigned int bank_size;     /**< bytes to map per bank, a multiple of the page size */
+    unsigned int lines_per_bank;
+    unsigned int level_reg;     /**< input level register */
+    unsigned int out_reg;       /**< output data register, used without set/clear registers */
+    unsigned int set_reg;       /**< write-1-to-set register or MRAA_GPIO_MMAP_NO_REG */
+    unsigned int clear_reg;     /**< write-1-to-clear register or MRAA_GPIO_MMAP_NO_REG */
+} mraa_gpio_mmap_soc_t;
+
+/**
+ * Look up the register description of a known SoC
+ *
+ * @param name SoC name, e.g. "bcm2837" or "rk3399"
+ * @return the description or NULL if the SoC is unknown
+ */
+const mraa_gpio_mmap_soc_t* mraa_gpio_mmap_find_soc(const char* name);
+
+/**
+ * Generic gpio_mmap_setup implementation. dev->pin is taken as the controller
+ * line number, bank * lines_per_bank + bit. Banks are mapped on first use and
+ * unmapped when the last context using them disables mmap.
+ *
+ * @param dev The Gpio context
+ * @param en Enable or disable register access
+ * @param soc Register description of the controller
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en, const mraa_gpio_mmap_soc_t* soc);
+
+/**
+ * Drop the register mapping of a context being closed, if it has one.
+ *
+ * @param dev The Gpio context
+ */
+void mraa_gpio_mmap_release(mraa_gpio_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Close and free every attribute handle of a device.
+ *
+ * @param dev The iio context
+ */
+void mraa_iio_attr_release_all(mraa_iio_context dev);
+
+/**
+ * Change the directory attributes are looked up in, the device number is
+ * appended to it. Only meant for tests running against a fake sysfs tree,
+ * handles prepared before keep their descriptors.
+ *
+ * @param prefix Device directory without the number, NULL for sysfs
+ */
+void mraa_iio_attr_set_root(const char* prefix);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Scans drained with a single read when the ring is full. */
+#define MRAA_IIO_CAPTURE_READ_BATCH 256
+
+/**
+ * Place the enabled channels in index order the way the kernel packs them
+ * into a scan, and update datasize to the size of a whole scan.
+ *
+ * @param dev The iio context
+ * @return Result of operation
+ */
+mraa_result_t mraa_iio_update_scan_layout(mraa_iio_context dev);
+
+/**
+ * Decode one channel out of consecutive scans.
+ *
+ * @param scans First scan
+ * @param num_scans Number of scans
+ * @param scan_size Size of a scan in bytes
+ * @param chan Layout of the channel
+ * @param out int64_t array for 8 byte channels, int32_t array otherwise
+ */
+void mraa_iio_demux(const uint8_t* scans,
+                    unsigned int num_scans,
+                    unsigned int scan_size,
+                    const mraa_iio_channel* chan,
+                    void* out);
+
+/**
+ * Stop the capture of a context, if any, before it gets closed.
+ *
+ * @param dev The iio context
+ */
+void mraa_iio_capture_release(mraa_iio_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gpio/gpio_chardev.h"
+#include "mraa_internal.h"
+
+typedef enum {
+    MRAA_LOOKUP_GPIO = 0, /**< gpio capable pins, by pin name */
+    MRAA_LOOKUP_I2C,      /**< i2c buses, by bus name */
+    MRAA_LOOKUP_SPI,      /**< spi buses, by bus name */
+    MRAA_LOOKUP_PWM,      /**< pwm devices, by device name */
+    MRAA_LOOKUP_UART,     /**< uart devices, by device name */
+    MRAA_LOOKUP_LINE      /**< gpiochip lines, by kernel line name */
+} mraa_lookup_kind_t;
+
+/**
+ * Find a name of the platform in its hash index, built on first use. Names
+ * of the main platform shadow those of the sub platform.
+ *
+ * @param kind what the name stands for, anything but MRAA_LOOKUP_LINE
+ * @param name name to look for
+ * @return what the linear lookup of that kind returned for the name, flagged
+ * as a sub platform id when it is from the sub platform, -1 if not found
+ */
+int mraa_lookup_name(mraa_lookup_kind_t kind, const char* name);
+
+/**
+ * Find a gpiochip line by its kernel name. The line names of all chips are
+ * indexed on first use and indexed again when the chips changed since.
+ *
+ * @param name line name to look for
+ * @param cinfos the gpiochips as returned by mraa_get_chip_infos()
+ * @param num_chips number of gpiochips
+ * @param line set to the line offset within its chip
+ * @return index of the chip in cinfos, -1 if there is no such line
+ */
+int mraa_lookup_gpio_line(const char* name, mraa_gpiod_chip_info** cinfos, int num_chips, unsigned int* line);
+
+/**
+ * Drop all indexes, to be called whenever the platform or its sub platform
+ * changed.
+ */
+void mraa_lookup_reset();
+
+#ifdef __cplusplus
+}
+#endif
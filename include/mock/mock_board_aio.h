@@ -13,6 +13,10 @@ extern "C" {
 
 #include "mraa_internal.h"
 
+// Scans queued by a mock stream. Channel i of scan s carries the raw 12 bit
+// value (s * 16 + i) << 2, which reads back as s * 16 + i at 10 bits.
+#define MOCK_AIO_STREAM_SCANS 16
+
 mraa_result_t
 mraa_mock_aio_init_internal_replace(mraa_aio_context dev, int pin);
 
@@ -22,6 +26,17 @@ mraa_mock_aio_close_replace(mraa_aio_context dev);
 int
 mraa_mock_aio_read_replace(mraa_aio_context dev);
 
+mraa_result_t
+mraa_mock_aio_read_multi_replace(mraa_aio_context dev, int values[], unsigned int num_channels);
+
+int
+mraa_mock_aio_stream_open_replace(mraa_aio_context dev,
+                                  const unsigned int* channels,
+                                  unsigned int num_channels,
+                                  const char* trigger,
+                                  struct _aio_scan_element* layout,
+                                  unsigned int* scan_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,12 @@ mraa_mock_gpio_isr_exit_replace(mraa_gpio_context dev);
 mraa_result_t
 mraa_mock_gpio_mode_replace(mraa_gpio_context dev, mraa_gpio_mode_t mode);
 
+mraa_result_t
+mraa_mock_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en);
+
+mraa_result_t
+mraa_mock_gpio_event_fds_replace(mraa_gpio_context dev, mraa_gpio_edge_t mode, int fds[], unsigned int num_fds);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,10 +15,15 @@ extern "C" {
 
 // ASCII code for "Z", used as a basis for our mock reads
 #define MOCK_UART_DATA_BYTE 0x5A
+// Highest rate accepted by the mock UART
+#define MOCK_UART_MAX_BAUDRATE 12000000
 
 mraa_result_t
 mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud);
 
+mraa_result_t
+mraa_mock_uart_get_baudrate_replace(mraa_uart_context dev, unsigned int* baud);
+
 mraa_result_t
 mraa_mock_uart_init_raw_replace(mraa_uart_context dev, const char* path);
 
@@ -49,6 +54,9 @@ mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len)
 int
 mraa_mock_uart_read_replace(mraa_uart_context dev, char* buf, size_t len);
 
+int
+mraa_mock_uart_rx_open_replace(mraa_uart_context dev);
+
 #ifdef __cplusplus
 }
 #endif
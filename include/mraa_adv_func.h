@@ -13,6 +13,9 @@
 // FIXME: Nasty macro to test for presence of function in context structure function table
 #define IS_FUNC_DEFINED(dev, func)   (dev != NULL && dev->advance_func != NULL && dev->advance_func->func != NULL)
 
+/* Layout of a channel in a buffered IIO scan, see aio/aio_stream.h */
+struct _aio_scan_element;
+
 typedef struct {
     mraa_result_t (*gpio_init_internal_replace) (mraa_gpio_context dev, int pin);
     mraa_result_t (*gpio_init_pre) (int pin);
@@ -36,12 +39,14 @@ typedef struct {
     mraa_result_t (*gpio_write_replace) (mraa_gpio_context dev, int value);
     mraa_result_t (*gpio_write_pre) (mraa_gpio_context dev, int value);
     mraa_result_t (*gpio_write_post) (mraa_gpio_context dev, int value);
+    mraa_result_t (*gpio_write_multi_replace) (mraa_gpio_context dev, int input_values[]);
     mraa_result_t (*gpio_mmap_setup) (mraa_gpio_context dev, mraa_boolean_t en);
     mraa_result_t (*gpio_interrupt_handler_init_replace) (mraa_gpio_context dev);
     mraa_result_t (*gpio_wait_interrupt_replace) (mraa_gpio_context dev);
     mraa_result_t (*gpio_isr_replace) (mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*), void* args);
     mraa_result_t (*gpio_isr_exit_replace) (mraa_gpio_context dev);
     mraa_result_t (*gpio_out_driver_mode_replace) (mraa_gpio_context dev, mraa_gpio_out_driver_mode_t mode);
+    mraa_result_t (*gpio_event_fds_replace) (mraa_gpio_context dev, mraa_gpio_edge_t mode, int fds[], unsigned int num_fds);
 
     mraa_result_t (*i2c_init_pre) (unsigned int bus);
     mraa_result_t (*i2c_init_bus_replace) (mraa_i2c_context dev);
@@ -58,14 +63,17 @@ typedef struct {
     mraa_result_t (*i2c_write_byte_replace) (mraa_i2c_context dev, uint8_t data);
     mraa_result_t (*i2c_write_byte_data_replace) (mraa_i2c_context dev, const uint8_t data, const uint8_t command);
     mraa_result_t (*i2c_write_word_data_replace) (mraa_i2c_context dev, const uint16_t data, const uint8_t command);
+    mraa_result_t (*i2c_transfer_replace) (mraa_i2c_context dev, mraa_i2c_msg_t* msgs, unsigned int num_msgs);
     mraa_result_t (*i2c_stop_replace) (mraa_i2c_context dev);
 
     mraa_result_t (*aio_init_internal_replace) (mraa_aio_context dev, int pin);
     mraa_result_t (*aio_close_replace) (mraa_aio_context dev);
     int (*aio_read_replace) (mraa_aio_context dev);
+    mraa_result_t (*aio_read_multi_replace) (mraa_aio_context dev, int values[], unsigned int num_channels);
     mraa_result_t (*aio_get_valid_fp) (mraa_aio_context dev);
     mraa_result_t (*aio_init_pre) (unsigned int aio);
     mraa_result_t (*aio_init_post) (mraa_aio_context dev);
+    int (*aio_stream_open_replace) (mraa_aio_context dev, const unsigned int* channels, unsigned int num_channels, const char* trigger, struct _aio_scan_element* layout, unsigned int* scan_size);
 
     mraa_pwm_context (*pwm_init_replace) (int pin);
     mraa_pwm_context (*pwm_init_internal_replace) (void* func_table, int pin);
@@ -88,6 +96,7 @@ typedef struct {
     mraa_result_t (*spi_frequency_replace) (mraa_spi_context dev, int hz);
     mraa_result_t (*spi_transfer_buf_replace) (mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length);
     mraa_result_t (*spi_transfer_buf_word_replace) (mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
+    mraa_result_t (*spi_transfer_batch_replace) (mraa_spi_context dev, mraa_spi_segment_t* segments, unsigned int num_segments);
     int (*spi_write_replace) (mraa_spi_context dev, uint8_t data);
     int (*spi_write_word_replace) (mraa_spi_context dev, uint16_t data);
     mraa_result_t (*spi_stop_replace) (mraa_spi_context dev);
@@ -98,6 +107,7 @@ typedef struct {
     mraa_result_t (*uart_flush_replace) (mraa_uart_context dev);
     mraa_result_t (*uart_sendbreak_replace) (mraa_uart_context dev, int duration);
     mraa_result_t (*uart_set_baudrate_replace) (mraa_uart_context dev, unsigned int baud);
+    mraa_result_t (*uart_get_baudrate_replace) (mraa_uart_context dev, unsigned int* baud);
     mraa_result_t (*uart_set_mode_replace) (mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits);
     mraa_result_t (*uart_set_flowcontrol_replace) (mraa_uart_context dev, mraa_boolean_t xonxoff, mraa_boolean_t rtscts);
     mraa_result_t (*uart_set_timeout_replace) (mraa_uart_context dev, int read, int write, int interchar);
@@ -105,6 +115,7 @@ typedef struct {
     int (*uart_read_replace) (mraa_uart_context dev, char* buf, size_t len);
     int (*uart_write_replace)(mraa_uart_context dev, const char* buf, size_t len);
     mraa_boolean_t (*uart_data_available_replace) (mraa_uart_context dev, unsigned int millis);
+    int (*uart_rx_open_replace) (mraa_uart_context dev);
     mraa_result_t (*led_set_bright) (int index, int val);
     mraa_result_t (*led_set_close) (int index );
     mraa_result_t (*led_init) (int index);
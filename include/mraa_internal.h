@@ -26,6 +26,21 @@ extern mraa_iio_info_t* plat_iio;
 #endif
 extern mraa_lang_func_t* lang_func;
 
+/**
+ * Get the main platform, setting it up with mraa_init() on first use. Entry
+ * points that read plat call this first, so no explicit mraa_init() is needed.
+ *
+ * @return the main platform, NULL if it could not be set up
+ */
+mraa_board_t* mraa_resolve_platform();
+
+/**
+ * Attach the sub platforms found through the USB extender library and the
+ * imraa lockfile. Runs once per mraa_init(), when a sub platform is first
+ * asked for.
+ */
+void mraa_discover_sub_platforms();
+
 /**
  * Takes in pin information and sets up the multiplexors.
  *
@@ -63,7 +78,7 @@ mraa_platform_t mraa_mips_platform();
 mraa_platform_t mraa_mock_platform();
 
 /**
- * runtime detect iio subsystem
+ * runtime detect iio subsystem, once until mraa_deinit()
  *
  * @return mraa_result_t indicating success of iio detection
  */
@@ -127,13 +127,20 @@ struct _gpio {
     int isr_control_pipe[2]; /**< a pipe used to interrupt the isr from polling the value fd*/
 #endif
     mraa_boolean_t isr_thread_terminating; /**< is the isr thread being terminated? */
+    mraa_gpio_edge_t isr_edge; /**< the edge mode the isr was set up with */
+    struct _gpio_dispatch_reg* isr_dispatch; /**< shared dispatcher registration, NULL when using a thread */
     mraa_boolean_t owner; /**< If this context originally exported the pin */
     mraa_result_t (*mmap_write) (mraa_gpio_context dev, int value);
     int (*mmap_read) (mraa_gpio_context dev);
+    struct _gpio_mmap_line* mmap_line; /**< registers used by the generic mmap backend */
+    struct _gpio_event_stream* event_stream; /**< edge event ring buffer, NULL when not streaming */
+    struct _mraa_stats* stats; /**< I/O statistics, NULL until measured */
     mraa_adv_func_t* advance_func; /**< override function table */
 #if defined(MOCKPLAT)
     mraa_gpio_dir_t mock_dir; /**< mock direction of the pin */
     int mock_state; /**< mock state of the pin */
+    int mock_event_fd; /**< write end of the mock edge event pipe, -1 when not streaming */
+    mraa_gpio_edge_t mock_edge; /**< edges written to mock_event_fd */
 #endif
     /*@}*/
 #ifdef PERIPHERALMAN
@@ -172,6 +179,7 @@ struct _i2c {
     int addr; /**< the address of the i2c slave */
     unsigned long funcs; /**< /dev/i2c-* device capabilities as per https://www.kernel.org/doc/Documentation/i2c/functionality */
     void *handle; /**< generic handle for non-standard drivers that don't use file descriptors  */
+    struct _mraa_stats* stats; /**< I/O statistics, NULL until measured */
     mraa_adv_func_t* advance_func; /**< override function table */
 #if defined(MOCKPLAT)
     uint8_t mock_dev_addr; /**< address of the mock I2C device */
@@ -190,11 +198,15 @@ struct _i2c {
  */
 struct _spi {
     /*@{*/
+    int busnum;         /**< the bus number of the /dev/spidev* device */
     int devfd;          /**< File descriptor to SPI Device */
     uint32_t mode;      /**< Spi mode see spidev.h */
     int clock;          /**< clock to run transactions at */
     mraa_boolean_t lsb; /**< least significant bit mode */
     unsigned int bpw;   /**< Bits per word */
+    void* rx_arena;     /**< receive buffer reused by the *_reuse writes */
+    size_t rx_arena_size; /**< size of rx_arena in bytes */
+    struct _mraa_stats* stats; /**< I/O statistics, NULL until measured */
     mraa_adv_func_t* advance_func; /**< override function table */
     /*@}*/
 #ifdef PERIPHERALMAN
@@ -227,8 +239,12 @@ struct _aio {
     unsigned int channel; /**< the channel as on board and ADC module */
     int adc_in_fp; /**< File Pointer to raw sysfs */
     int value_bit; /**< 10 bits by default. Can be increased if board */
+    struct _aio_stream* stream; /**< continuous acquisition, NULL when not streaming */
+    int* scan_ring; /**< ring of the buffered scan behind mraa_aio_read_multi() */
+    int scan_mode; /**< buffered multi reads: 0 untried, 1 running, -1 unavailable */
     mraa_adv_func_t* advance_func; /**< override function table */
     /*@}*/
+    struct _aio* next; /**< next pin of a context from mraa_aio_init_multi() */
 };
 
 /**
@@ -239,6 +255,10 @@ struct _uart {
     int index; /**< the uart index, as known to the os. */
     const char* path; /**< the uart device path. */
     int fd; /**< file descriptor for device. */
+    mraa_boolean_t nonblock; /**< reads return at once, as set with mraa_uart_set_non_blocking() */
+    struct _mraa_stats* stats; /**< I/O statistics, NULL until measured */
+    struct _uart_rx* rx; /**< receive engine, NULL when not running */
+    struct _uart_tx* tx; /**< transmit engine, NULL when not running */
     mraa_adv_func_t* advance_func; /**< override function table */
     /*@}*/
 #if defined(PERIPHERALMAN)
@@ -261,9 +281,12 @@ struct _iio {
     int chan_num;
     pthread_t thread_id; /**< the isr handler thread id */
     mraa_iio_channel* channels;
+    char** scan_elements; /**< scan_elements name prefix of each channel, by index */
     int event_num;
     mraa_iio_event* events;
     int datasize;
+    struct _iio_capture* capture; /**< buffer capture, NULL when not capturing */
+    struct _iio_attr* attrs; /**< attribute handles opened so far */
 };
 #endif
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Overrides the snapshot location, an empty value disables the snapshot */
+#define MRAA_SNAPSHOT_ENV_VAR "MRAA_SNAPSHOT_FILE"
+
+#if defined(MRAA_PLATSNAPSHOT)
+
+/**
+ * Map the platform snapshot written by an earlier process of this boot.
+ * The snapshot is rejected when the boot id, the device-tree/DMI identity,
+ * the library or the checksum do not match.
+ *
+ * @return the board as detected back then, NULL when there is no usable snapshot
+ */
+mraa_board_t* mraa_snapshot_load();
+
+/**
+ * Write the detected platform for the next processes. Boards whose hooks
+ * depend on state set up by their constructor are not written.
+ *
+ * @param board the main platform, its sub platform is left out
+ * @return Result of operation
+ */
+mraa_result_t mraa_snapshot_save(const mraa_board_t* board);
+
+/**
+ * Map a board description written by mraa_snapshot_write_board(). Unlike a
+ * snapshot it is not tied to a boot, only to the layout of the structures.
+ *
+ * @param path file to map
+ * @param board set to the board on success
+ * @return Result of operation, MRAA_ERROR_NO_DATA_AVAILABLE if path is no
+ * board file at all and may be json instead
+ */
+mraa_result_t mraa_snapshot_load_board(const char* path, mraa_board_t** board);
+
+/**
+ * Write a board without hooks, as set up from json, as a board description
+ * any process can map with mraa_snapshot_load_board().
+ *
+ * @param board the board to write, its sub platform is left out
+ * @param path file to write, replaced atomically
+ * @return Result of operation
+ */
+mraa_result_t mraa_snapshot_write_board(const mraa_board_t* board, const char* path);
+
+/**
+ * @param board a platform
+ * @return 1 if the board lives in the mapped snapshot or board file and must
+ * not be freed
+ */
+mraa_boolean_t mraa_snapshot_owns(const mraa_board_t* board);
+
+/**
+ * Unmap the snapshot or board file, the board mapped from it is gone after.
+ */
+void mraa_snapshot_release();
+
+#else
+
+#define mraa_snapshot_load() ((mraa_board_t*) NULL)
+#define mraa_snapshot_save(board) ((void) (board), MRAA_ERROR_FEATURE_NOT_SUPPORTED)
+#define mraa_snapshot_load_board(path, board) ((void) (path), (void) (board), MRAA_ERROR_NO_DATA_AVAILABLE)
+#define mraa_snapshot_write_board(board, path) ((void) (board), (void) (path), MRAA_ERROR_FEATURE_NOT_SUPPORTED)
+#define mraa_snapshot_owns(board) ((void) (board), 0)
+#define mraa_snapshot_release() ((void) 0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "stats.h"
+
+/* Per-context counters, see the stats member of the context structs. */
+struct _mraa_stats;
+
+#if defined(MRAA_IOSTATS)
+
+/* Nonzero while collection is on, see mraa_stats_enable(). */
+extern int mraa_stats_active;
+
+/**
+ * Start measuring an operation.
+ *
+ * @return start time in nanoseconds, 0 when collection is off
+ */
+static inline uint64_t
+mraa_stats_begin()
+{
+    if (!__atomic_load_n(&mraa_stats_active, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * Account a finished operation to a context, registering it on first use.
+ *
+ * @param slot The stats pointer of the context
+ * @param op Operation performed
+ * @param id Pin, bus or uart index of the context
+ * @param start Value returned by mraa_stats_begin(), nothing is recorded if 0
+ * @param bytes Bytes transferred, ignored for failed calls
+ * @param ok Whether the call succeeded
+ */
+void mraa_stats_record(struct _mraa_stats** slot,
+                       mraa_stats_op_t op,
+                       int id,
+                       uint64_t start,
+                       size_t bytes,
+                       mraa_boolean_t ok);
+
+/**
+ * Remove a context from the registry. Called when the context is closed.
+ *
+ * @param slot The stats pointer of the context
+ */
+void mraa_stats_release(struct _mraa_stats** slot);
+
+#else
+
+#define mraa_stats_begin() ((uint64_t) 0)
+#define mraa_stats_record(slot, op, id, start, bytes, ok) ((void) (start))
+#define mraa_stats_release(slot) ((void) 0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Receptions remembered for the latency counters. */
+#define MRAA_UART_RX_MARKS 64
+/* Largest read() into the frame parser or while the ring is full. */
+#define MRAA_UART_RX_CHUNK 4096
+
+/**
+ * Take bytes out of the ring of a running receive engine, waiting for data
+ * when it is empty.
+ *
+ * @param dev uart context with a receive engine
+ * @param buf buffer pointer
+ * @param len maximum size of buffer
+ * @return the number of bytes read, 0 once the engine stopped, -1 on error
+ */
+int mraa_uart_rx_read(mraa_uart_context dev, char* buf, size_t len);
+
+/**
+ * Check the ring of a running receive engine for data.
+ *
+ * @param dev uart context with a receive engine
+ * @param millis number of milliseconds to wait, or 0 to return immediately
+ * @return 1 if there is data available to read, 0 otherwise
+ */
+mraa_boolean_t mraa_uart_rx_available(mraa_uart_context dev, unsigned int millis);
+
+/**
+ * Stop the receive engine of a context, if any, before it gets closed.
+ *
+ * @param dev uart context
+ */
+void mraa_uart_rx_release(mraa_uart_context dev);
+
+#ifdef __cplusplus
+}
+#endif
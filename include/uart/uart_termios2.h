@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/*
+ * termios2 lives in its own translation unit, the kernel definitions clash
+ * with the ones of <termios.h>.
+ */
+
+/**
+ * Set an arbitrary integer rate on both directions through BOTHER.
+ *
+ * @param fd tty file descriptor
+ * @param baud rate in bit/s
+ * @return Result of operation, MRAA_ERROR_FEATURE_NOT_SUPPORTED without termios2
+ */
+mraa_result_t mraa_uart_termios2_set_speed(int fd, unsigned int baud);
+
+/**
+ * Read back the output rate the driver actually configured.
+ *
+ * @param fd tty file descriptor
+ * @param baud rate in bit/s
+ * @return Result of operation, MRAA_ERROR_FEATURE_NOT_SUPPORTED without termios2
+ */
+mraa_result_t mraa_uart_termios2_get_speed(int fd, unsigned int* baud);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/* Largest number of segments passed to a single writev(). */
+#define MRAA_UART_TX_IOV_MAX 64
+
+/**
+ * Write all segments to a file descriptor, resuming after partial writes
+ * and waiting for the descriptor to become writable on EAGAIN.
+ *
+ * @param fd file descriptor
+ * @param iov segments to write
+ * @param iovcnt number of segments
+ * @param would_block incremented for every EAGAIN, may be NULL
+ * @return the number of bytes written, -1 on error
+ */
+ssize_t mraa_uart_tx_writev_fd(int fd, const mraa_uart_iovec_t* iov, unsigned int iovcnt, uint64_t* would_block);
+
+/**
+ * Queue segments on the transmit engine, waiting for room when the queue
+ * is full. The segments are queued back to back.
+ *
+ * @param dev uart context with a transmit engine
+ * @param iov segments to send
+ * @param iovcnt number of segments
+ * @return the number of bytes queued, -1 on error
+ */
+int mraa_uart_tx_queue(mraa_uart_context dev, const mraa_uart_iovec_t* iov, unsigned int iovcnt);
+
+/**
+ * Wait until everything queued so far left the UART.
+ *
+ * @param dev uart context with a transmit engine
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_flush(mraa_uart_context dev);
+
+/**
+ * Stop the transmit engine of a context, if any, before it gets closed.
+ *
+ * @param dev uart context
+ */
+void mraa_uart_tx_release(mraa_uart_context dev);
+
+#ifdef __cplusplus
+}
+#endif
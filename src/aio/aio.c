@@ -7,13 +7,19 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 
 #include "aio.h"
+#include "aio/aio_stream.h"
 #include "mraa_internal.h"
 
 #define DEFAULT_BITS 10
+/* Scans kept for mraa_aio_read_multi(), only the newest one is used. */
+#define MULTI_SCAN_RING 4
+/* Time to wait for the first buffered scan before falling back to single reads. */
+#define MULTI_SCAN_TIMEOUT_MS 100
 
 static int raw_bits;
 static unsigned int shifter_value;
@@ -76,7 +82,7 @@ mraa_aio_init_internal(mraa_adv_func_t* func_table, int aio, unsigned int channe
 mraa_aio_context
 mraa_aio_init(unsigned int aio)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
     int pin;
     if (board == NULL) {
         syslog(LOG_ERR, "aio: Platform not initialised");
@@ -157,6 +163,38 @@ mraa_aio_init(unsigned int aio)
     return dev;
 }
 
+mraa_aio_context
+mraa_aio_init_multi(int pins[], int num_pins)
+{
+    if (pins == NULL || num_pins <= 0) {
+        syslog(LOG_ERR, "aio: init_multi: invalid pin array");
+        return NULL;
+    }
+
+    mraa_aio_context head = NULL, tail = NULL;
+    for (int i = 0; i < num_pins; ++i) {
+        mraa_aio_context dev = mraa_aio_init(pins[i]);
+        if (dev == NULL || (head != NULL && dev->advance_func != head->advance_func)) {
+            syslog(LOG_ERR, "aio: init_multi: failed to initialise pin %d", pins[i]);
+            if (dev != NULL) {
+                mraa_aio_close(dev);
+            }
+            if (head != NULL) {
+                mraa_aio_close(head);
+            }
+            return NULL;
+        }
+        if (tail != NULL) {
+            tail->next = dev;
+        } else {
+            head = dev;
+        }
+        tail = dev;
+    }
+
+    return head;
+}
+
 int
 mraa_aio_read(mraa_aio_context dev)
 {
@@ -219,14 +257,116 @@ mraa_aio_read_float(mraa_aio_context dev)
     return analog_value_int / max_analog_value;
 }
 
+/* Take the newest scan of a stream over all pins, started on first use. */
+static mraa_result_t
+mraa_aio_read_scan(mraa_aio_context dev, int values[], unsigned int num)
+{
+    if (dev->scan_mode < 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (dev->scan_mode == 0) {
+        if (dev->stream != NULL) {
+            // The IIO buffer is busy with mraa_aio_stream_start()
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        mraa_aio_context devs[num];
+        unsigned int i = 0;
+        for (mraa_aio_context it = dev; it != NULL; it = it->next) {
+            devs[i++] = it;
+        }
+        dev->scan_mode = -1;
+        dev->scan_ring = malloc(MULTI_SCAN_RING * num * sizeof(int));
+        if (dev->scan_ring == NULL ||
+            mraa_aio_stream_open(devs, num, NULL, dev->scan_ring, MULTI_SCAN_RING, 1) != MRAA_SUCCESS) {
+            free(dev->scan_ring);
+            dev->scan_ring = NULL;
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        dev->scan_mode = 1;
+    }
+
+    int scans[MULTI_SCAN_RING * num];
+    int got = mraa_aio_stream_read(dev, scans, MULTI_SCAN_RING, MULTI_SCAN_TIMEOUT_MS);
+    if (got <= 0) {
+        syslog(LOG_NOTICE, "aio: read_multi: no buffered scan, is a trigger running? Reading channels one by one");
+        mraa_aio_stream_release(dev);
+        free(dev->scan_ring);
+        dev->scan_ring = NULL;
+        dev->scan_mode = -1;
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    memcpy(values, &scans[(got - 1) * num], num * sizeof(int));
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
-mraa_aio_close(mraa_aio_context dev)
+mraa_aio_read_multi(mraa_aio_context dev, int values[])
 {
-    if (dev == NULL) {
-        syslog(LOG_ERR, "aio: close: context is invalid");
+    if (dev == NULL || values == NULL) {
+        syslog(LOG_ERR, "aio: read_multi: context or values invalid");
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    unsigned int num = 0;
+    for (mraa_aio_context it = dev; it != NULL; it = it->next) {
+        num++;
+    }
+
+    if (IS_FUNC_DEFINED(dev, aio_read_multi_replace)) {
+        return dev->advance_func->aio_read_multi_replace(dev, values, num);
+    }
+
+    // A single channel is cheaper to read through sysfs than to stream
+    if (num > 1 && !IS_FUNC_DEFINED(dev, aio_read_replace) &&
+        mraa_aio_read_scan(dev, values, num) == MRAA_SUCCESS) {
+        return MRAA_SUCCESS;
+    }
+
+    unsigned int i = 0;
+    for (mraa_aio_context it = dev; it != NULL; it = it->next) {
+        values[i] = mraa_aio_read(it);
+        if (values[i++] == -1) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_read_float_multi(mraa_aio_context dev, float values[])
+{
+    if (dev == NULL || values == NULL) {
+        syslog(LOG_ERR, "aio: read_float_multi: context or values invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    unsigned int num = 0;
+    for (mraa_aio_context it = dev; it != NULL; it = it->next) {
+        num++;
+    }
+
+    int raw[num];
+    mraa_result_t ret = mraa_aio_read_multi(dev, raw);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    for (unsigned int i = 0; i < num; ++i) {
+        values[i] = raw[i] / max_analog_value;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_aio_close_internal(mraa_aio_context dev)
+{
+    /* Stop continuous acquisition */
+    mraa_aio_stream_release(dev);
+    free(dev->scan_ring);
+
     if (IS_FUNC_DEFINED(dev, aio_close_replace)) {
         return dev->advance_func->aio_close_replace(dev);
     }
@@ -240,6 +380,27 @@ mraa_aio_close(mraa_aio_context dev)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_aio_close(mraa_aio_context dev)
+{
+    mraa_result_t result = MRAA_SUCCESS;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: close: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    while (dev != NULL) {
+        mraa_aio_context next = dev->next;
+        if (mraa_aio_close_internal(dev) != MRAA_SUCCESS) {
+            result = MRAA_ERROR_UNSPECIFIED;
+        }
+        dev = next;
+    }
+
+    return result;
+}
+
 mraa_result_t
 mraa_aio_set_bit(mraa_aio_context dev, int bits)
 {
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "aio/aio_stream.h"
+#include "aio.h"
+#include "mraa_internal.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define AIO_IIO_SYSFS "/sys/bus/iio/devices/iio:device0/"
+#define AIO_IIO_DEV "/dev/iio:device0"
+#define MAX_SIZE 128
+
+struct _aio_stream {
+    pthread_t thread;
+    int fd;      /**< buffered scans */
+    int wake_fd; /**< eventfd used to stop the drain thread */
+    mraa_boolean_t sysfs; /**< fd was set up through sysfs and has to be torn down there */
+    unsigned int num_channels;
+    unsigned int channels[MRAA_AIO_STREAM_MAX_CHANNELS];
+    mraa_aio_scan_element_t layout[MRAA_AIO_STREAM_MAX_CHANNELS];
+    int scale_shift[MRAA_AIO_STREAM_MAX_CHANNELS]; /**< left shift if positive, right shift if negative */
+    unsigned int scan_size;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int* ring;
+    unsigned int capacity; /**< in scans */
+    unsigned int head; /**< index of the oldest scan */
+    unsigned int count;
+    mraa_boolean_t keep_newest; /**< overwrite the oldest scans when the ring is full */
+    mraa_boolean_t ended; /**< the drain thread stopped on its own */
+    mraa_aio_stream_stats_t stats;
+};
+
+int64_t
+mraa_aio_scan_decode(const uint8_t* scan, const mraa_aio_scan_element_t* element)
+{
+    uint64_t value = 0;
+
+    for (unsigned int i = 0; i < element->bytes; ++i) {
+        if (element->big_endian) {
+            value = (value << 8) | scan[element->location + i];
+        } else {
+            value |= (uint64_t) scan[element->location + i] << (8 * i);
+        }
+    }
+    value >>= element->shift;
+    if (element->bits < 64) {
+        value &= (1ULL << element->bits) - 1;
+        if (element->is_signed && (value & (1ULL << (element->bits - 1)))) {
+            value |= ~((1ULL << element->bits) - 1);
+        }
+    }
+    return (int64_t) value;
+}
+
+static mraa_result_t
+mraa_aio_sysfs_write(const char* attr, const char* value)
+{
+    char path[MAX_SIZE];
+    snprintf(path, sizeof(path), AIO_IIO_SYSFS "%s", attr);
+
+    int fd = open(path, O_WRONLY);
+    if (fd == -1) {
+        syslog(LOG_ERR, "aio: stream: Failed to open %s: %s", path, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    ssize_t len = write(fd, value, strlen(value));
+    close(fd);
+    if (len != (ssize_t) strlen(value)) {
+        syslog(LOG_ERR, "aio: stream: Failed to write %s: %s", path, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_aio_sysfs_read(const char* attr, char* buf, size_t size)
+{
+    char path[MAX_SIZE];
+    snprintf(path, sizeof(path), AIO_IIO_SYSFS "%s", attr);
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        syslog(LOG_ERR, "aio: stream: Failed to open %s: %s", path, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    ssize_t len = read(fd, buf, size - 1);
+    close(fd);
+    if (len < 1) {
+        syslog(LOG_ERR, "aio: stream: Failed to read %s", path);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    buf[len] = '\0';
+    return MRAA_SUCCESS;
+}
+
+/* Disable every scan element, including the ones enabled by someone else. */
+static void
+mraa_aio_scan_elements_disable()
+{
+    DIR* dir = opendir(AIO_IIO_SYSFS "scan_elements");
+    if (dir == NULL) {
+        return;
+    }
+
+    const struct dirent* ent;
+    char attr[MAX_SIZE];
+    while ((ent = readdir(dir)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len > 3 && strcmp(ent->d_name + len - 3, "_en") == 0) {
+            snprintf(attr, sizeof(attr), "scan_elements/%.64s", ent->d_name);
+            mraa_aio_sysfs_write(attr, "0");
+        }
+    }
+    closedir(dir);
+}
+
+static void
+mraa_aio_stream_close_iio()
+{
+    mraa_aio_sysfs_write("buffer/enable", "0");
+    mraa_aio_scan_elements_disable();
+}
+
+/* Enable the scan elements of the channels and open the buffered device. */
+static int
+mraa_aio_stream_open_iio(struct _aio_stream* stream, const char* trigger)
+{
+    char attr[MAX_SIZE];
+    char buf[MAX_SIZE];
+    unsigned int index[MRAA_AIO_STREAM_MAX_CHANNELS];
+
+    // The buffer can't be reconfigured while it is enabled
+    mraa_aio_sysfs_write("buffer/enable", "0");
+    mraa_aio_scan_elements_disable();
+
+    for (unsigned int i = 0; i < stream->num_channels; ++i) {
+        mraa_aio_scan_element_t* element = &stream->layout[i];
+        char endian, sign;
+        unsigned int storage;
+
+        for (unsigned int j = 0; j < i; ++j) {
+            if (stream->channels[j] == stream->channels[i]) {
+                syslog(LOG_ERR, "aio: stream: channel %u is scanned twice", stream->channels[i]);
+                return -1;
+            }
+        }
+
+        snprintf(attr, sizeof(attr), "scan_elements/in_voltage%u_en", stream->channels[i]);
+        if (mraa_aio_sysfs_write(attr, "1") != MRAA_SUCCESS) {
+            return -1;
+        }
+        snprintf(attr, sizeof(attr), "scan_elements/in_voltage%u_index", stream->channels[i]);
+        if (mraa_aio_sysfs_read(attr, buf, sizeof(buf)) != MRAA_SUCCESS) {
+            return -1;
+        }
+        index[i] = (unsigned int) strtoul(buf, NULL, 10);
+        snprintf(attr, sizeof(attr), "scan_elements/in_voltage%u_type", stream->channels[i]);
+        if (mraa_aio_sysfs_read(attr, buf, sizeof(buf)) != MRAA_SUCCESS) {
+            return -1;
+        }
+        element->shift = 0;
+        if (sscanf(buf, "%ce:%c%u/%u>>%u", &endian, &sign, &element->bits, &storage, &element->shift) < 4 ||
+            element->bits == 0 || storage % 8 != 0 || storage == 0 || storage > 64 || element->bits > storage) {
+            syslog(LOG_ERR, "aio: stream: unsupported scan type %s", buf);
+            return -1;
+        }
+        element->bytes = storage / 8;
+        element->is_signed = (sign == 's');
+        element->big_endian = (endian == 'b');
+    }
+
+    // Channels are stored by scan index, each aligned to its own size
+    unsigned int order[MRAA_AIO_STREAM_MAX_CHANNELS];
+    for (unsigned int i = 0; i < stream->num_channels; ++i) {
+        unsigned int j = i;
+        while (j > 0 && index[order[j - 1]] > index[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    unsigned int location = 0;
+    unsigned int align = 1;
+    for (unsigned int i = 0; i < stream->num_channels; ++i) {
+        mraa_aio_scan_element_t* element = &stream->layout[order[i]];
+        location = (location + element->bytes - 1) / element->bytes * element->bytes;
+        element->location = location;
+        location += element->bytes;
+        if (element->bytes > align) {
+            align = element->bytes;
+        }
+    }
+    stream->scan_size = (location + align - 1) / align * align;
+
+    if (trigger != NULL && mraa_aio_sysfs_write("trigger/current_trigger", trigger) != MRAA_SUCCESS) {
+        return -1;
+    }
+
+    unsigned int length = stream->capacity > MRAA_AIO_STREAM_READ_BATCH ? stream->capacity : MRAA_AIO_STREAM_READ_BATCH;
+    snprintf(buf, sizeof(buf), "%u", length);
+    if (mraa_aio_sysfs_write("buffer/length", buf) != MRAA_SUCCESS ||
+        mraa_aio_sysfs_write("buffer/enable", "1") != MRAA_SUCCESS) {
+        return -1;
+    }
+
+    int fd = open(AIO_IIO_DEV, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd == -1) {
+        syslog(LOG_ERR, "aio: stream: Failed to open " AIO_IIO_DEV ": %s", strerror(errno));
+    }
+    return fd;
+}
+
+static void
+mraa_aio_stream_push(struct _aio_stream* stream, const uint8_t* scans, unsigned int num_scans)
+{
+    pthread_mutex_lock(&stream->lock);
+    for (unsigned int s = 0; s < num_scans; ++s) {
+        stream->stats.scans++;
+        if (stream->count == stream->capacity) {
+            // The overflow counter tells how many scans went missing
+            stream->stats.overflows++;
+            if (!stream->keep_newest) {
+                continue;
+            }
+            stream->head = (stream->head + 1) % stream->capacity;
+            stream->count--;
+        }
+        const uint8_t* scan = scans + s * stream->scan_size;
+        int* values = &stream->ring[((stream->head + stream->count) % stream->capacity) * stream->num_channels];
+        for (unsigned int i = 0; i < stream->num_channels; ++i) {
+            int64_t value = mraa_aio_scan_decode(scan, &stream->layout[i]);
+            if (stream->scale_shift[i] >= 0) {
+                value *= (int64_t) 1 << stream->scale_shift[i];
+            } else {
+                value >>= -stream->scale_shift[i];
+            }
+            values[i] = (int) value;
+        }
+        stream->count++;
+    }
+    if (stream->count > stream->stats.max_fill) {
+        stream->stats.max_fill = stream->count;
+    }
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->lock);
+}
+
+static void*
+mraa_aio_stream_drain(void* arg)
+{
+    struct _aio_stream* stream = (struct _aio_stream*) arg;
+    size_t size = MRAA_AIO_STREAM_READ_BATCH * stream->scan_size;
+    uint8_t* buf = malloc(size);
+    size_t fill = 0;
+    struct pollfd pfd[2];
+
+    pfd[0].fd = stream->fd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = stream->wake_fd;
+    pfd[1].events = POLLIN;
+
+    while (buf != NULL) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "aio: stream: poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (pfd[1].revents & POLLIN) {
+            break;
+        }
+        if (!(pfd[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            continue;
+        }
+
+        ssize_t len = read(stream->fd, buf + fill, size - fill);
+        if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+            continue;
+        }
+        if (len <= 0) {
+            if (len < 0) {
+                syslog(LOG_ERR, "aio: stream: read failed: %s", strerror(errno));
+            }
+            break;
+        }
+
+        // The kernel hands out whole scans, a pipe from a sub platform may not
+        fill += len;
+        unsigned int num_scans = fill / stream->scan_size;
+        mraa_aio_stream_push(stream, buf, num_scans);
+        fill -= num_scans * stream->scan_size;
+        memmove(buf, buf + num_scans * stream->scan_size, fill);
+    }
+    free(buf);
+
+    pthread_mutex_lock(&stream->lock);
+    stream->ended = 1;
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->lock);
+
+    return NULL;
+}
+
+static void
+mraa_aio_stream_free(struct _aio_stream* stream)
+{
+    if (stream->fd >= 0) {
+        close(stream->fd);
+    }
+    if (stream->sysfs) {
+        mraa_aio_stream_close_iio();
+    }
+    if (stream->wake_fd >= 0) {
+        close(stream->wake_fd);
+    }
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->lock);
+    free(stream);
+}
+
+mraa_result_t
+mraa_aio_stream_open(mraa_aio_context* devs,
+                     unsigned int num_devs,
+                     const char* trigger,
+                     int* ring,
+                     unsigned int ring_scans,
+                     mraa_boolean_t keep_newest)
+{
+    if (devs == NULL || num_devs == 0 || devs[0] == NULL) {
+        syslog(LOG_ERR, "aio: stream_start: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_aio_context dev = devs[0];
+    if (num_devs > MRAA_AIO_STREAM_MAX_CHANNELS || ring == NULL || ring_scans == 0) {
+        syslog(LOG_ERR, "aio%u: stream_start: invalid channels or ring", dev->channel);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->stream != NULL) {
+        syslog(LOG_ERR, "aio%u: stream_start: context is already streaming", dev->channel);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    struct _aio_stream* stream = calloc(1, sizeof(struct _aio_stream));
+    if (stream == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&stream->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    stream->fd = -1;
+    stream->ring = ring;
+    stream->capacity = ring_scans;
+    stream->num_channels = num_devs;
+    stream->keep_newest = keep_newest;
+    stream->wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (stream->wake_fd < 0) {
+        mraa_aio_stream_free(stream);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    int raw_bits = mraa_adc_raw_bits();
+    for (unsigned int i = 0; i < num_devs; ++i) {
+        if (devs[i] == NULL) {
+            syslog(LOG_ERR, "aio%u: stream_start: channel %u is invalid", dev->channel, i);
+            mraa_aio_stream_free(stream);
+            return MRAA_ERROR_INVALID_HANDLE;
+        }
+        stream->channels[i] = devs[i]->channel;
+        stream->scale_shift[i] = devs[i]->value_bit - raw_bits;
+    }
+
+    if (IS_FUNC_DEFINED(dev, aio_stream_open_replace)) {
+        stream->fd = dev->advance_func->aio_stream_open_replace(dev, stream->channels, num_devs, trigger,
+                                                                stream->layout, &stream->scan_size);
+    } else {
+        stream->sysfs = 1;
+        stream->fd = mraa_aio_stream_open_iio(stream, trigger);
+    }
+    if (stream->fd < 0 || stream->scan_size == 0) {
+        mraa_aio_stream_free(stream);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (pthread_create(&stream->thread, NULL, mraa_aio_stream_drain, stream) != 0) {
+        syslog(LOG_ERR, "aio%u: stream_start: failed to start drain thread", dev->channel);
+        mraa_aio_stream_free(stream);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->stream = stream;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_stream_start(mraa_aio_context* devs, unsigned int num_devs, const char* trigger, int* ring, unsigned int ring_scans)
+{
+    return mraa_aio_stream_open(devs, num_devs, trigger, ring, ring_scans, 0);
+}
+
+int
+mraa_aio_stream_read(mraa_aio_context dev, int* values, unsigned int max_scans, int timeout_ms)
+{
+    if (dev == NULL || dev->stream == NULL) {
+        syslog(LOG_ERR, "aio: stream_read: context is invalid or not streaming");
+        return -1;
+    }
+
+    if (values == NULL) {
+        syslog(LOG_ERR, "aio%u: stream_read: invalid values array", dev->channel);
+        return -1;
+    }
+
+    struct _aio_stream* stream = dev->stream;
+    struct timespec deadline;
+
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&stream->lock);
+    while (stream->count == 0 && !stream->ended && timeout_ms != 0) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&stream->cond, &stream->lock);
+        } else if (pthread_cond_timedwait(&stream->cond, &stream->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    unsigned int num = stream->count < max_scans ? stream->count : max_scans;
+    size_t scan_values = stream->num_channels;
+    for (unsigned int i = 0; i < num; ++i) {
+        memcpy(&values[i * scan_values], &stream->ring[stream->head * scan_values], scan_values * sizeof(int));
+        stream->head = (stream->head + 1) % stream->capacity;
+    }
+    stream->count -= num;
+    stream->stats.delivered += num;
+    pthread_mutex_unlock(&stream->lock);
+
+    return num;
+}
+
+mraa_result_t
+mraa_aio_stream_stats(mraa_aio_context dev, mraa_aio_stream_stats_t* stats)
+{
+    if (dev == NULL || dev->stream == NULL) {
+        syslog(LOG_ERR, "aio: stream_stats: context is invalid or not streaming");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&dev->stream->lock);
+    *stats = dev->stream->stats;
+    pthread_mutex_unlock(&dev->stream->lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_stream_stop(mraa_aio_context dev)
+{
+    if (dev == NULL || dev->stream == NULL) {
+        syslog(LOG_ERR, "aio: stream_stop: context is invalid or not streaming");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    struct _aio_stream* stream = dev->stream;
+    uint64_t wake = 1;
+
+    if (write(stream->wake_fd, &wake, sizeof(wake)) != sizeof(wake)) {
+        syslog(LOG_ERR, "aio%u: stream_stop: failed to wake drain thread", dev->channel);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(stream->thread, NULL);
+
+    dev->stream = NULL;
+    mraa_aio_stream_free(stream);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_aio_stream_release(mraa_aio_context dev)
+{
+    if (dev != NULL && dev->stream != NULL) {
+        mraa_aio_stream_stop(dev);
+    }
+}
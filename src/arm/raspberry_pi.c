@@ -15,6 +15,7 @@
 
 #include "arm/raspberry_pi.h"
 #include "common.h"
+#include "gpio/gpio_mmap.h"
 
 #define PLATFORM_NAME_RASPBERRY_PI_B_REV_1 "Raspberry Pi Model B Rev 1"
 #define PLATFORM_NAME_RASPBERRY_PI_A_REV_2 "Raspberry Pi Model A Rev 2"
@@ -40,16 +41,12 @@
 #define PLATFORM_RASPBERRY_PI_ZERO_W 10
 #define PLATFORM_RASPBERRY_PI3_B_PLUS 11
 #define PLATFORM_RASPBERRY_PI3_A_PLUS 12
-#define MMAP_PATH "/dev/mem"
 #define BCM2835_PERI_BASE 0x20000000
 #define BCM2836_PERI_BASE 0x3f000000
 #define BCM2835_BLOCK_SIZE (4 * 1024)
 #define BCM2836_BLOCK_SIZE (4 * 1024)
 #define BCM2837_PERI_BASE (0x3F000000)
 #define BCM2837_BLOCK_SIZE (4 * 1024)
-#define BCM283X_GPSET0 0x001c
-#define BCM283X_GPCLR0 0x0028
-#define BCM2835_GPLEV0 0x0034
 #define MAX_SIZE 64
 
 #define GPIO_OFFSET (0x200000)
@@ -77,11 +74,6 @@ static volatile unsigned* gpio_reg = NULL;
 static volatile unsigned* pwm_reg = NULL;
 
 
-// GPIO MMAP
-static uint8_t* mmap_reg = NULL;
-static int mmap_fd = 0;
-static int mmap_size;
-static unsigned int mmap_count = 0;
 static int platform_detected = 0;
 static uint32_t peripheral_base = BCM2835_PERI_BASE;
 static uint32_t block_size = BCM2835_BLOCK_SIZE;
@@ -333,94 +325,13 @@ mraa_raspberry_pi_i2c_init_pre(unsigned int bus)
     return MRAA_SUCCESS;
 }
 
-mraa_result_t
-mraa_raspberry_pi_mmap_write(mraa_gpio_context dev, int value)
-{
-    if (value) {
-        *(volatile uint32_t*) (mmap_reg + BCM283X_GPSET0 + (dev->pin / 32) * 4) =
-        (uint32_t)(1 << (dev->pin % 32));
-    } else {
-        *(volatile uint32_t*) (mmap_reg + BCM283X_GPCLR0 + (dev->pin / 32) * 4) =
-        (uint32_t)(1 << (dev->pin % 32));
-    }
-    return MRAA_SUCCESS;
-}
-
 static mraa_result_t
-mraa_raspberry_pi_mmap_unsetup()
-{
-    if (mmap_reg == NULL) {
-        syslog(LOG_ERR, "raspberry mmap: null register cant unsetup");
-        return MRAA_ERROR_INVALID_RESOURCE;
-    }
-    munmap(mmap_reg, mmap_size);
-    mmap_reg = NULL;
-    if (close(mmap_fd) != 0) {
-        return MRAA_ERROR_INVALID_RESOURCE;
-    }
-    return MRAA_SUCCESS;
-}
-
-int
-mraa_raspberry_pi_mmap_read(mraa_gpio_context dev)
-{
-    uint32_t value = *(volatile uint32_t*) (mmap_reg + BCM2835_GPLEV0 + (dev->pin / 32) * 4);
-    if (value & (uint32_t)(1 << (dev->pin % 32))) {
-        return 1;
-    }
-    return 0;
-}
-
-mraa_result_t
 mraa_raspberry_pi_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en)
 {
-    if (dev == NULL) {
-        syslog(LOG_ERR, "raspberry mmap: context not valid");
-        return MRAA_ERROR_INVALID_HANDLE;
-    }
+    // BCM2836 and BCM2837 share the GPIO block layout and address
+    const char* soc = peripheral_base == BCM2835_PERI_BASE ? "bcm2835" : "bcm2837";
 
-    if (en == 0) {
-        if (dev->mmap_write == NULL && dev->mmap_read == NULL) {
-            syslog(LOG_ERR, "raspberry mmap: can't disable disabled mmap gpio");
-            return MRAA_ERROR_INVALID_PARAMETER;
-        }
-        dev->mmap_write = NULL;
-        dev->mmap_read = NULL;
-        mmap_count--;
-        if (mmap_count == 0) {
-            return mraa_raspberry_pi_mmap_unsetup();
-        }
-        return MRAA_SUCCESS;
-    }
-
-    if (dev->mmap_write != NULL && dev->mmap_read != NULL) {
-        syslog(LOG_ERR, "raspberry mmap: can't enable enabled mmap gpio");
-        return MRAA_ERROR_INVALID_PARAMETER;
-    }
-
-    // Might need to make some elements of this thread safe.
-    // For example only allow one thread to enter the following block
-    // to prevent mmap'ing twice.
-    if (mmap_reg == NULL) {
-        if ((mmap_fd = open(MMAP_PATH, O_RDWR)) < 0) {
-            syslog(LOG_ERR, "raspberry map: unable to open resource0 file");
-            return MRAA_ERROR_INVALID_HANDLE;
-        }
-
-        mmap_reg = (uint8_t*) mmap(NULL, block_size, PROT_READ | PROT_WRITE, MAP_FILE | MAP_SHARED,
-                                   mmap_fd, peripheral_base + GPIO_OFFSET);
-        if (mmap_reg == MAP_FAILED) {
-            syslog(LOG_ERR, "raspberry mmap: failed to mmap");
-            mmap_reg = NULL;
-            close(mmap_fd);
-            return MRAA_ERROR_NO_RESOURCES;
-        }
-    }
-    dev->mmap_write = &mraa_raspberry_pi_mmap_write;
-    dev->mmap_read = &mraa_raspberry_pi_mmap_read;
-    mmap_count++;
-
-    return MRAA_SUCCESS;
+    return mraa_gpio_mmap_setup(dev, en, mraa_gpio_mmap_find_soc(soc));
 }
 
 mraa_board_t*
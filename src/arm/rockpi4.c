@@ -13,6 +13,7 @@
 
 #include "arm/rockpi4.h"
 #include "common.h"
+#include "gpio/gpio_mmap.h"
 
 #define DT_BASE "/proc/device-tree"
 /* 
@@ -51,6 +52,12 @@ mraa_rockpi4_pininfo(mraa_board_t* board, int index, int sysfs_pin, mraa_pincapa
     pininfo->gpio.mux_total = 0;
 }
 
+static mraa_result_t
+mraa_rockpi4_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en)
+{
+    return mraa_gpio_mmap_setup(dev, en, mraa_gpio_mmap_find_soc("rk3399"));
+}
+
 mraa_board_t*
 mraa_rockpi4()
 {
@@ -65,6 +72,8 @@ mraa_rockpi4()
         return NULL;
     }
 
+    b->adv_func->gpio_mmap_setup = &mraa_rockpi4_mmap_setup;
+
     // pin mux for buses are setup by default by kernel so tell mraa to ignore them
     b->no_bus_mux = 1;
     b->phy_pin_count = MRAA_ROCKPI4_PIN_COUNT + 1;
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "async/bus_queue.h"
+#include "i2c.h"
+#include "spi.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+struct _async_request {
+    struct _async_request* next;
+    mraa_async_bus_type_t type;
+    void* dev;
+    mraa_async_callback_t cb;
+    void* args;
+    mraa_result_t result;
+    mraa_boolean_t done;
+    int refs; /**< one for the caller, one for the queue */
+    unsigned int num_items;
+    void* items; /**< descriptors, allocated with the request */
+};
+
+typedef struct {
+    mraa_boolean_t used;
+    mraa_boolean_t stopping;
+    mraa_async_bus_type_t type;
+    int busnum;
+    int efd;
+    pthread_t thread;
+    pthread_cond_t work;
+    struct _async_request* head;
+    struct _async_request* tail;
+    struct _async_request* inflight; /**< batch being executed by the worker */
+} mraa_async_queue_t;
+
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_done = PTHREAD_COND_INITIALIZER;
+static mraa_async_queue_t async_queues[MRAA_ASYNC_MAX_QUEUES];
+
+static size_t
+mraa_async_item_size(mraa_async_bus_type_t type)
+{
+    return type == MRAA_ASYNC_I2C ? sizeof(mraa_i2c_msg_t) : sizeof(mraa_spi_segment_t);
+}
+
+static unsigned int
+mraa_async_max_items(mraa_async_bus_type_t type)
+{
+    return type == MRAA_ASYNC_I2C ? MRAA_I2C_MAX_MSGS : MRAA_SPI_MAX_SEGMENTS;
+}
+
+/* Called with async_lock held. */
+static void
+mraa_async_put(struct _async_request* req)
+{
+    if (--req->refs == 0) {
+        free(req);
+    }
+}
+
+/* Can the request be appended to the transaction ending with last. */
+static mraa_boolean_t
+mraa_async_can_merge(const struct _async_request* last, const struct _async_request* req, unsigned int num_items)
+{
+    // Every I2C request ends with a STOP, merged it would end with a repeated
+    // START and devices like EEPROMs only commit a write on the STOP
+    if (req->type != MRAA_ASYNC_SPI) {
+        return 0;
+    }
+    if (req->dev != last->dev || num_items + req->num_items > mraa_async_max_items(req->type)) {
+        return 0;
+    }
+    // A request ending with cs_change keeps the device selected, which
+    // can't be expressed in the middle of a merged transfer
+    const mraa_spi_segment_t* segments = (const mraa_spi_segment_t*) last->items;
+    return !segments[last->num_items - 1].cs_change;
+}
+
+static mraa_result_t
+mraa_async_execute(struct _async_request* batch, unsigned int num_items)
+{
+    size_t item_size = mraa_async_item_size(batch->type);
+    union {
+        mraa_i2c_msg_t i2c[MRAA_I2C_MAX_MSGS];
+        mraa_spi_segment_t spi[MRAA_SPI_MAX_SEGMENTS];
+    } items;
+    unsigned int pos = 0;
+
+    for (struct _async_request* req = batch; req != NULL; req = req->next) {
+        memcpy((uint8_t*) &items + pos * item_size, req->items, req->num_items * item_size);
+        pos += req->num_items;
+        if (req->type == MRAA_ASYNC_SPI && req->next != NULL) {
+            // Deselect the device between merged requests, as separate transfers would
+            items.spi[pos - 1].cs_change = 1;
+        }
+    }
+
+    if (batch->type == MRAA_ASYNC_I2C) {
+        return mraa_i2c_transfer((mraa_i2c_context) batch->dev, items.i2c, num_items);
+    }
+    return mraa_spi_transfer_batch((mraa_spi_context) batch->dev, items.spi, num_items);
+}
+
+static void*
+mraa_async_worker(void* arg)
+{
+    mraa_async_queue_t* q = (mraa_async_queue_t*) arg;
+
+    pthread_mutex_lock(&async_lock);
+    for (;;) {
+        while (q->head == NULL && !q->stopping) {
+            pthread_cond_wait(&q->work, &async_lock);
+        }
+        if (q->head == NULL) {
+            break;
+        }
+
+        // Take the head request and every following request it can be merged with
+        struct _async_request* last = q->head;
+        unsigned int num_items = last->num_items;
+        while (last->next != NULL && mraa_async_can_merge(last, last->next, num_items)) {
+            last = last->next;
+            num_items += last->num_items;
+        }
+        q->inflight = q->head;
+        q->head = last->next;
+        if (q->head == NULL) {
+            q->tail = NULL;
+        }
+        last->next = NULL;
+        pthread_mutex_unlock(&async_lock);
+
+        mraa_result_t result = mraa_async_execute(q->inflight, num_items);
+
+        for (struct _async_request* req = q->inflight; req != NULL; req = req->next) {
+            req->result = result;
+            if (req->cb != NULL) {
+                req->cb(req, result, req->args);
+            }
+        }
+
+        uint64_t completed = 0;
+        pthread_mutex_lock(&async_lock);
+        while (q->inflight != NULL) {
+            struct _async_request* req = q->inflight;
+            q->inflight = req->next;
+            req->done = 1;
+            mraa_async_put(req);
+            completed++;
+        }
+        pthread_cond_broadcast(&async_done);
+        if (write(q->efd, &completed, sizeof(completed)) != sizeof(completed)) {
+            syslog(LOG_ERR, "async: failed to signal completion: %s", strerror(errno));
+        }
+    }
+    pthread_mutex_unlock(&async_lock);
+
+    return NULL;
+}
+
+/* Called with async_lock held. */
+static mraa_async_queue_t*
+mraa_async_get_queue(mraa_async_bus_type_t type, int busnum)
+{
+    mraa_async_queue_t* free_slot = NULL;
+
+    for (int i = 0; i < MRAA_ASYNC_MAX_QUEUES; ++i) {
+        mraa_async_queue_t* q = &async_queues[i];
+        if (!q->used) {
+            if (free_slot == NULL) {
+                free_slot = q;
+            }
+            continue;
+        }
+        if (q->type == type && q->busnum == busnum && !q->stopping) {
+            return q;
+        }
+    }
+
+    if (free_slot == NULL) {
+        syslog(LOG_ERR, "async: too many bus queues");
+        return NULL;
+    }
+
+    memset(free_slot, 0, sizeof(mraa_async_queue_t));
+    free_slot->type = type;
+    free_slot->busnum = busnum;
+    free_slot->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (free_slot->efd < 0) {
+        syslog(LOG_ERR, "async: failed to create eventfd: %s", strerror(errno));
+        return NULL;
+    }
+    pthread_cond_init(&free_slot->work, NULL);
+    if (pthread_create(&free_slot->thread, NULL, mraa_async_worker, free_slot) != 0) {
+        syslog(LOG_ERR, "async: failed to start worker thread");
+        pthread_cond_destroy(&free_slot->work);
+        close(free_slot->efd);
+        return NULL;
+    }
+    free_slot->used = 1;
+
+    return free_slot;
+}
+
+mraa_async_request_t
+mraa_async_submit(mraa_async_bus_type_t type,
+                  int busnum,
+                  void* dev,
+                  const void* items,
+                  unsigned int num_items,
+                  mraa_async_callback_t cb,
+                  void* args)
+{
+    size_t items_size = num_items * mraa_async_item_size(type);
+    struct _async_request* req = calloc(1, sizeof(struct _async_request) + items_size);
+    if (req == NULL) {
+        syslog(LOG_CRIT, "async: Failed to allocate memory for request");
+        return NULL;
+    }
+
+    req->type = type;
+    req->dev = dev;
+    req->cb = cb;
+    req->args = args;
+    req->refs = 2;
+    req->num_items = num_items;
+    req->items = req + 1;
+    memcpy(req->items, items, items_size);
+
+    pthread_mutex_lock(&async_lock);
+    mraa_async_queue_t* q = mraa_async_get_queue(type, busnum);
+    if (q == NULL) {
+        pthread_mutex_unlock(&async_lock);
+        free(req);
+        return NULL;
+    }
+    if (q->tail != NULL) {
+        q->tail->next = req;
+    } else {
+        q->head = req;
+    }
+    q->tail = req;
+    pthread_cond_signal(&q->work);
+    pthread_mutex_unlock(&async_lock);
+
+    return req;
+}
+
+int
+mraa_async_fd(mraa_async_bus_type_t type, int busnum)
+{
+    pthread_mutex_lock(&async_lock);
+    mraa_async_queue_t* q = mraa_async_get_queue(type, busnum);
+    int efd = q != NULL ? q->efd : -1;
+    pthread_mutex_unlock(&async_lock);
+
+    return efd;
+}
+
+/* Called with async_lock held. */
+static mraa_boolean_t
+mraa_async_pending(void* dev)
+{
+    for (int i = 0; i < MRAA_ASYNC_MAX_QUEUES; ++i) {
+        if (!async_queues[i].used) {
+            continue;
+        }
+        struct _async_request* lists[2] = { async_queues[i].head, async_queues[i].inflight };
+        for (int l = 0; l < 2; ++l) {
+            for (struct _async_request* req = lists[l]; req != NULL; req = req->next) {
+                if (req->dev == dev) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+void
+mraa_async_flush(void* dev)
+{
+    pthread_mutex_lock(&async_lock);
+    while (mraa_async_pending(dev)) {
+        pthread_cond_wait(&async_done, &async_lock);
+    }
+    pthread_mutex_unlock(&async_lock);
+}
+
+void
+mraa_async_shutdown()
+{
+    for (int i = 0; i < MRAA_ASYNC_MAX_QUEUES; ++i) {
+        mraa_async_queue_t* q = &async_queues[i];
+
+        pthread_mutex_lock(&async_lock);
+        if (!q->used) {
+            pthread_mutex_unlock(&async_lock);
+            continue;
+        }
+        q->stopping = 1;
+        pthread_cond_signal(&q->work);
+        pthread_mutex_unlock(&async_lock);
+
+        pthread_join(q->thread, NULL);
+
+        pthread_mutex_lock(&async_lock);
+        pthread_cond_destroy(&q->work);
+        close(q->efd);
+        q->used = 0;
+        pthread_mutex_unlock(&async_lock);
+    }
+}
+
+mraa_boolean_t
+mraa_async_done(mraa_async_request_t request)
+{
+    if (request == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&async_lock);
+    mraa_boolean_t done = request->done;
+    pthread_mutex_unlock(&async_lock);
+
+    return done;
+}
+
+mraa_result_t
+mraa_async_wait(mraa_async_request_t request)
+{
+    if (request == NULL) {
+        syslog(LOG_ERR, "async: wait: request is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    pthread_mutex_lock(&async_lock);
+    while (!request->done) {
+        pthread_cond_wait(&async_done, &async_lock);
+    }
+    mraa_result_t result = request->result;
+    pthread_mutex_unlock(&async_lock);
+
+    return result;
+}
+
+mraa_result_t
+mraa_async_free(mraa_async_request_t request)
+{
+    if (request == NULL) {
+        syslog(LOG_ERR, "async: free: request is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    pthread_mutex_lock(&async_lock);
+    mraa_async_put(request);
+    pthread_mutex_unlock(&async_lock);
+
+    return MRAA_SUCCESS;
+}
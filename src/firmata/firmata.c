@@ -22,7 +22,17 @@ firmata_new(const char* name)
         return NULL;
     }
 
-    int ret = pthread_spin_init(&res->lock, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    int ret = pthread_mutex_init(&res->lock, NULL);
+    if (ret == 0) {
+        ret = pthread_cond_init(&res->cond, &attr);
+        if (ret != 0) {
+            pthread_mutex_destroy(&res->lock);
+        }
+    }
+    pthread_condattr_destroy(&attr);
     if (ret != 0) {
         syslog(LOG_ERR, "firmata; could not init locking");
         free(res);
@@ -32,6 +42,8 @@ firmata_new(const char* name)
     res->uart = mraa_uart_init_raw(name);
     if (res->uart == NULL) {
         syslog(LOG_ERR, "firmata: UART failed to setup");
+        pthread_cond_destroy(&res->cond);
+        pthread_mutex_destroy(&res->lock);
         free(res);
         return  NULL;
     }
@@ -52,16 +64,18 @@ void
 firmata_close(t_firmata* firmata)
 {
     mraa_uart_stop(firmata->uart);
+    pthread_cond_destroy(&firmata->cond);
+    pthread_mutex_destroy(&firmata->lock);
     free(firmata);
 }
 
 int
-firmata_pull(t_firmata* firmata)
+firmata_pull(t_firmata* firmata, unsigned int millis)
 {
     char buff[FIRMATA_MSG_LEN];
     int r;
 
-    r = mraa_uart_data_available(firmata->uart, 40);
+    r = mraa_uart_data_available(firmata->uart, millis);
     if (r > 0) {
         r = mraa_uart_read(firmata->uart, buff, sizeof(buff));
         if (r < 0) {
@@ -121,11 +135,11 @@ firmata_endParse(t_firmata* firmata)
     if (cmd == 0xE0 && firmata->parse_count == 3) {
         int analog_ch = (firmata->parse_buff[0] & 0x0F);
         int analog_val = firmata->parse_buff[1] | (firmata->parse_buff[2] << 7);
-        for (pin = 0; pin < 128; pin++) {
+        for (pin = 0; pin < FIRMATA_PIN_COUNT; pin++) {
             if (firmata->pins[pin].analog_channel == analog_ch) {
-                if (pthread_spin_lock(&firmata->lock) != 0) return;
+                pthread_mutex_lock(&firmata->lock);
                 firmata->pins[pin].value = analog_val;
-                if (pthread_spin_unlock(&firmata->lock) != 0) syslog(LOG_ERR, "firmata: Fatal spinlock deadlock");
+                pthread_mutex_unlock(&firmata->lock);
                 return;
             }
         }
@@ -136,14 +150,23 @@ firmata_endParse(t_firmata* firmata)
         int port_val = firmata->parse_buff[1] | (firmata->parse_buff[2] << 7);
         int pin = port_num * 8;
         int mask;
+        int changed = 0;
+        pthread_mutex_lock(&firmata->lock);
         for (mask = 1; mask & 0xFF; mask <<= 1, pin++) {
             if (firmata->pins[pin].mode == MODE_INPUT) {
                 uint32_t val = (port_val & mask) ? 1 : 0;
-                if (pthread_spin_lock(&firmata->lock)) return;
+                if (firmata->pins[pin].value != val) {
+                    // remember the edge until the pin's interrupt waiter takes it
+                    firmata->isr_detected[pin / 64] |= (uint64_t) 1 << (pin % 64);
+                    changed = 1;
+                }
                 firmata->pins[pin].value = val;
-                if (pthread_spin_unlock(&firmata->lock) != 0) syslog(LOG_ERR, "firmata: Fatal spinlock deadlock");
             }
         }
+        if (changed) {
+            pthread_cond_broadcast(&firmata->cond);
+        }
+        pthread_mutex_unlock(&firmata->lock);
         return;
     }
     if (firmata->parse_buff[0] == FIRMATA_START_SYSEX &&
@@ -234,12 +257,14 @@ firmata_endParse(t_firmata* firmata)
             int reg = (firmata->parse_buff[4] & 0x7f) | ((firmata->parse_buff[5] & 0x7f) << 7);
             int i = 6;
             int ii = 0;
-            if (pthread_spin_lock(&firmata->lock) != 0) syslog(LOG_ERR, "firmata: Fatal spinlock deadlock, skipping i2c msg");
-            for (; ii < (firmata->parse_count - 7) / 2; ii++) {
+            pthread_mutex_lock(&firmata->lock);
+            for (; ii < (firmata->parse_count - 7) / 2 && addr < 256 && reg + ii < 256; ii++) {
                 firmata->i2cmsg[addr][reg+ii] = (firmata->parse_buff[i] & 0x7f) | ((firmata->parse_buff[i+1] & 0x7f) << 7);
                 i = i+2;
             }
-            if (pthread_spin_unlock(&firmata->lock) != 0) syslog(LOG_ERR, "firmata: Fatal spinlock deadlock");
+            // wake the reader waiting in mraa_firmata_i2c_wait()
+            pthread_cond_broadcast(&firmata->cond);
+            pthread_mutex_unlock(&firmata->lock);
         } else {
             if (firmata->devs != NULL) {
                 struct _firmata* devs = firmata->devs[0];
@@ -330,25 +355,37 @@ firmata_analogRead(t_firmata *firmata, int pin)
 
 int
 firmata_digitalWrite(t_firmata* firmata, int pin, int value)
+{
+    if (pin < 0 || pin > 127)
+        return (0);
+    pthread_mutex_lock(&firmata->lock);
+    firmata->pins[pin].value = value;
+    pthread_mutex_unlock(&firmata->lock);
+    return firmata_digitalWritePort(firmata, pin / 8);
+}
+
+int
+firmata_digitalWritePort(t_firmata* firmata, int port)
 {
     int i;
     int res;
     char buff[4];
 
-    if (pin < 0 || pin > 127)
+    if (port < 0 || port >= FIRMATA_PIN_COUNT / 8)
         return (0);
-    firmata->pins[pin].value = value;
-    int port_num = pin / 8;
+    // the message always carries the whole port, pins[] holds the state of all 8
     int port_val = 0;
+    pthread_mutex_lock(&firmata->lock);
     for (i = 0; i < 8; i++) {
-        int p = port_num * 8 + i;
+        int p = port * 8 + i;
         if (firmata->pins[p].mode == MODE_OUTPUT || firmata->pins[p].mode == MODE_INPUT) {
             if (firmata->pins[p].value) {
                 port_val |= (1 << i);
             }
         }
     }
-    buff[0] = FIRMATA_DIGITAL_MESSAGE | port_num;
+    pthread_mutex_unlock(&firmata->lock);
+    buff[0] = FIRMATA_DIGITAL_MESSAGE | port;
     buff[1] = port_val & 0x7F;
     buff[2] = (port_val >> 7) & 0x7F;
     res = mraa_uart_write(firmata->uart, buff, 3);
@@ -5,18 +5,22 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include <syslog.h>
+#include <time.h>
 
 #include "firmata.h"
 #include "mraa_internal.h"
 #include "firmata/firmata_mraa.h"
 #include "firmata/firmata.h"
 
+// How long an I2C read waits for the reply of the board
+#define FIRMATA_I2C_TIMEOUT_MS 100
+
 static t_firmata* firmata_dev;
 static pthread_t thread_id;
-static volatile int isr_detected;
 
 mraa_firmata_context
 mraa_firmata_init(int feature)
@@ -67,7 +71,6 @@ mraa_result_t
 mraa_firmata_close(mraa_firmata_context dev)
 {
     mraa_firmata_response_stop(dev);
-    pthread_spin_destroy(&firmata_dev->lock);
     free(dev);
     return MRAA_SUCCESS;
 }
@@ -118,14 +121,16 @@ mraa_firmata_send_i2c_read_req(mraa_i2c_context dev, int length)
     buffer[5] = (length >> 7) & 0x7f;
     buffer[6] = FIRMATA_END_SYSEX;
 
+    // invalidate before asking, the reply may be parsed before write returns
+    pthread_mutex_lock(&firmata_dev->lock);
+    memset(&firmata_dev->i2cmsg[dev->addr][0], -1, sizeof(int)*length);
+    pthread_mutex_unlock(&firmata_dev->lock);
+
     if (mraa_uart_write(firmata_dev->uart, buffer, 7) != 7) {
         free(buffer);
         return MRAA_ERROR_UNSPECIFIED;
     }
 
-    // this needs a lock :)
-    memset(&firmata_dev->i2cmsg[dev->addr][0], -1, sizeof(int)*length);
-
     free(buffer);
     return MRAA_SUCCESS;
 }
@@ -150,34 +155,95 @@ mraa_firmata_send_i2c_read_reg_req(mraa_i2c_context dev, uint8_t command, int le
     buffer[7] = (length >> 7) & 0x7f;
     buffer[8] = FIRMATA_END_SYSEX;
 
+    // invalidate before asking, the reply may be parsed before write returns
+    pthread_mutex_lock(&firmata_dev->lock);
+    memset(&firmata_dev->i2cmsg[dev->addr][command], -1, sizeof(int)*length);
+    pthread_mutex_unlock(&firmata_dev->lock);
+
     if (mraa_uart_write(firmata_dev->uart, buffer, 9) != 9) {
         free(buffer);
         return MRAA_ERROR_UNSPECIFIED;
     }
 
-    // this needs a lock :)
-    memset(&firmata_dev->i2cmsg[dev->addr][command], -1, sizeof(int)*length);
-
     free(buffer);
     return MRAA_SUCCESS;
 }
 
 static mraa_result_t
-mraa_firmata_i2c_wait(int addr, int reg)
+mraa_firmata_i2c_wait(int addr, int reg, int length)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_nsec += FIRMATA_I2C_TIMEOUT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+    }
+
+    // the reader thread broadcasts as soon as firmata_endParse() stored a reply
+    mraa_result_t ret = MRAA_SUCCESS;
+    int i = 0;
+    pthread_mutex_lock(&firmata_dev->lock);
+    while (i < length) {
+        if (firmata_dev->i2cmsg[addr][reg + i] != -1) {
+            i++;
+            continue;
+        }
+        if (pthread_cond_timedwait(&firmata_dev->cond, &firmata_dev->lock, &deadline) == ETIMEDOUT) {
+            ret = MRAA_ERROR_UNSPECIFIED;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&firmata_dev->lock);
+    return ret;
+}
+
+/* Continuous read of addr that covers the registers, -1 if none. Needs the lock. */
+static int
+mraa_firmata_i2c_query_find(int addr, int reg, int length)
 {
     int i = 0;
-    if (pthread_spin_lock(&firmata_dev->lock) != 0) return MRAA_ERROR_UNSPECIFIED;
-    int res = firmata_dev->i2cmsg[addr][reg];
-    if (pthread_spin_unlock(&firmata_dev->lock) != 0) return MRAA_ERROR_UNSPECIFIED;
-    for (; res == -1; i++) {
-        if (i > 1000) {
-            return MRAA_ERROR_UNSPECIFIED;
+    for (; i < firmata_dev->i2c_query_count; i++) {
+        t_i2c_query* query = &firmata_dev->i2c_queries[i];
+        if (query->addr == addr && reg >= query->reg && reg + length <= query->reg + query->len) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Registers the board reports continuously are served from i2cmsg, anything
+ * else costs a request and a round trip.
+ */
+static mraa_result_t
+mraa_firmata_i2c_read_regs(mraa_i2c_context dev, uint8_t command, uint8_t* data, int length)
+{
+    if (length <= 0 || command + length > 256) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&firmata_dev->lock);
+    int streamed = mraa_firmata_i2c_query_find(dev->addr, command, length) != -1;
+    pthread_mutex_unlock(&firmata_dev->lock);
+
+    if (!streamed) {
+        mraa_result_t ret = mraa_firmata_send_i2c_read_reg_req(dev, command, length);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
         }
-        usleep(50);
-        if (pthread_spin_lock(&firmata_dev->lock) != 0) return MRAA_ERROR_UNSPECIFIED;
-        res = firmata_dev->i2cmsg[addr][reg];
-        if (pthread_spin_unlock(&firmata_dev->lock) != 0) return MRAA_ERROR_UNSPECIFIED;
     }
+    // a continuous read that was just started has no sample yet either
+    if (mraa_firmata_i2c_wait(dev->addr, command, length) != MRAA_SUCCESS) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+
+    pthread_mutex_lock(&firmata_dev->lock);
+    int i = 0;
+    for (; i < length; i++) {
+        data[i] = (uint8_t) firmata_dev->i2cmsg[dev->addr][command + i];
+    }
+    pthread_mutex_unlock(&firmata_dev->lock);
     return MRAA_SUCCESS;
 }
 
@@ -185,7 +251,7 @@ static int
 mraa_firmata_i2c_read_byte(mraa_i2c_context dev)
 {
     if (mraa_firmata_send_i2c_read_req(dev, 1) == MRAA_SUCCESS) {
-        if (mraa_firmata_i2c_wait(dev->addr, 0) == MRAA_SUCCESS) {
+        if (mraa_firmata_i2c_wait(dev->addr, 0, 1) == MRAA_SUCCESS) {
             return firmata_dev->i2cmsg[dev->addr][0];
         }
     }
@@ -195,46 +261,28 @@ mraa_firmata_i2c_read_byte(mraa_i2c_context dev)
 static int
 mraa_firmata_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
 {
-    if (mraa_firmata_send_i2c_read_reg_req(dev, command, 2) == MRAA_SUCCESS) {
-        if (mraa_firmata_i2c_wait(dev->addr, command) == MRAA_SUCCESS) {
-            uint8_t rawdata[2];
-            rawdata[0] = firmata_dev->i2cmsg[dev->addr][command];
-            rawdata[1] = firmata_dev->i2cmsg[dev->addr][command+1];
-            uint16_t data = (uint16_t) *rawdata;
-            uint8_t high = (data & 0xFF00) >> 8;
-            data = (data << 8) & 0xFF00;
-            data |= high;
-
-            return (int) data;
-        }
+    uint8_t rawdata[2];
+    if (mraa_firmata_i2c_read_regs(dev, command, rawdata, 2) != MRAA_SUCCESS) {
+        return -1;
     }
-    return -1;
+    // same byte order as an SMBus word read
+    return (int) (rawdata[0] | (rawdata[1] << 8));
 }
 
 static int
 mraa_firmata_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, int length)
 {
-    uint32_t *local_storage = (uint32_t*) calloc(length, sizeof(int));
-    if (mraa_firmata_send_i2c_read_reg_req(dev, command, length) == MRAA_SUCCESS) {
-        if (mraa_firmata_i2c_wait(dev->addr, command) == MRAA_SUCCESS) {
-            memcpy(local_storage, &firmata_dev->i2cmsg[dev->addr][command], sizeof(int)*length);
-            int x = 0;
-            for(; x<length; x++){
-                data[x] = (uint8_t) local_storage[x];
-            }
-            free(local_storage);
-
-            return length;
-        }
+    if (mraa_firmata_i2c_read_regs(dev, command, data, length) != MRAA_SUCCESS) {
+        return 0;
     }
-    return 0;
+    return length;
 }
 
 static int
 mraa_firmata_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
 {
     if (mraa_firmata_send_i2c_read_req(dev, length) == MRAA_SUCCESS) {
-        if (mraa_firmata_i2c_wait(dev->addr, 0) == MRAA_SUCCESS) {
+        if (mraa_firmata_i2c_wait(dev->addr, 0, length) == MRAA_SUCCESS) {
             int i = 0;
             for (; i < length; i++) {
                 data[i] = firmata_dev->i2cmsg[dev->addr][i];
@@ -249,13 +297,11 @@ mraa_firmata_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
 static int
 mraa_firmata_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
 {
-    if (mraa_firmata_send_i2c_read_reg_req(dev, command, 1) == MRAA_SUCCESS) {
-        if (mraa_firmata_i2c_wait(dev->addr, command) == MRAA_SUCCESS) {
-            return (int) firmata_dev->i2cmsg[dev->addr][command];
-        }
+    uint8_t data;
+    if (mraa_firmata_i2c_read_regs(dev, command, &data, 1) != MRAA_SUCCESS) {
+        return -1;
     }
-
-    return -1;
+    return (int) data;
 }
 
 static mraa_result_t
@@ -331,23 +377,173 @@ mraa_firmata_i2c_write_word_data(mraa_i2c_context dev, const uint16_t data, cons
     return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
 }
 
+static mraa_result_t
+mraa_firmata_send_i2c_stop_reading(int addr)
+{
+    char buffer[5];
+    buffer[0] = FIRMATA_START_SYSEX;
+    buffer[1] = FIRMATA_I2C_REQUEST;
+    buffer[2] = addr;
+    buffer[3] = I2C_STOP_READING << 3;
+    buffer[4] = FIRMATA_END_SYSEX;
+    if (mraa_uart_write(firmata_dev->uart, buffer, 5) != 5) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
 static mraa_result_t
 mraa_firmata_i2c_stop(mraa_i2c_context dev)
 {
+    mraa_firmata_i2c_stop_reading(dev);
+    free(dev);
+    return MRAA_SUCCESS;
+}
+
+static mraa_boolean_t
+mraa_firmata_i2c_is_firmata(mraa_i2c_context dev)
+{
+    return firmata_dev != NULL && dev != NULL && dev->advance_func != NULL &&
+           dev->advance_func->i2c_read_byte_data_replace == &mraa_firmata_i2c_read_byte_data;
+}
+
+mraa_result_t
+mraa_firmata_set_sampling_interval(unsigned int millis)
+{
+    if (firmata_dev == NULL) {
+        syslog(LOG_ERR, "firmata: set_sampling_interval: no firmata board initialised");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (millis == 0 || millis > 0x3fff) {
+        syslog(LOG_ERR, "firmata: set_sampling_interval: %u ms out of range", millis);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    char buffer[5];
+    buffer[0] = FIRMATA_START_SYSEX;
+    buffer[1] = FIRMATA_SAMPLING_INTERVAL;
+    buffer[2] = millis & 0x7f;
+    buffer[3] = (millis >> 7) & 0x7f;
+    buffer[4] = FIRMATA_END_SYSEX;
+    if (mraa_uart_write(firmata_dev->uart, buffer, 5) != 5) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_firmata_i2c_read_continuous(mraa_i2c_context dev, uint8_t command, int length)
+{
+    if (!mraa_firmata_i2c_is_firmata(dev)) {
+        syslog(LOG_ERR, "firmata: i2c_read_continuous: not a firmata i2c context");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (length <= 0 || command + length > 256) {
+        syslog(LOG_ERR, "firmata: i2c_read_continuous: invalid length %d", length);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&firmata_dev->lock);
+    int index = mraa_firmata_i2c_query_find(dev->addr, command, length);
+    if (index != -1) {
+        pthread_mutex_unlock(&firmata_dev->lock);
+        return MRAA_SUCCESS;
+    }
+    if (firmata_dev->i2c_query_count == FIRMATA_I2C_MAX_QUERIES) {
+        pthread_mutex_unlock(&firmata_dev->lock);
+        syslog(LOG_ERR, "firmata: i2c_read_continuous: board serves at most %d continuous reads",
+               FIRMATA_I2C_MAX_QUERIES);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    t_i2c_query* query = &firmata_dev->i2c_queries[firmata_dev->i2c_query_count++];
+    query->addr = dev->addr;
+    query->reg = command;
+    query->len = length;
+    // readers wait for the first report instead of serving stale values
+    memset(&firmata_dev->i2cmsg[dev->addr][command], -1, sizeof(int) * length);
+    pthread_mutex_unlock(&firmata_dev->lock);
+
+    char buffer[9];
+    buffer[0] = FIRMATA_START_SYSEX;
+    buffer[1] = FIRMATA_I2C_REQUEST;
+    buffer[2] = dev->addr;
+    buffer[3] = I2C_CONTINUOUSREAD << 3;
+    buffer[4] = command & 0x7f;
+    buffer[5] = (command >> 7) & 0x7f;
+    buffer[6] = length & 0x7f;
+    buffer[7] = (length >> 7) & 0x7f;
+    buffer[8] = FIRMATA_END_SYSEX;
+    if (mraa_uart_write(firmata_dev->uart, buffer, 9) != 9) {
+        pthread_mutex_lock(&firmata_dev->lock);
+        index = mraa_firmata_i2c_query_find(dev->addr, command, length);
+        if (index != -1) {
+            firmata_dev->i2c_query_count--;
+            memmove(&firmata_dev->i2c_queries[index], &firmata_dev->i2c_queries[index + 1],
+                    (firmata_dev->i2c_query_count - index) * sizeof(t_i2c_query));
+        }
+        pthread_mutex_unlock(&firmata_dev->lock);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_firmata_i2c_stop_reading(mraa_i2c_context dev)
+{
+    if (!mraa_firmata_i2c_is_firmata(dev)) {
+        syslog(LOG_ERR, "firmata: i2c_stop_reading: not a firmata i2c context");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    int stopped = 0;
+    pthread_mutex_lock(&firmata_dev->lock);
+    int i = 0;
+    while (i < firmata_dev->i2c_query_count) {
+        if (firmata_dev->i2c_queries[i].addr == dev->addr) {
+            firmata_dev->i2c_query_count--;
+            memmove(&firmata_dev->i2c_queries[i], &firmata_dev->i2c_queries[i + 1],
+                    (firmata_dev->i2c_query_count - i) * sizeof(t_i2c_query));
+            stopped++;
+        } else {
+            i++;
+        }
+    }
+    pthread_mutex_unlock(&firmata_dev->lock);
+
+    // StandardFirmata drops a single query of the address per message
+    mraa_result_t ret = MRAA_SUCCESS;
+    for (; stopped > 0; stopped--) {
+        if (mraa_firmata_send_i2c_stop_reading(dev->addr) != MRAA_SUCCESS) {
+            ret = MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+    return ret;
+}
+
 static int
 mraa_firmata_aio_read(mraa_aio_context dev)
 {
     // careful, whilst you need to enable '0' for A0 you then need to read 14
     // in t_firmata because well that makes sense doesn't it...
-    if (pthread_spin_lock(&firmata_dev->lock) != 0) return -1;
+    pthread_mutex_lock(&firmata_dev->lock);
     int ret = (int) firmata_dev->pins[dev->channel].value;
-    if (pthread_spin_unlock(&firmata_dev->lock) != 0) return -1;
+    pthread_mutex_unlock(&firmata_dev->lock);
     return ret;
 }
 
+static mraa_result_t
+mraa_firmata_aio_read_multi(mraa_aio_context dev, int values[], unsigned int num_channels)
+{
+    // take all reported values under one lock so they belong together
+    pthread_mutex_lock(&firmata_dev->lock);
+    unsigned int i = 0;
+    for (mraa_aio_context it = dev; it != NULL && i < num_channels; it = it->next) {
+        values[i++] = (int) firmata_dev->pins[it->channel].value;
+    }
+    pthread_mutex_unlock(&firmata_dev->lock);
+    return MRAA_SUCCESS;
+}
+
 static mraa_result_t
 mraa_firmata_aio_init_internal_replace(mraa_aio_context dev, int aio)
 {
@@ -380,9 +576,9 @@ mraa_firmata_gpio_mode_replace(mraa_gpio_context dev, mraa_gpio_mode_t mode)
 static int
 mraa_firmata_gpio_read_replace(mraa_gpio_context dev)
 {
-    if (pthread_spin_lock(&firmata_dev->lock) != 0) return -1;
+    pthread_mutex_lock(&firmata_dev->lock);
     int res = firmata_dev->pins[dev->pin].value;
-    if (pthread_spin_unlock(&firmata_dev->lock) != 0) return -1;
+    pthread_mutex_unlock(&firmata_dev->lock);
     return res;
 }
 
@@ -399,25 +595,55 @@ mraa_firmata_gpio_write_replace(mraa_gpio_context dev, int write_value)
 }
 
 static mraa_result_t
-mraa_firmata_gpio_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t dir)
+mraa_firmata_gpio_write_multi_replace(mraa_gpio_context dev, int input_values[])
 {
-    switch (dir) {
-        case MRAA_GPIO_IN:
-            firmata_pinMode(firmata_dev, dev->phy_pin, MODE_INPUT);
-            break;
-        case MRAA_GPIO_OUT:
-            firmata_pinMode(firmata_dev, dev->phy_pin, MODE_OUTPUT);
-            break;
-        case MRAA_GPIO_OUT_LOW:
-            firmata_pinMode(firmata_dev, dev->phy_pin, MODE_OUTPUT);
-            firmata_digitalWrite(firmata_dev, dev->phy_pin, LOW);
-            break;
-        case MRAA_GPIO_OUT_HIGH:
-            firmata_pinMode(firmata_dev, dev->phy_pin, MODE_OUTPUT);
-            firmata_digitalWrite(firmata_dev, dev->phy_pin, HIGH);
-            break;
-        default:
+    uint16_t ports = 0;
+    int i = 0;
+
+    pthread_mutex_lock(&firmata_dev->lock);
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next, i++) {
+        if (it->phy_pin < 0 || it->phy_pin >= FIRMATA_PIN_COUNT) {
+            pthread_mutex_unlock(&firmata_dev->lock);
             return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        firmata_dev->pins[it->phy_pin].value = input_values[i] ? HIGH : LOW;
+        ports |= 1 << (it->phy_pin / 8);
+    }
+    pthread_mutex_unlock(&firmata_dev->lock);
+
+    // one digital message per port no matter how many of its pins changed
+    int port = 0;
+    for (; port < FIRMATA_PIN_COUNT / 8; port++) {
+        if ((ports & (1 << port)) && firmata_digitalWritePort(firmata_dev, port) != 3) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_firmata_gpio_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t dir)
+{
+    // contexts from mraa_gpio_init_multi() are chained
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+        switch (dir) {
+            case MRAA_GPIO_IN:
+                firmata_pinMode(firmata_dev, it->phy_pin, MODE_INPUT);
+                break;
+            case MRAA_GPIO_OUT:
+                firmata_pinMode(firmata_dev, it->phy_pin, MODE_OUTPUT);
+                break;
+            case MRAA_GPIO_OUT_LOW:
+                firmata_pinMode(firmata_dev, it->phy_pin, MODE_OUTPUT);
+                firmata_digitalWrite(firmata_dev, it->phy_pin, LOW);
+                break;
+            case MRAA_GPIO_OUT_HIGH:
+                firmata_pinMode(firmata_dev, it->phy_pin, MODE_OUTPUT);
+                firmata_digitalWrite(firmata_dev, it->phy_pin, HIGH);
+                break;
+            default:
+                return MRAA_ERROR_INVALID_PARAMETER;
+        }
     }
     return MRAA_SUCCESS;
 }
@@ -425,12 +651,24 @@ mraa_firmata_gpio_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t dir)
 static mraa_result_t
 mraa_firmata_gpio_edge_mode_replace(mraa_gpio_context dev, mraa_gpio_edge_t mode)
 {
+    if (dev->pin < 0 || dev->pin >= FIRMATA_PIN_COUNT) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
     switch (mode) {
         case MRAA_GPIO_EDGE_BOTH:
-            return MRAA_SUCCESS;
+        case MRAA_GPIO_EDGE_NONE:
+            break;
         default:
             return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
     }
+
+    // only edges from now on count, this runs before the isr thread starts
+    // so an edge arriving while it comes up is still delivered
+    pthread_mutex_lock(&firmata_dev->lock);
+    firmata_dev->isr_detected[dev->pin / 64] &= ~((uint64_t) 1 << (dev->pin % 64));
+    pthread_mutex_unlock(&firmata_dev->lock);
+    return MRAA_SUCCESS;
 }
 
 static mraa_result_t
@@ -439,14 +677,26 @@ mraa_firmata_gpio_interrupt_handler_init_replace(mraa_gpio_context dev)
     return MRAA_SUCCESS;
 }
 
+static void
+mraa_firmata_unlock(void* arg)
+{
+    pthread_mutex_unlock(&firmata_dev->lock);
+}
+
 static mraa_result_t
 mraa_firmata_gpio_wait_interrupt_replace(mraa_gpio_context dev)
 {
-    while (!((isr_detected >> dev->pin) & 1)) {
-        usleep(100);
+    uint64_t* word = &firmata_dev->isr_detected[dev->pin / 64];
+    uint64_t bit = (uint64_t) 1 << (dev->pin % 64);
+
+    // the isr thread gets cancelled while waiting here
+    pthread_mutex_lock(&firmata_dev->lock);
+    pthread_cleanup_push(mraa_firmata_unlock, NULL);
+    while (!(*word & bit)) {
+        pthread_cond_wait(&firmata_dev->cond, &firmata_dev->lock);
     }
-    // might want to lock here?
-    isr_detected &= ~(1 << dev->pin);
+    *word &= ~bit;
+    pthread_cleanup_pop(1);
     return MRAA_SUCCESS;
 }
 
@@ -514,19 +764,12 @@ mraa_firmata_pwm_period_replace(mraa_pwm_context dev, int period)
 static void*
 mraa_firmata_pull_handler(void* vp)
 {
-    int i, isr_now, isr_prev;
-    isr_prev = 0;
+    // blocks in select() until the board sends something, firmata_endParse()
+    // wakes the waiters of whatever it parsed
     while(1) {
-        isr_now = 0;
-        firmata_pull(firmata_dev);
-        // would prefer to send board pointer as argument
-        for(i = 0; i < 14; i++) {
-            isr_now |= (firmata_dev->pins[i].value & 1) << i;
+        if (firmata_pull(firmata_dev, 1000) < 0) {
+            usleep(10000);
         }
-        // might want to lock here?
-        isr_detected = isr_prev ^ isr_now; //both edges for now
-        isr_prev = isr_now;
-        usleep(100);
     }
 
     return NULL;
@@ -551,7 +794,7 @@ mraa_firmata_plat_init(const char* uart_dev)
     // if this isn't working then we have an issue with our uart
     int retry = 20;
     while (!firmata_dev->isReady && --retry) {
-       firmata_pull(firmata_dev);
+       firmata_pull(firmata_dev, 40);
     }
 
     if (!retry) {
@@ -665,10 +908,12 @@ mraa_firmata_plat_init(const char* uart_dev)
     b->adv_func->gpio_wait_interrupt_replace = &mraa_firmata_gpio_wait_interrupt_replace;
     b->adv_func->gpio_read_replace = &mraa_firmata_gpio_read_replace;
     b->adv_func->gpio_write_replace = &mraa_firmata_gpio_write_replace;
+    b->adv_func->gpio_write_multi_replace = &mraa_firmata_gpio_write_multi_replace;
     b->adv_func->gpio_close_replace = &mraa_firmata_gpio_close_replace;
 
     b->adv_func->aio_init_internal_replace = &mraa_firmata_aio_init_internal_replace;
     b->adv_func->aio_read_replace = &mraa_firmata_aio_read;
+    b->adv_func->aio_read_multi_replace = &mraa_firmata_aio_read_multi;
 
     b->adv_func->pwm_init_internal_replace = &mraa_firmata_pwm_init_internal_replace;
     b->adv_func->pwm_write_replace = &mraa_firmata_pwm_write_replace;
@@ -7,8 +7,13 @@
  */
 #include "gpio.h"
 #include "gpio/gpio_chardev.h"
+#include "gpio/gpio_dispatch.h"
+#include "gpio/gpio_events.h"
+#include "gpio/gpio_mmap.h"
 #include "linux/gpio.h"
+#include "lookup/lookup.h"
 #include "mraa_internal.h"
+#include "stats/io_stats.h"
 
 #include <dirent.h>
 #include <errno.h>
@@ -149,13 +154,17 @@ init_internal_cleanup:
 mraa_gpio_context
 mraa_gpio_init_by_name(char* name)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
     mraa_gpio_context dev;
     mraa_gpiod_group_t gpio_group;
-    mraa_gpiod_line_info* linfo = NULL;
-    mraa_gpiod_chip_info* cinfo;
     mraa_gpiod_chip_info** cinfos;
-    int i, line_found, line_offset;
+    unsigned int line_offset;
+    int i, chip;
+
+    if (board == NULL) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: platform not initialised");
+        return NULL;
+    }
 
     if (name == NULL) {
         syslog(LOG_ERR, "[GPIOD_INTERFACE]: Gpio name not valid");
@@ -202,38 +211,29 @@ mraa_gpio_init_by_name(char* name)
         gpio_group[i].gpio_lines = NULL;
     }
 
-    /* Iterate over all gpiochips in the platform to find the requested line */
-    for_each_gpio_chip(cinfo, cinfos, dev->num_chips)
-    {
-        for (i = 0; i < cinfo->chip_info.lines; i++) {
-            linfo = mraa_get_line_info_by_chip_name(cinfo->chip_info.name, i);
-            if (!strncmp(linfo->name, name, 32)) {
-                /* idx is coming from `for_each_gpio_chip` definition */
-                syslog(LOG_DEBUG, "[GPIOD_INTERFACE]: Chip: %d Line: %d", idx, i);
-                if (!gpio_group[idx].is_required) {
-                    gpio_group[idx].dev_fd = cinfo->chip_fd;
-                    gpio_group[idx].is_required = 1;
-                    gpio_group[idx].gpiod_handle = -1;
-                }
-
-                /* Map pin to _gpio_group structure. */
-                dev->pin_to_gpio_table[0] = idx;
-                gpio_group[idx].gpio_lines = realloc(gpio_group[idx].gpio_lines, sizeof(unsigned int));
-                gpio_group[idx].gpio_lines[0] = i;
-                gpio_group[idx].num_gpio_lines++;
-
-                line_found = 1;
-                line_offset = i;
-
-                break;
-            }
-        }
+    /* The line names of all gpiochips are indexed on first use */
+    chip = mraa_lookup_gpio_line(name, cinfos, dev->num_chips, &line_offset);
+    if (chip < 0) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: Gpio not found!");
+        mraa_gpio_close(dev);
+        return NULL;
     }
 
-    if (!line_found) {
-        syslog(LOG_ERR, "[GPIOD_INTERFACE]: Gpio not found!");
+    syslog(LOG_DEBUG, "[GPIOD_INTERFACE]: Chip: %d Line: %u", chip, line_offset);
+    gpio_group[chip].dev_fd = cinfos[chip]->chip_fd;
+    gpio_group[chip].is_required = 1;
+    gpio_group[chip].gpiod_handle = -1;
+
+    /* Map pin to _gpio_group structure. */
+    dev->pin_to_gpio_table[0] = chip;
+    gpio_group[chip].gpio_lines = malloc(sizeof(unsigned int));
+    if (gpio_group[chip].gpio_lines == NULL) {
+        syslog(LOG_CRIT, "[GPIOD_INTERFACE]: Failed to allocate memory for internal member");
+        mraa_gpio_close(dev);
         return NULL;
     }
+    gpio_group[chip].gpio_lines[0] = line_offset;
+    gpio_group[chip].num_gpio_lines = 1;
 
     /* Initialize rw_values for read / write multiple functions */
     for (i = 0; i < dev->num_chips; ++i) {
@@ -265,7 +265,7 @@ mraa_gpio_init_by_name(char* name)
 mraa_gpio_context
 mraa_gpio_init(int pin)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
 
     if (board == NULL) {
         syslog(LOG_ERR, "gpio%i: init: platform not initialised", pin);
@@ -499,7 +499,7 @@ mraa_gpio_chardev_init(int pins[], int num_pins)
 mraa_gpio_context
 mraa_gpio_init_multi(int pins[], int num_pins)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
 
     if (board == NULL) {
         syslog(LOG_ERR, "[GPIOD_INTERFACE]: init: platform not initialised");
@@ -540,7 +540,8 @@ mraa_gpio_init_multi(int pins[], int num_pins)
 mraa_gpio_context
 mraa_gpio_init_raw(int pin)
 {
-    return mraa_gpio_init_internal(plat == NULL ? NULL : plat->adv_func, pin);
+    mraa_board_t* board = mraa_resolve_platform();
+    return mraa_gpio_init_internal(board == NULL ? NULL : board->adv_func, pin);
 }
 
 mraa_timestamp_t
@@ -706,8 +707,8 @@ mraa_gpio_interrupt_handler(void* arg)
         return NULL;
     }
 
-    /* Is this pin on a subplatform? Do nothing... */
-    if (mraa_is_sub_platform_id(dev->pin)) {
+    /* Is this pin on a subplatform, or does the platform wait itself? Do nothing... */
+    if (mraa_is_sub_platform_id(dev->pin) || IS_FUNC_DEFINED(dev, gpio_wait_interrupt_replace)) {
     }
     /* Is the platform chardev_capable? */
     else if (plat->chardev_capable) {
@@ -950,6 +951,22 @@ mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
     return MRAA_SUCCESS;
 }
 
+static mraa_result_t
+mraa_gpio_isr_start(mraa_gpio_context dev, mraa_boolean_t shared)
+{
+    if (shared && mraa_gpio_dispatch_eligible(dev)) {
+        mraa_result_t ret = mraa_gpio_dispatch_add(dev);
+        if (ret == MRAA_SUCCESS) {
+            return ret;
+        }
+        syslog(LOG_NOTICE, "gpio%i: isr: shared dispatcher unavailable, using a thread", dev->pin);
+    }
+
+    pthread_create(&dev->thread_id, NULL, mraa_gpio_interrupt_handler, (void*) dev);
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*), void* args)
 {
@@ -962,8 +979,8 @@ mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*),
         return dev->advance_func->gpio_isr_replace(dev, mode, fptr, args);
     }
 
-    // we only allow one isr per mraa_gpio_context
-    if (dev->thread_id != 0) {
+    // we only allow one isr per mraa_gpio_context, and none while streaming events
+    if (dev->thread_id != 0 || dev->isr_dispatch != NULL || dev->event_stream != NULL) {
         return MRAA_ERROR_NO_RESOURCES;
     }
 
@@ -976,6 +993,7 @@ mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*),
         return ret;
     }
 
+    dev->isr_edge = mode;
     dev->isr = fptr;
 
     /* Most UPM sensors use the C API, the Java global ref must be created here. */
@@ -988,9 +1006,7 @@ mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*),
 
     dev->isr_args = args;
 
-    pthread_create(&dev->thread_id, NULL, mraa_gpio_interrupt_handler, (void*) dev);
-
-    return MRAA_SUCCESS;
+    return mraa_gpio_isr_start(dev, mraa_gpio_dispatch_enabled());
 }
 
 mraa_result_t
@@ -1007,12 +1023,17 @@ mraa_gpio_isr_exit(mraa_gpio_context dev)
     }
 
     // wasting our time, there is no isr to exit from
-    if (dev->thread_id == 0) {
+    if (dev->thread_id == 0 && dev->isr_dispatch == NULL) {
         return ret;
     }
     // mark the beginning of the thread termination process for interested parties
     dev->isr_thread_terminating = 1;
 
+    // the event loop must let go of our fds before they get closed
+    if (dev->isr_dispatch != NULL) {
+        mraa_gpio_dispatch_remove(dev);
+    }
+
     // stop isr being useful
     if (plat && (plat->chardev_capable))
         _mraa_close_gpio_event_handles(dev);
@@ -1047,6 +1068,81 @@ mraa_gpio_isr_exit(mraa_gpio_context dev)
     return ret;
 }
 
+mraa_result_t
+mraa_gpio_isr_dispatch_mode(mraa_gpio_isr_dispatch_t mode, unsigned int num_loops)
+{
+    return mraa_gpio_dispatch_configure(mode, num_loops);
+}
+
+mraa_gpio_isr_dispatch_t
+mraa_gpio_get_isr_dispatch_mode()
+{
+    if (mraa_gpio_dispatch_enabled()) {
+        return MRAA_GPIO_ISR_DISPATCH_SHARED;
+    }
+
+    return MRAA_GPIO_ISR_DISPATCH_THREAD;
+}
+
+static mraa_result_t
+mraa_gpio_isr_rearm(mraa_gpio_context dev, mraa_boolean_t shared)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: isr_dispatch: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (IS_FUNC_DEFINED(dev, gpio_isr_replace) || IS_FUNC_DEFINED(dev, gpio_isr_exit_replace)) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (dev->thread_id == 0 && dev->isr_dispatch == NULL) {
+        syslog(LOG_ERR, "gpio%i: isr_dispatch: no isr is set", dev->pin);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if ((dev->isr_dispatch != NULL) == shared) {
+        return MRAA_SUCCESS;
+    }
+
+    if (shared && !mraa_gpio_dispatch_eligible(dev)) {
+        syslog(LOG_ERR, "gpio%i: isr_dispatch: isr cannot use the shared dispatcher", dev->pin);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    mraa_gpio_edge_t mode = dev->isr_edge;
+    void (*fptr)(void*) = dev->isr;
+    void* args = dev->isr_args;
+
+    mraa_result_t ret = mraa_gpio_isr_exit(dev);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+
+    ret = mraa_gpio_edge_mode(dev, mode);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+
+    dev->isr_edge = mode;
+    dev->isr = fptr;
+    dev->isr_args = args;
+
+    return mraa_gpio_isr_start(dev, shared);
+}
+
+mraa_result_t
+mraa_gpio_isr_dispatch_join(mraa_gpio_context dev)
+{
+    return mraa_gpio_isr_rearm(dev, 1);
+}
+
+mraa_result_t
+mraa_gpio_isr_dispatch_leave(mraa_gpio_context dev)
+{
+    return mraa_gpio_isr_rearm(dev, 0);
+}
+
 mraa_result_t
 mraa_gpio_mode(mraa_gpio_context dev, mraa_gpio_mode_t mode)
 {
@@ -1383,6 +1479,78 @@ mraa_gpio_read_dir(mraa_gpio_context dev, mraa_gpio_dir_t* dir)
     return result;
 }
 
+/*
+ * Single line fast paths. The line handle requested on first use is kept in
+ * the group until the direction or edge mode changes, so reading or writing
+ * a pin costs a single ioctl and no allocation.
+ */
+static int
+mraa_gpio_chardev_read_single(mraa_gpio_context dev)
+{
+    if (dev->num_pins != 1) {
+        int output_values[dev->num_pins];
+
+        if (mraa_gpio_read_multi(dev, output_values) != MRAA_SUCCESS)
+            return -1;
+
+        return output_values[0];
+    }
+
+    mraa_gpiod_group_t gpio_group = &dev->gpio_group[dev->pin_to_gpio_table[0]];
+    unsigned char value;
+
+    if (gpio_group->gpiod_handle <= 0) {
+        gpio_group->gpiod_handle = mraa_get_lines_handle(gpio_group->dev_fd, gpio_group->gpio_lines,
+                                                         1, GPIOHANDLE_REQUEST_INPUT, 0);
+        if (gpio_group->gpiod_handle <= 0) {
+            syslog(LOG_ERR, "[GPIOD_INTERFACE]: error getting gpio line handle");
+            return -1;
+        }
+    }
+
+    if (mraa_get_line_values(gpio_group->gpiod_handle, 1, &value) < 0) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: error reading gpio");
+        return -1;
+    }
+
+    return value;
+}
+
+static mraa_result_t
+mraa_gpio_chardev_write_single(mraa_gpio_context dev, int value)
+{
+    if (dev->num_pins != 1) {
+        int input_values[dev->num_pins];
+
+        for (int i = 0; i < dev->num_pins; ++i) {
+            input_values[i] = value;
+        }
+        return mraa_gpio_write_multi(dev, input_values);
+    }
+
+    mraa_gpiod_group_t gpio_group = &dev->gpio_group[dev->pin_to_gpio_table[0]];
+    unsigned char line_value = value ? 1 : 0;
+
+    if (gpio_group->gpiod_handle <= 0) {
+        // requesting the line as an output already drives the value
+        gpio_group->gpiod_handle =
+        mraa_get_lines_handle(gpio_group->dev_fd, gpio_group->gpio_lines, 1,
+                              GPIOHANDLE_REQUEST_OUTPUT, line_value);
+        if (gpio_group->gpiod_handle <= 0) {
+            syslog(LOG_ERR, "[GPIOD_INTERFACE]: error getting gpio line handle");
+            return MRAA_ERROR_INVALID_HANDLE;
+        }
+        return MRAA_SUCCESS;
+    }
+
+    if (mraa_set_line_values(gpio_group->gpiod_handle, 1, &line_value) < 0) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: error writing gpio");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    return MRAA_SUCCESS;
+}
+
 int
 mraa_gpio_read(mraa_gpio_context dev)
 {
@@ -1396,12 +1564,7 @@ mraa_gpio_read(mraa_gpio_context dev)
     }
 
     if (plat->chardev_capable) {
-        int output_values[1] = { 0 };
-
-        if (mraa_gpio_read_multi(dev, output_values) != MRAA_SUCCESS)
-            return -1;
-
-        return output_values[0];
+        return mraa_gpio_chardev_read_single(dev);
     }
 
     if (dev->mmap_read != NULL) {
@@ -1487,8 +1650,8 @@ mraa_gpio_read_multi(mraa_gpio_context dev, int output_values[])
     return MRAA_SUCCESS;
 }
 
-mraa_result_t
-mraa_gpio_write(mraa_gpio_context dev, int value)
+static mraa_result_t
+_mraa_gpio_write(mraa_gpio_context dev, int value)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "gpio: write: context is invalid");
@@ -1506,9 +1669,7 @@ mraa_gpio_write(mraa_gpio_context dev, int value)
     }
 
     if (plat->chardev_capable) {
-        int input_values[1] = { value };
-
-        return mraa_gpio_write_multi(dev, input_values);
+        return mraa_gpio_chardev_write_single(dev, value);
     }
 
     if (dev->mmap_write != NULL) {
@@ -1540,6 +1701,17 @@ mraa_gpio_write(mraa_gpio_context dev, int value)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_gpio_write(mraa_gpio_context dev, int value)
+{
+    uint64_t start = mraa_stats_begin();
+    mraa_result_t ret = _mraa_gpio_write(dev, value);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_GPIO_WRITE, dev->pin, start, 1, ret == MRAA_SUCCESS);
+    }
+    return ret;
+}
+
 mraa_result_t
 mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[])
 {
@@ -1548,14 +1720,15 @@ mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[])
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (IS_FUNC_DEFINED(dev, gpio_write_multi_replace)) {
+        return dev->advance_func->gpio_write_multi_replace(dev, input_values);
+    }
+
     if (plat->chardev_capable) {
         mraa_gpiod_group_t gpio_iter;
 
-        int* counters = calloc(dev->num_chips, sizeof(int));
-        if (counters == NULL) {
-            syslog(LOG_ERR, "mraa_gpio_write_multi() malloc error");
-            return MRAA_ERROR_NO_RESOURCES;
-        }
+        unsigned int counters[dev->num_chips];
+        memset(counters, 0, sizeof(counters));
 
         for (int i = 0; i < dev->num_pins; ++i) {
             int chip_id = dev->pin_to_gpio_table[i];
@@ -1563,7 +1736,6 @@ mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[])
             gpio_iter->rw_values[counters[chip_id]] = input_values[i];
             counters[chip_id]++;
         }
-        free(counters);
 
         for_each_gpio_group(gpio_iter, dev)
         {
@@ -1688,6 +1860,17 @@ mraa_gpio_close(mraa_gpio_context dev)
     /* Free any ISRs */
     mraa_gpio_isr_exit(dev);
 
+    /* Stop streaming edge events */
+    mraa_gpio_event_stream_release(dev);
+
+    /* Unmap registers handed out by the generic mmap backend */
+    mraa_gpio_mmap_release(dev);
+
+    /* Leave the statistics registry */
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+        mraa_stats_release(&it->stats);
+    }
+
     if (plat && plat->chardev_capable) {
         _mraa_free_gpio_groups(dev);
 
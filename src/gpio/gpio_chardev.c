@@ -141,7 +141,8 @@ mraa_get_lines_handle(int chip_fd, unsigned line_offsets[], unsigned num_lines,
     memcpy(__gpio_hreq.lineoffsets, line_offsets, num_lines * sizeof __gpio_hreq.lineoffsets[0]);
 
     if (flags & GPIOHANDLE_REQUEST_OUTPUT) {
-        memset(__gpio_hreq.default_values, 0, num_lines * sizeof __gpio_hreq.default_values[0]);
+        memset(__gpio_hreq.default_values, default_value ? 1 : 0,
+               num_lines * sizeof __gpio_hreq.default_values[0]);
     }
     __gpio_hreq.flags = flags;
 
@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+
+#include "gpio/gpio_dispatch.h"
+#include "gpio/gpio_chardev.h"
+#include "linux/gpio.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#define SYSFS_CLASS_GPIO "/sys/class/gpio"
+#define MAX_SIZE 64
+#define MAX_EVENTS 64
+
+struct _gpio_dispatch_loop;
+
+/**
+ * One watched file descriptor, passed to epoll as the event data
+ */
+typedef struct {
+    struct _gpio_dispatch_reg* reg; /**< registration this fd belongs to */
+    int fd;                         /**< sysfs value fd or chardev line event fd */
+    int index;                      /**< index of the line in the context's events array */
+} mraa_gpio_dispatch_src_t;
+
+/**
+ * A context served by the dispatcher
+ */
+struct _gpio_dispatch_reg {
+    mraa_gpio_context dev;
+    struct _gpio_dispatch_loop* loop;
+    mraa_boolean_t dead;     /**< removed, only kept until its loop is done with it */
+    mraa_boolean_t sysfs;    /**< fds are sysfs value files owned by the dispatcher */
+    int num_srcs;
+    mraa_gpio_dispatch_src_t* srcs;
+    struct _gpio_dispatch_reg* next; /**< next dead registration awaiting release */
+};
+
+typedef struct _gpio_dispatch_loop {
+    int epoll_fd;
+    int wake_fd;                  /**< eventfd used to wake the loop up */
+    pthread_t thread_id;
+    pthread_mutex_t lock;         /**< held while callbacks run, recursive */
+    unsigned int num_devs;        /**< number of contexts served by this loop */
+    mraa_boolean_t running;
+    mraa_boolean_t terminating;
+    struct _gpio_dispatch_reg* graveyard;
+} mraa_gpio_dispatch_loop_t;
+
+static pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;
+static mraa_gpio_isr_dispatch_t dispatch_mode = MRAA_GPIO_ISR_DISPATCH_THREAD;
+static unsigned int dispatch_num_loops = 1;
+static mraa_gpio_dispatch_loop_t dispatch_loops[MRAA_GPIO_DISPATCH_MAX_LOOPS];
+
+static void
+mraa_gpio_dispatch_release(mraa_gpio_dispatch_loop_t* loop)
+{
+    while (loop->graveyard != NULL) {
+        struct _gpio_dispatch_reg* reg = loop->graveyard;
+        loop->graveyard = reg->next;
+        free(reg->srcs);
+        free(reg);
+    }
+}
+
+static void
+mraa_gpio_dispatch_wake(mraa_gpio_dispatch_loop_t* loop)
+{
+    uint64_t one = 1;
+
+    if (write(loop->wake_fd, &one, sizeof(one)) != sizeof(one)) {
+        syslog(LOG_WARNING, "gpio: dispatch: failed to wake event loop: %s", strerror(errno));
+    }
+}
+
+static void
+mraa_gpio_dispatch_fire(mraa_gpio_dispatch_src_t* src)
+{
+    mraa_gpio_context dev = src->reg->dev;
+    mraa_timestamp_t timestamp;
+
+    if (src->reg->sysfs) {
+        unsigned char c;
+        // re-read the value to clear the pending notification
+        lseek(src->fd, 0, SEEK_SET);
+        if (read(src->fd, &c, 1) < 0) {
+            return;
+        }
+        timestamp = _mraa_gpio_get_timestamp_sysfs();
+    } else {
+        struct gpioevent_data event_data;
+        if (read(src->fd, &event_data, sizeof(event_data)) != sizeof(event_data)) {
+            return;
+        }
+        timestamp = event_data.timestamp;
+    }
+
+    if (dev->events != NULL) {
+        for (int i = 0; i < dev->num_pins; ++i) {
+            dev->events[i].id = -1;
+        }
+        dev->events[src->index].id = src->index;
+        dev->events[src->index].timestamp = timestamp;
+    }
+
+    if (lang_func->python_isr != NULL) {
+        lang_func->python_isr(dev->isr, dev->isr_args);
+    } else {
+        dev->isr(dev->isr_args);
+    }
+}
+
+static void*
+mraa_gpio_dispatch_loop(void* arg)
+{
+    mraa_gpio_dispatch_loop_t* loop = (mraa_gpio_dispatch_loop_t*) arg;
+    struct epoll_event events[MAX_EVENTS];
+    mraa_boolean_t terminating = 0;
+
+    while (!terminating) {
+        int num = epoll_wait(loop->epoll_fd, events, MAX_EVENTS, -1);
+        if (num < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "gpio: dispatch: epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+
+        pthread_mutex_lock(&loop->lock);
+        for (int i = 0; i < num; ++i) {
+            mraa_gpio_dispatch_src_t* src = (mraa_gpio_dispatch_src_t*) events[i].data.ptr;
+            if (src == NULL) {
+                uint64_t count;
+                if (read(loop->wake_fd, &count, sizeof(count)) < 0) {
+                    syslog(LOG_DEBUG, "gpio: dispatch: spurious wake up");
+                }
+                continue;
+            }
+            // the context may have left while this batch was pending
+            if (src->reg->dead) {
+                continue;
+            }
+            mraa_gpio_dispatch_fire(src);
+        }
+        // nothing returned from now on can refer to a registration removed so far
+        mraa_gpio_dispatch_release(loop);
+        terminating = loop->terminating;
+        pthread_mutex_unlock(&loop->lock);
+    }
+
+    return NULL;
+}
+
+static mraa_result_t
+mraa_gpio_dispatch_start(mraa_gpio_dispatch_loop_t* loop)
+{
+    pthread_mutexattr_t attr;
+    struct epoll_event ev;
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd == -1) {
+        syslog(LOG_ERR, "gpio: dispatch: failed to create epoll instance: %s", strerror(errno));
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    loop->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (loop->wake_fd == -1) {
+        syslog(LOG_ERR, "gpio: dispatch: failed to create eventfd: %s", strerror(errno));
+        close(loop->epoll_fd);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &ev) == -1) {
+        syslog(LOG_ERR, "gpio: dispatch: failed to watch eventfd: %s", strerror(errno));
+        close(loop->wake_fd);
+        close(loop->epoll_fd);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    // isr_exit() may be called from within an isr, on the loop thread
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&loop->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    loop->num_devs = 0;
+    loop->terminating = 0;
+    loop->graveyard = NULL;
+
+    if (pthread_create(&loop->thread_id, NULL, mraa_gpio_dispatch_loop, (void*) loop) != 0) {
+        syslog(LOG_ERR, "gpio: dispatch: failed to create event loop thread");
+        pthread_mutex_destroy(&loop->lock);
+        close(loop->wake_fd);
+        close(loop->epoll_fd);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    loop->running = 1;
+    return MRAA_SUCCESS;
+}
+
+static void
+mraa_gpio_dispatch_stop(mraa_gpio_dispatch_loop_t* loop)
+{
+    pthread_mutex_lock(&loop->lock);
+    loop->terminating = 1;
+    pthread_mutex_unlock(&loop->lock);
+
+    mraa_gpio_dispatch_wake(loop);
+    pthread_join(loop->thread_id, NULL);
+
+    mraa_gpio_dispatch_release(loop);
+    pthread_mutex_destroy(&loop->lock);
+    close(loop->wake_fd);
+    close(loop->epoll_fd);
+    loop->running = 0;
+}
+
+static mraa_boolean_t
+mraa_gpio_dispatch_is_loop_thread()
+{
+    for (int i = 0; i < MRAA_GPIO_DISPATCH_MAX_LOOPS; ++i) {
+        if (dispatch_loops[i].running &&
+            pthread_equal(dispatch_loops[i].thread_id, pthread_self())) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Registrations are counted under dispatch_lock, never under a loop lock. */
+static unsigned int
+mraa_gpio_dispatch_count_devs()
+{
+    unsigned int total = 0;
+
+    for (int i = 0; i < MRAA_GPIO_DISPATCH_MAX_LOOPS; ++i) {
+        if (dispatch_loops[i].running) {
+            total += dispatch_loops[i].num_devs;
+        }
+    }
+
+    return total;
+}
+
+/* Builds the list of fds to watch, in the same order as the events array. */
+static struct _gpio_dispatch_reg*
+mraa_gpio_dispatch_reg_new(mraa_gpio_context dev)
+{
+    struct _gpio_dispatch_reg* reg = calloc(1, sizeof(struct _gpio_dispatch_reg));
+    if (reg == NULL) {
+        return NULL;
+    }
+
+    reg->dev = dev;
+    reg->srcs = calloc(dev->num_pins, sizeof(mraa_gpio_dispatch_src_t));
+    if (reg->srcs == NULL) {
+        free(reg);
+        return NULL;
+    }
+
+    if (plat->chardev_capable) {
+        mraa_gpiod_group_t gpio_group;
+
+        for_each_gpio_group(gpio_group, dev)
+        {
+            for (int i = 0; i < gpio_group->num_gpio_lines; ++i) {
+                reg->srcs[reg->num_srcs].reg = reg;
+                reg->srcs[reg->num_srcs].fd = gpio_group->event_handles[i];
+                reg->srcs[reg->num_srcs].index = reg->num_srcs;
+                reg->num_srcs++;
+            }
+        }
+    } else {
+        mraa_gpio_context it = dev;
+
+        reg->sysfs = 1;
+        while (it && reg->num_srcs < dev->num_pins) {
+            char bu[MAX_SIZE];
+            unsigned char c;
+            snprintf(bu, MAX_SIZE, SYSFS_CLASS_GPIO "/gpio%d/value", it->pin);
+            int fd = open(bu, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                syslog(LOG_ERR, "gpio%i: dispatch: failed to open 'value' : %s", it->pin,
+                       strerror(errno));
+                for (int i = 0; i < reg->num_srcs; ++i) {
+                    close(reg->srcs[i].fd);
+                }
+                free(reg->srcs);
+                free(reg);
+                return NULL;
+            }
+            // do an initial read to clear interrupt
+            if (read(fd, &c, 1) < 0) {
+                syslog(LOG_DEBUG, "gpio%i: dispatch: initial read failed", it->pin);
+            }
+
+            reg->srcs[reg->num_srcs].reg = reg;
+            reg->srcs[reg->num_srcs].fd = fd;
+            reg->srcs[reg->num_srcs].index = reg->num_srcs;
+            reg->num_srcs++;
+            it = it->next;
+        }
+    }
+
+    return reg;
+}
+
+static void
+mraa_gpio_dispatch_close_srcs(struct _gpio_dispatch_reg* reg)
+{
+    // chardev event handles belong to the context and are closed by isr_exit
+    if (reg->sysfs) {
+        for (int i = 0; i < reg->num_srcs; ++i) {
+            close(reg->srcs[i].fd);
+        }
+    }
+}
+
+mraa_boolean_t
+mraa_gpio_dispatch_enabled()
+{
+    return dispatch_mode == MRAA_GPIO_ISR_DISPATCH_SHARED;
+}
+
+mraa_boolean_t
+mraa_gpio_dispatch_eligible(mraa_gpio_context dev)
+{
+    if (dev == NULL || dev->isr == NULL || plat == NULL) {
+        return 0;
+    }
+
+    // sub platforms and custom backends wait for interrupts their own way
+    if (IS_FUNC_DEFINED(dev, gpio_wait_interrupt_replace) ||
+        IS_FUNC_DEFINED(dev, gpio_interrupt_handler_init_replace)) {
+        return 0;
+    }
+
+    // Java callbacks need a JNI environment attached to their thread
+    if (lang_func != NULL && lang_func->java_isr_callback != NULL &&
+        dev->isr == lang_func->java_isr_callback) {
+        return 0;
+    }
+
+    return 1;
+}
+
+mraa_result_t
+mraa_gpio_dispatch_add(mraa_gpio_context dev)
+{
+    mraa_gpio_dispatch_loop_t* loop = NULL;
+    struct _gpio_dispatch_reg* reg;
+
+    if (dev->isr_dispatch != NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    reg = mraa_gpio_dispatch_reg_new(dev);
+    if (reg == NULL) {
+        syslog(LOG_ERR, "gpio%i: dispatch: failed to set up event sources", dev->pin);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    pthread_mutex_lock(&dispatch_lock);
+    for (int i = 0; i < dispatch_num_loops; ++i) {
+        if (!dispatch_loops[i].running &&
+            mraa_gpio_dispatch_start(&dispatch_loops[i]) != MRAA_SUCCESS) {
+            continue;
+        }
+        if (loop == NULL || dispatch_loops[i].num_devs < loop->num_devs) {
+            loop = &dispatch_loops[i];
+        }
+    }
+    if (loop != NULL) {
+        loop->num_devs++;
+    }
+    pthread_mutex_unlock(&dispatch_lock);
+
+    if (loop == NULL) {
+        mraa_gpio_dispatch_close_srcs(reg);
+        free(reg->srcs);
+        free(reg);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    reg->loop = loop;
+    for (int i = 0; i < reg->num_srcs; ++i) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        // sysfs signals edges through POLLPRI, chardev through readable event records
+        ev.events = reg->sysfs ? (EPOLLPRI | EPOLLERR) : EPOLLIN;
+        ev.data.ptr = &reg->srcs[i];
+        if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, reg->srcs[i].fd, &ev) == -1) {
+            syslog(LOG_ERR, "gpio%i: dispatch: failed to watch fd %d: %s", dev->pin,
+                   reg->srcs[i].fd, strerror(errno));
+            // nothing has fired yet, the registration can be dropped right away
+            pthread_mutex_lock(&loop->lock);
+            for (int j = 0; j < i; ++j) {
+                epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, reg->srcs[j].fd, NULL);
+            }
+            pthread_mutex_unlock(&loop->lock);
+            mraa_gpio_dispatch_close_srcs(reg);
+            pthread_mutex_lock(&dispatch_lock);
+            loop->num_devs--;
+            pthread_mutex_unlock(&dispatch_lock);
+            free(reg->srcs);
+            free(reg);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+    }
+    dev->isr_dispatch = reg;
+
+    syslog(LOG_DEBUG, "gpio%i: dispatch: %d line(s) added to event loop %d", dev->pin,
+           reg->num_srcs, (int) (loop - dispatch_loops));
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_dispatch_remove(mraa_gpio_context dev)
+{
+    struct _gpio_dispatch_reg* reg = dev->isr_dispatch;
+    mraa_gpio_dispatch_loop_t* loop;
+
+    if (reg == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    loop = reg->loop;
+
+    // waits for a running isr of this loop, unless we are that isr
+    pthread_mutex_lock(&loop->lock);
+    for (int i = 0; i < reg->num_srcs; ++i) {
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, reg->srcs[i].fd, NULL);
+    }
+    mraa_gpio_dispatch_close_srcs(reg);
+    reg->dead = 1;
+    reg->next = loop->graveyard;
+    loop->graveyard = reg;
+    dev->isr_dispatch = NULL;
+    pthread_mutex_unlock(&loop->lock);
+
+    pthread_mutex_lock(&dispatch_lock);
+    loop->num_devs--;
+    pthread_mutex_unlock(&dispatch_lock);
+
+    // let the loop release the registration
+    mraa_gpio_dispatch_wake(loop);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_dispatch_configure(mraa_gpio_isr_dispatch_t mode, unsigned int num_loops)
+{
+    if (mode != MRAA_GPIO_ISR_DISPATCH_THREAD && mode != MRAA_GPIO_ISR_DISPATCH_SHARED) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (num_loops > MRAA_GPIO_DISPATCH_MAX_LOOPS) {
+        syslog(LOG_ERR, "gpio: dispatch: at most %d event loops are supported",
+               MRAA_GPIO_DISPATCH_MAX_LOOPS);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&dispatch_lock);
+    if (num_loops != 0 && num_loops != dispatch_num_loops) {
+        if (mraa_gpio_dispatch_count_devs() != 0) {
+            syslog(LOG_ERR, "gpio: dispatch: cannot change the number of event loops while in use");
+            pthread_mutex_unlock(&dispatch_lock);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        if (mraa_gpio_dispatch_is_loop_thread()) {
+            pthread_mutex_unlock(&dispatch_lock);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        for (int i = 0; i < MRAA_GPIO_DISPATCH_MAX_LOOPS; ++i) {
+            if (dispatch_loops[i].running) {
+                mraa_gpio_dispatch_stop(&dispatch_loops[i]);
+            }
+        }
+        dispatch_num_loops = num_loops;
+    }
+
+    dispatch_mode = mode;
+    pthread_mutex_unlock(&dispatch_lock);
+
+    // idle loops are not needed anymore
+    if (mode == MRAA_GPIO_ISR_DISPATCH_THREAD) {
+        mraa_gpio_dispatch_shutdown();
+    }
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_gpio_dispatch_shutdown()
+{
+    pthread_mutex_lock(&dispatch_lock);
+    if (mraa_gpio_dispatch_is_loop_thread()) {
+        pthread_mutex_unlock(&dispatch_lock);
+        return;
+    }
+
+    if (mraa_gpio_dispatch_count_devs() != 0) {
+        syslog(LOG_NOTICE, "gpio: dispatch: event loops still in use, leaving them running");
+        pthread_mutex_unlock(&dispatch_lock);
+        return;
+    }
+
+    for (int i = 0; i < MRAA_GPIO_DISPATCH_MAX_LOOPS; ++i) {
+        if (dispatch_loops[i].running) {
+            mraa_gpio_dispatch_stop(&dispatch_loops[i]);
+        }
+    }
+    pthread_mutex_unlock(&dispatch_lock);
+}
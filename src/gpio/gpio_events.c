@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "gpio/gpio_events.h"
+#include "gpio/gpio_chardev.h"
+#include "linux/gpio.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+struct _gpio_event_stream {
+    pthread_t thread;
+    int wake_fd; /**< eventfd used to stop the drain thread */
+    unsigned int num_fds;
+    int* fds;  /**< one event fd per pin */
+    int* pins; /**< pin number reported for each fd */
+    mraa_boolean_t own_fds; /**< fds come from gpio_event_fds_replace and are closed on stop */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    mraa_gpio_edge_event_t* ring;
+    unsigned int capacity;
+    unsigned int head; /**< index of the oldest event */
+    unsigned int count;
+    mraa_gpio_event_stats_t stats;
+};
+
+static void
+mraa_gpio_event_stream_push(struct _gpio_event_stream* stream, int pin, const struct gpioevent_data* data, int num)
+{
+    pthread_mutex_lock(&stream->lock);
+    for (int i = 0; i < num; ++i) {
+        stream->stats.received++;
+        if (stream->count == stream->capacity) {
+            // Keep the oldest events, the overflow counter tells how many went missing
+            stream->stats.overflows++;
+            continue;
+        }
+        mraa_gpio_edge_event_t* event = &stream->ring[(stream->head + stream->count) % stream->capacity];
+        event->pin = pin;
+        event->edge = data[i].id == GPIOEVENT_EVENT_RISING_EDGE ? MRAA_GPIO_EDGE_RISING : MRAA_GPIO_EDGE_FALLING;
+        event->timestamp = data[i].timestamp;
+        stream->count++;
+    }
+    if (stream->count > stream->stats.max_fill) {
+        stream->stats.max_fill = stream->count;
+    }
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->lock);
+}
+
+static void*
+mraa_gpio_event_stream_drain(void* arg)
+{
+    struct _gpio_event_stream* stream = (struct _gpio_event_stream*) arg;
+    struct pollfd pfd[stream->num_fds + 1];
+    struct gpioevent_data data[MRAA_GPIO_EVENT_READ_BATCH];
+
+    for (unsigned int i = 0; i < stream->num_fds; ++i) {
+        pfd[i].fd = stream->fds[i];
+        pfd[i].events = POLLIN;
+    }
+    pfd[stream->num_fds].fd = stream->wake_fd;
+    pfd[stream->num_fds].events = POLLIN;
+
+    for (;;) {
+        if (poll(pfd, stream->num_fds + 1, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "gpio: event_stream: poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (pfd[stream->num_fds].revents & POLLIN) {
+            break;
+        }
+
+        for (unsigned int i = 0; i < stream->num_fds; ++i) {
+            if (!(pfd[i].revents & POLLIN)) {
+                continue;
+            }
+            // The kernel hands out as many queued records as fit in one read
+            ssize_t len = read(stream->fds[i], data, sizeof(data));
+            if (len > 0) {
+                mraa_gpio_event_stream_push(stream, stream->pins[i], data,
+                                            len / sizeof(struct gpioevent_data));
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Fill in the event fds of all pins of a context. */
+static mraa_result_t
+mraa_gpio_event_stream_fds(mraa_gpio_context dev, mraa_gpio_edge_t mode, struct _gpio_event_stream* stream)
+{
+    if (plat != NULL && plat->chardev_capable && !IS_FUNC_DEFINED(dev, gpio_event_fds_replace)) {
+        stream->num_fds = dev->num_pins;
+    } else {
+        stream->num_fds = 0;
+        for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+            stream->num_fds++;
+        }
+    }
+
+    stream->fds = calloc(stream->num_fds, sizeof(int));
+    stream->pins = calloc(stream->num_fds, sizeof(int));
+    if (stream->fds == NULL || stream->pins == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    if (IS_FUNC_DEFINED(dev, gpio_event_fds_replace)) {
+        // the hook fills one fd per linked context, unfilled slots are caught
+        // here rather than polled and closed as fd 0
+        for (unsigned int i = 0; i < stream->num_fds; ++i) {
+            stream->fds[i] = -1;
+        }
+        mraa_result_t ret = dev->advance_func->gpio_event_fds_replace(dev, mode, stream->fds, stream->num_fds);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
+        stream->own_fds = 1;
+        for (unsigned int i = 0; i < stream->num_fds; ++i) {
+            if (stream->fds[i] < 0) {
+                syslog(LOG_ERR, "gpio%i: event_stream: no event fd for pin %u of the context", dev->pin, i);
+                return MRAA_ERROR_INVALID_RESOURCE;
+            }
+        }
+
+        unsigned int idx = 0;
+        for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+            stream->pins[idx++] = it->phy_pin;
+        }
+        return MRAA_SUCCESS;
+    }
+
+    // sysfs has neither edge information nor kernel timestamps
+    if (plat == NULL || !plat->chardev_capable || IS_FUNC_DEFINED(dev, gpio_edge_mode_replace)) {
+        syslog(LOG_ERR, "gpio%i: event_stream: needs a chardev capable platform", dev->pin);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    mraa_result_t ret = mraa_gpio_edge_mode(dev, mode);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+
+    unsigned int idx = 0;
+    mraa_gpiod_group_t gpio_group;
+    for_each_gpio_group(gpio_group, dev)
+    {
+        for (int i = 0; i < gpio_group->num_gpio_lines; ++i) {
+            stream->fds[idx] = gpio_group->event_handles[i];
+            stream->pins[idx] = dev->provided_pins[gpio_group->gpio_group_to_pins_table[i]];
+            idx++;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+static void
+mraa_gpio_event_stream_free(mraa_gpio_context dev, struct _gpio_event_stream* stream)
+{
+    if (stream->own_fds) {
+        for (unsigned int i = 0; i < stream->num_fds; ++i) {
+            if (stream->fds[i] >= 0) {
+                close(stream->fds[i]);
+            }
+        }
+    } else if (stream->fds != NULL && plat != NULL && plat->chardev_capable) {
+        _mraa_close_gpio_event_handles(dev);
+    }
+    if (stream->wake_fd >= 0) {
+        close(stream->wake_fd);
+    }
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->lock);
+    free(stream->fds);
+    free(stream->pins);
+    free(stream->ring);
+    free(stream);
+}
+
+mraa_result_t
+mraa_gpio_event_stream_start(mraa_gpio_context dev, mraa_gpio_edge_t mode, unsigned int capacity)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: event_stream_start: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (mode == MRAA_GPIO_EDGE_NONE || capacity == 0) {
+        syslog(LOG_ERR, "gpio%i: event_stream_start: invalid edge mode or capacity", dev->pin);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->event_stream != NULL || dev->thread_id != 0 || dev->isr_dispatch != NULL) {
+        syslog(LOG_ERR, "gpio%i: event_stream_start: context already has a stream or an isr", dev->pin);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    struct _gpio_event_stream* stream = calloc(1, sizeof(struct _gpio_event_stream));
+    if (stream == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&stream->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    stream->capacity = capacity;
+    stream->wake_fd = eventfd(0, EFD_CLOEXEC);
+
+    stream->ring = malloc(capacity * sizeof(mraa_gpio_edge_event_t));
+    if (stream->ring == NULL || stream->wake_fd < 0) {
+        mraa_gpio_event_stream_free(dev, stream);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    mraa_result_t ret = mraa_gpio_event_stream_fds(dev, mode, stream);
+    if (ret != MRAA_SUCCESS) {
+        mraa_gpio_event_stream_free(dev, stream);
+        return ret;
+    }
+
+    if (pthread_create(&stream->thread, NULL, mraa_gpio_event_stream_drain, stream) != 0) {
+        syslog(LOG_ERR, "gpio%i: event_stream_start: failed to start drain thread", dev->pin);
+        mraa_gpio_event_stream_free(dev, stream);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->event_stream = stream;
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_gpio_event_stream_read(mraa_gpio_context dev, mraa_gpio_edge_event_t* events, unsigned int max_events, int timeout_ms)
+{
+    if (dev == NULL || dev->event_stream == NULL) {
+        syslog(LOG_ERR, "gpio: event_stream_read: context is invalid or not streaming");
+        return -1;
+    }
+
+    if (events == NULL) {
+        syslog(LOG_ERR, "gpio%i: event_stream_read: invalid events array", dev->pin);
+        return -1;
+    }
+
+    struct _gpio_event_stream* stream = dev->event_stream;
+    struct timespec deadline;
+
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&stream->lock);
+    while (stream->count == 0 && timeout_ms != 0) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&stream->cond, &stream->lock);
+        } else if (pthread_cond_timedwait(&stream->cond, &stream->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    unsigned int num = stream->count < max_events ? stream->count : max_events;
+    for (unsigned int i = 0; i < num; ++i) {
+        events[i] = stream->ring[stream->head];
+        stream->head = (stream->head + 1) % stream->capacity;
+    }
+    stream->count -= num;
+    stream->stats.delivered += num;
+    pthread_mutex_unlock(&stream->lock);
+
+    return num;
+}
+
+mraa_result_t
+mraa_gpio_event_stream_stats(mraa_gpio_context dev, mraa_gpio_event_stats_t* stats)
+{
+    if (dev == NULL || dev->event_stream == NULL) {
+        syslog(LOG_ERR, "gpio: event_stream_stats: context is invalid or not streaming");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&dev->event_stream->lock);
+    *stats = dev->event_stream->stats;
+    pthread_mutex_unlock(&dev->event_stream->lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_event_stream_stop(mraa_gpio_context dev)
+{
+    if (dev == NULL || dev->event_stream == NULL) {
+        syslog(LOG_ERR, "gpio: event_stream_stop: context is invalid or not streaming");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    struct _gpio_event_stream* stream = dev->event_stream;
+    uint64_t wake = 1;
+
+    if (write(stream->wake_fd, &wake, sizeof(wake)) != sizeof(wake)) {
+        syslog(LOG_ERR, "gpio%i: event_stream_stop: failed to wake drain thread", dev->pin);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(stream->thread, NULL);
+
+    dev->event_stream = NULL;
+    mraa_gpio_event_stream_free(dev, stream);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_gpio_event_stream_release(mraa_gpio_context dev)
+{
+    if (dev != NULL && dev->event_stream != NULL) {
+        mraa_gpio_event_stream_stop(dev);
+    }
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "gpio/gpio_mmap.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define MAX_MAPPINGS 16
+
+/* Register addresses of a context using the mmap backend. */
+struct _gpio_mmap_line {
+    volatile uint32_t* level;
+    volatile uint32_t* out;
+    volatile uint32_t* set;
+    volatile uint32_t* clear;
+    uint32_t mask;
+    int mapping; /**< index in the mappings table */
+};
+
+typedef struct {
+    const mraa_gpio_mmap_soc_t* soc;
+    unsigned int bank;
+    uint8_t* regs;
+    unsigned int refs;
+} mraa_gpio_mmap_mapping_t;
+
+static const mraa_gpio_mmap_soc_t mmap_socs[] = {
+    { "bcm2835", "/dev/gpiomem", "/dev/mem", 1, { 0x20200000 }, 4096, 54, 0x34,
+      MRAA_GPIO_MMAP_NO_REG, 0x1c, 0x28 },
+    { "bcm2836", "/dev/gpiomem", "/dev/mem", 1, { 0x3f200000 }, 4096, 54, 0x34,
+      MRAA_GPIO_MMAP_NO_REG, 0x1c, 0x28 },
+    { "bcm2837", "/dev/gpiomem", "/dev/mem", 1, { 0x3f200000 }, 4096, 54, 0x34,
+      MRAA_GPIO_MMAP_NO_REG, 0x1c, 0x28 },
+    { "bcm2711", "/dev/gpiomem", "/dev/mem", 1, { 0xfe200000 }, 4096, 58, 0x34,
+      MRAA_GPIO_MMAP_NO_REG, 0x1c, 0x28 },
+    // GPIO_EXT_PORTA for levels, GPIO_SWPORTA_DR for outputs
+    { "rk3399", NULL, "/dev/mem", 5, { 0xff720000, 0xff730000, 0xff780000, 0xff788000, 0xff790000 },
+      4096, 32, 0x50, 0x00, MRAA_GPIO_MMAP_NO_REG, MRAA_GPIO_MMAP_NO_REG },
+};
+
+static pthread_mutex_t mmap_lock = PTHREAD_MUTEX_INITIALIZER;
+static mraa_gpio_mmap_mapping_t mmap_mappings[MAX_MAPPINGS];
+
+static uint8_t*
+mraa_gpio_mmap_map_bank(const mraa_gpio_mmap_soc_t* soc, unsigned int bank)
+{
+    void* regs = MAP_FAILED;
+    int fd;
+
+    // gpiomem style devices expose the first bank without root privileges
+    if (soc->gpiomem_dev != NULL && bank == 0) {
+        fd = open(soc->gpiomem_dev, O_RDWR | O_SYNC | O_CLOEXEC);
+        if (fd >= 0) {
+            regs = mmap(NULL, soc->bank_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (regs != MAP_FAILED) {
+                return (uint8_t*) regs;
+            }
+        }
+    }
+
+    fd = open(soc->mem_dev, O_RDWR | O_SYNC | O_CLOEXEC);
+    if (fd < 0) {
+        syslog(LOG_ERR, "gpio: mmap: unable to open %s: %s", soc->mem_dev, strerror(errno));
+        return NULL;
+    }
+
+    regs = mmap(NULL, soc->bank_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, soc->bank_base[bank]);
+    close(fd);
+    if (regs == MAP_FAILED) {
+        syslog(LOG_ERR, "gpio: mmap: failed to map %s bank %u: %s", soc->name, bank, strerror(errno));
+        return NULL;
+    }
+
+    return (uint8_t*) regs;
+}
+
+/* Called with mmap_lock held. */
+static int
+mraa_gpio_mmap_get_mapping(const mraa_gpio_mmap_soc_t* soc, unsigned int bank)
+{
+    int free_slot = -1;
+
+    for (int i = 0; i < MAX_MAPPINGS; ++i) {
+        if (mmap_mappings[i].refs == 0) {
+            if (free_slot == -1) {
+                free_slot = i;
+            }
+            continue;
+        }
+        if (mmap_mappings[i].soc == soc && mmap_mappings[i].bank == bank) {
+            mmap_mappings[i].refs++;
+            return i;
+        }
+    }
+
+    if (free_slot == -1) {
+        syslog(LOG_ERR, "gpio: mmap: too many register banks mapped");
+        return -1;
+    }
+
+    uint8_t* regs = mraa_gpio_mmap_map_bank(soc, bank);
+    if (regs == NULL) {
+        return -1;
+    }
+
+    mmap_mappings[free_slot].soc = soc;
+    mmap_mappings[free_slot].bank = bank;
+    mmap_mappings[free_slot].regs = regs;
+    mmap_mappings[free_slot].refs = 1;
+
+    return free_slot;
+}
+
+/* Called with mmap_lock held. */
+static void
+mraa_gpio_mmap_put_mapping(int index)
+{
+    mraa_gpio_mmap_mapping_t* mapping = &mmap_mappings[index];
+
+    if (--mapping->refs == 0) {
+        munmap(mapping->regs, mapping->soc->bank_size);
+        mapping->regs = NULL;
+        mapping->soc = NULL;
+    }
+}
+
+static int
+mraa_gpio_mmap_read(mraa_gpio_context dev)
+{
+    return (*dev->mmap_line->level & dev->mmap_line->mask) ? 1 : 0;
+}
+
+static mraa_result_t
+mraa_gpio_mmap_write(mraa_gpio_context dev, int value)
+{
+    struct _gpio_mmap_line* line = dev->mmap_line;
+
+    if (value) {
+        *line->set = line->mask;
+    } else {
+        *line->clear = line->mask;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+/* Read-modify-write of the output register, for controllers without set/clear registers. */
+static mraa_result_t
+mraa_gpio_mmap_write_rmw(mraa_gpio_context dev, int value)
+{
+    struct _gpio_mmap_line* line = dev->mmap_line;
+
+    if (value) {
+        *line->out |= line->mask;
+    } else {
+        *line->out &= ~line->mask;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+const mraa_gpio_mmap_soc_t*
+mraa_gpio_mmap_find_soc(const char* name)
+{
+    if (name == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < sizeof(mmap_socs) / sizeof(mmap_socs[0]); ++i) {
+        if (strcmp(mmap_socs[i].name, name) == 0) {
+            return &mmap_socs[i];
+        }
+    }
+
+    return NULL;
+}
+
+void
+mraa_gpio_mmap_release(mraa_gpio_context dev)
+{
+    if (dev == NULL || dev->mmap_line == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&mmap_lock);
+    mraa_gpio_mmap_put_mapping(dev->mmap_line->mapping);
+    pthread_mutex_unlock(&mmap_lock);
+
+    free(dev->mmap_line);
+    dev->mmap_line = NULL;
+    dev->mmap_write = NULL;
+    dev->mmap_read = NULL;
+}
+
+mraa_result_t
+mraa_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en, const mraa_gpio_mmap_soc_t* soc)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: mmap: context not valid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (en == 0) {
+        if (dev->mmap_line == NULL) {
+            syslog(LOG_ERR, "gpio%i: mmap: can't disable disabled mmap gpio", dev->pin);
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        mraa_gpio_mmap_release(dev);
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->mmap_line != NULL) {
+        syslog(LOG_ERR, "gpio%i: mmap: can't enable enabled mmap gpio", dev->pin);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (soc == NULL) {
+        syslog(LOG_ERR, "gpio%i: mmap: no register description for this platform", dev->pin);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (dev->pin < 0 || dev->pin >= soc->num_banks * soc->lines_per_bank) {
+        syslog(LOG_ERR, "gpio%i: mmap: line is not handled by the %s controller", dev->pin, soc->name);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    unsigned int bank = dev->pin / soc->lines_per_bank;
+    unsigned int bit = dev->pin % soc->lines_per_bank;
+    unsigned int word = (bit / 32) * 4;
+
+    struct _gpio_mmap_line* line = calloc(1, sizeof(struct _gpio_mmap_line));
+    if (line == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    pthread_mutex_lock(&mmap_lock);
+    line->mapping = mraa_gpio_mmap_get_mapping(soc, bank);
+    if (line->mapping < 0) {
+        pthread_mutex_unlock(&mmap_lock);
+        free(line);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    uint8_t* regs = mmap_mappings[line->mapping].regs;
+    pthread_mutex_unlock(&mmap_lock);
+
+    line->mask = (uint32_t) 1 << (bit % 32);
+    line->level = (volatile uint32_t*) (regs + soc->level_reg + word);
+    if (soc->set_reg != MRAA_GPIO_MMAP_NO_REG && soc->clear_reg != MRAA_GPIO_MMAP_NO_REG) {
+        line->set = (volatile uint32_t*) (regs + soc->set_reg + word);
+        line->clear = (volatile uint32_t*) (regs + soc->clear_reg + word);
+        dev->mmap_write = &mraa_gpio_mmap_write;
+    } else {
+        line->out = (volatile uint32_t*) (regs + soc->out_reg + word);
+        dev->mmap_write = &mraa_gpio_mmap_write_rmw;
+    }
+    dev->mmap_read = &mraa_gpio_mmap_read;
+    dev->mmap_line = line;
+
+    return MRAA_SUCCESS;
+}
@@ -78,6 +78,20 @@ mraa_grovepi_aio_read_replace(mraa_aio_context dev)
     return mraa_grovepi_read_internal(GROVEPI_AIO_READ, dev->channel);
 }
 
+static mraa_result_t
+mraa_grovepi_aio_read_multi_replace(mraa_aio_context dev, int values[], unsigned int num_channels)
+{
+    // The firmware has no multi-channel command, a failed channel ends the sweep
+    unsigned int i = 0;
+    for (mraa_aio_context it = dev; it != NULL && i < num_channels; it = it->next) {
+        values[i] = mraa_grovepi_read_internal(GROVEPI_AIO_READ, it->channel);
+        if (values[i++] == -1) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
 static mraa_result_t
 mraa_grovepi_gpio_init_internal_replace(mraa_gpio_context dev, int pin)
 {
@@ -266,6 +280,7 @@ mraa_grovepi_platform(mraa_board_t* board, const int i2c_bus)
 
     b->adv_func->aio_init_internal_replace = &mraa_grovepi_aio_init_internal_replace;
     b->adv_func->aio_read_replace = &mraa_grovepi_aio_read_replace;
+    b->adv_func->aio_read_multi_replace = &mraa_grovepi_aio_read_multi_replace;
 
     b->adv_func->pwm_init_internal_replace = &mraa_grovepi_pwm_init_internal_replace;
     b->adv_func->pwm_write_replace = &mraa_grovepi_pwm_write_replace;
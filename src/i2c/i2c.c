@@ -9,7 +9,9 @@
  */
 
 #include "i2c.h"
+#include "async/bus_queue.h"
 #include "mraa_internal.h"
+#include "stats/io_stats.h"
 
 #include <stdlib.h>
 #include <unistd.h>
@@ -118,7 +120,7 @@ init_internal_cleanup:
 mraa_i2c_context
 mraa_i2c_init(int bus)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
     if (board == NULL) {
         syslog(LOG_ERR, "i2c%i_init: Platform Not Initialised", bus);
         return NULL;
@@ -173,7 +175,8 @@ mraa_i2c_init(int bus)
 mraa_i2c_context
 mraa_i2c_init_raw(unsigned int bus)
 {
-    return mraa_i2c_init_internal(plat == NULL ? NULL : plat->adv_func, bus);
+    mraa_board_t* board = mraa_resolve_platform();
+    return mraa_i2c_init_internal(board == NULL ? NULL : board->adv_func, bus);
 }
 
 
@@ -191,8 +194,8 @@ mraa_i2c_frequency(mraa_i2c_context dev, mraa_i2c_mode_t mode)
     return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
 }
 
-int
-mraa_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
+static int
+_mraa_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "i2c: read: context is invalid");
@@ -214,7 +217,18 @@ mraa_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
 }
 
 int
-mraa_i2c_read_byte(mraa_i2c_context dev)
+mraa_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_i2c_read(dev, data, length);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_I2C_READ, dev->busnum, start, length, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_i2c_read_byte(mraa_i2c_context dev)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "i2c: read_byte: context is invalid");
@@ -232,7 +246,18 @@ mraa_i2c_read_byte(mraa_i2c_context dev)
 }
 
 int
-mraa_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
+mraa_i2c_read_byte(mraa_i2c_context dev)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_i2c_read_byte(dev);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_I2C_READ, dev->busnum, start, 1, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "i2c: read_byte_data: context is invalid");
@@ -250,7 +275,18 @@ mraa_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
 }
 
 int
-mraa_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
+mraa_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_i2c_read_byte_data(dev, command);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_I2C_READ, dev->busnum, start, 1, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "i2c: read_word_data: context is invalid");
@@ -268,7 +304,18 @@ mraa_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
 }
 
 int
-mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, int length)
+mraa_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_i2c_read_word_data(dev, command);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_I2C_READ, dev->busnum, start, 2, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, int length)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "i2c: read_bytes_data: context is invalid");
@@ -302,6 +349,17 @@ mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, i
     return length;
 }
 
+int
+mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, int length)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_i2c_read_bytes_data(dev, command, data, length);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_I2C_READ, dev->busnum, start, length, ret >= 0);
+    }
+    return ret;
+}
+
 mraa_result_t
 mraa_i2c_write(mraa_i2c_context dev, const uint8_t* data, int length)
 {
@@ -391,6 +449,90 @@ mraa_i2c_write_word_data(mraa_i2c_context dev, const uint16_t data, const uint8_
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_i2c_transfer(mraa_i2c_context dev, mraa_i2c_msg_t* msgs, unsigned int num_msgs)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: transfer: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (msgs == NULL || num_msgs == 0 || num_msgs > MRAA_I2C_MAX_MSGS) {
+        syslog(LOG_ERR, "i2c%i: transfer: invalid number of messages %u", dev->busnum, num_msgs);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (msgs[0].flags & MRAA_I2C_MSG_NOSTART) {
+        syslog(LOG_ERR, "i2c%i: transfer: first message can't skip the start condition", dev->busnum);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (IS_FUNC_DEFINED(dev, i2c_transfer_replace))
+        return dev->advance_func->i2c_transfer_replace(dev, msgs, num_msgs);
+
+    struct i2c_rdwr_ioctl_data d;
+    struct i2c_msg m[num_msgs];
+
+    for (unsigned int i = 0; i < num_msgs; ++i) {
+        if ((msgs[i].flags & MRAA_I2C_MSG_NOSTART) && !(dev->funcs & I2C_FUNC_NOSTART)) {
+            syslog(LOG_ERR, "i2c%i: transfer: adapter does not support messages without start", dev->busnum);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        m[i].addr = msgs[i].addr;
+        m[i].flags = (msgs[i].flags & MRAA_I2C_MSG_READ) ? I2C_M_RD : 0x00;
+        if (msgs[i].flags & MRAA_I2C_MSG_NOSTART) {
+            m[i].flags |= I2C_M_NOSTART;
+        }
+        m[i].len = msgs[i].len;
+        m[i].buf = (char*) msgs[i].buf;
+    }
+
+    d.msgs = m;
+    d.nmsgs = num_msgs;
+
+    if (ioctl(dev->fh, I2C_RDWR, &d) < 0) {
+        syslog(LOG_ERR, "i2c%i: transfer: Access error: %s", dev->busnum, strerror(errno));
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_async_request_t
+mraa_i2c_transfer_async(mraa_i2c_context dev,
+                        const mraa_i2c_msg_t* msgs,
+                        unsigned int num_msgs,
+                        mraa_async_callback_t cb,
+                        void* args)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: transfer_async: context is invalid");
+        return NULL;
+    }
+
+    if (msgs == NULL || num_msgs == 0 || num_msgs > MRAA_I2C_MAX_MSGS) {
+        syslog(LOG_ERR, "i2c%i: transfer_async: invalid number of messages %u", dev->busnum, num_msgs);
+        return NULL;
+    }
+
+    if (msgs[0].flags & MRAA_I2C_MSG_NOSTART) {
+        syslog(LOG_ERR, "i2c%i: transfer_async: first message can't skip the start condition", dev->busnum);
+        return NULL;
+    }
+
+    return mraa_async_submit(MRAA_ASYNC_I2C, dev->busnum, dev, msgs, num_msgs, cb, args);
+}
+
+int
+mraa_i2c_async_fd(mraa_i2c_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: async_fd: context is invalid");
+        return -1;
+    }
+
+    return mraa_async_fd(MRAA_ASYNC_I2C, dev->busnum);
+}
+
 mraa_result_t
 mraa_i2c_address(mraa_i2c_context dev, uint8_t addr)
 {
@@ -420,6 +562,9 @@ mraa_i2c_stop(mraa_i2c_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    mraa_async_flush(dev);
+    mraa_stats_release(&dev->stats);
+
     if (IS_FUNC_DEFINED(dev, i2c_stop_replace)) {
         return dev->advance_func->i2c_stop_replace(dev);
     }
@@ -6,6 +6,8 @@
  */
 
 #include "iio.h"
+#include "iio/iio_attr.h"
+#include "iio/iio_capture.h"
 #include "mraa_internal.h"
 #include "dirent.h"
 #include <string.h>
@@ -27,7 +29,9 @@
 mraa_iio_context
 mraa_iio_init(int device)
 {
-    if (plat_iio->iio_device_count == 0 || device >= plat_iio->iio_device_count) {
+    // devices are scanned on the first use of iio
+    mraa_iio_detect();
+    if (plat_iio == NULL || plat_iio->iio_device_count == 0 || device < 0 || device >= plat_iio->iio_device_count) {
         return NULL;
     }
 
@@ -55,6 +59,31 @@ mraa_iio_get_channel_count(mraa_iio_context dev)
     return dev->chan_num;
 }
 
+static void
+mraa_iio_free_channels(mraa_iio_context dev)
+{
+    int i;
+
+    if (dev->scan_elements != NULL) {
+        for (i = 0; i < dev->chan_num; i++) {
+            free(dev->scan_elements[i]);
+        }
+    }
+    free(dev->scan_elements);
+    free(dev->channels);
+    dev->scan_elements = NULL;
+    dev->channels = NULL;
+}
+
+/* Read a small scan_elements attribute of a channel, e.g. "index". */
+static mraa_result_t
+mraa_iio_read_scan_element(mraa_iio_context dev, int chan, const char* suffix, char* data, int max_len)
+{
+    char name[MAX_SIZE];
+    snprintf(name, MAX_SIZE, IIO_SCAN_ELEM "/%s%s", dev->scan_elements[chan], suffix);
+    return mraa_iio_read_string(dev, name, data, max_len);
+}
+
 mraa_result_t
 mraa_iio_get_channel_data(mraa_iio_context dev)
 {
@@ -63,117 +92,142 @@ mraa_iio_get_channel_data(mraa_iio_context dev)
     int chan_num = 0;
     char buf[MAX_SIZE];
     char readbuf[32];
-    int fd;
     int ret = 0;
     int padint = 0;
-    int curr_bytes = 0;
     char shortbuf, signchar;
-    int i = 0;
+    int i;
 
     dev->datasize = 0;
 
     memset(buf, 0, MAX_SIZE);
     snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/" IIO_SCAN_ELEM, dev->num);
     dir = opendir(buf);
-    if (dir != NULL) {
-        while ((ent = readdir(dir)) != NULL) {
-            if (strcmp(ent->d_name + strlen(ent->d_name) - strlen("_en"), "_en") == 0) {
-                chan_num++;
+    if (dir == NULL) {
+        dev->chan_num = 0;
+        return MRAA_SUCCESS;
+    }
+    // every channel has an _index attribute, remember the names in a single
+    // pass and use them as the channel prefixes from now on
+    char** names = NULL;
+    while ((ent = readdir(dir)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len > strlen("index") && strcmp(ent->d_name + len - strlen("index"), "index") == 0) {
+            char** grown = realloc(names, (chan_num + 1) * sizeof(char*));
+            if (grown == NULL) {
+                break;
             }
+            names = grown;
+            names[chan_num++] = strndup(ent->d_name, len - strlen("index"));
         }
     }
+    closedir(dir);
+
+    mraa_iio_free_channels(dev);
     dev->chan_num = chan_num;
     // no need proceed if no channel found
     if (chan_num == 0) {
-        closedir(dir);
+        free(names);
         return MRAA_SUCCESS;
     }
-    mraa_iio_channel* chan;
     dev->channels = calloc(chan_num, sizeof(mraa_iio_channel));
-    seekdir(dir, 0);
-    while ((ent = readdir(dir)) != NULL) {
-        if (strcmp(ent->d_name + strlen(ent->d_name) - strlen("_index"), "_index") == 0) {
-            snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/" IIO_SCAN_ELEM "/%s", dev->num, ent->d_name);
-            fd = open(buf, O_RDONLY);
-            if (fd != -1) {
-                if (read(fd, readbuf, 2 * sizeof(char)) != 2) {
-                    close(fd);
-                    break;
-                }
-                chan_num = ((int) strtol(readbuf, NULL, 10));
-                chan = &dev->channels[chan_num];
-                chan->index = chan_num;
-                close(fd);
-
-                buf[(strlen(buf) - 5)] = '\0';
-                char* str = strdup(buf);
-                // grab the type of the buffer
-                snprintf(buf, MAX_SIZE, "%stype", str);
-                fd = open(buf, O_RDONLY);
-                if (fd != -1) {
-                    read(fd, readbuf, 31 * sizeof(char));
-                    ret = sscanf(readbuf, "%ce:%c%u/%u>>%u", &shortbuf, &signchar, &chan->bits_used,
-                                 &padint, &chan->shift);
-                    // probably should be 5?
-                    if (ret < 0) {
-                        // cleanup
-                        free(str);
-                        close(fd);
-                        return MRAA_IO_SETUP_FAILURE;
-                    }
-                    chan->bytes = padint / 8;
-                    chan->signedd = (signchar == 's');
-                    chan->lendian = (shortbuf == 'l');
-                    if (chan->bits_used == 64) {
-                        chan->mask = ~0;
-                    } else {
-                        chan->mask = (1 << chan->bits_used) - 1;
-                    }
-                    close(fd);
-                }
-                // grab the enable flag of channel
-                snprintf(buf, MAX_SIZE, "%sen", str);
-                fd = open(buf, O_RDONLY);
-                if (fd != -1) {
-                    if (read(fd, readbuf, 2 * sizeof(char)) != 2) {
-                        syslog(LOG_ERR, "iio: Failed to read a sensible value from sysfs");
-                        free(str);
-                        close(fd);
-                        return -1;
-                    }
-                    chan->enabled = (int) strtol(readbuf, NULL, 10);
-                    // only calculate enable buffer size for trigger buffer extract data
-                    if (chan->enabled) {
-                        dev->datasize += chan->bytes;
-                    }
-                    close(fd);
-                }
-                // clean up str var
-                free(str);
+    dev->scan_elements = calloc(chan_num, sizeof(char*));
+    if (dev->channels == NULL || dev->scan_elements == NULL) {
+        for (i = 0; i < chan_num; i++) {
+            free(names[i]);
+        }
+        free(names);
+        mraa_iio_free_channels(dev);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    // channels are stored by scan index
+    for (i = 0; i < chan_num; i++) {
+        char index[16] = { 0 };
+        char* prefix = names[i];
+        snprintf(buf, MAX_SIZE, IIO_SCAN_ELEM "/%sindex", prefix);
+        int idx = -1;
+        if (mraa_iio_read_string(dev, buf, index, sizeof(index) - 1) == MRAA_SUCCESS) {
+            idx = (int) strtol(index, NULL, 10);
+        }
+        if (idx < 0 || idx >= chan_num || dev->scan_elements[idx] != NULL) {
+            syslog(LOG_ERR, "iio: Ignoring scan element %s with index %d", prefix, idx);
+            free(prefix);
+            continue;
+        }
+        dev->scan_elements[idx] = prefix;
+    }
+    free(names);
+
+    for (i = 0; i < chan_num; i++) {
+        mraa_iio_channel* chan = &dev->channels[i];
+        chan->index = i;
+        if (dev->scan_elements[i] == NULL) {
+            continue;
+        }
+        // grab the type of the buffer
+        memset(readbuf, 0, sizeof(readbuf));
+        if (mraa_iio_read_scan_element(dev, i, "type", readbuf, sizeof(readbuf) - 1) == MRAA_SUCCESS) {
+            ret = sscanf(readbuf, "%ce:%c%u/%u>>%u", &shortbuf, &signchar, &chan->bits_used,
+                         &padint, &chan->shift);
+            // probably should be 5?
+            if (ret < 0) {
+                return MRAA_IO_SETUP_FAILURE;
+            }
+            chan->bytes = padint / 8;
+            chan->signedd = (signchar == 's');
+            chan->lendian = (shortbuf == 'l');
+            if (chan->bits_used == 64) {
+                chan->mask = ~0;
+            } else {
+                chan->mask = ((uint64_t) 1 << chan->bits_used) - 1;
             }
         }
+        // grab the enable flag of channel
+        memset(readbuf, 0, sizeof(readbuf));
+        if (mraa_iio_read_scan_element(dev, i, "en", readbuf, sizeof(readbuf) - 1) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "iio: Failed to read a sensible value from sysfs");
+            return -1;
+        }
+        chan->enabled = (int) strtol(readbuf, NULL, 10);
     }
-    closedir(dir);
 
     // channel location has to be done in channel index order so do it after we
     // have grabbed all the correct info
+    return mraa_iio_update_scan_layout(dev);
+}
+
+mraa_result_t
+mraa_iio_update_scan_layout(mraa_iio_context dev)
+{
+    unsigned int curr_bytes = 0;
+    unsigned int max_bytes = 1;
+    int i;
+
     for (i = 0; i < dev->chan_num; i++) {
-        chan = &dev->channels[i];
+        mraa_iio_channel* chan = &dev->channels[i];
 
-        if(chan->bytes <= 0)
-        {
-            syslog(LOG_ERR, "iio: Channel %d with channel bytes value <= 0");
+        // index without a scan element, already reported
+        if (dev->scan_elements != NULL && dev->scan_elements[i] == NULL) {
+            continue;
+        }
+        if (chan->bytes <= 0) {
+            syslog(LOG_ERR, "iio: Channel %d with channel bytes value <= 0", i);
             return MRAA_IO_SETUP_FAILURE;
         }
 
-        if (curr_bytes % chan->bytes == 0) {
-            chan->location = curr_bytes;
-        } else {
-            chan->location = curr_bytes - curr_bytes % chan->bytes + chan->bytes;
+        // each element is naturally aligned, disabled channels take no room
+        chan->location = (curr_bytes + chan->bytes - 1) / chan->bytes * chan->bytes;
+        if (chan->enabled) {
+            curr_bytes = chan->location + chan->bytes;
+            if (chan->bytes > max_bytes) {
+                max_bytes = chan->bytes;
+            }
         }
-        curr_bytes = chan->location + chan->bytes;
     }
 
+    // scans are padded to the alignment of their largest element
+    dev->datasize = (curr_bytes + max_bytes - 1) / max_bytes * max_bytes;
+
     return MRAA_SUCCESS;
 }
 
@@ -188,6 +242,7 @@ mraa_iio_get_device_num_by_name(const char* name)
 {
     int i;
 
+    mraa_iio_detect();
     if (plat_iio == NULL) {
         syslog(LOG_ERR, "iio: platform IIO structure is not initialized");
         return -1;
@@ -213,40 +268,34 @@ mraa_iio_get_device_num_by_name(const char* name)
 mraa_result_t
 mraa_iio_read_float(mraa_iio_context dev, const char* attr_name, float* data)
 {
-    char buf[MAX_SIZE];
-    mraa_result_t result = mraa_iio_read_string(dev, attr_name, buf, MAX_SIZE-1);
-    if (result != MRAA_SUCCESS)
-        return result;
-    int status = sscanf(buf, "%f", data);
-    result = status == 1 ? MRAA_SUCCESS : MRAA_ERROR_UNSPECIFIED;
-    return result;
+    mraa_iio_attr attr = mraa_iio_attr_prepare(dev, attr_name);
+    if (attr == NULL)
+        return MRAA_ERROR_UNSPECIFIED;
+    return mraa_iio_attr_read_float(attr, data);
 }
 
 
 mraa_result_t
 mraa_iio_read_int(mraa_iio_context dev, const char* attr_name, int* data)
 {
-    char buf[MAX_SIZE];
-    mraa_result_t result = mraa_iio_read_string(dev, attr_name, buf, MAX_SIZE-1);
-    if (result != MRAA_SUCCESS)
-        return result;
-    int status = sscanf(buf, "%d", data);
-    result = status == 1 ? MRAA_SUCCESS : MRAA_ERROR_UNSPECIFIED;
-    return result;
+    mraa_iio_attr attr = mraa_iio_attr_prepare(dev, attr_name);
+    if (attr == NULL)
+        return MRAA_ERROR_UNSPECIFIED;
+    return mraa_iio_attr_read_int(attr, data);
 }
 
 mraa_result_t
 mraa_iio_read_string(mraa_iio_context dev, const char* attr_name, char* data, int max_len)
 {
-    char buf[MAX_SIZE];
     mraa_result_t result = MRAA_ERROR_UNSPECIFIED;
-    snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/%s", dev->num, attr_name);
-    int fd = open(buf, O_RDONLY);
-    if (fd != -1) {
-        ssize_t len = read(fd, data, max_len);
-        if (len > 0)
+    mraa_iio_attr attr = mraa_iio_attr_prepare(dev, attr_name);
+    if (attr != NULL) {
+        int len = mraa_iio_attr_read(attr, data, max_len);
+        if (len > 0) {
+            if (len < max_len)
+                data[len] = '\0';
             result = MRAA_SUCCESS;
-        close(fd);
+        }
     }
     return result;
 
@@ -271,22 +320,18 @@ mraa_iio_write_int(mraa_iio_context dev, const char* attr_name, const int data)
 mraa_result_t
 mraa_iio_write_string(mraa_iio_context dev, const char* attr_name, const char* data)
 {
-    char buf[MAX_SIZE];
     mraa_result_t result = MRAA_ERROR_UNSPECIFIED;
-    snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/%s", dev->num, attr_name);
-    int fd = open(buf, O_WRONLY);
-    if (fd != -1) {
+    mraa_iio_attr attr = mraa_iio_attr_prepare(dev, attr_name);
+    if (attr != NULL) {
         int len = strlen(data);
-        ssize_t status = write(fd, data, len);
-        if (status == len)
+        if (mraa_iio_attr_write(attr, data, len) == len)
              result = MRAA_SUCCESS;
-        close(fd);
     }
     return result;
 }
 
 static mraa_result_t
-mraa_iio_wait_event(int fd, char* data, int* read_size)
+mraa_iio_wait_event(int fd, char* data, int size, int* read_size)
 {
     struct pollfd pfd;
 
@@ -301,8 +346,8 @@ mraa_iio_wait_event(int fd, char* data, int* read_size)
     // poll is a cancelable point like sleep()
     poll(&pfd, 1, -1);
 
-    memset(data, 0, 100);
-    *read_size = read(fd, data, 100);
+    memset(data, 0, size);
+    *read_size = read(fd, data, size);
 
     return MRAA_SUCCESS;
 }
@@ -315,14 +360,20 @@ mraa_iio_trigger_handler(void* arg)
     char data[MAX_SIZE * 100];
     int read_size;
 
+    if (dev->datasize <= 0 || dev->datasize > (int) sizeof(data)) {
+        return NULL;
+    }
+    // drain as many whole scans as fit at once
+    int size = sizeof(data) - sizeof(data) % dev->datasize;
+
     for (;;) {
-        if (mraa_iio_wait_event(dev->fp, &data[0], &read_size) == MRAA_SUCCESS) {
+        if (mraa_iio_wait_event(dev->fp, &data[0], size, &read_size) == MRAA_SUCCESS) {
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
 #endif
             // only can process if readsize >= enabled channel's datasize
             for (i = 0; i < (read_size / dev->datasize); i++) {
-                dev->isr((char*)&data, (void*)dev->isr_args);
+                dev->isr(&data[i * dev->datasize], (void*)dev->isr_args);
             }
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
@@ -341,7 +392,7 @@ mraa_result_t
 mraa_iio_trigger_buffer(mraa_iio_context dev, void (*fptr)(char*, void*), void* args)
 {
     char bu[MAX_SIZE];
-    if (dev->thread_id != 0) {
+    if (dev->thread_id != 0 || dev->capture != NULL) {
         return MRAA_ERROR_NO_RESOURCES;
     }
 
@@ -577,73 +628,34 @@ mraa_iio_create_trigger(mraa_iio_context dev, const char* trigger)
 mraa_result_t
 mraa_iio_update_channels(mraa_iio_context dev)
 {
-    const struct dirent* ent;
-    DIR* dir;
-    int chan_num = 0;
-    char buf[MAX_SIZE];
     char readbuf[32];
-    int fd;
-    mraa_iio_channel* chan;
+    int i;
 
-    dev->datasize = 0;
-    memset(buf, 0, MAX_SIZE);
-    snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/" IIO_SCAN_ELEM, dev->num);
-    dir = opendir(buf);
-    if (dir != NULL) {
-        while ((ent = readdir(dir)) != NULL) {
-            if (strcmp(ent->d_name + strlen(ent->d_name) - strlen("_index"), "_index") == 0) {
-                snprintf(buf, MAX_SIZE, IIO_SYSFS_DEVICE "%d/" IIO_SCAN_ELEM "/%s", dev->num, ent->d_name);
-                fd = open(buf, O_RDONLY);
-                if (fd != -1) {
-                    if (read(fd, readbuf, 2 * sizeof(char)) != 2) {
-                        close(fd);
-                        break;
-                    }
-                    chan_num = ((int) strtol(readbuf, NULL, 10));
-                    if (chan_num >= 0 && chan_num < dev->chan_num) {
-                        chan = &dev->channels[chan_num];
-                        chan->index = chan_num;
-                        close(fd);
+    if (dev->scan_elements == NULL) {
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
 
-                        buf[(strlen(buf) - 5)] = '\0';
-                        char* str = strdup(buf);
-                        // grab the enable flag of channel
-                        snprintf(buf, MAX_SIZE, "%sen", str);
-                        fd = open(buf, O_RDONLY);
-                        if (fd != -1) {
-                            if (read(fd, readbuf, 2 * sizeof(char)) != 2) {
-                                syslog(LOG_ERR, "iio: Failed to read a sensible value from sysfs");
-                                free(str);
-                                close(fd);
-                                closedir(dir);
-                                return -1;
-                            }
-                            chan->enabled = (int) strtol(readbuf, NULL, 10);
-                            // only calculate enable buffer size for trigger buffer extract data
-                            if (chan->enabled) {
-                                dev->datasize += chan->bytes;
-                            }
-                            close(fd);
-                        }
-                        // clean up str var
-                        free(str);
-                    }
-                    else {
-                        close(fd);
-                    }
-                }
-            }
+    // the enable flags are read through the cached attribute handles
+    for (i = 0; i < dev->chan_num; i++) {
+        if (dev->scan_elements[i] == NULL) {
+            continue;
         }
-        closedir(dir);
-        return MRAA_SUCCESS;
+        memset(readbuf, 0, sizeof(readbuf));
+        if (mraa_iio_read_scan_element(dev, i, "en", readbuf, sizeof(readbuf) - 1) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "iio: Failed to read a sensible value from sysfs");
+            return -1;
+        }
+        dev->channels[i].enabled = (int) strtol(readbuf, NULL, 10);
     }
 
-    return MRAA_ERROR_INVALID_HANDLE;
+    return mraa_iio_update_scan_layout(dev);
 }
 
 mraa_result_t
 mraa_iio_close(mraa_iio_context dev)
 {
-    free(dev->channels);
+    mraa_iio_capture_release(dev);
+    mraa_iio_free_channels(dev);
+    mraa_iio_attr_release_all(dev);
     return MRAA_SUCCESS;
 }
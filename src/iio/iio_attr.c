@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "iio/iio_attr.h"
+#include "iio.h"
+#include "mraa_internal.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_SIZE 128
+#define IIO_SYSFS_DEVICE "/sys/bus/iio/devices/iio:device"
+
+struct _iio_attr {
+    struct _iio_attr* next;
+    mraa_iio_context dev;
+    char* name;
+    int rfd; /**< opened on first read, -1 before */
+    int wfd; /**< opened on first write, -1 before */
+    mraa_boolean_t scale_known; /**< scale and offset were looked up */
+    double scale;
+    double offset; /**< offset attribute multiplied by scale */
+};
+
+/* Guards the handle lists of all devices and the lazy opens. */
+static pthread_mutex_t mraa_iio_attr_lock = PTHREAD_MUTEX_INITIALIZER;
+static const char* mraa_iio_attr_root = IIO_SYSFS_DEVICE;
+
+static int
+mraa_iio_attr_open_path(mraa_iio_context dev, const char* attr_name, int flags)
+{
+    char path[MAX_SIZE];
+    snprintf(path, MAX_SIZE, "%s%d/%s", mraa_iio_attr_root, dev->num, attr_name);
+    return open(path, flags | O_CLOEXEC);
+}
+
+mraa_iio_attr
+mraa_iio_attr_prepare(mraa_iio_context dev, const char* attr_name)
+{
+    if (dev == NULL || attr_name == NULL) {
+        syslog(LOG_ERR, "iio: attr_prepare: context or attribute name invalid");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&mraa_iio_attr_lock);
+    struct _iio_attr* attr = dev->attrs;
+    while (attr != NULL && strcmp(attr->name, attr_name) != 0) {
+        attr = attr->next;
+    }
+    if (attr == NULL) {
+        // Write only attributes cannot be opened for reading, those get
+        // their descriptor on first write
+        int rfd = mraa_iio_attr_open_path(dev, attr_name, O_RDONLY);
+        int wfd = -1;
+        if (rfd == -1 && errno != ENOENT) {
+            wfd = mraa_iio_attr_open_path(dev, attr_name, O_WRONLY);
+        }
+        if (rfd != -1 || wfd != -1) {
+            attr = calloc(1, sizeof(struct _iio_attr));
+            if (attr != NULL) {
+                attr->name = strdup(attr_name);
+            }
+            if (attr == NULL || attr->name == NULL) {
+                free(attr);
+                attr = NULL;
+                if (rfd != -1) {
+                    close(rfd);
+                }
+                if (wfd != -1) {
+                    close(wfd);
+                }
+            } else {
+                attr->dev = dev;
+                attr->rfd = rfd;
+                attr->wfd = wfd;
+                attr->next = dev->attrs;
+                dev->attrs = attr;
+            }
+        }
+    }
+    pthread_mutex_unlock(&mraa_iio_attr_lock);
+
+    return attr;
+}
+
+static int
+mraa_iio_attr_fd(mraa_iio_attr attr, mraa_boolean_t write)
+{
+    int* slot = write ? &attr->wfd : &attr->rfd;
+    int fd = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+
+    if (fd == -1) {
+        pthread_mutex_lock(&mraa_iio_attr_lock);
+        fd = *slot;
+        if (fd == -1) {
+            fd = mraa_iio_attr_open_path(attr->dev, attr->name, write ? O_WRONLY : O_RDONLY);
+            __atomic_store_n(slot, fd, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&mraa_iio_attr_lock);
+    }
+    return fd;
+}
+
+int
+mraa_iio_attr_read(mraa_iio_attr attr, char* data, int max_len)
+{
+    if (attr == NULL || data == NULL || max_len <= 0) {
+        syslog(LOG_ERR, "iio: attr_read: handle or buffer invalid");
+        return -1;
+    }
+
+    int fd = mraa_iio_attr_fd(attr, 0);
+    if (fd == -1) {
+        return -1;
+    }
+    // sysfs regenerates the content for every read at offset 0
+    return pread(fd, data, max_len, 0);
+}
+
+int
+mraa_iio_attr_write(mraa_iio_attr attr, const char* data, int len)
+{
+    if (attr == NULL || data == NULL || len < 0) {
+        syslog(LOG_ERR, "iio: attr_write: handle or data invalid");
+        return -1;
+    }
+
+    int fd = mraa_iio_attr_fd(attr, 1);
+    if (fd == -1) {
+        return -1;
+    }
+    return pwrite(fd, data, len, 0);
+}
+
+/* Read a numeric attribute into a terminated buffer. */
+static mraa_result_t
+mraa_iio_attr_read_text(mraa_iio_attr attr, char* buf, int size)
+{
+    int len = mraa_iio_attr_read(attr, buf, size - 1);
+    if (len <= 0) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    buf[len] = '\0';
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_iio_attr_read_int(mraa_iio_attr attr, int* data)
+{
+    char buf[32];
+    char* end;
+
+    if (data == NULL || mraa_iio_attr_read_text(attr, buf, sizeof(buf)) != MRAA_SUCCESS) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    long value = strtol(buf, &end, 10);
+    if (end == buf) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    *data = (int) value;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_iio_attr_read_float(mraa_iio_attr attr, float* data)
+{
+    char buf[MAX_SIZE];
+    char* end;
+
+    if (data == NULL || mraa_iio_attr_read_text(attr, buf, sizeof(buf)) != MRAA_SUCCESS) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    float value = strtof(buf, &end);
+    if (end == buf) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    *data = value;
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Read the _scale or _offset info of a channel, e.g. in_accel_x_scale, or of
+ * its type when it is shared, e.g. in_accel_scale or in_voltage_scale.
+ */
+static mraa_result_t
+mraa_iio_attr_read_info(mraa_iio_context dev, const char* channel, size_t len, const char* info, double* value)
+{
+    char name[MAX_SIZE];
+    char buf[MAX_SIZE];
+    char* end;
+
+    for (int shared = 0; shared < 2; ++shared) {
+        size_t prefix = len;
+        if (shared) {
+            // in_voltage0 -> in_voltage, in_accel_x -> in_accel
+            while (prefix > 0 && isdigit((unsigned char) channel[prefix - 1])) {
+                prefix--;
+            }
+            if (prefix == len) {
+                while (prefix > 0 && channel[prefix - 1] != '_') {
+                    prefix--;
+                }
+                if (prefix > 0) {
+                    prefix--;
+                }
+            }
+            if (prefix == 0) {
+                break;
+            }
+        }
+        snprintf(name, MAX_SIZE, "%.*s_%s", (int) prefix, channel, info);
+        mraa_iio_attr attr = mraa_iio_attr_prepare(dev, name);
+        if (attr != NULL && mraa_iio_attr_read_text(attr, buf, sizeof(buf)) == MRAA_SUCCESS) {
+            double parsed = strtod(buf, &end);
+            if (end != buf) {
+                *value = parsed;
+                return MRAA_SUCCESS;
+            }
+        }
+    }
+    return MRAA_ERROR_UNSPECIFIED;
+}
+
+mraa_result_t
+mraa_iio_attr_update_scale(mraa_iio_attr attr)
+{
+    if (attr == NULL) {
+        syslog(LOG_ERR, "iio: attr_update_scale: handle invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    size_t len = strlen(attr->name);
+    double scale = 1.0;
+    double offset = 0.0;
+
+    if (len > strlen("_raw") && strcmp(attr->name + len - strlen("_raw"), "_raw") == 0) {
+        len -= strlen("_raw");
+        // both are optional, a missing scale means the raw value is in SI units
+        mraa_iio_attr_read_info(attr->dev, attr->name, len, "scale", &scale);
+        mraa_iio_attr_read_info(attr->dev, attr->name, len, "offset", &offset);
+    }
+
+    pthread_mutex_lock(&mraa_iio_attr_lock);
+    attr->scale = scale;
+    attr->offset = offset * scale;
+    __atomic_store_n(&attr->scale_known, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&mraa_iio_attr_lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_iio_attr_read_scaled(mraa_iio_attr attr, double* data)
+{
+    char buf[32];
+    char* end;
+
+    if (attr == NULL || data == NULL) {
+        syslog(LOG_ERR, "iio: attr_read_scaled: handle or data invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!__atomic_load_n(&attr->scale_known, __ATOMIC_ACQUIRE)) {
+        mraa_iio_attr_update_scale(attr);
+    }
+
+    if (mraa_iio_attr_read_text(attr, buf, sizeof(buf)) != MRAA_SUCCESS) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    long long raw = strtoll(buf, &end, 10);
+    if (end == buf) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    *data = raw * attr->scale + attr->offset;
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_iio_attr_release_all(mraa_iio_context dev)
+{
+    pthread_mutex_lock(&mraa_iio_attr_lock);
+    struct _iio_attr* attr = dev->attrs;
+    dev->attrs = NULL;
+    pthread_mutex_unlock(&mraa_iio_attr_lock);
+
+    while (attr != NULL) {
+        struct _iio_attr* next = attr->next;
+        if (attr->rfd != -1) {
+            close(attr->rfd);
+        }
+        if (attr->wfd != -1) {
+            close(attr->wfd);
+        }
+        free(attr->name);
+        free(attr);
+        attr = next;
+    }
+}
+
+void
+mraa_iio_attr_set_root(const char* prefix)
+{
+    pthread_mutex_lock(&mraa_iio_attr_lock);
+    mraa_iio_attr_root = prefix != NULL ? prefix : IIO_SYSFS_DEVICE;
+    pthread_mutex_unlock(&mraa_iio_attr_lock);
+}
@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "iio/iio_capture.h"
+#include "iio.h"
+#include "mraa_internal.h"
+
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_SIZE 128
+#define IIO_SLASH_DEV "/dev/iio:device"
+
+struct _iio_capture {
+    pthread_t thread;
+    int fd;      /**< buffered scans */
+    int wake_fd; /**< eventfd used to stop the drain thread */
+    mraa_boolean_t enabled_buffer; /**< buffer/enable was set by the capture */
+    unsigned int scan_size;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t* ring; /**< raw scans, written by read() in place */
+    size_t ring_size; /**< mapped size in bytes */
+    unsigned int capacity; /**< in scans */
+    unsigned int head; /**< index of the oldest scan */
+    unsigned int count;
+    uint8_t* spill; /**< scans read while the ring is full */
+    mraa_boolean_t ended; /**< the drain thread stopped on its own */
+    mraa_iio_capture_stats_t stats;
+};
+
+/*
+ * Extract count values of one channel, the storage type is a parameter so
+ * that the load, shift, mask and sign extension form a tight loop per case.
+ */
+#define IIO_DEMUX_LOOP(type, to_host, out_type)                                          \
+    for (unsigned int s = 0; s < num_scans; ++s, p += scan_size) {                        \
+        type raw;                                                                        \
+        memcpy(&raw, p, sizeof(raw));                                                    \
+        uint64_t value = ((uint64_t) to_host(raw) >> shift) & mask;                      \
+        ((out_type*) out)[s] = (out_type) (int64_t) ((value ^ sign_bit) - sign_bit);     \
+    }
+
+#define IIO_NOSWAP(x) (x)
+
+void
+mraa_iio_demux(const uint8_t* scans, unsigned int num_scans, unsigned int scan_size, const mraa_iio_channel* chan, void* out)
+{
+    const uint8_t* p = scans + chan->location;
+    unsigned int shift = chan->shift;
+    uint64_t mask = chan->bits_used >= 64 ? ~0ULL : (1ULL << chan->bits_used) - 1;
+    // Flipping and subtracting the sign bit sign extends without a branch
+    uint64_t sign_bit = (chan->signedd && chan->bits_used > 0) ? 1ULL << (chan->bits_used - 1) : 0;
+
+    switch (chan->bytes) {
+        case 1:
+            IIO_DEMUX_LOOP(uint8_t, IIO_NOSWAP, int32_t)
+            break;
+        case 2:
+            if (chan->lendian) {
+                IIO_DEMUX_LOOP(uint16_t, le16toh, int32_t)
+            } else {
+                IIO_DEMUX_LOOP(uint16_t, be16toh, int32_t)
+            }
+            break;
+        case 4:
+            if (chan->lendian) {
+                IIO_DEMUX_LOOP(uint32_t, le32toh, int32_t)
+            } else {
+                IIO_DEMUX_LOOP(uint32_t, be32toh, int32_t)
+            }
+            break;
+        case 8:
+            if (chan->lendian) {
+                IIO_DEMUX_LOOP(uint64_t, le64toh, int64_t)
+            } else {
+                IIO_DEMUX_LOOP(uint64_t, be64toh, int64_t)
+            }
+            break;
+        default:
+            // The kernel only uses power of two storage sizes
+            memset(out, 0, num_scans * sizeof(int32_t));
+            break;
+    }
+}
+
+static void*
+mraa_iio_capture_drain(void* arg)
+{
+    struct _iio_capture* capture = (struct _iio_capture*) arg;
+    struct pollfd pfd[2];
+
+    pfd[0].fd = capture->fd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = capture->wake_fd;
+    pfd[1].events = POLLIN;
+
+    for (;;) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "iio: capture: poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (pfd[1].revents & POLLIN) {
+            break;
+        }
+        if (!(pfd[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            continue;
+        }
+
+        // Only the reader frees slots, so the free space can only grow
+        // while the read below fills it without holding the lock
+        pthread_mutex_lock(&capture->lock);
+        unsigned int tail = (capture->head + capture->count) % capture->capacity;
+        unsigned int room = capture->capacity - capture->count;
+        pthread_mutex_unlock(&capture->lock);
+
+        uint8_t* dst = capture->spill;
+        if (room > 0) {
+            if (room > capture->capacity - tail) {
+                room = capture->capacity - tail;
+            }
+            dst = capture->ring + (size_t) tail * capture->scan_size;
+        } else {
+            room = MRAA_IIO_CAPTURE_READ_BATCH;
+        }
+
+        ssize_t len = read(capture->fd, dst, (size_t) room * capture->scan_size);
+        if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+            continue;
+        }
+        if (len <= 0) {
+            if (len < 0) {
+                syslog(LOG_ERR, "iio: capture: read failed: %s", strerror(errno));
+            }
+            break;
+        }
+
+        // The kernel rounds reads down to whole scans
+        unsigned int num_scans = len / capture->scan_size;
+
+        pthread_mutex_lock(&capture->lock);
+        capture->stats.scans += num_scans;
+        if (dst == capture->spill) {
+            capture->stats.overflows += num_scans;
+        } else {
+            capture->count += num_scans;
+            if (capture->count > capture->stats.max_fill) {
+                capture->stats.max_fill = capture->count;
+            }
+        }
+        pthread_cond_broadcast(&capture->cond);
+        pthread_mutex_unlock(&capture->lock);
+    }
+
+    pthread_mutex_lock(&capture->lock);
+    capture->ended = 1;
+    pthread_cond_broadcast(&capture->cond);
+    pthread_mutex_unlock(&capture->lock);
+
+    return NULL;
+}
+
+static void
+mraa_iio_capture_free(mraa_iio_context dev, struct _iio_capture* capture)
+{
+    if (capture->fd >= 0) {
+        close(capture->fd);
+    }
+    if (capture->enabled_buffer) {
+        mraa_iio_write_int(dev, "buffer/enable", 0);
+    }
+    if (capture->wake_fd >= 0) {
+        close(capture->wake_fd);
+    }
+    if (capture->ring != NULL) {
+        munmap(capture->ring, capture->ring_size);
+    }
+    free(capture->spill);
+    pthread_cond_destroy(&capture->cond);
+    pthread_mutex_destroy(&capture->lock);
+    free(capture);
+}
+
+/* Set the kernel buffer up unless someone already enabled it. */
+static mraa_result_t
+mraa_iio_capture_enable_buffer(mraa_iio_context dev, struct _iio_capture* capture)
+{
+    int enabled = 0;
+
+    if (mraa_iio_read_int(dev, "buffer/enable", &enabled) == MRAA_SUCCESS && enabled) {
+        return MRAA_SUCCESS;
+    }
+
+    // Keep the kernel buffer as deep as the ring and wake up for a batch of
+    // scans at a time, older kernels have no watermark
+    unsigned int watermark = capture->capacity / 2;
+    if (watermark > MRAA_IIO_CAPTURE_READ_BATCH) {
+        watermark = MRAA_IIO_CAPTURE_READ_BATCH;
+    }
+    if (mraa_iio_write_int(dev, "buffer/length", capture->capacity) != MRAA_SUCCESS) {
+        syslog(LOG_NOTICE, "iio: capture: keeping the current buffer length");
+    }
+    if (watermark > 1) {
+        mraa_iio_write_int(dev, "buffer/watermark", watermark);
+    }
+
+    if (mraa_iio_write_int(dev, "buffer/enable", 1) != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "iio: capture: failed to enable the buffer of iio:device%d, is a trigger set?", dev->num);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    capture->enabled_buffer = 1;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_iio_capture_start(mraa_iio_context dev, unsigned int ring_scans)
+{
+    char path[MAX_SIZE];
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "iio: capture_start: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (ring_scans == 0) {
+        syslog(LOG_ERR, "iio: capture_start: invalid ring size");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->capture != NULL || dev->thread_id != 0) {
+        syslog(LOG_ERR, "iio: capture_start: iio:device%d is already read by another thread", dev->num);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    // Pick up the scan elements enabled since the context was initialised
+    if (mraa_iio_update_channels(dev) != MRAA_SUCCESS) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    if (dev->datasize <= 0) {
+        syslog(LOG_ERR, "iio: capture_start: no scan element enabled on iio:device%d", dev->num);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct _iio_capture* capture = calloc(1, sizeof(struct _iio_capture));
+    if (capture == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    pthread_mutex_init(&capture->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&capture->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    capture->fd = -1;
+    capture->capacity = ring_scans;
+    capture->scan_size = dev->datasize;
+    capture->wake_fd = eventfd(0, EFD_CLOEXEC);
+
+    // Populate the ring up front so the drain thread never faults on it
+    capture->ring_size = (size_t) ring_scans * capture->scan_size;
+    capture->ring = mmap(NULL, capture->ring_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (capture->ring == MAP_FAILED) {
+        capture->ring = NULL;
+    }
+    capture->spill = malloc((size_t) MRAA_IIO_CAPTURE_READ_BATCH * capture->scan_size);
+    if (capture->wake_fd < 0 || capture->ring == NULL || capture->spill == NULL) {
+        syslog(LOG_ERR, "iio: capture_start: failed to allocate a ring of %u scans", ring_scans);
+        mraa_iio_capture_free(dev, capture);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    mraa_result_t ret = mraa_iio_capture_enable_buffer(dev, capture);
+    if (ret != MRAA_SUCCESS) {
+        mraa_iio_capture_free(dev, capture);
+        return ret;
+    }
+
+    snprintf(path, MAX_SIZE, IIO_SLASH_DEV "%d", dev->num);
+    capture->fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (capture->fd == -1) {
+        syslog(LOG_ERR, "iio: capture_start: failed to open %s: %s", path, strerror(errno));
+        mraa_iio_capture_free(dev, capture);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (pthread_create(&capture->thread, NULL, mraa_iio_capture_drain, capture) != 0) {
+        syslog(LOG_ERR, "iio: capture_start: failed to start drain thread");
+        mraa_iio_capture_free(dev, capture);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->capture = capture;
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_iio_capture_read(mraa_iio_context dev, void* channels[], unsigned int max_scans, int timeout_ms)
+{
+    if (dev == NULL || dev->capture == NULL) {
+        syslog(LOG_ERR, "iio: capture_read: context is invalid or not capturing");
+        return -1;
+    }
+
+    if (channels == NULL) {
+        syslog(LOG_ERR, "iio: capture_read: invalid channel arrays");
+        return -1;
+    }
+
+    struct _iio_capture* capture = dev->capture;
+    struct timespec deadline;
+
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&capture->lock);
+    while (capture->count == 0 && !capture->ended && timeout_ms != 0) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&capture->cond, &capture->lock);
+        } else if (pthread_cond_timedwait(&capture->cond, &capture->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    unsigned int num = capture->count < max_scans ? capture->count : max_scans;
+    unsigned int head = capture->head;
+    pthread_mutex_unlock(&capture->lock);
+
+    // The drain thread does not touch the scans before they are released,
+    // so they are decoded straight out of the ring
+    unsigned int first = capture->capacity - head;
+    if (first > num) {
+        first = num;
+    }
+    for (int i = 0; i < dev->chan_num; ++i) {
+        const mraa_iio_channel* chan = &dev->channels[i];
+        if (!chan->enabled || channels[i] == NULL) {
+            continue;
+        }
+        size_t value_size = chan->bytes == 8 ? sizeof(int64_t) : sizeof(int32_t);
+        mraa_iio_demux(capture->ring + (size_t) head * capture->scan_size, first,
+                       capture->scan_size, chan, channels[i]);
+        if (num > first) {
+            mraa_iio_demux(capture->ring, num - first, capture->scan_size, chan,
+                           (uint8_t*) channels[i] + first * value_size);
+        }
+    }
+
+    pthread_mutex_lock(&capture->lock);
+    capture->head = (head + num) % capture->capacity;
+    capture->count -= num;
+    capture->stats.delivered += num;
+    pthread_mutex_unlock(&capture->lock);
+
+    return num;
+}
+
+mraa_result_t
+mraa_iio_capture_stats(mraa_iio_context dev, mraa_iio_capture_stats_t* stats)
+{
+    if (dev == NULL || dev->capture == NULL) {
+        syslog(LOG_ERR, "iio: capture_stats: context is invalid or not capturing");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&dev->capture->lock);
+    *stats = dev->capture->stats;
+    pthread_mutex_unlock(&dev->capture->lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_iio_capture_stop(mraa_iio_context dev)
+{
+    if (dev == NULL || dev->capture == NULL) {
+        syslog(LOG_ERR, "iio: capture_stop: context is invalid or not capturing");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    struct _iio_capture* capture = dev->capture;
+    uint64_t wake = 1;
+
+    if (write(capture->wake_fd, &wake, sizeof(wake)) != sizeof(wake)) {
+        syslog(LOG_ERR, "iio: capture_stop: failed to wake drain thread");
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(capture->thread, NULL);
+
+    dev->capture = NULL;
+    mraa_iio_capture_free(dev, capture);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_iio_capture_release(mraa_iio_context dev)
+{
+    if (dev != NULL && dev->capture != NULL) {
+        mraa_iio_capture_stop(dev);
+    }
+}
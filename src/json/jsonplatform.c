@@ -15,7 +15,9 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 
+#include "lookup/lookup.h"
 #include "mraa_internal.h"
+#include "snapshot/snapshot.h"
 
 typedef mraa_result_t (*init_plat_func_t)(json_object*, mraa_board_t*, int);
 
@@ -691,30 +693,26 @@ mraa_init_json_platform(const char* platform_json)
         goto unsuccessful;
     }
 
-    // Free the old empty platform
-    free(plat);
+    // Free the old empty platform, or unmap the one that came from a file
+    if (mraa_snapshot_owns(plat)) {
+        mraa_snapshot_release();
+    } else {
+        free(plat);
+    }
     // Set the new one in it's place
     plat = board;
+    mraa_lookup_reset();
 
-    // This one was allocated and assigned an "Unknown platform" value by now,
-    // so we need to reallocate it.
-    free(platform_name);
-
+    // The name is composed on first use, with the sub platforms found after this
     if (!plat->platform_name) {
         goto unsuccessful;
-    } else {
-        platform_name = calloc(strlen(plat->platform_name) + 1, sizeof(char));
     }
-
-    if (platform_name == NULL) {
-        syslog(LOG_ERR, "init_json_platform: Could not allocate memory for platform_name");
-        goto unsuccessful;
-    }
-    strncpy(platform_name, plat->platform_name, strlen(plat->platform_name) + 1);
+    free(platform_name);
+    __atomic_store_n(&platform_name, NULL, __ATOMIC_RELEASE);
 
     // We made it to the end without anything going wrong, just cleanup
     ret = MRAA_SUCCESS;
-    syslog(LOG_NOTICE, "init_json_platform: Platform %s initialised via json", platform_name);
+    syslog(LOG_NOTICE, "init_json_platform: Platform %s initialised via json", plat->platform_name);
     goto cleanup;
 
 unsuccessful:
@@ -134,7 +134,7 @@ mraa_led_init(int index)
     char directory[MAX_SIZE];
     struct stat dir;
 
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         syslog(LOG_ERR, "led: init: platform not initialised");
         return NULL;
     }
@@ -205,7 +205,7 @@ mraa_led_init_raw(const char* led)
         return NULL;
     }
 
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         syslog(LOG_ERR, "led: init: platform not initialised");
         return NULL;
     }
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lookup/lookup.h"
+#include "mraa_internal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Line offsets share the value with the chip index. */
+#define MRAA_LOOKUP_LINE_BITS 16
+
+typedef struct {
+    const char* name; /* NULL for a free slot */
+    uint32_t hash;
+    mraa_lookup_kind_t kind;
+    int value;
+} mraa_lookup_entry_t;
+
+/* Open addressing with linear probing, kept at most half full. */
+typedef struct {
+    const void* owner; /* the board the names point into */
+    unsigned int lines; /* gpiochip lines the line index was built from */
+    unsigned int mask;
+    char* names; /* copies of the line names, NULL for boards */
+    mraa_lookup_entry_t slots[];
+} mraa_lookup_table_t;
+
+static pthread_mutex_t lookup_lock = PTHREAD_MUTEX_INITIALIZER;
+/* main platform, sub platform */
+static mraa_lookup_table_t* board_tables[2] = { NULL, NULL };
+static mraa_lookup_table_t* line_table = NULL;
+
+static uint32_t
+mraa_lookup_hash(const char* name)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    while (*name != '\0') {
+        hash = (hash ^ (unsigned char) *name++) * 16777619u;
+    }
+    return hash;
+}
+
+static mraa_lookup_table_t*
+mraa_lookup_table_new(unsigned int entries)
+{
+    unsigned int size = 16;
+    while (size < 2 * entries) {
+        size <<= 1;
+    }
+    mraa_lookup_table_t* table =
+    (mraa_lookup_table_t*) calloc(1, sizeof(mraa_lookup_table_t) + size * sizeof(mraa_lookup_entry_t));
+    if (table == NULL) {
+        syslog(LOG_CRIT, "lookup: Failed to allocate memory for %u names", entries);
+        return NULL;
+    }
+    table->mask = size - 1;
+    return table;
+}
+
+static void
+mraa_lookup_table_free(mraa_lookup_table_t* table)
+{
+    if (table != NULL) {
+        free(table->names);
+        free(table);
+    }
+}
+
+static mraa_lookup_entry_t*
+mraa_lookup_slot(mraa_lookup_table_t* table, mraa_lookup_kind_t kind, const char* name, uint32_t hash)
+{
+    unsigned int i = hash & table->mask;
+    while (table->slots[i].name != NULL) {
+        mraa_lookup_entry_t* entry = &table->slots[i];
+        if (entry->hash == hash && entry->kind == kind && strcmp(entry->name, name) == 0) {
+            return entry;
+        }
+        i = (i + 1) & table->mask;
+    }
+    return &table->slots[i];
+}
+
+static void
+mraa_lookup_add(mraa_lookup_table_t* table, mraa_lookup_kind_t kind, const char* name, int value)
+{
+    if (name == NULL || name[0] == '\0') {
+        return;
+    }
+    uint32_t hash = mraa_lookup_hash(name);
+    mraa_lookup_entry_t* entry = mraa_lookup_slot(table, kind, name, hash);
+    /* the first of several equal names wins, as with a linear search */
+    if (entry->name == NULL) {
+        entry->name = name;
+        entry->hash = hash;
+        entry->kind = kind;
+        entry->value = value;
+    }
+}
+
+static mraa_boolean_t
+mraa_lookup_find(mraa_lookup_table_t* table, mraa_lookup_kind_t kind, const char* name, uint32_t hash, int* value)
+{
+    mraa_lookup_entry_t* entry = mraa_lookup_slot(table, kind, name, hash);
+    if (entry->name == NULL) {
+        return 0;
+    }
+    *value = entry->value;
+    return 1;
+}
+
+static int
+mraa_lookup_count(int count, int max)
+{
+    if (count < 0) {
+        return 0;
+    }
+    return count < max ? count : max;
+}
+
+static mraa_lookup_table_t*
+mraa_lookup_board_new(const mraa_board_t* board)
+{
+    int pins = (board->pins != NULL && board->phy_pin_count > 0) ? board->phy_pin_count : 0;
+    int i2c = mraa_lookup_count(board->i2c_bus_count, MAX_I2C_BUS_COUNT);
+    int spi = mraa_lookup_count(board->spi_bus_count, MAX_SPI_BUS_COUNT);
+    int pwm = mraa_lookup_count(board->pwm_dev_count, MAX_PWM_COUNT);
+    int uart = mraa_lookup_count(board->uart_dev_count, MAX_UART_COUNT);
+    int i;
+
+    mraa_lookup_table_t* table = mraa_lookup_table_new(pins + i2c + spi + pwm + uart);
+    if (table == NULL) {
+        return NULL;
+    }
+    table->owner = board;
+
+    for (i = 0; i < pins; i++) {
+        if (board->pins[i].capabilities.gpio) {
+            mraa_lookup_add(table, MRAA_LOOKUP_GPIO, board->pins[i].name, i);
+        }
+    }
+    for (i = 0; i < i2c; i++) {
+        mraa_lookup_add(table, MRAA_LOOKUP_I2C, board->i2c_bus[i].name, board->i2c_bus[i].bus_id);
+    }
+    for (i = 0; i < spi; i++) {
+        mraa_lookup_add(table, MRAA_LOOKUP_SPI, board->spi_bus[i].name, board->spi_bus[i].bus_id);
+    }
+    for (i = 0; i < pwm; i++) {
+        mraa_lookup_add(table, MRAA_LOOKUP_PWM, board->pwm_dev[i].name, board->pwm_dev[i].index);
+    }
+    for (i = 0; i < uart; i++) {
+        mraa_lookup_add(table, MRAA_LOOKUP_UART, board->uart_dev[i].name, board->uart_dev[i].index);
+    }
+    return table;
+}
+
+/* lookup_lock held, the table is only good until it is released */
+static mraa_lookup_table_t*
+mraa_lookup_board(int which, const mraa_board_t* board)
+{
+    mraa_lookup_table_t* table = board_tables[which];
+    if (table == NULL || table->owner != board) {
+        mraa_lookup_table_free(table);
+        table = mraa_lookup_board_new(board);
+        board_tables[which] = table;
+    }
+    return table;
+}
+
+int
+mraa_lookup_name(mraa_lookup_kind_t kind, const char* name)
+{
+    mraa_lookup_table_t* table;
+    int value, found = -1;
+
+    if (name == NULL || name[0] == '\0' || plat == NULL) {
+        return -1;
+    }
+    uint32_t hash = mraa_lookup_hash(name);
+
+    /* probed under the lock too, a reset or another board may free the table */
+    pthread_mutex_lock(&lookup_lock);
+    table = mraa_lookup_board(0, plat);
+    if (table != NULL && mraa_lookup_find(table, kind, name, hash, &value)) {
+        found = value;
+    } else if (mraa_has_sub_platform()) {
+        table = mraa_lookup_board(1, plat->sub_platform);
+        if (table != NULL && mraa_lookup_find(table, kind, name, hash, &value)) {
+            found = mraa_get_sub_platform_id(value);
+        }
+    }
+    pthread_mutex_unlock(&lookup_lock);
+    return found;
+}
+
+static unsigned int
+mraa_lookup_lines(mraa_gpiod_chip_info** cinfos, int num_chips)
+{
+    unsigned int lines = 0;
+    int i;
+
+    for (i = 0; i < num_chips; i++) {
+        lines += cinfos[i]->chip_info.lines;
+    }
+    return lines;
+}
+
+static mraa_lookup_table_t*
+mraa_lookup_lines_new(mraa_gpiod_chip_info** cinfos, int num_chips)
+{
+    const size_t name_size = sizeof(((mraa_gpiod_line_info*) NULL)->name);
+    unsigned int lines = mraa_lookup_lines(cinfos, num_chips);
+    unsigned int n = 0;
+    int i;
+    unsigned int j;
+
+    mraa_lookup_table_t* table = mraa_lookup_table_new(lines);
+    if (table == NULL) {
+        return NULL;
+    }
+    table->lines = lines;
+    table->names = (char*) calloc(lines > 0 ? lines : 1, name_size);
+    if (table->names == NULL) {
+        syslog(LOG_CRIT, "lookup: Failed to allocate memory for %u line names", lines);
+        mraa_lookup_table_free(table);
+        return NULL;
+    }
+
+    for (i = 0; i < num_chips; i++) {
+        for (j = 0; j < cinfos[i]->chip_info.lines && j < (1u << MRAA_LOOKUP_LINE_BITS); j++) {
+            mraa_gpiod_line_info* linfo = mraa_get_line_info_from_descriptor(cinfos[i]->chip_fd, j);
+            if (linfo == NULL) {
+                continue;
+            }
+            char* name = table->names + (n++) * name_size;
+            strncpy(name, linfo->name, name_size - 1);
+            free(linfo);
+            mraa_lookup_add(table, MRAA_LOOKUP_LINE, name, (i << MRAA_LOOKUP_LINE_BITS) | j);
+        }
+    }
+    return table;
+}
+
+/* the chips may have been replaced by others since the index was built */
+static mraa_boolean_t
+mraa_lookup_line_is(mraa_gpiod_chip_info** cinfos, int num_chips, int chip, unsigned int line, const char* name)
+{
+    mraa_boolean_t same = 0;
+
+    if (chip >= num_chips || line >= cinfos[chip]->chip_info.lines) {
+        return 0;
+    }
+    mraa_gpiod_line_info* linfo = mraa_get_line_info_from_descriptor(cinfos[chip]->chip_fd, line);
+    if (linfo != NULL) {
+        same = strncmp(linfo->name, name, sizeof(linfo->name)) == 0;
+        free(linfo);
+    }
+    return same;
+}
+
+int
+mraa_lookup_gpio_line(const char* name, mraa_gpiod_chip_info** cinfos, int num_chips, unsigned int* line)
+{
+    int value, chip = -1, attempt;
+
+    if (name == NULL || name[0] == '\0' || cinfos == NULL || num_chips <= 0) {
+        return -1;
+    }
+    uint32_t hash = mraa_lookup_hash(name);
+
+    pthread_mutex_lock(&lookup_lock);
+    for (attempt = 0; attempt < 2 && chip < 0; attempt++) {
+        if (line_table == NULL || attempt > 0) {
+            mraa_lookup_table_free(line_table);
+            line_table = mraa_lookup_lines_new(cinfos, num_chips);
+            if (line_table == NULL) {
+                break;
+            }
+        }
+        if (mraa_lookup_find(line_table, MRAA_LOOKUP_LINE, name, hash, &value)) {
+            unsigned int offset = value & ((1 << MRAA_LOOKUP_LINE_BITS) - 1);
+            if (mraa_lookup_line_is(cinfos, num_chips, value >> MRAA_LOOKUP_LINE_BITS, offset, name)) {
+                chip = value >> MRAA_LOOKUP_LINE_BITS;
+                *line = offset;
+            }
+        } else if (line_table->lines == mraa_lookup_lines(cinfos, num_chips)) {
+            /* not a line of these chips */
+            break;
+        }
+    }
+    pthread_mutex_unlock(&lookup_lock);
+    return chip;
+}
+
+void
+mraa_lookup_reset()
+{
+    int i;
+
+    pthread_mutex_lock(&lookup_lock);
+    for (i = 0; i < 2; i++) {
+        mraa_lookup_table_free(board_tables[i]);
+        board_tables[i] = NULL;
+    }
+    mraa_lookup_table_free(line_table);
+    line_table = NULL;
+    pthread_mutex_unlock(&lookup_lock);
+}
@@ -82,9 +82,13 @@ mraa_mock_board()
     b->adv_func->gpio_isr_replace = &mraa_mock_gpio_isr_replace;
     b->adv_func->gpio_isr_exit_replace = &mraa_mock_gpio_isr_exit_replace;
     b->adv_func->gpio_mode_replace = &mraa_mock_gpio_mode_replace;
+    b->adv_func->gpio_mmap_setup = &mraa_mock_gpio_mmap_setup;
+    b->adv_func->gpio_event_fds_replace = &mraa_mock_gpio_event_fds_replace;
     b->adv_func->aio_init_internal_replace = &mraa_mock_aio_init_internal_replace;
     b->adv_func->aio_close_replace = &mraa_mock_aio_close_replace;
     b->adv_func->aio_read_replace = &mraa_mock_aio_read_replace;
+    b->adv_func->aio_read_multi_replace = &mraa_mock_aio_read_multi_replace;
+    b->adv_func->aio_stream_open_replace = &mraa_mock_aio_stream_open_replace;
     b->adv_func->i2c_init_bus_replace = &mraa_mock_i2c_init_bus_replace;
     b->adv_func->i2c_stop_replace = &mraa_mock_i2c_stop_replace;
     b->adv_func->i2c_set_frequency_replace = &mraa_mock_i2c_set_frequency_replace;
@@ -98,6 +102,7 @@ mraa_mock_board()
     b->adv_func->i2c_write_byte_replace = &mraa_mock_i2c_write_byte_replace;
     b->adv_func->i2c_write_byte_data_replace = &mraa_mock_i2c_write_byte_data_replace;
     b->adv_func->i2c_write_word_data_replace = &mraa_mock_i2c_write_word_data_replace;
+    b->adv_func->i2c_transfer_replace = &mraa_mock_i2c_transfer_replace;
     b->adv_func->spi_init_raw_replace = &mraa_mock_spi_init_raw_replace;
     b->adv_func->spi_stop_replace = &mraa_mock_spi_stop_replace;
     b->adv_func->spi_bit_per_word_replace = &mraa_mock_spi_bit_per_word_replace;
@@ -108,8 +113,10 @@ mraa_mock_board()
     b->adv_func->spi_write_word_replace = &mraa_mock_spi_write_word_replace;
     b->adv_func->spi_transfer_buf_replace = &mraa_mock_spi_transfer_buf_replace;
     b->adv_func->spi_transfer_buf_word_replace = &mraa_mock_spi_transfer_buf_word_replace;
+    b->adv_func->spi_transfer_batch_replace = &mraa_mock_spi_transfer_batch_replace;
     b->adv_func->uart_init_raw_replace = &mraa_mock_uart_init_raw_replace;
     b->adv_func->uart_set_baudrate_replace = &mraa_mock_uart_set_baudrate_replace;
+    b->adv_func->uart_get_baudrate_replace = &mraa_mock_uart_get_baudrate_replace;
     b->adv_func->uart_flush_replace = &mraa_mock_uart_flush_replace;
     b->adv_func->uart_sendbreak_replace = &mraa_mock_uart_sendbreak_replace;
     b->adv_func->uart_set_flowcontrol_replace = &mraa_mock_uart_set_flowcontrol_replace;
@@ -119,6 +126,7 @@ mraa_mock_board()
     b->adv_func->uart_data_available_replace = &mraa_mock_uart_data_available_replace;
     b->adv_func->uart_write_replace = &mraa_mock_uart_write_replace;
     b->adv_func->uart_read_replace = &mraa_mock_uart_read_replace;
+    b->adv_func->uart_rx_open_replace = &mraa_mock_uart_rx_open_replace;
 
     // Pin definitions
     int pos = 0;
@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "aio/aio_stream.h"
 #include "common.h"
 #include "mock/mock_board_aio.h"
 
@@ -33,3 +36,59 @@ mraa_mock_aio_read_replace(mraa_aio_context dev)
     srand(time(NULL));
     return rand() % max_value;
 }
+
+mraa_result_t
+mraa_mock_aio_read_multi_replace(mraa_aio_context dev, int values[], unsigned int num_channels)
+{
+    unsigned int i = 0;
+    for (mraa_aio_context it = dev; it != NULL && i < num_channels; it = it->next) {
+        values[i++] = mraa_mock_aio_read_replace(it);
+    }
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_mock_aio_stream_open_replace(mraa_aio_context dev,
+                                  const unsigned int* channels,
+                                  unsigned int num_channels,
+                                  const char* trigger,
+                                  struct _aio_scan_element* layout,
+                                  unsigned int* scan_size)
+{
+    int pipe_fds[2];
+    uint8_t scan[2 * MRAA_AIO_STREAM_MAX_CHANNELS];
+
+    // le:u12/16>>0 for every channel, one after the other
+    for (unsigned int i = 0; i < num_channels; ++i) {
+        layout[i].location = 2 * i;
+        layout[i].bytes = 2;
+        layout[i].bits = 12;
+        layout[i].shift = 0;
+        layout[i].is_signed = 0;
+        layout[i].big_endian = 0;
+    }
+    *scan_size = 2 * num_channels;
+
+    if (pipe(pipe_fds) != 0) {
+        syslog(LOG_ERR, "aio%u: stream: failed to create mock pipe: %s", dev->channel, strerror(errno));
+        return -1;
+    }
+
+    // Queue all scans up front, the reader sees the end of the stream afterwards
+    for (unsigned int s = 0; s < MOCK_AIO_STREAM_SCANS; ++s) {
+        for (unsigned int i = 0; i < num_channels; ++i) {
+            uint16_t raw = ((s * 16 + i) << 2) & 0xFFF;
+            scan[2 * i] = raw & 0xFF;
+            scan[2 * i + 1] = raw >> 8;
+        }
+        if (write(pipe_fds[1], scan, *scan_size) != (ssize_t) *scan_size) {
+            syslog(LOG_ERR, "aio%u: stream: failed to fill mock pipe", dev->channel);
+            close(pipe_fds[0]);
+            close(pipe_fds[1]);
+            return -1;
+        }
+    }
+    close(pipe_fds[1]);
+
+    return pipe_fds[0];
+}
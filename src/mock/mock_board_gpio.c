@@ -5,12 +5,26 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <fcntl.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "common.h"
+#include "gpio/gpio_mmap.h"
+#include "linux/gpio.h"
 #include "mock/mock_board_gpio.h"
 
+#define MOCK_GPIO_REGS_SIZE 4096
+
+static char mock_regs_path[32];
+
+// Register file stand-in: a single bank with a plain data register at offset 0
+static mraa_gpio_mmap_soc_t mock_soc = { "mock", NULL, mock_regs_path, 1, { 0 }, MOCK_GPIO_REGS_SIZE,
+                                         32, 0x00, 0x00, MRAA_GPIO_MMAP_NO_REG, MRAA_GPIO_MMAP_NO_REG };
+
 mraa_result_t
 mraa_mock_gpio_init_internal_replace(mraa_gpio_context dev, int pin)
 {
@@ -27,6 +41,7 @@ mraa_mock_gpio_init_internal_replace(mraa_gpio_context dev, int pin)
     // We start as INPUT and LOW
     dev->mock_dir = MRAA_GPIO_IN;
     dev->mock_state = 0;
+    dev->mock_event_fd = -1;
 
     return MRAA_SUCCESS;
 }
@@ -34,6 +49,9 @@ mraa_mock_gpio_init_internal_replace(mraa_gpio_context dev, int pin)
 mraa_result_t
 mraa_mock_gpio_close_replace(mraa_gpio_context dev)
 {
+    if (dev->mock_event_fd != -1) {
+        close(dev->mock_event_fd);
+    }
     free(dev);
     return MRAA_SUCCESS;
 }
@@ -41,21 +59,32 @@ mraa_mock_gpio_close_replace(mraa_gpio_context dev)
 mraa_result_t
 mraa_mock_gpio_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t dir)
 {
-    switch (dir) {
-        case MRAA_GPIO_OUT_HIGH:
-            dev->mock_dir = MRAA_GPIO_OUT;
-            return mraa_gpio_write(dev, 1);
-        case MRAA_GPIO_OUT_LOW:
-            dev->mock_dir = MRAA_GPIO_OUT;
-            return mraa_gpio_write(dev, 0);
-        case MRAA_GPIO_IN:
-        case MRAA_GPIO_OUT:
-            dev->mock_dir = dir;
-            return MRAA_SUCCESS;
-        default:
-            syslog(LOG_ERR, "gpio: dir: invalid direction '%d' to set", (int) dir);
-            return MRAA_ERROR_INVALID_PARAMETER;
+    // contexts from mraa_gpio_init_multi() are chained
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+        mraa_result_t ret = MRAA_SUCCESS;
+        switch (dir) {
+            case MRAA_GPIO_OUT_HIGH:
+                it->mock_dir = MRAA_GPIO_OUT;
+                ret = mraa_gpio_write(it, 1);
+                break;
+            case MRAA_GPIO_OUT_LOW:
+                it->mock_dir = MRAA_GPIO_OUT;
+                ret = mraa_gpio_write(it, 0);
+                break;
+            case MRAA_GPIO_IN:
+            case MRAA_GPIO_OUT:
+                it->mock_dir = dir;
+                break;
+            default:
+                syslog(LOG_ERR, "gpio: dir: invalid direction '%d' to set", (int) dir);
+                return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
     }
+
+    return MRAA_SUCCESS;
 }
 
 mraa_result_t
@@ -68,6 +97,10 @@ mraa_mock_gpio_read_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t* dir)
 int
 mraa_mock_gpio_read_replace(mraa_gpio_context dev)
 {
+    if (dev->mmap_read != NULL) {
+        return dev->mmap_read(dev);
+    }
+
     return dev->mock_state;
 }
 
@@ -84,6 +117,25 @@ mraa_mock_gpio_write_replace(mraa_gpio_context dev, int value)
         return MRAA_ERROR_INVALID_RESOURCE;
     }
 
+    if (dev->mmap_write != NULL) {
+        return dev->mmap_write(dev, value);
+    }
+
+    // Report the transition like a line event fd would, the mock pin loops back to itself
+    if (dev->mock_event_fd != -1 && value != dev->mock_state) {
+        if ((value && dev->mock_edge != MRAA_GPIO_EDGE_FALLING) ||
+            (!value && dev->mock_edge != MRAA_GPIO_EDGE_RISING)) {
+            struct gpioevent_data event;
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            event.timestamp = (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+            event.id = value ? GPIOEVENT_EVENT_RISING_EDGE : GPIOEVENT_EVENT_FALLING_EDGE;
+            if (write(dev->mock_event_fd, &event, sizeof(event)) != sizeof(event)) {
+                syslog(LOG_ERR, "gpio%i: write: mock event pipe is full", dev->pin);
+            }
+        }
+    }
+
     dev->mock_state = value;
     return MRAA_SUCCESS;
 }
@@ -111,3 +163,62 @@ mraa_mock_gpio_mode_replace(mraa_gpio_context dev, mraa_gpio_mode_t mode)
 {
     return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
 }
+
+mraa_result_t
+mraa_mock_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en)
+{
+    // The register file is an unlinked temporary file kept open for the
+    // lifetime of the process and reopened by the backend through procfs
+    if (en && mock_regs_path[0] == '\0') {
+        FILE* regs = tmpfile();
+        if (regs == NULL) {
+            syslog(LOG_ERR, "gpio: mmap: unable to create mock register file");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        if (ftruncate(fileno(regs), MOCK_GPIO_REGS_SIZE) != 0) {
+            syslog(LOG_ERR, "gpio: mmap: unable to size mock register file");
+            fclose(regs);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        snprintf(mock_regs_path, sizeof(mock_regs_path), "/proc/self/fd/%d", fileno(regs));
+    }
+
+    return mraa_gpio_mmap_setup(dev, en, &mock_soc);
+}
+
+mraa_result_t
+mraa_mock_gpio_event_fds_replace(mraa_gpio_context dev, mraa_gpio_edge_t mode, int fds[], unsigned int num_fds)
+{
+    unsigned int idx = 0;
+
+    // One pipe per pin of the context, contexts from mraa_gpio_init_multi() are chained
+    for (mraa_gpio_context it = dev; it != NULL && idx < num_fds; it = it->next, idx++) {
+        int pipe_fds[2];
+
+        if (it->mock_event_fd != -1) {
+            close(it->mock_event_fd);
+            it->mock_event_fd = -1;
+        }
+
+        if (pipe(pipe_fds) != 0) {
+            syslog(LOG_ERR, "gpio%i: event_fds: failed to create mock event pipe", it->pin);
+            for (mraa_gpio_context done = dev; done != it; done = done->next) {
+                close(done->mock_event_fd);
+                done->mock_event_fd = -1;
+            }
+            for (unsigned int i = 0; i < idx; i++) {
+                close(fds[i]);
+                fds[i] = -1;
+            }
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        // A full pipe stands in for the kernel dropping events, writes must not block
+        fcntl(pipe_fds[1], F_SETFL, O_NONBLOCK);
+
+        it->mock_event_fd = pipe_fds[1];
+        it->mock_edge = mode;
+        fds[idx] = pipe_fds[0];
+    }
+
+    return MRAA_SUCCESS;
+}
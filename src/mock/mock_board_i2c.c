@@ -224,3 +224,39 @@ mraa_mock_i2c_write_word_data_replace(mraa_i2c_context dev, const uint16_t data,
         return MRAA_ERROR_UNSPECIFIED;
     }
 }
+
+mraa_result_t
+mraa_mock_i2c_transfer_replace(mraa_i2c_context dev, mraa_i2c_msg_t* msgs, unsigned int num_msgs)
+{
+    // Behave like a typical register based device: the first byte written after a
+    // start selects the register, data bytes then auto-increment it
+    int reg = 0;
+
+    for (unsigned int i = 0; i < num_msgs; ++i) {
+        if (msgs[i].addr != dev->mock_dev_addr) {
+            // Not our mock device, nobody acks the address
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+
+        int pos = 0;
+        if (!(msgs[i].flags & (MRAA_I2C_MSG_READ | MRAA_I2C_MSG_NOSTART)) && msgs[i].len > 0) {
+            reg = msgs[i].buf[0];
+            pos = 1;
+        }
+
+        for (; pos < msgs[i].len; ++pos, ++reg) {
+            if (reg >= dev->mock_dev_data_len) {
+                syslog(LOG_ERR, "i2c%i: transfer: Command/register number is too big, max is 0x%X",
+                       dev->busnum, dev->mock_dev_data_len - 1);
+                return MRAA_ERROR_UNSPECIFIED;
+            }
+            if (msgs[i].flags & MRAA_I2C_MSG_READ) {
+                msgs[i].buf[pos] = dev->mock_dev_data[reg];
+            } else {
+                dev->mock_dev_data[reg] = msgs[i].buf[pos];
+            }
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
@@ -160,3 +160,27 @@ mraa_mock_spi_transfer_buf_word_replace(mraa_spi_context dev, uint16_t* data, ui
 
     return MRAA_SUCCESS;
 }
+
+mraa_result_t
+mraa_mock_spi_transfer_batch_replace(mraa_spi_context dev, mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    for (unsigned int i = 0; i < num_segments; ++i) {
+        if (segments[i].len == 0) {
+            syslog(LOG_ERR, "spi: transfer_batch: segment %u is empty, cannot proceed", i);
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    // Every segment is answered like a standalone transfer_buf
+    for (unsigned int i = 0; i < num_segments; ++i) {
+        if (segments[i].rx_buf == NULL) {
+            continue;
+        }
+        for (unsigned int j = 0; j < segments[i].len; ++j) {
+            uint8_t tx = segments[i].tx_buf != NULL ? segments[i].tx_buf[j] : 0;
+            segments[i].rx_buf[j] = tx ^ MOCK_SPI_REPLY_DATA_MODIFIER_BYTE;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
@@ -7,19 +7,35 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include "common.h"
 #include "mock/mock_board_uart.h"
 
+// Last rate set, read back by mraa_uart_get_baudrate()
+static unsigned int mock_uart_baudrate = 0;
+
+// Write end of the loopback feeding the receive engine, -1 when not running
+static int mock_uart_loopback = -1;
+
 mraa_result_t
 mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud)
 {
-    // Limits are taken from uart.c::uint2speed(), they don't matter much anyway
-    if ((baud < 0) || (baud > 4000000)) {
-        syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %i", dev->index, baud);
+    // Any rate the fastest USB and SoC UARTs can do, they don't matter much anyway
+    if ((baud == 0) || (baud > MOCK_UART_MAX_BAUDRATE)) {
+        syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %u", dev->index, baud);
         return MRAA_ERROR_INVALID_PARAMETER;
     }
 
+    mock_uart_baudrate = baud;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_mock_uart_get_baudrate_replace(mraa_uart_context dev, unsigned int* baud)
+{
+    *baud = mock_uart_baudrate;
     return MRAA_SUCCESS;
 }
 
@@ -76,7 +92,12 @@ mraa_mock_uart_data_available_replace(mraa_uart_context dev, unsigned int millis
 int
 mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len)
 {
-    // Our mock implementation always succeeds when sending data
+    // Our mock implementation always succeeds when sending data, what is
+    // written is looped back to a running receive engine
+    if (mock_uart_loopback >= 0 && send(mock_uart_loopback, buf, len, MSG_NOSIGNAL) < 0) {
+        close(mock_uart_loopback);
+        mock_uart_loopback = -1;
+    }
     return len;
 }
 
@@ -87,3 +108,19 @@ mraa_mock_uart_read_replace(mraa_uart_context dev, char* buf, size_t len)
     memset(buf, MOCK_UART_DATA_BYTE, len);
     return len;
 }
+
+int
+mraa_mock_uart_rx_open_replace(mraa_uart_context dev)
+{
+    int sv[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) != 0) {
+        syslog(LOG_ERR, "uart%i: rx_open: failed to create loopback", dev->index);
+        return -1;
+    }
+    if (mock_uart_loopback >= 0) {
+        close(mock_uart_loopback);
+    }
+    mock_uart_loopback = sv[1];
+    return sv[0];
+}
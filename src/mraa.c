@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <sys/utsname.h>
@@ -38,13 +39,17 @@
 #endif
 
 #include "aio.h"
+#include "async/bus_queue.h"
 #include "firmata/firmata_mraa.h"
 #include "gpio.h"
 #include "gpio/gpio_chardev.h"
+#include "gpio/gpio_dispatch.h"
 #include "grovepi/grovepi.h"
 #include "i2c.h"
+#include "lookup/lookup.h"
 #include "mraa_internal.h"
 #include "pwm.h"
+#include "snapshot/snapshot.h"
 #include "spi.h"
 #include "uart.h"
 #include "version.h"
@@ -65,6 +70,16 @@ mraa_lang_func_t* lang_func = NULL;
 
 char* platform_name = NULL;
 
+// Held while anything is set up lazily. Recursive as board code may call
+// back into entry points while it is being detected.
+static pthread_mutex_t init_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+// Set once imraa_init() completed, cleared by mraa_deinit()
+static int init_done = 0;
+static int init_depth = 0;
+// 0 before, 1 during and 2 after the sub platform discovery
+static int sub_platforms_state = 0;
+static mraa_boolean_t log_level_set = 0;
+
 const char*
 mraa_get_version()
 {
@@ -76,6 +91,8 @@ mraa_set_log_level(int level)
 {
     if (level <= 7 && level >= 0) {
         setlogmask(LOG_UPTO(level));
+        // not reset by a platform set up later
+        log_level_set = 1;
         syslog(LOG_DEBUG, "Loglevel %d is set", level);
         return MRAA_SUCCESS;
     }
@@ -118,14 +135,17 @@ imraa_init()
     }
     char* env_var;
     mraa_platform_t platform_type = MRAA_NULL_PLATFORM;
+    mraa_boolean_t from_snapshot = 0;
     uid_t proc_euid = geteuid();
     struct passwd* proc_user = getpwuid(proc_euid);
 
+    if (!log_level_set) {
 #ifdef DEBUG
-    setlogmask(LOG_UPTO(LOG_DEBUG));
+        setlogmask(LOG_UPTO(LOG_DEBUG));
 #else
-    setlogmask(LOG_UPTO(LOG_NOTICE));
+        setlogmask(LOG_UPTO(LOG_NOTICE));
 #endif
+    }
 
     openlog("libmraa", LOG_CONS | LOG_PID | LOG_NDELAY, LOG_LOCAL1);
     syslog(LOG_NOTICE, "libmraa version %s initialised by user '%s' with EUID %d",
@@ -134,8 +154,13 @@ imraa_init()
     // Check to see if the enviroment variable has been set
     env_var = getenv(MRAA_JSONPLAT_ENV_VAR);
     if (env_var != NULL) {
+        // A board file from mraa-platform-compile is mapped, anything else is parsed as json
+        mraa_result_t ret = mraa_snapshot_load_board(env_var, &plat);
+        if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+            ret = mraa_init_json_platform(env_var);
+        }
         // We only care about success, the init will write to syslog if things went wrong
-        switch (mraa_init_json_platform(env_var)) {
+        switch (ret) {
             case MRAA_SUCCESS:
                 platform_type = plat->platform_type;
                 break;
@@ -144,6 +169,15 @@ imraa_init()
         }
     }
 
+    // A platform detected earlier during this boot is mapped as it was
+    if (platform_type == MRAA_NULL_PLATFORM) {
+        plat = mraa_snapshot_load();
+        if (plat != NULL) {
+            platform_type = plat->platform_type;
+            from_snapshot = 1;
+        }
+    }
+
     // Not an else because if the env var didn't load what we wanted maybe we can still load something
     if (platform_type == MRAA_NULL_PLATFORM) {
 #if defined(X86PLAT)
@@ -183,6 +217,73 @@ imraa_init()
         }
     }
 
+    lang_func = (mraa_lang_func_t*) calloc(1, sizeof(mraa_lang_func_t));
+    if (lang_func == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    // a snapshot holds the result of the probe
+    if (!from_snapshot) {
+        plat->chardev_capable = mraa_is_platform_chardev_interface_capable();
+    }
+    if (plat->chardev_capable) {
+        syslog(LOG_NOTICE, "gpio: support for chardev interface is activated");
+    }
+
+    if (!mraa_snapshot_owns(plat)) {
+        (void) mraa_snapshot_save(plat);
+    }
+
+    syslog(LOG_NOTICE, "libmraa initialised for platform '%s' of type %d", plat->platform_name,
+           plat->platform_type);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_init()
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (__atomic_load_n(&init_done, __ATOMIC_ACQUIRE)) {
+        return MRAA_SUCCESS;
+    }
+    pthread_mutex_lock(&init_lock);
+    // calls from board code while it is detected return at once
+    if (!init_done && init_depth == 0) {
+        init_depth++;
+        ret = imraa_init();
+        init_depth--;
+        if (ret == MRAA_SUCCESS) {
+            __atomic_store_n(&init_done, 1, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&init_lock);
+    return ret;
+}
+
+mraa_board_t*
+mraa_resolve_platform()
+{
+    if (mraa_init() != MRAA_SUCCESS) {
+        return NULL;
+    }
+    return plat;
+}
+
+void
+mraa_discover_sub_platforms()
+{
+    if (__atomic_load_n(&sub_platforms_state, __ATOMIC_ACQUIRE) == 2 || mraa_resolve_platform() == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&init_lock);
+    // adding a sub platform from the discovery itself asks again while in state 1
+    if (sub_platforms_state != 0 || !init_done) {
+        pthread_mutex_unlock(&init_lock);
+        return;
+    }
+    sub_platforms_state = 1;
+
 #if defined(USBPLAT)
     syslog(LOG_NOTICE, "Searching for USB plaform extender libraries...");
     /* If a usb platform lib is present, attempt to load and look for
@@ -205,62 +306,29 @@ imraa_init()
     mraa_add_from_lockfile(subplatform_lockfile);
 #endif
 
-#if !defined(PERIPHERALMAN)
-    // Look for IIO devices
-    mraa_iio_detect();
-
-    if (plat != NULL) {
-        int length = strlen(plat->platform_name) + 1;
-        if (mraa_has_sub_platform()) {
-            // Account for ' + ' chars
-            length += strlen(plat->sub_platform->platform_name) + 3;
-        }
-        platform_name = calloc(length, sizeof(char));
-        if (mraa_has_sub_platform()) {
-            snprintf(platform_name, length, "%s + %s", plat->platform_name, plat->sub_platform->platform_name);
-        } else {
-            strncpy(platform_name, plat->platform_name, length);
-        }
-    }
-#endif
-
-    lang_func = (mraa_lang_func_t*) calloc(1, sizeof(mraa_lang_func_t));
-    if (lang_func == NULL) {
-        return MRAA_ERROR_NO_RESOURCES;
-    }
-
-    plat->chardev_capable = mraa_is_platform_chardev_interface_capable();
-    if (plat->chardev_capable) {
-        syslog(LOG_NOTICE, "gpio: support for chardev interface is activated");
-    }
-
-    syslog(LOG_NOTICE, "libmraa initialised for platform '%s' of type %d", mraa_get_platform_name(),
-           mraa_get_platform_type());
-    return MRAA_SUCCESS;
-}
-
-#if (defined SWIGPYTHON) || (defined SWIG)
-mraa_result_t
-#else
-mraa_result_t __attribute__((constructor))
-#endif
-mraa_init()
-{
-    if (plat != NULL) {
-        return MRAA_SUCCESS;
-    } else {
-        return imraa_init();
-    }
+    mraa_lookup_reset();
+    __atomic_store_n(&sub_platforms_state, 2, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&init_lock);
 }
 
 void
 mraa_deinit()
 {
+    mraa_gpio_dispatch_shutdown();
+    mraa_async_shutdown();
+
+    pthread_mutex_lock(&init_lock);
+    __atomic_store_n(&init_done, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&sub_platforms_state, 0, __ATOMIC_RELEASE);
+    mraa_lookup_reset();
+
     if (plat != NULL) {
-        if (plat->pins != NULL) {
+        // a board from the snapshot lives in its mapping, only sub platforms are allocated
+        mraa_boolean_t mapped = mraa_snapshot_owns(plat);
+        if (!mapped && plat->pins != NULL) {
             free(plat->pins);
         }
-        if (plat->adv_func != NULL) {
+        if (!mapped && plat->adv_func != NULL) {
             free(plat->adv_func);
         }
         mraa_board_t* sub_plat = plat->sub_platform;
@@ -274,7 +342,7 @@ mraa_deinit()
             }
             free(sub_plat);
         }
-        if (plat->platform_type == MRAA_JSON_PLATFORM) {
+        if (!mapped && plat->platform_type == MRAA_JSON_PLATFORM) {
             // Free the platform name
             free(plat->platform_name);
             plat->platform_name = NULL;
@@ -285,8 +353,8 @@ mraa_deinit()
          * allocate space for device_path, others use #defines or consts,
          * which means this has to be handled differently per platform
          */
-        if ((plat->platform_type == MRAA_JSON_PLATFORM) || (plat->platform_type == MRAA_UP2) ||
-            (plat->platform_type == MRAA_IEI_TANK)) {
+        if (!mapped && ((plat->platform_type == MRAA_JSON_PLATFORM) || (plat->platform_type == MRAA_UP2) ||
+                        (plat->platform_type == MRAA_IEI_TANK))) {
             for (i = 0; i < plat->uart_dev_count; i++) {
                 if (plat->uart_dev[i].device_path != NULL) {
                     free(plat->uart_dev[i].device_path);
@@ -294,7 +362,11 @@ mraa_deinit()
             }
         }
 
-        free(plat);
+        if (mapped) {
+            mraa_snapshot_release();
+        } else {
+            free(plat);
+        }
         plat = NULL;
 
         if (lang_func != NULL) {
@@ -316,6 +388,7 @@ mraa_deinit()
     pman_mraa_deinit();
 #endif
     closelog();
+    pthread_mutex_unlock(&init_lock);
 }
 
 int
@@ -344,11 +417,9 @@ mraa_count_iio_devices(const char* path, const struct stat* sb, int flag, struct
     return 0;
 }
 
-mraa_result_t
-mraa_iio_detect()
+static mraa_result_t
+mraa_iio_scan(mraa_iio_info_t* iio)
 {
-    plat_iio = (mraa_iio_info_t*) calloc(1, sizeof(mraa_iio_info_t));
-    plat_iio->iio_device_count = num_iio_devices;
     // Now detect IIO devices, linux only
     // find how many iio devices we have if we haven't already
     if (num_iio_devices == 0) {
@@ -358,11 +429,14 @@ mraa_iio_detect()
     }
     char name[64], filepath[64];
     int fd, len, i;
-    plat_iio->iio_device_count = num_iio_devices;
-    plat_iio->iio_devices = calloc(num_iio_devices, sizeof(struct _iio));
+    iio->iio_devices = calloc(num_iio_devices, sizeof(struct _iio));
+    if (iio->iio_devices == NULL && num_iio_devices > 0) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    iio->iio_device_count = num_iio_devices;
     struct _iio* device;
     for (i = 0; i < num_iio_devices; i++) {
-        device = &plat_iio->iio_devices[i];
+        device = &iio->iio_devices[i];
         device->num = i;
         snprintf(filepath, 64, "/sys/bus/iio/devices/iio:device%d/name", i);
         fd = open(filepath, O_RDONLY);
@@ -382,6 +456,29 @@ mraa_iio_detect()
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_iio_detect()
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (__atomic_load_n(&plat_iio, __ATOMIC_ACQUIRE) != NULL) {
+        return MRAA_SUCCESS;
+    }
+    pthread_mutex_lock(&init_lock);
+    if (plat_iio == NULL) {
+        mraa_iio_info_t* iio = (mraa_iio_info_t*) calloc(1, sizeof(mraa_iio_info_t));
+        if (iio == NULL) {
+            pthread_mutex_unlock(&init_lock);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        // kept even when the scan failed, there is nothing to find then
+        ret = mraa_iio_scan(iio);
+        __atomic_store_n(&plat_iio, iio, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&init_lock);
+    return ret;
+}
+
 mraa_result_t
 mraa_setup_mux_mapped(mraa_pin_t meta)
 {
@@ -626,13 +723,14 @@ mraa_result_print(mraa_result_t result)
 mraa_boolean_t
 mraa_has_sub_platform()
 {
+    mraa_discover_sub_platforms();
     return (plat != NULL) && (plat->sub_platform != NULL);
 }
 
 mraa_boolean_t
 mraa_pin_mode_test(int pin, mraa_pinmodes_t mode)
 {
-    if (plat == NULL)
+    if (mraa_resolve_platform() == NULL)
         return 0;
 
     mraa_board_t* current_plat = plat;
@@ -695,7 +793,7 @@ mraa_pin_mode_test(int pin, mraa_pinmodes_t mode)
 mraa_platform_t
 mraa_get_platform_type()
 {
-    if (plat == NULL)
+    if (mraa_resolve_platform() == NULL)
         return MRAA_UNKNOWN_PLATFORM;
     return plat->platform_type;
 }
@@ -711,7 +809,7 @@ mraa_get_platform_combined_type()
 unsigned int
 mraa_adc_raw_bits()
 {
-    if (plat == NULL)
+    if (mraa_resolve_platform() == NULL)
         return 0;
 
     if (plat->aio_count == 0)
@@ -740,7 +838,7 @@ mraa_get_platform_adc_raw_bits(uint8_t platform_offset)
 unsigned int
 mraa_adc_supported_bits()
 {
-    if (plat == NULL)
+    if (mraa_resolve_platform() == NULL)
         return 0;
 
     if (plat->aio_count == 0)
@@ -768,26 +866,53 @@ mraa_get_platform_adc_supported_bits(int platform_offset)
 const char*
 mraa_get_platform_name()
 {
-    return platform_name;
+    char* name = __atomic_load_n(&platform_name, __ATOMIC_ACQUIRE);
+    if (name != NULL || mraa_resolve_platform() == NULL) {
+        return name;
+    }
+
+    // composed on first use, after the sub platforms had a chance to show up
+    mraa_boolean_t has_sub_platform = mraa_has_sub_platform();
+    pthread_mutex_lock(&init_lock);
+    if (platform_name == NULL && plat != NULL) {
+        int length = strlen(plat->platform_name) + 1;
+        if (has_sub_platform) {
+            // Account for ' + ' chars
+            length += strlen(plat->sub_platform->platform_name) + 3;
+        }
+        name = calloc(length, sizeof(char));
+        if (name != NULL) {
+            if (has_sub_platform) {
+                snprintf(name, length, "%s + %s", plat->platform_name, plat->sub_platform->platform_name);
+            } else {
+                strncpy(name, plat->platform_name, length);
+            }
+        }
+        __atomic_store_n(&platform_name, name, __ATOMIC_RELEASE);
+    }
+    name = platform_name;
+    pthread_mutex_unlock(&init_lock);
+    return name;
 }
 
 const char*
 mraa_get_platform_version(int platform_offset)
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return NULL;
     }
     if (platform_offset == MRAA_MAIN_PLATFORM_OFFSET) {
         return plat->platform_version;
-    } else {
+    } else if (mraa_has_sub_platform()) {
         return plat->sub_platform->platform_version;
     }
+    return NULL;
 }
 
 int
 mraa_get_uart_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->uart_dev_count;
@@ -796,7 +921,7 @@ mraa_get_uart_count()
 int
 mraa_get_spi_bus_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->spi_bus_count;
@@ -805,7 +930,7 @@ mraa_get_spi_bus_count()
 int
 mraa_get_pwm_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->pwm_dev_count;
@@ -814,7 +939,7 @@ mraa_get_pwm_count()
 int
 mraa_get_gpio_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->gpio_count;
@@ -823,7 +948,7 @@ mraa_get_gpio_count()
 int
 mraa_get_aio_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->aio_count;
@@ -832,7 +957,7 @@ mraa_get_aio_count()
 int
 mraa_get_i2c_bus_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
     return plat->i2c_bus_count;
@@ -841,7 +966,7 @@ mraa_get_i2c_bus_count()
 int
 mraa_get_i2c_bus_id(int i2c_bus)
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
 
@@ -855,7 +980,7 @@ mraa_get_i2c_bus_id(int i2c_bus)
 unsigned int
 mraa_get_pin_count()
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return 0;
     }
     return plat->phy_pin_count;
@@ -878,7 +1003,7 @@ mraa_get_platform_pin_count(uint8_t platform_offset)
 char*
 mraa_get_pin_name(int pin)
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return 0;
     }
 
@@ -901,121 +1026,52 @@ mraa_get_pin_name(int pin)
 int
 mraa_gpio_lookup(const char* pin_name)
 {
-    int i;
-
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
-
-    if (pin_name == NULL || strlen(pin_name) == 0) {
-        return -1;
-    }
-
-    for (i = 0; i < plat->phy_pin_count; i++) {
-        // Skip non GPIO pins
-        if (!(plat->pins[i].capabilities.gpio))
-            continue;
-
-        if (plat->pins[i].name != NULL &&
-            strncmp(pin_name, plat->pins[i].name, strlen(plat->pins[i].name) + 1) == 0) {
-            return i;
-        }
-    }
-    return -1;
+    return mraa_lookup_name(MRAA_LOOKUP_GPIO, pin_name);
 }
 
 int
 mraa_i2c_lookup(const char* i2c_name)
 {
-    int i;
-
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
-
-    if (i2c_name == NULL || strlen(i2c_name) == 0) {
-        return -1;
-    }
-
-    for (i = 0; i < plat->i2c_bus_count; i++) {
-        if (plat->i2c_bus[i].name != NULL &&
-            strncmp(i2c_name, plat->i2c_bus[i].name, strlen(plat->i2c_bus[i].name) + 1) == 0) {
-            return plat->i2c_bus[i].bus_id;
-        }
-    }
-    return -1;
+    return mraa_lookup_name(MRAA_LOOKUP_I2C, i2c_name);
 }
 
 int
 mraa_spi_lookup(const char* spi_name)
 {
-    int i;
-
-    if (plat == NULL) {
-        return -1;
-    }
-
-    if (spi_name == NULL || strlen(spi_name) == 0) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
-
-    for (i = 0; i < plat->spi_bus_count; i++) {
-        if (plat->spi_bus[i].name != NULL &&
-            strncmp(spi_name, plat->spi_bus[i].name, strlen(plat->spi_bus[i].name) + 1) == 0) {
-            return plat->spi_bus[i].bus_id;
-        }
-    }
-    return -1;
+    return mraa_lookup_name(MRAA_LOOKUP_SPI, spi_name);
 }
 
 int
 mraa_pwm_lookup(const char* pwm_name)
 {
-    int i;
-
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
-
-    if (pwm_name == NULL || strlen(pwm_name) == 0) {
-        return -1;
-    }
-
-    for (i = 0; i < plat->pwm_dev_count; i++) {
-        if (plat->pwm_dev[i].name != NULL &&
-            strncmp(pwm_name, plat->pwm_dev[i].name, strlen(plat->pwm_dev[i].name) + 1) == 0) {
-            return plat->pwm_dev[i].index;
-        }
-    }
-    return -1;
+    return mraa_lookup_name(MRAA_LOOKUP_PWM, pwm_name);
 }
 
 int
 mraa_uart_lookup(const char* uart_name)
 {
-    int i;
-
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return -1;
     }
-
-    if (uart_name == NULL || strlen(uart_name) == 0) {
-        return -1;
-    }
-
-    for (i = 0; i < plat->uart_dev_count; i++) {
-        if (plat->uart_dev[i].name != NULL &&
-            strncmp(uart_name, plat->uart_dev[i].name, strlen(plat->uart_dev[i].name) + 1) == 0) {
-            return plat->uart_dev[i].index;
-        }
-    }
-    return -1;
+    return mraa_lookup_name(MRAA_LOOKUP_UART, uart_name);
 }
 
 int
 mraa_get_default_i2c_bus(uint8_t platform_offset)
 {
-    if (plat == NULL)
+    if (mraa_resolve_platform() == NULL)
         return -1;
     if (platform_offset == MRAA_MAIN_PLATFORM_OFFSET) {
         return plat->def_i2c_bus;
@@ -1311,7 +1367,12 @@ mraa_find_i2c_bus(const char* devname, int startfrom)
 mraa_boolean_t
 mraa_is_sub_platform_id(int pin_or_bus)
 {
-    return (pin_or_bus & MRAA_SUB_PLATFORM_MASK) != 0;
+    if ((pin_or_bus & MRAA_SUB_PLATFORM_MASK) == 0) {
+        return 0;
+    }
+    // the first sub platform id asked for attaches the sub platforms
+    mraa_discover_sub_platforms();
+    return 1;
 }
 
 int
@@ -1332,6 +1393,10 @@ mraa_get_iio_device_count()
 #if defined(PERIPHERALMAN)
     return -1;
 #else
+    mraa_iio_detect();
+    if (plat_iio == NULL) {
+        return -1;
+    }
     return plat_iio->iio_device_count;
 #endif
 }
@@ -1339,6 +1404,12 @@ mraa_get_iio_device_count()
 mraa_result_t
 mraa_add_subplatform(mraa_platform_t subplatformtype, const char* dev)
 {
+    // discovered ones come first, as they always did
+    mraa_discover_sub_platforms();
+    if (plat == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
 #if defined(FIRMATA)
     if (subplatformtype == MRAA_GENERIC_FIRMATA) {
         if (plat->sub_platform != NULL) {
@@ -1351,6 +1422,7 @@ mraa_add_subplatform(mraa_platform_t subplatformtype, const char* dev)
         }
         if (mraa_firmata_platform(plat, dev) == MRAA_GENERIC_FIRMATA) {
             syslog(LOG_NOTICE, "mraa: Added firmata subplatform");
+            mraa_lookup_reset();
             return MRAA_SUCCESS;
         }
     }
@@ -1361,7 +1433,7 @@ mraa_add_subplatform(mraa_platform_t subplatformtype, const char* dev)
 #endif
 
     if (subplatformtype == MRAA_GROVEPI) {
-        if (plat == NULL || plat->platform_type == MRAA_UNKNOWN_PLATFORM || plat->i2c_bus_count == 0) {
+        if (plat->platform_type == MRAA_UNKNOWN_PLATFORM || plat->i2c_bus_count == 0) {
             syslog(LOG_NOTICE, "mraa: The GrovePi shield is not supported on this platform!");
             return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
         }
@@ -1379,6 +1451,7 @@ mraa_add_subplatform(mraa_platform_t subplatformtype, const char* dev)
         free(dev_dup);
         if (mraa_grovepi_platform(plat, i2c_bus) == MRAA_GROVEPI) {
             syslog(LOG_NOTICE, "mraa: Added GrovePi subplatform");
+            mraa_lookup_reset();
             return MRAA_SUCCESS;
         }
     }
@@ -1390,12 +1463,14 @@ mraa_result_t
 mraa_remove_subplatform(mraa_platform_t subplatformtype)
 {
     if (subplatformtype != MRAA_FTDI_FT4222) {
-        if (plat == NULL || plat->sub_platform == NULL) {
+        if (!mraa_has_sub_platform()) {
             return MRAA_ERROR_INVALID_PARAMETER;
         }
         free(plat->sub_platform->adv_func);
         free(plat->sub_platform->pins);
         free(plat->sub_platform);
+        plat->sub_platform = NULL;
+        mraa_lookup_reset();
         return MRAA_SUCCESS;
     }
     return MRAA_ERROR_INVALID_PARAMETER;
@@ -1460,7 +1535,9 @@ mraa_add_from_lockfile(const char* imraa_lock_file)
             /* assume we have declared IO so we are preinitialised and wipe the
              * advance func array
              */
-            memset(plat->adv_func, 0, sizeof(mraa_adv_func_t));
+            if (plat->adv_func != NULL) {
+                memset(plat->adv_func, 0, sizeof(mraa_adv_func_t));
+            }
         }
     } else {
         ret = MRAA_ERROR_INVALID_RESOURCE;
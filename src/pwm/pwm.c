@@ -198,7 +198,7 @@ mraa_pwm_init_internal(mraa_adv_func_t* func_table, int chipin, int pin)
 mraa_pwm_context
 mraa_pwm_init(int pin)
 {
-    mraa_board_t* board = plat;
+    mraa_board_t* board = mraa_resolve_platform();
     if (board == NULL) {
         syslog(LOG_ERR, "pwm_init: Platform Not Initialised");
         return NULL;
@@ -263,7 +263,8 @@ mraa_pwm_init(int pin)
 mraa_pwm_context
 mraa_pwm_init_raw(int chipin, int pin)
 {
-    mraa_pwm_context dev = mraa_pwm_init_internal(plat == NULL ? NULL : plat->adv_func , chipin, pin);
+    mraa_board_t* board = mraa_resolve_platform();
+    mraa_pwm_context dev = mraa_pwm_init_internal(board == NULL ? NULL : board->adv_func , chipin, pin);
     if (dev == NULL) {
         syslog(LOG_CRIT, "pwm: Failed to allocate memory for context");
         return NULL;
@@ -0,0 +1,628 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "snapshot/snapshot.h"
+#include "mraa_internal.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <link.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SNAPSHOT_MAGIC "MRAASNAP"
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_DIR "/run/mraa"
+#define SNAPSHOT_NAME "platform.snap"
+#define SNAPSHOT_MAX_SIZE (1024 * 1024)
+#define SNAPSHOT_FNV_BASIS 0xcbf29ce484222325ULL
+#define SNAPSHOT_FNV_PRIME 0x100000001b3ULL
+
+#define SNAPSHOT_MAX_STRINGS                                                                     \
+    (2 + MAX_I2C_BUS_COUNT + MAX_SPI_BUS_COUNT + 2 * MAX_UART_COUNT + 2 * MAX_PWM_COUNT + MAX_LED_COUNT)
+
+typedef void (*mraa_snapshot_hook_t)(void);
+#define SNAPSHOT_HOOKS (sizeof(mraa_adv_func_t) / sizeof(mraa_snapshot_hook_t))
+
+_Static_assert(sizeof(mraa_adv_func_t) % sizeof(mraa_snapshot_hook_t) == 0,
+               "the hook table must only hold function pointers");
+_Static_assert(sizeof(uintptr_t) == sizeof(mraa_snapshot_hook_t),
+               "hook offsets are stored in place of the hooks");
+
+/* A board description compiled from json, not tied to a boot or a library file */
+#define SNAPSHOT_FLAG_BOARD_FILE 0x1
+
+/*
+ * File layout: this header, then the pins, the hook table, the strings and
+ * the board, all pointers stored as offsets into the file. Hooks are stored
+ * as offsets into the library that wrote the snapshot. Board files have no
+ * hooks and leave the boot, hardware and library fields zero.
+ */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t board_size; /**< sizeof(mraa_board_t) of the writer */
+    uint32_t pin_size;   /**< sizeof(mraa_pininfo_t) of the writer */
+    uint32_t hooks_size; /**< sizeof(mraa_adv_func_t) of the writer */
+    uint32_t flags;      /**< SNAPSHOT_FLAG_* */
+    uint32_t reserved;
+    uint64_t size;       /**< of the whole file */
+    uint64_t checksum;   /**< FNV-1a of everything after the header */
+    char boot_id[40];
+    uint64_t hw_hash; /**< device-tree model/compatible and DMI names */
+    uint64_t lib_dev;
+    uint64_t lib_ino;
+    uint64_t lib_size;
+    uint64_t lib_mtime;
+    uint64_t board;    /**< offset of the mraa_board_t */
+    uint64_t adv_func; /**< offset of the hook table, 0 without hooks */
+} mraa_snapshot_header_t;
+
+typedef struct {
+    uintptr_t base;       /**< load address the hooks are stored relative to */
+    uintptr_t text_start; /**< executable segment of the library, relative to base */
+    uintptr_t text_end;
+} mraa_snapshot_lib_t;
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+    int failed;
+} mraa_snapshot_buf_t;
+
+/* Files platform detection looks at, a change in any means another board */
+static const char* mraa_snapshot_identity[] = {
+    "/proc/device-tree/compatible",
+    "/proc/device-tree/model",
+    "/sys/devices/virtual/dmi/id/board_name",
+    "/sys/devices/virtual/dmi/id/product_name",
+};
+
+/* Boards with hooks that only use state the hooks set up themselves. They are
+ * test boards and only cached where MRAA_SNAPSHOT_FILE points, never in the
+ * system location real processes use. */
+static const mraa_platform_t mraa_snapshot_stateless[] = {
+    MRAA_MOCK_PLATFORM,
+};
+
+static uint8_t* mraa_snapshot_map = NULL;
+static size_t mraa_snapshot_map_size = 0;
+
+static uint64_t
+mraa_snapshot_fnv(uint64_t hash, const void* data, size_t len)
+{
+    const uint8_t* p = data;
+    while (len--) {
+        hash ^= *p++;
+        hash *= SNAPSHOT_FNV_PRIME;
+    }
+    return hash;
+}
+
+static int
+mraa_snapshot_path(char* path, size_t size, mraa_boolean_t create)
+{
+    const char* env = getenv(MRAA_SNAPSHOT_ENV_VAR);
+    if (env != NULL) {
+        if (*env == '\0') {
+            return -1;
+        }
+        snprintf(path, size, "%s", env);
+        return 0;
+    }
+
+    if (geteuid() == 0) {
+        if (create && mkdir(SNAPSHOT_DIR, 0755) == -1 && errno != EEXIST) {
+            return -1;
+        }
+        snprintf(path, size, SNAPSHOT_DIR "/" SNAPSHOT_NAME);
+        return 0;
+    }
+
+    // other users keep theirs in their own runtime directory
+    const char* runtime = getenv("XDG_RUNTIME_DIR");
+    if (runtime == NULL || *runtime == '\0') {
+        return -1;
+    }
+    snprintf(path, size, "%s/mraa-" SNAPSHOT_NAME, runtime);
+    return 0;
+}
+
+static int
+mraa_snapshot_find_text(struct dl_phdr_info* info, size_t size, void* data)
+{
+    mraa_snapshot_lib_t* lib = data;
+    uintptr_t self = (uintptr_t) &mraa_snapshot_find_text;
+
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        uintptr_t start = info->dlpi_addr + phdr->p_vaddr;
+        if (phdr->p_type == PT_LOAD && (phdr->p_flags & PF_X) && self >= start && self < start + phdr->p_memsz) {
+            lib->base = info->dlpi_addr;
+            lib->text_start = phdr->p_vaddr;
+            lib->text_end = phdr->p_vaddr + phdr->p_memsz;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Fill in the layout of the structures this library was built with. */
+static void
+mraa_snapshot_layout(mraa_snapshot_header_t* header, uint32_t flags)
+{
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = SNAPSHOT_VERSION;
+    header->board_size = sizeof(mraa_board_t);
+    header->pin_size = sizeof(mraa_pininfo_t);
+    header->hooks_size = sizeof(mraa_adv_func_t);
+    header->flags = flags;
+}
+
+/* Fill in what a snapshot has to match to be used by this process. */
+static int
+mraa_snapshot_key(mraa_snapshot_header_t* header, mraa_snapshot_lib_t* lib)
+{
+    char buf[4096];
+    Dl_info info;
+    struct stat st;
+
+    int fd = open("/proc/sys/kernel/random/boot_id", O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return -1;
+    }
+    ssize_t len = read(fd, header->boot_id, sizeof(header->boot_id) - 1);
+    close(fd);
+    if (len <= 0) {
+        return -1;
+    }
+    header->boot_id[strcspn(header->boot_id, "\r\n")] = '\0';
+
+    uint64_t hash = SNAPSHOT_FNV_BASIS;
+    for (size_t i = 0; i < sizeof(mraa_snapshot_identity) / sizeof(mraa_snapshot_identity[0]); i++) {
+        len = -1;
+        fd = open(mraa_snapshot_identity[i], O_RDONLY | O_CLOEXEC);
+        if (fd != -1) {
+            len = read(fd, buf, sizeof(buf));
+            close(fd);
+        }
+        // a missing file hashes differently from an empty one
+        hash = mraa_snapshot_fnv(hash, &len, sizeof(len));
+        if (len > 0) {
+            hash = mraa_snapshot_fnv(hash, buf, len);
+        }
+    }
+    header->hw_hash = hash;
+
+    // hook offsets are only valid for the very same library file
+    if (dladdr((void*) &mraa_snapshot_key, &info) == 0 || info.dli_fname == NULL ||
+        stat(info.dli_fname, &st) != 0 || dl_iterate_phdr(&mraa_snapshot_find_text, lib) != 1) {
+        return -1;
+    }
+    header->lib_dev = st.st_dev;
+    header->lib_ino = st.st_ino;
+    header->lib_size = st.st_size;
+    header->lib_mtime = (uint64_t) st.st_mtim.tv_sec * 1000000000ULL + st.st_mtim.tv_nsec;
+    return 0;
+}
+
+/* Every string a board points to. */
+static int
+mraa_snapshot_strings(mraa_board_t* board, char** fields[])
+{
+    int n = 0;
+    int i;
+
+    fields[n++] = &board->platform_name;
+    fields[n++] = (char**) &board->platform_version;
+    for (i = 0; i < MAX_I2C_BUS_COUNT; i++) {
+        fields[n++] = &board->i2c_bus[i].name;
+    }
+    for (i = 0; i < MAX_SPI_BUS_COUNT; i++) {
+        fields[n++] = &board->spi_bus[i].name;
+    }
+    for (i = 0; i < MAX_UART_COUNT; i++) {
+        fields[n++] = &board->uart_dev[i].name;
+        fields[n++] = &board->uart_dev[i].device_path;
+    }
+    for (i = 0; i < MAX_PWM_COUNT; i++) {
+        fields[n++] = &board->pwm_dev[i].name;
+        fields[n++] = &board->pwm_dev[i].device_path;
+    }
+    for (i = 0; i < MAX_LED_COUNT; i++) {
+        fields[n++] = &board->led_dev[i].name;
+    }
+    return n;
+}
+
+/* Append to the image, returns the offset or 0 once anything failed. */
+static uint64_t
+mraa_snapshot_put(mraa_snapshot_buf_t* buf, const void* data, size_t len, size_t align)
+{
+    size_t off = (buf->len + align - 1) & ~(align - 1);
+    if (buf->failed) {
+        return 0;
+    }
+    if (off + len > buf->cap) {
+        size_t cap = buf->cap ? buf->cap : 4096;
+        while (cap < off + len) {
+            cap *= 2;
+        }
+        uint8_t* data_new = realloc(buf->data, cap);
+        if (data_new == NULL) {
+            buf->failed = 1;
+            return 0;
+        }
+        memset(data_new + buf->cap, 0, cap - buf->cap);
+        buf->data = data_new;
+        buf->cap = cap;
+    }
+    memcpy(buf->data + off, data, len);
+    buf->len = off + len;
+    return off;
+}
+
+/* Boards allocate their hook table up front, a table of NULLs is no hooks. */
+static mraa_boolean_t
+mraa_snapshot_has_hooks(const mraa_board_t* board)
+{
+    if (board->adv_func != NULL) {
+        const mraa_snapshot_hook_t* hooks = (const mraa_snapshot_hook_t*) board->adv_func;
+        for (size_t i = 0; i < SNAPSHOT_HOOKS; i++) {
+            if (hooks[i] != NULL) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static mraa_boolean_t
+mraa_snapshot_cacheable(const mraa_board_t* board)
+{
+    if (board == NULL || board->platform_type == MRAA_UNKNOWN_PLATFORM ||
+        board->platform_type == MRAA_NULL_PLATFORM || board->platform_type == MRAA_JSON_PLATFORM) {
+        return 0;
+    }
+    // without hooks nothing of the board's code runs after construction
+    if (!mraa_snapshot_has_hooks(board)) {
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(mraa_snapshot_stateless) / sizeof(mraa_snapshot_stateless[0]); i++) {
+        if (board->platform_type == mraa_snapshot_stateless[i]) {
+            return getenv(MRAA_SNAPSHOT_ENV_VAR) != NULL;
+        }
+    }
+    return 0;
+}
+
+/* Write the image of a board, the header is filled in but for the layout. */
+static mraa_result_t
+mraa_snapshot_write(const mraa_board_t* board, mraa_snapshot_header_t header, const mraa_snapshot_lib_t* lib, const char* path)
+{
+    mraa_snapshot_buf_t buf = { NULL, 0, 0, 0 };
+    char tmp[PATH_MAX + 8];
+
+    // copied bytewise so that padding is written as found, not as stack garbage
+    mraa_board_t copy;
+    memcpy(&copy, board, sizeof(copy));
+    copy.sub_platform = NULL;
+    copy.adv_func = NULL;
+    mraa_snapshot_put(&buf, &header, sizeof(header), 1);
+
+    if (board->pins != NULL && board->phy_pin_count > 0) {
+        copy.pins = (mraa_pininfo_t*) (uintptr_t)
+        mraa_snapshot_put(&buf, board->pins, board->phy_pin_count * sizeof(mraa_pininfo_t), 16);
+    } else {
+        copy.pins = NULL;
+    }
+
+    if (board->adv_func != NULL) {
+        mraa_snapshot_hook_t hooks[SNAPSHOT_HOOKS];
+        uintptr_t offsets[SNAPSHOT_HOOKS];
+        memcpy(hooks, board->adv_func, sizeof(hooks));
+        for (size_t i = 0; i < SNAPSHOT_HOOKS; i++) {
+            offsets[i] = 0;
+            if (hooks[i] != NULL) {
+                offsets[i] = (uintptr_t) hooks[i] - lib->base;
+                if (lib->base == 0 || offsets[i] < lib->text_start || offsets[i] >= lib->text_end) {
+                    free(buf.data);
+                    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+                }
+            }
+        }
+        header.adv_func = mraa_snapshot_put(&buf, offsets, sizeof(offsets), 16);
+    }
+
+    char** fields[SNAPSHOT_MAX_STRINGS];
+    int count = mraa_snapshot_strings(&copy, fields);
+    for (int i = 0; i < count; i++) {
+        if (*fields[i] != NULL) {
+            *fields[i] = (char*) (uintptr_t) mraa_snapshot_put(&buf, *fields[i], strlen(*fields[i]) + 1, 1);
+        }
+    }
+
+    header.board = mraa_snapshot_put(&buf, &copy, sizeof(copy), 16);
+    if (buf.failed) {
+        free(buf.data);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    header.size = buf.len;
+    header.checksum = mraa_snapshot_fnv(SNAPSHOT_FNV_BASIS, buf.data + sizeof(header), buf.len - sizeof(header));
+    memcpy(buf.data, &header, sizeof(header));
+
+    // written aside and renamed, a concurrent reader sees the old or the new one
+    snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path);
+    int fd = mkstemp(tmp);
+    if (fd == -1) {
+        free(buf.data);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    size_t done = 0;
+    while (done < buf.len) {
+        ssize_t ret = write(fd, buf.data + done, buf.len - done);
+        if (ret <= 0) {
+            break;
+        }
+        done += ret;
+    }
+    // board files are installed for every user, snapshots stay private
+    if ((header.flags & SNAPSHOT_FLAG_BOARD_FILE) != 0 && fchmod(fd, 0644) != 0) {
+        done = 0;
+    }
+    close(fd);
+    free(buf.data);
+    if (done != header.size || rename(tmp, path) != 0) {
+        unlink(tmp);
+        syslog(LOG_NOTICE, "snapshot: could not write %s", path);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    syslog(LOG_DEBUG, "snapshot: platform written to %s", path);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_snapshot_save(const mraa_board_t* board)
+{
+    mraa_snapshot_header_t header;
+    mraa_snapshot_lib_t lib;
+    char path[PATH_MAX];
+
+    if (!mraa_snapshot_cacheable(board)) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    memset(&header, 0, sizeof(header));
+    mraa_snapshot_layout(&header, 0);
+    if (mraa_snapshot_key(&header, &lib) != 0 || mraa_snapshot_path(path, sizeof(path), 1) != 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    return mraa_snapshot_write(board, header, &lib, path);
+}
+
+mraa_result_t
+mraa_snapshot_write_board(const mraa_board_t* board, const char* path)
+{
+    mraa_snapshot_header_t header;
+    mraa_snapshot_lib_t lib;
+
+    if (board == NULL || path == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    // nothing but data, hooks only mean something to the library that set them
+    if (mraa_snapshot_has_hooks(board)) {
+        syslog(LOG_ERR, "snapshot: %s has hooks and cannot be written as a board file", board->platform_name);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    memset(&header, 0, sizeof(header));
+    memset(&lib, 0, sizeof(lib));
+    mraa_snapshot_layout(&header, SNAPSHOT_FLAG_BOARD_FILE);
+
+    mraa_board_t copy;
+    memcpy(&copy, board, sizeof(copy));
+    copy.adv_func = NULL;
+    return mraa_snapshot_write(&copy, header, &lib, path);
+}
+
+static mraa_boolean_t
+mraa_snapshot_in_map(size_t size, uint64_t off, uint64_t len)
+{
+    return off >= sizeof(mraa_snapshot_header_t) && off <= size && len <= size - off;
+}
+
+/* Check the mapped image against this process and turn offsets into pointers. */
+static mraa_board_t*
+mraa_snapshot_relocate(uint8_t* map, size_t size, uint32_t flags)
+{
+    mraa_snapshot_header_t expect;
+    const mraa_snapshot_header_t* header = (const mraa_snapshot_header_t*) map;
+    mraa_snapshot_lib_t lib;
+
+    memset(&expect, 0, sizeof(expect));
+    memset(&lib, 0, sizeof(lib));
+    mraa_snapshot_layout(&expect, flags);
+    if (memcmp(header->magic, expect.magic, sizeof(expect.magic)) != 0 || header->version != expect.version ||
+        header->board_size != expect.board_size || header->pin_size != expect.pin_size ||
+        header->hooks_size != expect.hooks_size || header->flags != expect.flags || header->size != size) {
+        return NULL;
+    }
+    if ((flags & SNAPSHOT_FLAG_BOARD_FILE) != 0) {
+        if (header->adv_func != 0) {
+            return NULL;
+        }
+    } else if (mraa_snapshot_key(&expect, &lib) != 0 ||
+               memcmp(header->boot_id, expect.boot_id, sizeof(expect.boot_id)) != 0 ||
+               header->hw_hash != expect.hw_hash || header->lib_dev != expect.lib_dev ||
+               header->lib_ino != expect.lib_ino || header->lib_size != expect.lib_size ||
+               header->lib_mtime != expect.lib_mtime) {
+        return NULL;
+    }
+    if (mraa_snapshot_fnv(SNAPSHOT_FNV_BASIS, map + sizeof(*header), size - sizeof(*header)) != header->checksum) {
+        syslog(LOG_WARNING, "snapshot: checksum mismatch");
+        return NULL;
+    }
+
+    if (!mraa_snapshot_in_map(size, header->board, sizeof(mraa_board_t)) || header->board % 16 != 0) {
+        return NULL;
+    }
+    mraa_board_t* board = (mraa_board_t*) (map + header->board);
+    board->sub_platform = NULL;
+
+    uint64_t off = (uintptr_t) board->pins;
+    if (off != 0) {
+        if (board->phy_pin_count <= 0 || off % 16 != 0 ||
+            !mraa_snapshot_in_map(size, off, (uint64_t) board->phy_pin_count * sizeof(mraa_pininfo_t))) {
+            return NULL;
+        }
+        board->pins = (mraa_pininfo_t*) (map + off);
+    }
+
+    char** fields[SNAPSHOT_MAX_STRINGS];
+    int count = mraa_snapshot_strings(board, fields);
+    for (int i = 0; i < count; i++) {
+        off = (uintptr_t) *fields[i];
+        if (off != 0) {
+            if (!mraa_snapshot_in_map(size, off, 1) || memchr(map + off, '\0', size - off) == NULL) {
+                return NULL;
+            }
+            *fields[i] = (char*) (map + off);
+        }
+    }
+
+    board->adv_func = NULL;
+    if (header->adv_func != 0) {
+        mraa_snapshot_hook_t hooks[SNAPSHOT_HOOKS];
+        uintptr_t offsets[SNAPSHOT_HOOKS];
+        if (header->adv_func % 16 != 0 || !mraa_snapshot_in_map(size, header->adv_func, sizeof(offsets))) {
+            return NULL;
+        }
+        memcpy(offsets, map + header->adv_func, sizeof(offsets));
+        for (size_t i = 0; i < SNAPSHOT_HOOKS; i++) {
+            hooks[i] = NULL;
+            if (offsets[i] != 0) {
+                // never call into anything but the code of this library
+                if (offsets[i] < lib.text_start || offsets[i] >= lib.text_end) {
+                    return NULL;
+                }
+                hooks[i] = (mraa_snapshot_hook_t) (lib.base + offsets[i]);
+            }
+        }
+        memcpy(map + header->adv_func, hooks, sizeof(hooks));
+        board->adv_func = (mraa_adv_func_t*) (map + header->adv_func);
+    }
+    return board;
+}
+
+/* Map an image, the result tells whether the file was one at all. */
+static mraa_result_t
+mraa_snapshot_map_file(const char* path, uint32_t flags, mraa_board_t** board)
+{
+    mraa_snapshot_header_t header;
+    struct stat st;
+
+    *board = NULL;
+    if (mraa_snapshot_map != NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd == -1) {
+        return MRAA_ERROR_NO_DATA_AVAILABLE;
+    }
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < (off_t) sizeof(header) ||
+        pread(fd, header.magic, sizeof(header.magic), 0) != sizeof(header.magic) ||
+        memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        close(fd);
+        return MRAA_ERROR_NO_DATA_AVAILABLE;
+    }
+    // hooks are called through snapshots, only trust one nobody else can
+    // write, board files have no hooks and may come from root as well
+    if ((st.st_uid != geteuid() && ((flags & SNAPSHOT_FLAG_BOARD_FILE) == 0 || st.st_uid != 0)) ||
+        (st.st_mode & (S_IWGRP | S_IWOTH)) != 0 || st.st_size > SNAPSHOT_MAX_SIZE) {
+        close(fd);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    uint8_t* map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    *board = mraa_snapshot_relocate(map, st.st_size, flags);
+    if (*board == NULL) {
+        munmap(map, st.st_size);
+        return MRAA_ERROR_INVALID_PLATFORM;
+    }
+    mraa_snapshot_map = map;
+    mraa_snapshot_map_size = st.st_size;
+    return MRAA_SUCCESS;
+}
+
+mraa_board_t*
+mraa_snapshot_load()
+{
+    char path[PATH_MAX];
+    mraa_board_t* board = NULL;
+
+    if (mraa_snapshot_path(path, sizeof(path), 0) != 0) {
+        return NULL;
+    }
+    switch (mraa_snapshot_map_file(path, 0, &board)) {
+        case MRAA_SUCCESS:
+            syslog(LOG_DEBUG, "snapshot: platform loaded from %s", path);
+            break;
+        case MRAA_ERROR_NO_DATA_AVAILABLE:
+            break;
+        default:
+            syslog(LOG_NOTICE, "snapshot: %s does not match this boot, detecting the platform", path);
+            break;
+    }
+    return board;
+}
+
+mraa_result_t
+mraa_snapshot_load_board(const char* path, mraa_board_t** board)
+{
+    mraa_result_t ret = mraa_snapshot_map_file(path, SNAPSHOT_FLAG_BOARD_FILE, board);
+    switch (ret) {
+        case MRAA_SUCCESS:
+            syslog(LOG_NOTICE, "snapshot: platform %s loaded from board file %s", (*board)->platform_name, path);
+            break;
+        case MRAA_ERROR_NO_DATA_AVAILABLE:
+            break;
+        case MRAA_ERROR_INVALID_RESOURCE:
+            syslog(LOG_ERR, "snapshot: %s may be written by other users, not using it", path);
+            break;
+        default:
+            syslog(LOG_ERR, "snapshot: %s was not compiled for this libmraa, run mraa-platform-compile again", path);
+            break;
+    }
+    return ret;
+}
+
+mraa_boolean_t
+mraa_snapshot_owns(const mraa_board_t* board)
+{
+    const uint8_t* p = (const uint8_t*) board;
+    return mraa_snapshot_map != NULL && p >= mraa_snapshot_map && p < mraa_snapshot_map + mraa_snapshot_map_size;
+}
+
+void
+mraa_snapshot_release()
+{
+    if (mraa_snapshot_map != NULL) {
+        munmap(mraa_snapshot_map, mraa_snapshot_map_size);
+        mraa_snapshot_map = NULL;
+        mraa_snapshot_map_size = 0;
+    }
+}
@@ -27,7 +27,9 @@
 #include <errno.h>
 
 #include "spi.h"
+#include "async/bus_queue.h"
 #include "mraa_internal.h"
+#include "stats/io_stats.h"
 
 #define MAX_SIZE 64
 #define SPI_MAX_LENGTH 4096
@@ -47,7 +49,7 @@ mraa_spi_init_internal(mraa_adv_func_t* func_table)
 mraa_spi_context
 mraa_spi_init(int bus)
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         syslog(LOG_ERR, "spi: Platform Not Initialised");
         return NULL;
     }
@@ -122,13 +124,15 @@ mraa_spi_context
 mraa_spi_init_raw(unsigned int bus, unsigned int cs)
 {
     mraa_result_t status = MRAA_SUCCESS;
+    mraa_board_t* board = mraa_resolve_platform();
 
-    mraa_spi_context dev = mraa_spi_init_internal(plat == NULL ? NULL : plat->adv_func);
+    mraa_spi_context dev = mraa_spi_init_internal(board == NULL ? NULL : board->adv_func);
     if (dev == NULL) {
         syslog(LOG_CRIT, "spi: Failed to allocate memory for context");
         status = MRAA_ERROR_NO_RESOURCES;
         goto init_raw_cleanup;
     }
+    dev->busnum = bus;
 
     if (IS_FUNC_DEFINED(dev, spi_init_raw_replace)) {
         status = dev->advance_func->spi_init_raw_replace(dev, bus, cs);
@@ -295,8 +299,8 @@ mraa_spi_bit_per_word(mraa_spi_context dev, unsigned int bits)
     return MRAA_SUCCESS;
 }
 
-int
-mraa_spi_write(mraa_spi_context dev, uint8_t data)
+static int
+_mraa_spi_write(mraa_spi_context dev, uint8_t data)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "spi: write: context is invalid");
@@ -327,7 +331,18 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
 }
 
 int
-mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
+mraa_spi_write(mraa_spi_context dev, uint8_t data)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_spi_write(dev, data);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_SPI_TRANSFER, dev->busnum, start, 1, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "spi: write_word: context is invalid");
@@ -357,8 +372,19 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
     return (int) recv;
 }
 
-mraa_result_t
-mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length)
+int
+mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_spi_write_word(dev, data);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_SPI_TRANSFER, dev->busnum, start, 2, ret >= 0);
+    }
+    return ret;
+}
+
+static mraa_result_t
+_mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "spi: transfer_buf: context is invalid");
@@ -386,7 +412,18 @@ mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int l
 }
 
 mraa_result_t
-mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length)
+mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length)
+{
+    uint64_t start = mraa_stats_begin();
+    mraa_result_t ret = _mraa_spi_transfer_buf(dev, data, rxbuf, length);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_SPI_TRANSFER, dev->busnum, start, length, ret == MRAA_SUCCESS);
+    }
+    return ret;
+}
+
+static mraa_result_t
+_mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "spi: transfer_buf_word: context is invalid");
@@ -413,6 +450,110 @@ mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length)
+{
+    uint64_t start = mraa_stats_begin();
+    mraa_result_t ret = _mraa_spi_transfer_buf_word(dev, data, rxbuf, length);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_SPI_TRANSFER, dev->busnum, start, length, ret == MRAA_SUCCESS);
+    }
+    return ret;
+}
+
+#if defined(MRAA_IOSTATS)
+/* Bytes clocked out by a batch, for the statistics. */
+static size_t
+mraa_spi_batch_length(const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    size_t length = 0;
+
+    for (unsigned int i = 0; segments != NULL && i < num_segments; ++i) {
+        length += segments[i].len;
+    }
+    return length;
+}
+#endif
+
+static mraa_result_t
+_mraa_spi_transfer_batch(mraa_spi_context dev, mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: transfer_batch: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (segments == NULL || num_segments == 0 || num_segments > MRAA_SPI_MAX_SEGMENTS) {
+        syslog(LOG_ERR, "spi: transfer_batch: invalid number of segments %u", num_segments);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (IS_FUNC_DEFINED(dev, spi_transfer_batch_replace)) {
+        return dev->advance_func->spi_transfer_batch_replace(dev, segments, num_segments);
+    }
+
+    struct spi_ioc_transfer msgs[num_segments];
+    memset(msgs, 0, sizeof(msgs));
+
+    for (unsigned int i = 0; i < num_segments; ++i) {
+        msgs[i].tx_buf = (unsigned long) segments[i].tx_buf;
+        msgs[i].rx_buf = (unsigned long) segments[i].rx_buf;
+        msgs[i].len = segments[i].len;
+        msgs[i].speed_hz = segments[i].speed_hz ? segments[i].speed_hz : dev->clock;
+        msgs[i].bits_per_word = segments[i].bits_per_word ? segments[i].bits_per_word : dev->bpw;
+        msgs[i].delay_usecs = segments[i].delay_usecs;
+        msgs[i].cs_change = segments[i].cs_change ? 1 : 0;
+    }
+
+    if (ioctl(dev->devfd, SPI_IOC_MESSAGE(num_segments), msgs) < 0) {
+        syslog(LOG_ERR, "spi: transfer_batch: Failed to perform dev transfer: %s", strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_transfer_batch(mraa_spi_context dev, mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    uint64_t start = mraa_stats_begin();
+    mraa_result_t ret = _mraa_spi_transfer_batch(dev, segments, num_segments);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_SPI_TRANSFER, dev->busnum, start, mraa_spi_batch_length(segments, num_segments), ret == MRAA_SUCCESS);
+    }
+    return ret;
+}
+
+mraa_async_request_t
+mraa_spi_transfer_batch_async(mraa_spi_context dev,
+                              const mraa_spi_segment_t* segments,
+                              unsigned int num_segments,
+                              mraa_async_callback_t cb,
+                              void* args)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: transfer_batch_async: context is invalid");
+        return NULL;
+    }
+
+    if (segments == NULL || num_segments == 0 || num_segments > MRAA_SPI_MAX_SEGMENTS) {
+        syslog(LOG_ERR, "spi: transfer_batch_async: invalid number of segments %u", num_segments);
+        return NULL;
+    }
+
+    return mraa_async_submit(MRAA_ASYNC_SPI, dev->busnum, dev, segments, num_segments, cb, args);
+}
+
+int
+mraa_spi_async_fd(mraa_spi_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: async_fd: context is invalid");
+        return -1;
+    }
+
+    return mraa_async_fd(MRAA_ASYNC_SPI, dev->busnum);
+}
+
 uint8_t*
 mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length)
 {
@@ -447,6 +588,69 @@ mraa_spi_write_buf_word(mraa_spi_context dev, uint16_t* data, int length)
     return recv;
 }
 
+static void*
+mraa_spi_rx_arena(mraa_spi_context dev, size_t size)
+{
+    if (size > dev->rx_arena_size) {
+        void* arena = realloc(dev->rx_arena, size);
+        if (arena == NULL) {
+            syslog(LOG_ERR, "spi: failed to grow receive buffer to %zu bytes", size);
+            return NULL;
+        }
+        dev->rx_arena = arena;
+        dev->rx_arena_size = size;
+    }
+    return dev->rx_arena;
+}
+
+const uint8_t*
+mraa_spi_write_buf_reuse(mraa_spi_context dev, uint8_t* data, int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: write_buf_reuse: context is invalid");
+        return NULL;
+    }
+
+    if (length <= 0) {
+        syslog(LOG_ERR, "spi: write_buf_reuse: invalid length %d", length);
+        return NULL;
+    }
+
+    uint8_t* recv = mraa_spi_rx_arena(dev, sizeof(uint8_t) * length);
+    if (recv == NULL) {
+        return NULL;
+    }
+
+    if (mraa_spi_transfer_buf(dev, data, recv, length) != MRAA_SUCCESS) {
+        return NULL;
+    }
+    return recv;
+}
+
+const uint16_t*
+mraa_spi_write_buf_word_reuse(mraa_spi_context dev, uint16_t* data, int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: write_buf_word_reuse: context is invalid");
+        return NULL;
+    }
+
+    if (length <= 0) {
+        syslog(LOG_ERR, "spi: write_buf_word_reuse: invalid length %d", length);
+        return NULL;
+    }
+
+    uint16_t* recv = mraa_spi_rx_arena(dev, sizeof(uint16_t) * length);
+    if (recv == NULL) {
+        return NULL;
+    }
+
+    if (mraa_spi_transfer_buf_word(dev, data, recv, length) != MRAA_SUCCESS) {
+        return NULL;
+    }
+    return recv;
+}
+
 mraa_result_t
 mraa_spi_stop(mraa_spi_context dev)
 {
@@ -455,6 +659,13 @@ mraa_spi_stop(mraa_spi_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    mraa_async_flush(dev);
+    mraa_stats_release(&dev->stats);
+
+    free(dev->rx_arena);
+    dev->rx_arena = NULL;
+    dev->rx_arena_size = 0;
+
     if (IS_FUNC_DEFINED(dev, spi_stop_replace)) {
         return dev->advance_func->spi_stop_replace(dev);
     }
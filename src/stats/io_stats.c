@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "stats/io_stats.h"
+#include "mraa_internal.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* stats_op_names[MRAA_STATS_OP_COUNT] = {
+    "gpio_write", "i2c_read", "spi_transfer", "uart_read", "uart_write",
+};
+
+#if defined(MRAA_IOSTATS)
+
+/* Each power of two is split in 1 << MRAA_STATS_SUB_BITS buckets. */
+#define MRAA_STATS_SUB_BITS 2
+#define MRAA_STATS_SUB_BUCKETS (1 << MRAA_STATS_SUB_BITS)
+/* Latencies of 2^(MRAA_STATS_MAX_MSB + 1) ns (about 18 minutes) and longer share the last bucket. */
+#define MRAA_STATS_MAX_MSB 39
+#define MRAA_STATS_NUM_BUCKETS (MRAA_STATS_MAX_MSB * MRAA_STATS_SUB_BUCKETS)
+/* Room per line of mraa_stats_snapshot(). */
+#define MRAA_STATS_LINE_SIZE 192
+
+typedef struct {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t errors;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t buckets[MRAA_STATS_NUM_BUCKETS];
+} mraa_stats_counters_t;
+
+struct _mraa_stats {
+    struct _mraa_stats* next;
+    int id;
+    unsigned int serial;
+    mraa_stats_op_t first_op;
+    unsigned int num_ops;
+    mraa_stats_counters_t ops[];
+};
+
+int mraa_stats_active = 0;
+
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct _mraa_stats* stats_head = NULL;
+static unsigned int stats_serial = 0;
+
+static unsigned int
+mraa_stats_bucket(uint64_t ns)
+{
+    if (ns < MRAA_STATS_SUB_BUCKETS) {
+        return ns;
+    }
+    unsigned int msb = 63 - __builtin_clzll(ns);
+    if (msb > MRAA_STATS_MAX_MSB) {
+        return MRAA_STATS_NUM_BUCKETS - 1;
+    }
+    unsigned int shift = msb - MRAA_STATS_SUB_BITS;
+    return (msb - 1) * MRAA_STATS_SUB_BUCKETS + ((ns >> shift) & (MRAA_STATS_SUB_BUCKETS - 1));
+}
+
+/* Largest latency falling in a bucket. */
+static uint64_t
+mraa_stats_bucket_limit(unsigned int bucket)
+{
+    if (bucket < MRAA_STATS_SUB_BUCKETS) {
+        return bucket;
+    }
+    unsigned int msb = bucket / MRAA_STATS_SUB_BUCKETS + 1;
+    unsigned int shift = msb - MRAA_STATS_SUB_BITS;
+    uint64_t sub = MRAA_STATS_SUB_BUCKETS + bucket % MRAA_STATS_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+static uint64_t
+mraa_stats_percentile(const uint64_t* buckets, uint64_t count, unsigned int percent)
+{
+    uint64_t rank = (count * percent + 99) / 100;
+    uint64_t seen = 0;
+
+    for (unsigned int i = 0; i < MRAA_STATS_NUM_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0) {
+            return mraa_stats_bucket_limit(i);
+        }
+    }
+    return 0;
+}
+
+/* The operations a context can perform are those of its type. */
+static void
+mraa_stats_op_range(mraa_stats_op_t op, mraa_stats_op_t* first_op, unsigned int* num_ops)
+{
+    if (op == MRAA_STATS_UART_READ || op == MRAA_STATS_UART_WRITE) {
+        *first_op = MRAA_STATS_UART_READ;
+        *num_ops = 2;
+    } else {
+        *first_op = op;
+        *num_ops = 1;
+    }
+}
+
+static struct _mraa_stats*
+mraa_stats_register(struct _mraa_stats** slot, mraa_stats_op_t op, int id)
+{
+    pthread_mutex_lock(&stats_lock);
+    struct _mraa_stats* stats = *slot;
+    if (stats == NULL) {
+        mraa_stats_op_t first_op;
+        unsigned int num_ops;
+        mraa_stats_op_range(op, &first_op, &num_ops);
+
+        stats = calloc(1, sizeof(struct _mraa_stats) + num_ops * sizeof(mraa_stats_counters_t));
+        if (stats == NULL) {
+            syslog(LOG_CRIT, "stats: Failed to allocate memory for context statistics");
+            pthread_mutex_unlock(&stats_lock);
+            return NULL;
+        }
+        stats->id = id;
+        stats->serial = ++stats_serial;
+        stats->first_op = first_op;
+        stats->num_ops = num_ops;
+        stats->next = stats_head;
+        stats_head = stats;
+        __atomic_store_n(slot, stats, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&stats_lock);
+
+    return stats;
+}
+
+void
+mraa_stats_record(struct _mraa_stats** slot, mraa_stats_op_t op, int id, uint64_t start, size_t bytes, mraa_boolean_t ok)
+{
+    if (start == 0) {
+        return;
+    }
+    uint64_t elapsed = mraa_stats_begin();
+    if (elapsed < start) {
+        // Collection was turned off during the call
+        return;
+    }
+    elapsed -= start;
+
+    struct _mraa_stats* stats = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (stats == NULL && (stats = mraa_stats_register(slot, op, id)) == NULL) {
+        return;
+    }
+
+    mraa_stats_counters_t* counters = &stats->ops[op - stats->first_op];
+    __atomic_fetch_add(&counters->calls, 1, __ATOMIC_RELAXED);
+    if (ok) {
+        __atomic_fetch_add(&counters->bytes, bytes, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&counters->errors, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&counters->total_ns, elapsed, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&counters->buckets[mraa_stats_bucket(elapsed)], 1, __ATOMIC_RELAXED);
+
+    uint64_t max = __atomic_load_n(&counters->max_ns, __ATOMIC_RELAXED);
+    while (elapsed > max &&
+           !__atomic_compare_exchange_n(&counters->max_ns, &max, elapsed, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void
+mraa_stats_release(struct _mraa_stats** slot)
+{
+    pthread_mutex_lock(&stats_lock);
+    struct _mraa_stats* stats = *slot;
+    if (stats != NULL) {
+        struct _mraa_stats** it = &stats_head;
+        while (*it != stats) {
+            it = &(*it)->next;
+        }
+        *it = stats->next;
+        free(stats);
+        *slot = NULL;
+    }
+    pthread_mutex_unlock(&stats_lock);
+}
+
+mraa_result_t
+mraa_stats_enable(mraa_boolean_t enable)
+{
+    __atomic_store_n(&mraa_stats_active, enable ? 1 : 0, __ATOMIC_RELAXED);
+    return MRAA_SUCCESS;
+}
+
+mraa_boolean_t
+mraa_stats_enabled()
+{
+    return __atomic_load_n(&mraa_stats_active, __ATOMIC_RELAXED) ? 1 : 0;
+}
+
+int
+mraa_stats_get(mraa_stats_record_t* records, unsigned int max_records)
+{
+    if (records == NULL && max_records > 0) {
+        syslog(LOG_ERR, "stats: get: records is invalid");
+        return -1;
+    }
+
+    unsigned int count = 0;
+    uint64_t buckets[MRAA_STATS_NUM_BUCKETS];
+
+    pthread_mutex_lock(&stats_lock);
+    for (struct _mraa_stats* stats = stats_head; stats != NULL; stats = stats->next) {
+        for (unsigned int i = 0; i < stats->num_ops; ++i) {
+            mraa_stats_counters_t* counters = &stats->ops[i];
+            uint64_t calls = __atomic_load_n(&counters->calls, __ATOMIC_RELAXED);
+            if (calls == 0) {
+                continue;
+            }
+            if (count < max_records) {
+                mraa_stats_record_t* rec = &records[count];
+                uint64_t in_buckets = 0;
+                for (unsigned int b = 0; b < MRAA_STATS_NUM_BUCKETS; ++b) {
+                    buckets[b] = __atomic_load_n(&counters->buckets[b], __ATOMIC_RELAXED);
+                    in_buckets += buckets[b];
+                }
+                rec->op = stats->first_op + i;
+                rec->id = stats->id;
+                rec->serial = stats->serial;
+                rec->calls = calls;
+                rec->bytes = __atomic_load_n(&counters->bytes, __ATOMIC_RELAXED);
+                rec->errors = __atomic_load_n(&counters->errors, __ATOMIC_RELAXED);
+                rec->total_ns = __atomic_load_n(&counters->total_ns, __ATOMIC_RELAXED);
+                rec->max_ns = __atomic_load_n(&counters->max_ns, __ATOMIC_RELAXED);
+                rec->p50_ns = mraa_stats_percentile(buckets, in_buckets, 50);
+                rec->p99_ns = mraa_stats_percentile(buckets, in_buckets, 99);
+            }
+            count++;
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+
+    return count;
+}
+
+char*
+mraa_stats_snapshot()
+{
+    int count = mraa_stats_get(NULL, 0);
+    mraa_stats_record_t* records = calloc(count > 0 ? count : 1, sizeof(mraa_stats_record_t));
+    char* text = malloc((count + 1) * MRAA_STATS_LINE_SIZE);
+    if (records == NULL || text == NULL) {
+        syslog(LOG_CRIT, "stats: snapshot: Failed to allocate memory");
+        free(records);
+        free(text);
+        return NULL;
+    }
+
+    int available = mraa_stats_get(records, count);
+    if (available < count) {
+        count = available;
+    }
+
+    size_t pos = snprintf(text, MRAA_STATS_LINE_SIZE, "%-12s %5s %6s %12s %12s %8s %10s %10s %10s %10s\n", "op",
+                          "id", "serial", "calls", "bytes", "errors", "avg_ns", "p50_ns", "p99_ns", "max_ns");
+    for (int i = 0; i < count; ++i) {
+        mraa_stats_record_t* rec = &records[i];
+        pos += snprintf(text + pos, MRAA_STATS_LINE_SIZE, "%-12s %5d %6u %12llu %12llu %8llu %10llu %10llu %10llu %10llu\n",
+                        mraa_stats_op_name(rec->op), rec->id, rec->serial, (unsigned long long) rec->calls,
+                        (unsigned long long) rec->bytes, (unsigned long long) rec->errors,
+                        (unsigned long long) (rec->total_ns / rec->calls), (unsigned long long) rec->p50_ns,
+                        (unsigned long long) rec->p99_ns, (unsigned long long) rec->max_ns);
+    }
+    free(records);
+
+    return text;
+}
+
+mraa_result_t
+mraa_stats_reset()
+{
+    pthread_mutex_lock(&stats_lock);
+    for (struct _mraa_stats* stats = stats_head; stats != NULL; stats = stats->next) {
+        memset(stats->ops, 0, stats->num_ops * sizeof(mraa_stats_counters_t));
+    }
+    pthread_mutex_unlock(&stats_lock);
+
+    return MRAA_SUCCESS;
+}
+
+#else
+
+mraa_result_t
+mraa_stats_enable(mraa_boolean_t enable)
+{
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+}
+
+mraa_boolean_t
+mraa_stats_enabled()
+{
+    return 0;
+}
+
+int
+mraa_stats_get(mraa_stats_record_t* records, unsigned int max_records)
+{
+    return -1;
+}
+
+char*
+mraa_stats_snapshot()
+{
+    return NULL;
+}
+
+mraa_result_t
+mraa_stats_reset()
+{
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+}
+
+#endif
+
+const char*
+mraa_stats_op_name(mraa_stats_op_t op)
+{
+    if ((unsigned int) op < MRAA_STATS_OP_COUNT) {
+        return stats_op_names[op];
+    }
+    return NULL;
+}
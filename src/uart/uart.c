@@ -19,6 +19,10 @@
 
 #include "uart.h"
 #include "mraa_internal.h"
+#include "stats/io_stats.h"
+#include "uart/uart_rx.h"
+#include "uart/uart_termios2.h"
+#include "uart/uart_tx.h"
 
 #ifndef CMSPAR
 #define CMSPAR   010000000000
@@ -114,6 +118,7 @@ static unsigned int speed_to_uint(speed_t speedt) {
         { B1200, 1200 },
         { B1800, 1800 },
         { B2400, 2400 },
+        { B4800, 4800 },
         { B9600, 9600 },
         { B19200, 19200 },
         { B38400, 38400 },
@@ -165,7 +170,7 @@ mraa_uart_init_internal(mraa_adv_func_t* func_table)
 mraa_uart_context
 mraa_uart_init(int index)
 {
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         syslog(LOG_ERR, "uart%i: init: platform not initialised", index);
         return NULL;
     }
@@ -236,6 +241,7 @@ mraa_uart_init_raw(const char* path)
 {
     mraa_result_t status = MRAA_SUCCESS;
     mraa_uart_context dev = NULL;
+    mraa_board_t* board = mraa_resolve_platform();
 
     if (!path) {
         syslog(LOG_ERR, "uart: device path undefined");
@@ -243,7 +249,7 @@ mraa_uart_init_raw(const char* path)
         goto init_raw_cleanup;
     }
 
-    dev = mraa_uart_init_internal(plat == NULL ? NULL : plat->adv_func);
+    dev = mraa_uart_init_internal(board == NULL ? NULL : board->adv_func);
     if (dev == NULL) {
         syslog(LOG_ERR, "uart: Failed to allocate memory for context");
         status = MRAA_ERROR_NO_RESOURCES;
@@ -323,6 +329,9 @@ mraa_uart_stop(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    mraa_uart_tx_release(dev);
+    mraa_uart_rx_release(dev);
+
     // just close the device and reset our fd.
     if (dev->fd >= 0) {
         close(dev->fd);
@@ -331,6 +340,8 @@ mraa_uart_stop(mraa_uart_context dev)
         free((void *) dev->path);
     }
 
+    mraa_stats_release(&dev->stats);
+
     free(dev);
 
     return MRAA_SUCCESS;
@@ -341,7 +352,7 @@ mraa_uart_settings(int index, const char **devpath, const char **name, int* baud
     struct termios term;
     int fd;
 
-    if (plat == NULL) {
+    if (mraa_resolve_platform() == NULL) {
         return MRAA_ERROR_PLATFORM_NOT_INITIALISED;
     }
 
@@ -411,7 +422,12 @@ mraa_uart_settings(int index, const char **devpath, const char **name, int* baud
        }
 
        if (baudrate != NULL) {
-           *baudrate = speed_to_uint(cfgetospeed(&term));
+           unsigned int speed;
+           if (mraa_uart_termios2_get_speed(fd, &speed) == MRAA_SUCCESS) {
+               *baudrate = speed;
+           } else {
+               *baudrate = speed_to_uint(cfgetospeed(&term));
+           }
        }
 
        if (ctsrts != NULL) {
@@ -435,6 +451,10 @@ mraa_uart_flush(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->tx != NULL) {
+        return mraa_uart_tx_flush(dev);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_flush_replace)) {
         return dev->advance_func->uart_flush_replace(dev);
     }
@@ -491,8 +511,17 @@ mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud)
     speed_t speed = uint2speed(baud);
     if (speed == B0)
     {
-        syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %i", dev->index, baud);
-        return MRAA_ERROR_INVALID_PARAMETER;
+        // not one of the Bxxx rates, the driver derives the divisor itself
+        if (baud == 0 || mraa_uart_termios2_set_speed(dev->fd, baud) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %u", dev->index, baud);
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        unsigned int actual = 0;
+        if (mraa_uart_get_baudrate(dev, &actual) == MRAA_SUCCESS &&
+            (actual < baud - baud / 50 || actual > baud + baud / 50)) {
+            syslog(LOG_NOTICE, "uart%i: set_baudrate: asked for %u, got %u", dev->index, baud, actual);
+        }
+        return MRAA_SUCCESS;
     }
     cfsetispeed(&termio, speed);
     cfsetospeed(&termio, speed);
@@ -505,6 +534,32 @@ mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_uart_get_baudrate(mraa_uart_context dev, unsigned int* baud)
+{
+    if (!dev || !baud) {
+        syslog(LOG_ERR, "uart: get_baudrate: context or baud is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (IS_FUNC_DEFINED(dev, uart_get_baudrate_replace)) {
+        return dev->advance_func->uart_get_baudrate_replace(dev, baud);
+    }
+
+    // termios2 reports the rate the driver achieved, also for custom rates
+    if (mraa_uart_termios2_get_speed(dev->fd, baud) == MRAA_SUCCESS) {
+        return MRAA_SUCCESS;
+    }
+
+    struct termios termio;
+    if (tcgetattr(dev->fd, &termio)) {
+        syslog(LOG_ERR, "uart%i: get_baudrate: tcgetattr() failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    *baud = speed_to_uint(cfgetospeed(&termio));
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_uart_set_mode(mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits)
 {
@@ -690,7 +745,11 @@ mraa_uart_set_non_blocking(mraa_uart_context dev, mraa_boolean_t nonblock)
     }
 
     if (IS_FUNC_DEFINED(dev, uart_set_non_blocking_replace)) {
-        return dev->advance_func->uart_set_non_blocking_replace(dev, nonblock);
+        mraa_result_t ret = dev->advance_func->uart_set_non_blocking_replace(dev, nonblock);
+        if (ret == MRAA_SUCCESS) {
+            dev->nonblock = nonblock;
+        }
+        return ret;
     }
 
     // get current flags
@@ -708,6 +767,7 @@ mraa_uart_set_non_blocking(mraa_uart_context dev, mraa_boolean_t nonblock)
         syslog(LOG_ERR, "uart%i: non_blocking: failed changing fd blocking state: %s", dev->index, strerror(errno));
         return MRAA_ERROR_UNSPECIFIED;
     }
+    dev->nonblock = nonblock;
 
     return MRAA_SUCCESS;
 }
@@ -725,14 +785,18 @@ mraa_uart_get_dev_path(mraa_uart_context dev)
     return dev->path;
 }
 
-int
-mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
+static int
+_mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
 {
     if (!dev) {
         syslog(LOG_ERR, "uart: read: context is NULL");
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->rx != NULL) {
+        return mraa_uart_rx_read(dev, buf, len);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_read_replace)) {
         return dev->advance_func->uart_read_replace(dev, buf, len);
     }
@@ -746,13 +810,29 @@ mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
 }
 
 int
-mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
+mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_uart_read(dev, buf, len);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_UART_READ, dev->index, start, ret > 0 ? ret : 0, ret >= 0);
+    }
+    return ret;
+}
+
+static int
+_mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
 {
     if (!dev) {
         syslog(LOG_ERR, "uart: write: context is NULL");
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->tx != NULL) {
+        mraa_uart_iovec_t iov = { buf, len };
+        return mraa_uart_tx_queue(dev, &iov, 1);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_write_replace)) {
         return dev->advance_func->uart_write_replace(dev, buf, len);
     }
@@ -765,6 +845,69 @@ mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
     return write(dev->fd, buf, len);
 }
 
+static int
+_mraa_uart_writev(mraa_uart_context dev, const mraa_uart_iovec_t* iov, unsigned int iovcnt)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: writev: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (iov == NULL && iovcnt > 0) {
+        syslog(LOG_ERR, "uart%i: writev: segments are NULL", dev->index);
+        return -1;
+    }
+
+    if (dev->tx != NULL) {
+        return mraa_uart_tx_queue(dev, iov, iovcnt);
+    }
+
+    if (IS_FUNC_DEFINED(dev, uart_write_replace)) {
+        int total = 0;
+        for (unsigned int i = 0; i < iovcnt; ++i) {
+            size_t done = 0;
+            while (done < iov[i].length) {
+                int ret = dev->advance_func->uart_write_replace(dev, iov[i].data + done, iov[i].length - done);
+                if (ret < 0) {
+                    return ret;
+                }
+                done += ret;
+            }
+            total += done;
+        }
+        return total;
+    }
+
+    if (dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: writev: port is not open", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    return mraa_uart_tx_writev_fd(dev->fd, iov, iovcnt, NULL);
+}
+
+int
+mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_uart_write(dev, buf, len);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_UART_WRITE, dev->index, start, ret > 0 ? ret : 0, ret >= 0);
+    }
+    return ret;
+}
+
+int
+mraa_uart_writev(mraa_uart_context dev, const mraa_uart_iovec_t* iov, unsigned int iovcnt)
+{
+    uint64_t start = mraa_stats_begin();
+    int ret = _mraa_uart_writev(dev, iov, iovcnt);
+    if (dev != NULL) {
+        mraa_stats_record(&dev->stats, MRAA_STATS_UART_WRITE, dev->index, start, ret > 0 ? ret : 0, ret >= 0);
+    }
+    return ret;
+}
+
 mraa_boolean_t
 mraa_uart_data_available(mraa_uart_context dev, unsigned int millis)
 {
@@ -773,6 +916,10 @@ mraa_uart_data_available(mraa_uart_context dev, unsigned int millis)
         return 0;
     }
 
+    if (dev->rx != NULL) {
+        return mraa_uart_rx_available(dev, millis);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_data_available_replace)) {
         return dev->advance_func->uart_data_available_replace(dev, millis);
     }
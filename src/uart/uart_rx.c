@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart/uart_rx.h"
+#include "mraa_internal.h"
+#include "uart.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/serial.h>
+#endif
+
+struct _uart_rx_mark {
+    size_t end; /**< ring position right after the received chunk */
+    uint64_t ns; /**< when the chunk was received */
+};
+
+/*
+ * The engine thread is the only producer and the reader of the context the
+ * only consumer, head and tail are free running counters.
+ */
+struct _uart_rx {
+    pthread_t thread;
+    int fd;       /**< read by the engine */
+    mraa_boolean_t own_fd; /**< fd comes from uart_rx_open_replace */
+    int wake_fd;  /**< eventfd used to stop the engine */
+    char* ring;   /**< ring, or frame buffer when framing */
+    size_t size;  /**< power of two when used as a ring */
+    size_t head;  /**< consumer position */
+    size_t tail;  /**< producer position */
+    char* chunk;  /**< read buffer of the parser, or for dropped bytes */
+    struct _uart_rx_mark marks[MRAA_UART_RX_MARKS];
+    unsigned int mark_head;
+    unsigned int mark_tail;
+    mraa_boolean_t framed;
+    mraa_uart_framer_t framer;
+    size_t frame_len;  /**< bytes of the current frame in the buffer */
+    size_t frame_need; /**< payload still expected by the length prefixed framer */
+    unsigned int prefix_len; /**< length prefix bytes seen so far */
+    mraa_boolean_t discard; /**< dropping the rest of an oversized frame */
+    int waiting;  /**< a reader sleeps on cond */
+    int ended;    /**< the engine stopped on its own */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint64_t bytes;
+    uint64_t reads;
+    uint64_t frames;
+    uint64_t overruns;
+    uint64_t framing_errors;
+    uint64_t latency_total_ns;
+    uint64_t latency_count;
+    uint64_t latency_max_ns;
+};
+
+static uint64_t
+mraa_uart_rx_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void
+mraa_uart_rx_latency(struct _uart_rx* rx, uint64_t received, uint64_t now)
+{
+    uint64_t ns = now > received ? now - received : 0;
+    uint64_t max = __atomic_load_n(&rx->latency_max_ns, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&rx->latency_total_ns, ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&rx->latency_count, 1, __ATOMIC_RELAXED);
+    while (ns > max &&
+           !__atomic_compare_exchange_n(&rx->latency_max_ns, &max, ns, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/* Wake a reader sleeping in mraa_uart_rx_wait(). */
+static void
+mraa_uart_rx_notify(struct _uart_rx* rx)
+{
+    if (__atomic_load_n(&rx->waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&rx->lock);
+        pthread_cond_broadcast(&rx->cond);
+        pthread_mutex_unlock(&rx->lock);
+    }
+}
+
+static void
+mraa_uart_rx_deliver(struct _uart_rx* rx, uint64_t received)
+{
+    rx->framer.callback(rx->ring, rx->frame_len, rx->framer.args);
+    __atomic_fetch_add(&rx->frames, 1, __ATOMIC_RELAXED);
+    mraa_uart_rx_latency(rx, received, mraa_uart_rx_now());
+    rx->frame_len = 0;
+}
+
+/* Append to the current frame, an oversized frame is dropped as a whole. */
+static void
+mraa_uart_rx_append(struct _uart_rx* rx, const char* data, size_t len)
+{
+    if (rx->discard) {
+        return;
+    }
+    if (rx->frame_len + len > rx->size) {
+        __atomic_fetch_add(&rx->framing_errors, 1, __ATOMIC_RELAXED);
+        rx->discard = 1;
+        rx->frame_len = 0;
+        return;
+    }
+    memcpy(rx->ring + rx->frame_len, data, len);
+    rx->frame_len += len;
+}
+
+static void
+mraa_uart_rx_parse(struct _uart_rx* rx, const char* data, size_t len, uint64_t received)
+{
+    while (len > 0) {
+        size_t take;
+
+        switch (rx->framer.type) {
+            case MRAA_UART_FRAME_DELIMITER: {
+                const char* end = memchr(data, (int) rx->framer.param, len);
+                take = end == NULL ? len : (size_t)(end - data) + 1;
+                mraa_uart_rx_append(rx, data, end == NULL ? len : take - 1);
+                if (end != NULL) {
+                    if (!rx->discard) {
+                        mraa_uart_rx_deliver(rx, received);
+                    }
+                    rx->discard = 0;
+                }
+                break;
+            }
+            case MRAA_UART_FRAME_FIXED:
+                take = rx->framer.param - rx->frame_len;
+                if (take > len) {
+                    take = len;
+                }
+                mraa_uart_rx_append(rx, data, take);
+                if (rx->frame_len == rx->framer.param) {
+                    mraa_uart_rx_deliver(rx, received);
+                }
+                break;
+            default:
+                if (rx->prefix_len < rx->framer.param) {
+                    // length prefix, most significant byte first
+                    rx->frame_need = (rx->frame_need << 8) | (uint8_t) data[0];
+                    take = 1;
+                    if (++rx->prefix_len == rx->framer.param) {
+                        rx->frame_len = 0;
+                        rx->discard = 0;
+                        if (rx->frame_need > rx->size) {
+                            __atomic_fetch_add(&rx->framing_errors, 1, __ATOMIC_RELAXED);
+                            rx->discard = 1;
+                        }
+                    }
+                } else {
+                    take = rx->frame_need < len ? rx->frame_need : len;
+                    mraa_uart_rx_append(rx, data, take);
+                    rx->frame_need -= take;
+                }
+                if (rx->prefix_len == rx->framer.param && rx->frame_need == 0) {
+                    if (!rx->discard) {
+                        mraa_uart_rx_deliver(rx, received);
+                    }
+                    rx->discard = 0;
+                    rx->prefix_len = 0;
+                }
+                break;
+        }
+        data += take;
+        len -= take;
+    }
+}
+
+/* Read once into the free part of the ring, or drop what cannot fit. */
+static ssize_t
+mraa_uart_rx_fill(struct _uart_rx* rx)
+{
+    size_t head = __atomic_load_n(&rx->head, __ATOMIC_ACQUIRE);
+    size_t room = rx->size - (rx->tail - head);
+
+    if (room == 0) {
+        ssize_t len = read(rx->fd, rx->chunk, MRAA_UART_RX_CHUNK);
+        if (len > 0) {
+            __atomic_fetch_add(&rx->overruns, len, __ATOMIC_RELAXED);
+        }
+        return len;
+    }
+
+    size_t offset = rx->tail & (rx->size - 1);
+    if (room > rx->size - offset) {
+        room = rx->size - offset;
+    }
+    ssize_t len = read(rx->fd, rx->ring + offset, room);
+    if (len <= 0) {
+        return len;
+    }
+
+    // Readers may miss a mark when they are far behind, not data
+    if (rx->mark_tail - __atomic_load_n(&rx->mark_head, __ATOMIC_ACQUIRE) < MRAA_UART_RX_MARKS) {
+        struct _uart_rx_mark* mark = &rx->marks[rx->mark_tail % MRAA_UART_RX_MARKS];
+        mark->end = rx->tail + len;
+        mark->ns = mraa_uart_rx_now();
+        __atomic_store_n(&rx->mark_tail, rx->mark_tail + 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&rx->tail, rx->tail + len, __ATOMIC_SEQ_CST);
+    mraa_uart_rx_notify(rx);
+
+    return len;
+}
+
+static void*
+mraa_uart_rx_engine(void* arg)
+{
+    struct _uart_rx* rx = (struct _uart_rx*) arg;
+    struct pollfd pfd[2];
+
+    pfd[0].fd = rx->fd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = rx->wake_fd;
+    pfd[1].events = POLLIN;
+
+    for (;;) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "uart: rx: poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (pfd[1].revents & POLLIN) {
+            break;
+        }
+        if (!(pfd[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            continue;
+        }
+
+        ssize_t len;
+        if (rx->framed) {
+            len = read(rx->fd, rx->chunk, MRAA_UART_RX_CHUNK);
+            if (len > 0) {
+                mraa_uart_rx_parse(rx, rx->chunk, len, mraa_uart_rx_now());
+            }
+        } else {
+            len = mraa_uart_rx_fill(rx);
+        }
+        if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+            continue;
+        }
+        if (len <= 0) {
+            if (len < 0) {
+                syslog(LOG_ERR, "uart: rx: read failed: %s", strerror(errno));
+            }
+            break;
+        }
+        __atomic_fetch_add(&rx->reads, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&rx->bytes, len, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&rx->ended, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&rx->lock);
+    pthread_cond_broadcast(&rx->cond);
+    pthread_mutex_unlock(&rx->lock);
+
+    return NULL;
+}
+
+static void
+mraa_uart_rx_free(struct _uart_rx* rx)
+{
+    if (rx->own_fd && rx->fd >= 0) {
+        close(rx->fd);
+    }
+    if (rx->wake_fd >= 0) {
+        close(rx->wake_fd);
+    }
+    free(rx->ring);
+    free(rx->chunk);
+    pthread_cond_destroy(&rx->cond);
+    pthread_mutex_destroy(&rx->lock);
+    free(rx);
+}
+
+mraa_result_t
+mraa_uart_rx_start(mraa_uart_context dev, size_t ring_size, const mraa_uart_framer_t* framer)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "uart: rx_start: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (ring_size == 0 || ring_size > (SIZE_MAX >> 2)) {
+        syslog(LOG_ERR, "uart%i: rx_start: invalid ring size", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (framer != NULL &&
+        (framer->callback == NULL || framer->type > MRAA_UART_FRAME_LENGTH_PREFIXED ||
+         (framer->type == MRAA_UART_FRAME_DELIMITER && framer->param > 0xff) ||
+         (framer->type == MRAA_UART_FRAME_FIXED && (framer->param == 0 || framer->param > ring_size)) ||
+         (framer->type == MRAA_UART_FRAME_LENGTH_PREFIXED && (framer->param < 1 || framer->param > 2)))) {
+        syslog(LOG_ERR, "uart%i: rx_start: invalid framer", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->rx != NULL) {
+        syslog(LOG_ERR, "uart%i: rx_start: receive engine already running", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    struct _uart_rx* rx = calloc(1, sizeof(struct _uart_rx));
+    if (rx == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    pthread_mutex_init(&rx->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&rx->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    rx->fd = -1;
+    rx->wake_fd = eventfd(0, EFD_CLOEXEC);
+
+    if (framer != NULL) {
+        rx->framed = 1;
+        rx->framer = *framer;
+        rx->size = ring_size;
+    } else {
+        // A power of two keeps the ring positions a mask away from offsets
+        rx->size = 1;
+        while (rx->size < ring_size) {
+            rx->size <<= 1;
+        }
+    }
+    rx->ring = malloc(rx->size);
+    rx->chunk = malloc(MRAA_UART_RX_CHUNK);
+    if (rx->wake_fd < 0 || rx->ring == NULL || rx->chunk == NULL) {
+        mraa_uart_rx_free(rx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    if (IS_FUNC_DEFINED(dev, uart_rx_open_replace)) {
+        rx->own_fd = 1;
+        rx->fd = dev->advance_func->uart_rx_open_replace(dev);
+    } else if (!IS_FUNC_DEFINED(dev, uart_read_replace)) {
+        rx->fd = dev->fd;
+    }
+    if (rx->fd < 0) {
+        syslog(LOG_ERR, "uart%i: rx_start: no file descriptor to receive from", dev->index);
+        mraa_uart_rx_free(rx);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (pthread_create(&rx->thread, NULL, mraa_uart_rx_engine, rx) != 0) {
+        syslog(LOG_ERR, "uart%i: rx_start: failed to start receive thread", dev->index);
+        mraa_uart_rx_free(rx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->rx = rx;
+    return MRAA_SUCCESS;
+}
+
+/* Wait until the ring has data, the engine ended or the timeout expired. */
+static size_t
+mraa_uart_rx_wait(struct _uart_rx* rx, int timeout_ms)
+{
+    size_t pending = __atomic_load_n(&rx->tail, __ATOMIC_ACQUIRE) - rx->head;
+    if (pending > 0 || timeout_ms == 0) {
+        return pending;
+    }
+
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&rx->lock);
+    __atomic_store_n(&rx->waiting, 1, __ATOMIC_SEQ_CST);
+    for (;;) {
+        // Checked after announcing the wait, the engine checks the other way round
+        pending = __atomic_load_n(&rx->tail, __ATOMIC_SEQ_CST) - rx->head;
+        if (pending > 0 || __atomic_load_n(&rx->ended, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&rx->cond, &rx->lock);
+        } else if (pthread_cond_timedwait(&rx->cond, &rx->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    __atomic_store_n(&rx->waiting, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&rx->lock);
+
+    return pending;
+}
+
+int
+mraa_uart_rx_read(mraa_uart_context dev, char* buf, size_t len)
+{
+    struct _uart_rx* rx = dev->rx;
+
+    if (rx->framed) {
+        syslog(LOG_ERR, "uart%i: read: frames are delivered to the framer callback", dev->index);
+        return -1;
+    }
+
+    // An empty ring reads like a non blocking tty with nothing received
+    size_t pending = mraa_uart_rx_wait(rx, dev->nonblock ? 0 : -1);
+    if (pending == 0 && dev->nonblock && len > 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    size_t num = pending < len ? pending : len;
+    size_t offset = rx->head & (rx->size - 1);
+    size_t first = rx->size - offset < num ? rx->size - offset : num;
+
+    memcpy(buf, rx->ring + offset, first);
+    memcpy(buf + first, rx->ring, num - first);
+    size_t head = rx->head + num;
+    __atomic_store_n(&rx->head, head, __ATOMIC_RELEASE);
+
+    // Account the receptions that are now fully consumed
+    uint64_t now = 0;
+    unsigned int mark_head = rx->mark_head;
+    while (mark_head != __atomic_load_n(&rx->mark_tail, __ATOMIC_ACQUIRE)) {
+        struct _uart_rx_mark* mark = &rx->marks[mark_head % MRAA_UART_RX_MARKS];
+        if (mark->end > head) {
+            break;
+        }
+        if (now == 0) {
+            now = mraa_uart_rx_now();
+        }
+        mraa_uart_rx_latency(rx, mark->ns, now);
+        mark_head++;
+    }
+    __atomic_store_n(&rx->mark_head, mark_head, __ATOMIC_RELEASE);
+
+    return num;
+}
+
+mraa_boolean_t
+mraa_uart_rx_available(mraa_uart_context dev, unsigned int millis)
+{
+    if (dev->rx->framed) {
+        return 0;
+    }
+    return mraa_uart_rx_wait(dev->rx, millis > INT32_MAX ? INT32_MAX : (int) millis) > 0;
+}
+
+mraa_result_t
+mraa_uart_rx_stats(mraa_uart_context dev, mraa_uart_rx_stats_t* stats)
+{
+    if (dev == NULL || dev->rx == NULL) {
+        syslog(LOG_ERR, "uart: rx_stats: context is NULL or receive engine not running");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct _uart_rx* rx = dev->rx;
+    memset(stats, 0, sizeof(*stats));
+    stats->bytes = __atomic_load_n(&rx->bytes, __ATOMIC_RELAXED);
+    stats->reads = __atomic_load_n(&rx->reads, __ATOMIC_RELAXED);
+    stats->frames = __atomic_load_n(&rx->frames, __ATOMIC_RELAXED);
+    stats->overruns = __atomic_load_n(&rx->overruns, __ATOMIC_RELAXED);
+    stats->framing_errors = __atomic_load_n(&rx->framing_errors, __ATOMIC_RELAXED);
+    stats->latency_max_ns = __atomic_load_n(&rx->latency_max_ns, __ATOMIC_RELAXED);
+    uint64_t count = __atomic_load_n(&rx->latency_count, __ATOMIC_RELAXED);
+    if (count > 0) {
+        stats->latency_avg_ns = __atomic_load_n(&rx->latency_total_ns, __ATOMIC_RELAXED) / count;
+    }
+
+#if defined(__linux__) && defined(TIOCGICOUNT)
+    // Overruns of the driver and of the tty flip buffer, not available on ptys
+    struct serial_icounter_struct icount;
+    if (ioctl(rx->fd, TIOCGICOUNT, &icount) == 0) {
+        stats->hw_overruns = (uint64_t) icount.overrun + icount.buf_overrun;
+    }
+#endif
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_rx_stop(mraa_uart_context dev)
+{
+    if (dev == NULL || dev->rx == NULL) {
+        syslog(LOG_ERR, "uart: rx_stop: context is NULL or receive engine not running");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    struct _uart_rx* rx = dev->rx;
+    uint64_t wake = 1;
+
+    if (write(rx->wake_fd, &wake, sizeof(wake)) != sizeof(wake)) {
+        syslog(LOG_ERR, "uart%i: rx_stop: failed to wake receive thread", dev->index);
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(rx->thread, NULL);
+
+    dev->rx = NULL;
+    mraa_uart_rx_free(rx);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_uart_rx_release(mraa_uart_context dev)
+{
+    if (dev != NULL && dev->rx != NULL) {
+        mraa_uart_rx_stop(dev);
+    }
+}
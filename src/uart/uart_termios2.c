@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart/uart_termios2.h"
+
+#if defined(__linux__) && !defined(MSYS)
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+#endif
+
+#if defined(TCGETS2) && defined(BOTHER)
+
+mraa_result_t
+mraa_uart_termios2_set_speed(int fd, unsigned int baud)
+{
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) != 0) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ispeed = baud;
+    tio.c_ospeed = baud;
+    // TCSETSF2 drains output and flushes input like TCSAFLUSH
+    if (ioctl(fd, TCSETSF2, &tio) != 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_termios2_get_speed(int fd, unsigned int* baud)
+{
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) != 0) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    *baud = tio.c_ospeed;
+    return MRAA_SUCCESS;
+}
+
+#else
+
+mraa_result_t
+mraa_uart_termios2_set_speed(int fd, unsigned int baud)
+{
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+}
+
+mraa_result_t
+mraa_uart_termios2_get_speed(int fd, unsigned int* baud)
+{
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart/uart_tx.h"
+#include "mraa_internal.h"
+#include "uart.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*
+ * Writers append to the ring one at a time under queue_lock, the engine
+ * thread is the only consumer. head, tail and drained are free running
+ * counters.
+ */
+struct _uart_tx {
+    pthread_t thread;
+    mraa_uart_context dev;
+    int kick_fd;   /**< eventfd waking an idle engine */
+    int drain_fd;  /**< eventfd signalled after every drain */
+    void (*drained_cb)(void* args);
+    void* args;
+    char* ring;
+    size_t size;    /**< power of two */
+    size_t head;    /**< sent up to here */
+    size_t tail;    /**< queued up to here */
+    size_t drained; /**< left the wire up to here */
+    int idle;      /**< the engine sleeps on kick_fd */
+    int waiting;   /**< writers and flushers sleeping on cond */
+    int stopping;
+    int ended;     /**< the engine stopped */
+    pthread_mutex_t queue_lock; /**< keeps the segments of a write together */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint64_t bytes;
+    uint64_t writes;
+    uint64_t requests;
+    uint64_t would_block;
+    uint64_t drains;
+    size_t max_fill;
+};
+
+ssize_t
+mraa_uart_tx_writev_fd(int fd, const mraa_uart_iovec_t* iov, unsigned int iovcnt, uint64_t* would_block)
+{
+    struct iovec vec[MRAA_UART_TX_IOV_MAX];
+    unsigned int next = 0;
+    size_t skip = 0; /**< bytes of iov[next] already written */
+    ssize_t total = 0;
+
+    for (;;) {
+        while (next < iovcnt && iov[next].length == skip) {
+            next++;
+            skip = 0;
+        }
+        if (next == iovcnt) {
+            return total;
+        }
+
+        unsigned int cnt = 0;
+        for (unsigned int i = next; i < iovcnt && cnt < MRAA_UART_TX_IOV_MAX; ++i) {
+            size_t offset = i == next ? skip : 0;
+            if (iov[i].length > offset) {
+                vec[cnt].iov_base = (char*) iov[i].data + offset;
+                vec[cnt].iov_len = iov[i].length - offset;
+                cnt++;
+            }
+        }
+
+        ssize_t len = writev(fd, vec, cnt);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return -1;
+            }
+            // Non blocking descriptor with a full driver buffer
+            if (would_block != NULL) {
+                __atomic_fetch_add(would_block, 1, __ATOMIC_RELAXED);
+            }
+            struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+                return -1;
+            }
+            continue;
+        }
+
+        total += len;
+        while (len > 0) {
+            size_t left = iov[next].length - skip;
+            if ((size_t) len < left) {
+                skip += len;
+                break;
+            }
+            len -= left;
+            next++;
+            skip = 0;
+        }
+    }
+}
+
+/* Wake writers and flushers sleeping in mraa_uart_tx_wait(). */
+static void
+mraa_uart_tx_notify(struct _uart_tx* tx)
+{
+    if (__atomic_load_n(&tx->waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&tx->lock);
+        pthread_cond_broadcast(&tx->cond);
+        pthread_mutex_unlock(&tx->lock);
+    }
+}
+
+/* Send the queued bytes from head to tail, in up to two segments. */
+static ssize_t
+mraa_uart_tx_send(struct _uart_tx* tx, size_t head, size_t tail)
+{
+    mraa_uart_context dev = tx->dev;
+    mraa_uart_iovec_t iov[2];
+    unsigned int iovcnt = 1;
+    size_t offset = head & (tx->size - 1);
+    size_t len = tail - head;
+
+    iov[0].data = tx->ring + offset;
+    iov[0].length = len;
+    if (len > tx->size - offset) {
+        iov[0].length = tx->size - offset;
+        iov[1].data = tx->ring;
+        iov[1].length = len - iov[0].length;
+        iovcnt = 2;
+    }
+
+    if (!IS_FUNC_DEFINED(dev, uart_write_replace)) {
+        __atomic_fetch_add(&tx->writes, 1, __ATOMIC_RELAXED);
+        return mraa_uart_tx_writev_fd(dev->fd, iov, iovcnt, &tx->would_block);
+    }
+
+    for (unsigned int i = 0; i < iovcnt; ++i) {
+        size_t done = 0;
+        while (done < iov[i].length) {
+            int ret = dev->advance_func->uart_write_replace(dev, iov[i].data + done, iov[i].length - done);
+            __atomic_fetch_add(&tx->writes, 1, __ATOMIC_RELAXED);
+            if (ret < 0) {
+                return -1;
+            }
+            done += ret;
+        }
+    }
+    return len;
+}
+
+/* Wait for the hardware to send everything and tell whoever listens. */
+static void
+mraa_uart_tx_drain(struct _uart_tx* tx, size_t head)
+{
+    mraa_uart_context dev = tx->dev;
+    uint64_t one = 1;
+
+    if (IS_FUNC_DEFINED(dev, uart_flush_replace)) {
+        dev->advance_func->uart_flush_replace(dev);
+    } else {
+        while (tcdrain(dev->fd) == -1 && errno == EINTR) {
+        }
+    }
+
+    __atomic_store_n(&tx->drained, head, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&tx->drains, 1, __ATOMIC_RELAXED);
+    if (write(tx->drain_fd, &one, sizeof(one)) != sizeof(one)) {
+        syslog(LOG_WARNING, "uart%i: tx: failed to signal drain", dev->index);
+    }
+    if (tx->drained_cb != NULL) {
+        tx->drained_cb(tx->args);
+    }
+    mraa_uart_tx_notify(tx);
+}
+
+static void*
+mraa_uart_tx_engine(void* arg)
+{
+    struct _uart_tx* tx = (struct _uart_tx*) arg;
+    struct pollfd pfd = { .fd = tx->kick_fd, .events = POLLIN };
+    uint64_t kick;
+
+    for (;;) {
+        size_t head = tx->head;
+        size_t tail = __atomic_load_n(&tx->tail, __ATOMIC_ACQUIRE);
+
+        if (tail != head) {
+            // Everything queued since the last round goes out with one writev()
+            ssize_t len = mraa_uart_tx_send(tx, head, tail);
+            if (len < 0) {
+                syslog(LOG_ERR, "uart%i: tx: write failed: %s", tx->dev->index, strerror(errno));
+                break;
+            }
+            __atomic_fetch_add(&tx->bytes, len, __ATOMIC_RELAXED);
+            __atomic_store_n(&tx->head, tail, __ATOMIC_SEQ_CST);
+            mraa_uart_tx_notify(tx);
+            continue;
+        }
+
+        if (__atomic_load_n(&tx->drained, __ATOMIC_RELAXED) != head) {
+            mraa_uart_tx_drain(tx, head);
+            continue;
+        }
+        if (__atomic_load_n(&tx->stopping, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+
+        // Announce the sleep before checking the queue once more, writers
+        // check the other way round
+        __atomic_store_n(&tx->idle, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&tx->tail, __ATOMIC_SEQ_CST) == head && !__atomic_load_n(&tx->stopping, __ATOMIC_SEQ_CST)) {
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+                syslog(LOG_ERR, "uart%i: tx: poll failed: %s", tx->dev->index, strerror(errno));
+                break;
+            }
+        }
+        __atomic_store_n(&tx->idle, 0, __ATOMIC_SEQ_CST);
+        if (read(tx->kick_fd, &kick, sizeof(kick)) < 0 && errno != EAGAIN) {
+            break;
+        }
+    }
+
+    __atomic_store_n(&tx->ended, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&tx->lock);
+    pthread_cond_broadcast(&tx->cond);
+    pthread_mutex_unlock(&tx->lock);
+
+    return NULL;
+}
+
+static void
+mraa_uart_tx_kick(struct _uart_tx* tx)
+{
+    uint64_t one = 1;
+
+    if (write(tx->kick_fd, &one, sizeof(one)) != sizeof(one)) {
+        syslog(LOG_ERR, "uart%i: tx: failed to wake transmit thread", tx->dev->index);
+    }
+}
+
+static void
+mraa_uart_tx_free(struct _uart_tx* tx)
+{
+    if (tx->kick_fd >= 0) {
+        close(tx->kick_fd);
+    }
+    if (tx->drain_fd >= 0) {
+        close(tx->drain_fd);
+    }
+    free(tx->ring);
+    pthread_cond_destroy(&tx->cond);
+    pthread_mutex_destroy(&tx->lock);
+    pthread_mutex_destroy(&tx->queue_lock);
+    free(tx);
+}
+
+mraa_result_t
+mraa_uart_tx_start(mraa_uart_context dev, size_t queue_size, void (*drained)(void* args), void* args)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "uart: tx_start: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (queue_size == 0 || queue_size > (SIZE_MAX >> 2)) {
+        syslog(LOG_ERR, "uart%i: tx_start: invalid queue size", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->tx != NULL) {
+        syslog(LOG_ERR, "uart%i: tx_start: transmit engine already running", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    if (!IS_FUNC_DEFINED(dev, uart_write_replace) && dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: tx_start: port is not open", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    struct _uart_tx* tx = calloc(1, sizeof(struct _uart_tx));
+    if (tx == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    pthread_mutex_init(&tx->queue_lock, NULL);
+    pthread_mutex_init(&tx->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&tx->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    tx->dev = dev;
+    tx->drained_cb = drained;
+    tx->args = args;
+    tx->kick_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    tx->drain_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    // A power of two keeps the ring positions a mask away from offsets
+    tx->size = 1;
+    while (tx->size < queue_size) {
+        tx->size <<= 1;
+    }
+    tx->ring = malloc(tx->size);
+    if (tx->kick_fd < 0 || tx->drain_fd < 0 || tx->ring == NULL) {
+        mraa_uart_tx_free(tx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    if (pthread_create(&tx->thread, NULL, mraa_uart_tx_engine, tx) != 0) {
+        syslog(LOG_ERR, "uart%i: tx_start: failed to start transmit thread", dev->index);
+        mraa_uart_tx_free(tx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->tx = tx;
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Sleep until the engine moved on or ended. The condition is checked after
+ * announcing the wait, the engine checks the other way round.
+ */
+#define MRAA_UART_TX_WAIT(tx, cond_expr)                                                  \
+    do {                                                                                  \
+        pthread_mutex_lock(&(tx)->lock);                                                  \
+        __atomic_add_fetch(&(tx)->waiting, 1, __ATOMIC_SEQ_CST);                          \
+        while (!(cond_expr) && !__atomic_load_n(&(tx)->ended, __ATOMIC_SEQ_CST)) {        \
+            pthread_cond_wait(&(tx)->cond, &(tx)->lock);                                  \
+        }                                                                                 \
+        __atomic_sub_fetch(&(tx)->waiting, 1, __ATOMIC_SEQ_CST);                          \
+        pthread_mutex_unlock(&(tx)->lock);                                                \
+    } while (0)
+
+int
+mraa_uart_tx_queue(mraa_uart_context dev, const mraa_uart_iovec_t* iov, unsigned int iovcnt)
+{
+    struct _uart_tx* tx = dev->tx;
+    size_t total = 0;
+
+    pthread_mutex_lock(&tx->queue_lock);
+    for (unsigned int i = 0; i < iovcnt; ++i) {
+        const char* data = iov[i].data;
+        size_t len = iov[i].length;
+
+        while (len > 0) {
+            size_t room = tx->size - (tx->tail - __atomic_load_n(&tx->head, __ATOMIC_ACQUIRE));
+            if (room == 0) {
+                MRAA_UART_TX_WAIT(tx, tx->tail != __atomic_load_n(&tx->head, __ATOMIC_SEQ_CST) + tx->size);
+                if (__atomic_load_n(&tx->ended, __ATOMIC_SEQ_CST)) {
+                    pthread_mutex_unlock(&tx->queue_lock);
+                    return -1;
+                }
+                continue;
+            }
+
+            size_t offset = tx->tail & (tx->size - 1);
+            size_t num = room < len ? room : len;
+            if (num > tx->size - offset) {
+                num = tx->size - offset;
+            }
+            memcpy(tx->ring + offset, data, num);
+            __atomic_store_n(&tx->tail, tx->tail + num, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&tx->idle, __ATOMIC_SEQ_CST)) {
+                mraa_uart_tx_kick(tx);
+            }
+            data += num;
+            len -= num;
+            total += num;
+        }
+    }
+
+    size_t fill = tx->tail - __atomic_load_n(&tx->head, __ATOMIC_RELAXED);
+    if (fill > tx->max_fill) {
+        __atomic_store_n(&tx->max_fill, fill, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&tx->requests, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&tx->queue_lock);
+
+    return __atomic_load_n(&tx->ended, __ATOMIC_SEQ_CST) ? -1 : (int) total;
+}
+
+mraa_result_t
+mraa_uart_tx_flush(mraa_uart_context dev)
+{
+    struct _uart_tx* tx = dev->tx;
+    size_t target = __atomic_load_n(&tx->tail, __ATOMIC_SEQ_CST);
+
+    MRAA_UART_TX_WAIT(tx, (ptrdiff_t)(__atomic_load_n(&tx->drained, __ATOMIC_SEQ_CST) - target) >= 0);
+
+    if ((ptrdiff_t)(__atomic_load_n(&tx->drained, __ATOMIC_SEQ_CST) - target) < 0) {
+        syslog(LOG_ERR, "uart%i: flush: transmit engine stopped", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_uart_tx_drain_fd(mraa_uart_context dev)
+{
+    if (dev == NULL || dev->tx == NULL) {
+        syslog(LOG_ERR, "uart: tx_drain_fd: context is NULL or transmit engine not running");
+        return -1;
+    }
+    return dev->tx->drain_fd;
+}
+
+mraa_result_t
+mraa_uart_tx_stats(mraa_uart_context dev, mraa_uart_tx_stats_t* stats)
+{
+    if (dev == NULL || dev->tx == NULL) {
+        syslog(LOG_ERR, "uart: tx_stats: context is NULL or transmit engine not running");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct _uart_tx* tx = dev->tx;
+    memset(stats, 0, sizeof(*stats));
+    stats->bytes = __atomic_load_n(&tx->bytes, __ATOMIC_RELAXED);
+    stats->writes = __atomic_load_n(&tx->writes, __ATOMIC_RELAXED);
+    stats->requests = __atomic_load_n(&tx->requests, __ATOMIC_RELAXED);
+    stats->would_block = __atomic_load_n(&tx->would_block, __ATOMIC_RELAXED);
+    stats->drains = __atomic_load_n(&tx->drains, __ATOMIC_RELAXED);
+    stats->max_fill = __atomic_load_n(&tx->max_fill, __ATOMIC_RELAXED);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_tx_stop(mraa_uart_context dev)
+{
+    if (dev == NULL || dev->tx == NULL) {
+        syslog(LOG_ERR, "uart: tx_stop: context is NULL or transmit engine not running");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    struct _uart_tx* tx = dev->tx;
+
+    // The engine sends and drains what is queued before it ends
+    __atomic_store_n(&tx->stopping, 1, __ATOMIC_SEQ_CST);
+    mraa_uart_tx_kick(tx);
+    pthread_join(tx->thread, NULL);
+
+    dev->tx = NULL;
+    mraa_uart_tx_free(tx);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_uart_tx_release(mraa_uart_context dev)
+{
+    if (dev != NULL && dev->tx != NULL) {
+        mraa_uart_tx_stop(dev);
+    }
+}
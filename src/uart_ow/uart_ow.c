@@ -23,38 +23,109 @@
 #include "uart_ow.h"
 #include "mraa_internal.h"
 
-// low-level read byte
+// DS18B20 and compatible function commands
+#define OW_CMD_CONVERT_T 0x44
+#define OW_CMD_READ_SCRATCHPAD 0xbe
+#define OW_CMD_READ_POWER_SUPPLY 0xb4
+#define OW_SCRATCHPAD_SIZE 9
+// Longest conversion, 12 bit resolution
+#define OW_CONVERT_MS 750
+
+// Slots sent with a single UART write, 32 bytes worth of bits
+#define OW_MAX_SLOTS 256
+
+// Slot value for a bit: 0xff keeps the line released after the start bit
+// (a 1, or a read slot), 0x00 holds it low (a 0)
+#define OW_SLOT(bit) ((bit) ? 0xff : 0x00)
+
+// low-level slot exchange: send n slots with one write and replace them
+// with what came back over the loopback.  0xff is a '1', anything else
+// (typically 0xfc or 0x00) is a 0.
 static mraa_result_t
-_ow_read_byte(mraa_uart_ow_context dev, uint8_t *ch)
+_ow_exchange(mraa_uart_ow_context dev, uint8_t* slots, size_t n)
 {
     time_t thetime = time(NULL);
     // add 5 seconds -- our crude timeout
     thetime += 5;
 
-    int rv;
-    do {
-        rv = mraa_uart_read(dev->uart, (char*) ch, 1);
-    } while (rv == 0 && (time(NULL) < thetime));
-
-    if (rv == 0) {
-        return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+    size_t done = 0;
+    while (done < n) {
+        int rv = mraa_uart_write(dev->uart, (const char*) slots + done, n - done);
+        if (rv > 0) {
+            done += rv;
+        } else if ((rv < 0 && errno != EAGAIN) || time(NULL) >= thetime) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
     }
-    else {
-        return MRAA_SUCCESS;
+
+    done = 0;
+    while (done < n) {
+        if (!mraa_uart_data_available(dev->uart, 100)) {
+            if (time(NULL) >= thetime) {
+                return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+            }
+            continue;
+        }
+        int rv = mraa_uart_read(dev->uart, (char*) slots + done, n - done);
+        if (rv > 0) {
+            done += rv;
+        } else if (rv < 0 && errno != EAGAIN) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
     }
+
+    return MRAA_SUCCESS;
 }
 
-// low-level write byte
-static int
-_ow_write_byte(mraa_uart_ow_context dev, const char ch)
+// Exchange whole bytes, least significant bit first.  tx NULL sends read
+// slots (0xff), rx NULL drops what was read back.
+static mraa_result_t
+_ow_transfer(mraa_uart_ow_context dev, const uint8_t* tx, uint8_t* rx, size_t len)
 {
-    return mraa_uart_write(dev->uart, &ch, 1);
+    uint8_t slots[OW_MAX_SLOTS];
+
+    while (len > 0) {
+        size_t num = len < OW_MAX_SLOTS / 8 ? len : OW_MAX_SLOTS / 8;
+        size_t i;
+        int bit;
+
+        for (i = 0; i < num; i++) {
+            uint8_t byte = tx ? tx[i] : 0xff;
+            for (bit = 0; bit < 8; bit++) {
+                slots[i * 8 + bit] = OW_SLOT(byte & (1 << bit));
+            }
+        }
+
+        mraa_result_t rv = _ow_exchange(dev, slots, num * 8);
+        if (rv != MRAA_SUCCESS) {
+            return rv;
+        }
+
+        if (rx) {
+            for (i = 0; i < num; i++) {
+                uint8_t byte = 0;
+                for (bit = 0; bit < 8; bit++) {
+                    if (slots[i * 8 + bit] == 0xff)
+                        byte |= 1 << bit;
+                }
+                rx[i] = byte;
+            }
+            rx += num;
+        }
+        if (tx) {
+            tx += num;
+        }
+        len -= num;
+    }
+
+    return MRAA_SUCCESS;
 }
 
 // Here we setup a very simple termios with the minimum required
 // settings.  We use this to also change speed from high to low.  We
 // use the low speed (9600 bd) for emitting the reset pulse, and
-// high speed (115200 bd) for actual data communications.
+// high speed (115200 bd) for actual data communications.  In overdrive
+// the reset pulse is sent at 57600 bd and data at 1 Mbd.
 //
 static mraa_result_t
 _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
@@ -65,12 +136,12 @@ _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    static speed_t baud;
+    speed_t baud;
     if (speed) {
-        baud = B115200;
+        baud = dev->overdrive ? B1000000 : B115200;
     }
     else {
-        baud = B9600;
+        baud = dev->overdrive ? B57600 : B9600;
     }
 
     struct termios termio = {
@@ -100,6 +171,7 @@ _ow_search(mraa_uart_ow_context dev)
     int last_zero, rom_byte_number, search_result;
     int id_bit, cmp_id_bit;
     unsigned char rom_byte_mask, search_direction;
+    uint8_t slots[3];
 
     // initialize for search
     id_bit_number = 1;
@@ -119,14 +191,20 @@ _ow_search(mraa_uart_ow_context dev)
             return 0;
         }
 
-        // issue the search command
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SEARCH_ROM);
+        // issue the search command and read the first bit and its
+        // complement in the same go
+        uint8_t cmd = MRAA_UART_OW_CMD_SEARCH_ROM;
+        slots[1] = slots[2] = OW_SLOT(1);
+        if (_ow_transfer(dev, &cmd, NULL, 1) != MRAA_SUCCESS ||
+            _ow_exchange(dev, slots + 1, 2) != MRAA_SUCCESS) {
+            slots[1] = slots[2] = 0xff;
+        }
 
         // loop to do the search
         do {
-            // read a bit and its complement
-            id_bit = mraa_uart_ow_bit(dev, 1);
-            cmp_id_bit = mraa_uart_ow_bit(dev, 1);
+            // the bit and its complement read with the previous slots
+            id_bit = (slots[1] == 0xff);
+            cmp_id_bit = (slots[2] == 0xff);
 
             // check for no devices on 1-wire
             if ((id_bit == 1) && (cmp_id_bit == 1))
@@ -159,8 +237,13 @@ _ow_search(mraa_uart_ow_context dev)
                 else
                     dev->ROM_NO[rom_byte_number] &= ~rom_byte_mask;
 
-                // serial number search direction write bit
-                mraa_uart_ow_bit(dev, search_direction);
+                // serial number search direction write bit, followed by
+                // the read slots of the next bit unless this was the last
+                slots[0] = OW_SLOT(search_direction);
+                slots[1] = slots[2] = OW_SLOT(1);
+                if (_ow_exchange(dev, slots, id_bit_number < 64 ? 3 : 1) != MRAA_SUCCESS) {
+                    slots[1] = slots[2] = 0xff;
+                }
 
                 // increment the byte counter id_bit_number
                 // and shift the mask rom_byte_mask
@@ -284,6 +367,7 @@ mraa_result_t
 mraa_uart_ow_stop(mraa_uart_ow_context dev)
 {
     mraa_result_t rv =  mraa_uart_stop(dev->uart);
+    free(dev->roms);
     free(dev);
     return rv;
 }
@@ -302,19 +386,12 @@ mraa_uart_ow_bit(mraa_uart_ow_context dev, uint8_t bit)
         return -1;
     }
 
-    int ret = 0;
-    uint8_t ch;
-    if (bit) {
-        ret = _ow_write_byte(dev, 0xff); /* write a 1 bit */
-    }
-    else {
-        ret = _ow_write_byte(dev, 0x00); /* write a 0 bit */
-    }
+    uint8_t ch = OW_SLOT(bit);
 
     /* return the bit present on the bus (0xff is a '1', anything else
      * (typically 0xfc or 0x00) is a 0
      */
-    if (_ow_read_byte(dev, &ch) != MRAA_SUCCESS || ret == -1) {
+    if (_ow_exchange(dev, &ch, 1) != MRAA_SUCCESS) {
          return -1;
     }
     return (ch == 0xff);
@@ -335,20 +412,13 @@ mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte)
      * loopback connection, except the devices on the 1-wire bus have
      * the ability to modify the returning bitstream.
      */
-
-    uint8_t bit;
-    int i;
-    for (i = 0; i < 8; i++) {
-        bit = mraa_uart_ow_bit(dev, byte & 0x01);
-        /* prep for next bit to send, and clear space for bit read */
-        byte >>= 1;
-        /* store read bit in the msb */
-        if (bit)
-            byte |= 0x80;
+    uint8_t rx;
+    if (_ow_transfer(dev, &byte, &rx, 1) != MRAA_SUCCESS) {
+        return -1;
     }
 
     /* return the new byte read */
-    return byte;
+    return rx;
 }
 
 int
@@ -366,6 +436,40 @@ mraa_uart_ow_read_byte(mraa_uart_ow_context dev)
     return mraa_uart_ow_write_byte(dev, 0xff);
 }
 
+mraa_result_t
+mraa_uart_ow_transfer(mraa_uart_ow_context dev, const uint8_t* tx, uint8_t* rx, size_t len)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: transfer: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    return _ow_transfer(dev, tx, rx, len);
+}
+
+mraa_result_t
+mraa_uart_ow_write_bytes(mraa_uart_ow_context dev, const uint8_t* buf, size_t len)
+{
+    if (!dev || (!buf && len > 0)) {
+        syslog(LOG_ERR, "uart_ow: write_bytes: context or buffer is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    return _ow_transfer(dev, buf, NULL, len);
+}
+
+mraa_result_t
+mraa_uart_ow_read_bytes(mraa_uart_ow_context dev, uint8_t* buf, size_t len)
+{
+    if (!dev || (!buf && len > 0)) {
+        syslog(LOG_ERR, "uart_ow: read_bytes: context or buffer is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    /* read slots release the bus for the devices to send their bits */
+    return _ow_transfer(dev, NULL, buf, len);
+}
+
 mraa_result_t
 mraa_uart_ow_reset(mraa_uart_ow_context dev)
 {
@@ -394,9 +498,8 @@ mraa_uart_ow_reset(mraa_uart_ow_context dev)
     }
 
     /* pull the data line low */
-    _ow_write_byte(dev, 0xf0);
-
-    if (_ow_read_byte(dev, &rv) != MRAA_SUCCESS) {
+    rv = 0xf0;
+    if (_ow_exchange(dev, &rv, 1) != MRAA_SUCCESS) {
         return MRAA_ERROR_NO_DATA_AVAILABLE;
     }
 
@@ -450,6 +553,202 @@ mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t start, uint8_t*
         return MRAA_ERROR_UART_OW_NO_DEVICES;
 }
 
+int
+mraa_uart_ow_enumerate(mraa_uart_ow_context dev, mraa_boolean_t refresh)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: enumerate: context is NULL");
+        return -1;
+    }
+
+    if (dev->roms && !refresh) {
+        return dev->rom_count;
+    }
+
+    free(dev->roms);
+    dev->roms = NULL;
+    dev->rom_count = 0;
+
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+    int size = 0;
+    mraa_result_t rv = mraa_uart_ow_rom_search(dev, 1, id);
+    while (rv == MRAA_SUCCESS) {
+        if (mraa_uart_ow_crc8(id, MRAA_UART_OW_ROMCODE_SIZE - 1) != id[MRAA_UART_OW_ROMCODE_SIZE - 1]) {
+            syslog(LOG_WARNING, "uart_ow: enumerate: skipping rom code with bad crc");
+        } else {
+            if (dev->rom_count == size) {
+                size = size ? size * 2 : 8;
+                uint8_t* roms = realloc(dev->roms, size * MRAA_UART_OW_ROMCODE_SIZE);
+                if (!roms) {
+                    syslog(LOG_ERR, "uart_ow: enumerate: failed to allocate memory");
+                    return -1;
+                }
+                dev->roms = roms;
+            }
+            memcpy(dev->roms + dev->rom_count * MRAA_UART_OW_ROMCODE_SIZE, id, MRAA_UART_OW_ROMCODE_SIZE);
+            dev->rom_count++;
+        }
+        rv = mraa_uart_ow_rom_search(dev, 0, id);
+    }
+
+    if (rv != MRAA_ERROR_UART_OW_NO_DEVICES) {
+        syslog(LOG_ERR, "uart_ow: enumerate: search failed");
+        return -1;
+    }
+
+    // an empty bus is remembered as well
+    if (!dev->roms) {
+        dev->roms = malloc(MRAA_UART_OW_ROMCODE_SIZE);
+        if (!dev->roms) {
+            return -1;
+        }
+    }
+    return dev->rom_count;
+}
+
+mraa_result_t
+mraa_uart_ow_get_rom(mraa_uart_ow_context dev, int index, uint8_t* id)
+{
+    if (!dev || !id) {
+        syslog(LOG_ERR, "uart_ow: get_rom: context or id is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (index < 0 || index >= dev->rom_count) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(id, dev->roms + index * MRAA_UART_OW_ROMCODE_SIZE, MRAA_UART_OW_ROMCODE_SIZE);
+    return MRAA_SUCCESS;
+}
+
+// Temperature sensor families: DS18S20, DS1822, DS18B20, DS1825, DS28EA00
+static mraa_boolean_t
+_ow_is_thermometer(uint8_t family)
+{
+    return family == 0x10 || family == 0x22 || family == 0x28 || family == 0x3b || family == 0x42;
+}
+
+// Convert a scratchpad to degrees Celsius
+static float
+_ow_scratchpad_celsius(uint8_t family, const uint8_t* sp)
+{
+    int16_t raw = (int16_t)((sp[1] << 8) | sp[0]);
+
+    if (family == 0x10) {
+        // DS18S20: half degrees, extended with COUNT_REMAIN and COUNT_PER_C
+        if (sp[7] == 0)
+            return raw / 2.0f;
+        return (raw >> 1) - 0.25f + (float) (sp[7] - sp[6]) / sp[7];
+    }
+
+    // the low bits are undefined below 12 bit resolution
+    int resolution = (sp[4] >> 5) & 0x03;
+    raw &= ~((1 << (3 - resolution)) - 1);
+    return raw / 16.0f;
+}
+
+int
+mraa_uart_ow_temperature_sweep(mraa_uart_ow_context dev, mraa_uart_ow_temperature_t* results, int max_results)
+{
+    if (!dev || (!results && max_results > 0)) {
+        syslog(LOG_ERR, "uart_ow: temperature_sweep: context or results are NULL");
+        return -1;
+    }
+
+    if (mraa_uart_ow_enumerate(dev, 0) < 0) {
+        return -1;
+    }
+
+    /* parasite powered sensors pull the bus low during this read slot,
+     * and cannot report the end of the conversion
+     */
+    if (mraa_uart_ow_command(dev, OW_CMD_READ_POWER_SUPPLY, NULL) != MRAA_SUCCESS) {
+        return -1;
+    }
+    int powered = mraa_uart_ow_bit(dev, 1);
+
+    /* a single conversion for all sensors on the bus */
+    if (powered < 0 || mraa_uart_ow_command(dev, OW_CMD_CONVERT_T, NULL) != MRAA_SUCCESS) {
+        return -1;
+    }
+    if (powered) {
+        // sensors hold read slots low until they are done
+        int waited = 0;
+        while (mraa_uart_ow_bit(dev, 1) == 0 && waited < OW_CONVERT_MS) {
+            usleep(10000);
+            waited += 10;
+        }
+    } else {
+        usleep(OW_CONVERT_MS * 1000);
+    }
+
+    int count = 0;
+    int i;
+    for (i = 0; i < dev->rom_count && count < max_results; i++) {
+        const uint8_t* id = dev->roms + i * MRAA_UART_OW_ROMCODE_SIZE;
+        if (!_ow_is_thermometer(id[0]))
+            continue;
+
+        mraa_uart_ow_temperature_t* result = &results[count++];
+        memcpy(result->id, id, MRAA_UART_OW_ROMCODE_SIZE);
+        result->celsius = 0.0f;
+
+        /* match rom, read scratchpad and the scratchpad read slots go
+         * out as a single transfer
+         */
+        uint8_t tx[MRAA_UART_OW_ROMCODE_SIZE + 2 + OW_SCRATCHPAD_SIZE];
+        uint8_t rx[sizeof(tx)];
+        tx[0] = MRAA_UART_OW_CMD_MATCH_ROM;
+        memcpy(tx + 1, id, MRAA_UART_OW_ROMCODE_SIZE);
+        tx[MRAA_UART_OW_ROMCODE_SIZE + 1] = OW_CMD_READ_SCRATCHPAD;
+        memset(tx + MRAA_UART_OW_ROMCODE_SIZE + 2, 0xff, OW_SCRATCHPAD_SIZE);
+
+        result->status = mraa_uart_ow_reset(dev);
+        if (result->status == MRAA_SUCCESS)
+            result->status = _ow_transfer(dev, tx, rx, sizeof(tx));
+        if (result->status != MRAA_SUCCESS)
+            continue;
+
+        const uint8_t* sp = rx + MRAA_UART_OW_ROMCODE_SIZE + 2;
+        if (mraa_uart_ow_crc8((uint8_t*) sp, OW_SCRATCHPAD_SIZE - 1) != sp[OW_SCRATCHPAD_SIZE - 1]) {
+            result->status = MRAA_ERROR_UART_OW_DATA_ERROR;
+            continue;
+        }
+        result->celsius = _ow_scratchpad_celsius(id[0], sp);
+    }
+
+    return count;
+}
+
+mraa_result_t
+mraa_uart_ow_set_overdrive(mraa_uart_ow_context dev, mraa_boolean_t enable)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: set_overdrive: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    /* devices only enter overdrive from standard speed, and a standard
+     * speed reset brings them all back
+     */
+    dev->overdrive = 0;
+    if (!enable)
+        return mraa_uart_ow_reset(dev);
+
+    mraa_result_t rv = mraa_uart_ow_reset(dev);
+    if (rv != MRAA_SUCCESS)
+        return rv;
+
+    uint8_t cmd = MRAA_UART_OW_CMD_OVERDRIVE_SKIP_ROM;
+    rv = _ow_transfer(dev, &cmd, NULL, 1);
+    if (rv != MRAA_SUCCESS)
+        return rv;
+
+    dev->overdrive = 1;
+    return mraa_uart_ow_reset(dev);
+}
+
 mraa_result_t
 mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id)
 {
@@ -464,51 +763,62 @@ mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id)
     if (rv != MRAA_SUCCESS)
         return rv;
 
+    uint8_t buf[MRAA_UART_OW_ROMCODE_SIZE + 2];
+    size_t len = 0;
     if (id) {
         /* send the match rom command */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_MATCH_ROM);
+        buf[len++] = MRAA_UART_OW_CMD_MATCH_ROM;
 
         /* sending to a specific device, so send out the full romcode */
-        int i;
-        for (i = 0; i < MRAA_UART_OW_ROMCODE_SIZE; i++)
-            mraa_uart_ow_write_byte(dev, id[i]);
+        memcpy(buf + len, id, MRAA_UART_OW_ROMCODE_SIZE);
+        len += MRAA_UART_OW_ROMCODE_SIZE;
     } else {
         /* send to all devices (or a single device if it's the only one
          * on the bus)
          */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SKIP_ROM);
+        buf[len++] = MRAA_UART_OW_CMD_SKIP_ROM;
     }
 
-    mraa_uart_ow_write_byte(dev, command);
+    buf[len++] = command;
 
-    return MRAA_SUCCESS;
+    /* the whole sequence goes out as a single write */
+    return _ow_transfer(dev, buf, NULL, len);
 }
 
 uint8_t
 mraa_uart_ow_crc8(uint8_t* buffer, uint16_t length)
 {
-    // 0x18 = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0
-    static const uint8_t CRC8POLY = 0x18;
+    // 0x18 = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0, one entry per byte value
+    static const uint8_t crc8_table[256] = {
+    0x00, 0x5e, 0xbc, 0xe2, 0x61, 0x3f, 0xdd, 0x83, 0xc2, 0x9c, 0x7e, 0x20,
+    0xa3, 0xfd, 0x1f, 0x41, 0x9d, 0xc3, 0x21, 0x7f, 0xfc, 0xa2, 0x40, 0x1e,
+    0x5f, 0x01, 0xe3, 0xbd, 0x3e, 0x60, 0x82, 0xdc, 0x23, 0x7d, 0x9f, 0xc1,
+    0x42, 0x1c, 0xfe, 0xa0, 0xe1, 0xbf, 0x5d, 0x03, 0x80, 0xde, 0x3c, 0x62,
+    0xbe, 0xe0, 0x02, 0x5c, 0xdf, 0x81, 0x63, 0x3d, 0x7c, 0x22, 0xc0, 0x9e,
+    0x1d, 0x43, 0xa1, 0xff, 0x46, 0x18, 0xfa, 0xa4, 0x27, 0x79, 0x9b, 0xc5,
+    0x84, 0xda, 0x38, 0x66, 0xe5, 0xbb, 0x59, 0x07, 0xdb, 0x85, 0x67, 0x39,
+    0xba, 0xe4, 0x06, 0x58, 0x19, 0x47, 0xa5, 0xfb, 0x78, 0x26, 0xc4, 0x9a,
+    0x65, 0x3b, 0xd9, 0x87, 0x04, 0x5a, 0xb8, 0xe6, 0xa7, 0xf9, 0x1b, 0x45,
+    0xc6, 0x98, 0x7a, 0x24, 0xf8, 0xa6, 0x44, 0x1a, 0x99, 0xc7, 0x25, 0x7b,
+    0x3a, 0x64, 0x86, 0xd8, 0x5b, 0x05, 0xe7, 0xb9, 0x8c, 0xd2, 0x30, 0x6e,
+    0xed, 0xb3, 0x51, 0x0f, 0x4e, 0x10, 0xf2, 0xac, 0x2f, 0x71, 0x93, 0xcd,
+    0x11, 0x4f, 0xad, 0xf3, 0x70, 0x2e, 0xcc, 0x92, 0xd3, 0x8d, 0x6f, 0x31,
+    0xb2, 0xec, 0x0e, 0x50, 0xaf, 0xf1, 0x13, 0x4d, 0xce, 0x90, 0x72, 0x2c,
+    0x6d, 0x33, 0xd1, 0x8f, 0x0c, 0x52, 0xb0, 0xee, 0x32, 0x6c, 0x8e, 0xd0,
+    0x53, 0x0d, 0xef, 0xb1, 0xf0, 0xae, 0x4c, 0x12, 0x91, 0xcf, 0x2d, 0x73,
+    0xca, 0x94, 0x76, 0x28, 0xab, 0xf5, 0x17, 0x49, 0x08, 0x56, 0xb4, 0xea,
+    0x69, 0x37, 0xd5, 0x8b, 0x57, 0x09, 0xeb, 0xb5, 0x36, 0x68, 0x8a, 0xd4,
+    0x95, 0xcb, 0x29, 0x77, 0xf4, 0xaa, 0x48, 0x16, 0xe9, 0xb7, 0x55, 0x0b,
+    0x88, 0xd6, 0x34, 0x6a, 0x2b, 0x75, 0x97, 0xc9, 0x4a, 0x14, 0xf6, 0xa8,
+    0x74, 0x2a, 0xc8, 0x96, 0x15, 0x4b, 0xa9, 0xf7, 0xb6, 0xe8, 0x0a, 0x54,
+    0xd7, 0x89, 0x6b, 0x35
+    };
 
     uint8_t crc = 0x00;
     uint16_t loop_count;
-    uint8_t bit_counter;
-    uint8_t data;
-    uint8_t feedback_bit;
 
     for (loop_count = 0; loop_count != length; loop_count++) {
-        data = buffer[loop_count];
-        bit_counter = 8;
-        do {
-            feedback_bit = (crc ^ data) & 0x01;
-            if (feedback_bit == 0x01)
-                crc = crc ^ CRC8POLY;
-            crc = (crc >> 1) & 0x7F;
-            if (feedback_bit == 0x01)
-                crc = crc | 0x80;
-            data = data >> 1;
-            bit_counter--;
-        } while (bit_counter > 0);
+        crc = crc8_table[crc ^ buffer[loop_count]];
     }
 
     return crc;
@@ -821,6 +821,50 @@ i2c_write_word_data_replace(mraa_i2c_context dev, const uint16_t data, const uin
     return status;
 }
 
+mraa_result_t
+i2c_transfer_replace(mraa_i2c_context dev, mraa_i2c_msg_t* msgs, unsigned int num_msgs)
+{
+    Ftdi_4222_Shim* shim = ShimFromI2cBus(dev->busnum);
+    if (!shim)
+        return MRAA_ERROR_NO_RESOURCES;
+
+    lock_guard lock(shim->mtx_ft4222);
+
+    if (ft4222_i2c_select_bus(dev->busnum) != MRAA_SUCCESS)
+        return MRAA_ERROR_UNSPECIFIED;
+
+    /* Map the messages on the explicit start/stop conditions of the Ex calls */
+    for (unsigned int i = 0; i < num_msgs; ++i) {
+        uint8 flag = 0;
+        if (i == 0)
+            flag = START;
+        else if (!(msgs[i].flags & MRAA_I2C_MSG_NOSTART))
+            flag = Repeated_START;
+        if (i == num_msgs - 1)
+            flag |= STOP;
+        if (flag == 0)
+            flag = NONE;
+
+        uint16 transferred = 0;
+        FT4222_STATUS sts;
+        if (msgs[i].flags & MRAA_I2C_MSG_READ)
+            sts = FT4222_I2CMaster_ReadEx(shim->h_i2c, msgs[i].addr, flag, msgs[i].buf, msgs[i].len, &transferred);
+        else
+            sts = FT4222_I2CMaster_WriteEx(shim->h_i2c, msgs[i].addr, flag, msgs[i].buf, msgs[i].len, &transferred);
+
+        if (sts != FT4222_OK || transferred != msgs[i].len) {
+            uint8 controllerStatus = 0;
+            FT4222_I2CMaster_GetStatus(shim->h_i2c, &controllerStatus);
+            syslog(LOG_ERR, "FT4222 I2C transfer failed on message %u for address 0x%02x with code 0x%02x I2C "
+                            "controller status: 0x%02x",
+                   i, msgs[i].addr, sts, controllerStatus);
+            FT4222_I2CMaster_Reset(shim->h_i2c);
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t i2c_stop_replace(mraa_i2c_context /*dev*/)
 {
     return MRAA_SUCCESS;
@@ -1275,6 +1319,7 @@ ft4222_populate_i2c_func_table(mraa_adv_func_t* func_table)
     func_table->i2c_write_byte_replace = &i2c_write_byte_replace; // No mutex needed
     func_table->i2c_write_byte_data_replace = &i2c_write_byte_data_replace;
     func_table->i2c_write_word_data_replace = &i2c_write_word_data_replace;
+    func_table->i2c_transfer_replace = &i2c_transfer_replace;
     func_table->i2c_stop_replace = &i2c_stop_replace;
 }
 
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Per-call latency and throughput of the mraa I/O primitives.
+ *
+ * On the mock platform every benchmark runs against the mock backend. On a
+ * real board the resources to use are taken from the environment, benchmarks
+ * whose resource is not set are skipped:
+ *
+ *   MRAA_BENCH_GPIO      gpio pin, it is toggled as an output
+ *   MRAA_BENCH_I2C_BUS   i2c bus, with MRAA_BENCH_I2C_ADDR as slave address
+ *   MRAA_BENCH_SPI_BUS   spi bus
+ *   MRAA_BENCH_AIO       aio pin
+ *   MRAA_BENCH_UART      uart index, it should be looped back
+ *
+ * Run with --benchmark_format=json or --benchmark_out=<file> to get results
+ * as JSON, the bench_json target does the latter.
+ */
+
+#include "benchmark/benchmark.h"
+#include "mraa/aio.h"
+#include "mraa/common.h"
+#include "mraa/gpio.h"
+#include "mraa/i2c.h"
+#include "mraa/iio.h"
+#include "mraa/spi.h"
+#include "mraa/uart.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Must match MOCK_I2C_DEV_ADDR */
+#define MOCK_I2C_ADDR 0x33
+
+static bool
+is_mock()
+{
+    return mraa_get_platform_type() == MRAA_MOCK_PLATFORM;
+}
+
+/* Resource number from the environment, or the mock default */
+static bool
+bench_resource(const char* name, int mock_default, int* value)
+{
+    const char* env = getenv(name);
+    if (env != NULL) {
+        *value = (int) strtol(env, NULL, 0);
+        return true;
+    }
+    if (is_mock()) {
+        *value = mock_default;
+        return true;
+    }
+    return false;
+}
+
+static mraa_gpio_context
+bench_gpio(benchmark::State& state, mraa_gpio_dir_t dir)
+{
+    int pin;
+    if (!bench_resource("MRAA_BENCH_GPIO", 0, &pin)) {
+        state.SkipWithError("MRAA_BENCH_GPIO not set");
+        return NULL;
+    }
+    mraa_gpio_context gpio = mraa_gpio_init(pin);
+    if (gpio == NULL || mraa_gpio_dir(gpio, dir) != MRAA_SUCCESS) {
+        state.SkipWithError("gpio init failed");
+        if (gpio != NULL)
+            mraa_gpio_close(gpio);
+        return NULL;
+    }
+    return gpio;
+}
+
+static void
+BM_GpioRead(benchmark::State& state)
+{
+    mraa_gpio_context gpio = bench_gpio(state, MRAA_GPIO_IN);
+    if (gpio == NULL)
+        return;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_gpio_read(gpio));
+    state.SetItemsProcessed(state.iterations());
+    mraa_gpio_close(gpio);
+}
+BENCHMARK(BM_GpioRead);
+
+static void
+BM_GpioWrite(benchmark::State& state)
+{
+    mraa_gpio_context gpio = bench_gpio(state, MRAA_GPIO_OUT);
+    if (gpio == NULL)
+        return;
+    int value = 0;
+    for (auto _ : state) {
+        mraa_gpio_write(gpio, value);
+        value ^= 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    mraa_gpio_close(gpio);
+}
+BENCHMARK(BM_GpioWrite);
+
+static void
+BM_GpioReadMmap(benchmark::State& state)
+{
+    mraa_gpio_context gpio = bench_gpio(state, MRAA_GPIO_IN);
+    if (gpio == NULL)
+        return;
+    if (mraa_gpio_use_mmaped(gpio, 1) != MRAA_SUCCESS) {
+        state.SkipWithError("mmap access not supported");
+        mraa_gpio_close(gpio);
+        return;
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_gpio_read(gpio));
+    state.SetItemsProcessed(state.iterations());
+    mraa_gpio_close(gpio);
+}
+BENCHMARK(BM_GpioReadMmap);
+
+static void
+BM_GpioWriteMmap(benchmark::State& state)
+{
+    mraa_gpio_context gpio = bench_gpio(state, MRAA_GPIO_OUT);
+    if (gpio == NULL)
+        return;
+    if (mraa_gpio_use_mmaped(gpio, 1) != MRAA_SUCCESS) {
+        state.SkipWithError("mmap access not supported");
+        mraa_gpio_close(gpio);
+        return;
+    }
+    int value = 0;
+    for (auto _ : state) {
+        mraa_gpio_write(gpio, value);
+        value ^= 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    mraa_gpio_close(gpio);
+}
+BENCHMARK(BM_GpioWriteMmap);
+
+static mraa_i2c_context
+bench_i2c(benchmark::State& state, int* addr)
+{
+    int bus;
+    if (!bench_resource("MRAA_BENCH_I2C_BUS", 0, &bus) ||
+        !bench_resource("MRAA_BENCH_I2C_ADDR", MOCK_I2C_ADDR, addr)) {
+        state.SkipWithError("MRAA_BENCH_I2C_BUS or MRAA_BENCH_I2C_ADDR not set");
+        return NULL;
+    }
+    mraa_i2c_context i2c = mraa_i2c_init(bus);
+    if (i2c == NULL || mraa_i2c_address(i2c, *addr) != MRAA_SUCCESS) {
+        state.SkipWithError("i2c init failed");
+        if (i2c != NULL)
+            mraa_i2c_stop(i2c);
+        return NULL;
+    }
+    return i2c;
+}
+
+static void
+BM_I2cReadByteData(benchmark::State& state)
+{
+    int addr;
+    mraa_i2c_context i2c = bench_i2c(state, &addr);
+    if (i2c == NULL)
+        return;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_i2c_read_byte_data(i2c, 0));
+    state.SetItemsProcessed(state.iterations());
+    mraa_i2c_stop(i2c);
+}
+BENCHMARK(BM_I2cReadByteData);
+
+static void
+BM_I2cReadBytesData(benchmark::State& state)
+{
+    int addr;
+    mraa_i2c_context i2c = bench_i2c(state, &addr);
+    if (i2c == NULL)
+        return;
+    uint8_t data[256];
+    int length = state.range(0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_i2c_read_bytes_data(i2c, 0, data, length));
+    state.SetBytesProcessed(state.iterations() * length);
+    mraa_i2c_stop(i2c);
+}
+BENCHMARK(BM_I2cReadBytesData)->Arg(2)->Arg(8);
+
+static void
+BM_I2cTransfer(benchmark::State& state)
+{
+    int addr;
+    mraa_i2c_context i2c = bench_i2c(state, &addr);
+    if (i2c == NULL)
+        return;
+    uint8_t reg = 0;
+    uint8_t data[8];
+    mraa_i2c_msg_t msgs[2] = {};
+    msgs[0].addr = addr;
+    msgs[0].len = 1;
+    msgs[0].buf = &reg;
+    msgs[1].addr = addr;
+    msgs[1].flags = MRAA_I2C_MSG_READ;
+    msgs[1].len = sizeof(data);
+    msgs[1].buf = data;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_i2c_transfer(i2c, msgs, 2));
+    state.SetBytesProcessed(state.iterations() * sizeof(data));
+    mraa_i2c_stop(i2c);
+}
+BENCHMARK(BM_I2cTransfer);
+
+static void
+BM_I2cWriteByteData(benchmark::State& state)
+{
+    int addr;
+    mraa_i2c_context i2c = bench_i2c(state, &addr);
+    if (i2c == NULL)
+        return;
+    for (auto _ : state)
+        mraa_i2c_write_byte_data(i2c, 0x55, 0);
+    state.SetItemsProcessed(state.iterations());
+    mraa_i2c_stop(i2c);
+}
+BENCHMARK(BM_I2cWriteByteData);
+
+static mraa_spi_context
+bench_spi(benchmark::State& state)
+{
+    int bus;
+    if (!bench_resource("MRAA_BENCH_SPI_BUS", 0, &bus)) {
+        state.SkipWithError("MRAA_BENCH_SPI_BUS not set");
+        return NULL;
+    }
+    mraa_spi_context spi = mraa_spi_init(bus);
+    if (spi == NULL)
+        state.SkipWithError("spi init failed");
+    return spi;
+}
+
+static void
+BM_SpiWriteByte(benchmark::State& state)
+{
+    mraa_spi_context spi = bench_spi(state);
+    if (spi == NULL)
+        return;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_spi_write(spi, 0x55));
+    state.SetItemsProcessed(state.iterations());
+    mraa_spi_stop(spi);
+}
+BENCHMARK(BM_SpiWriteByte);
+
+static void
+BM_SpiTransferBuf(benchmark::State& state)
+{
+    mraa_spi_context spi = bench_spi(state);
+    if (spi == NULL)
+        return;
+    int length = state.range(0);
+    uint8_t tx[4096];
+    uint8_t rx[4096];
+    memset(tx, 0x55, sizeof(tx));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_spi_transfer_buf(spi, tx, rx, length));
+    state.SetBytesProcessed(state.iterations() * length);
+    mraa_spi_stop(spi);
+}
+BENCHMARK(BM_SpiTransferBuf)->Arg(16)->Arg(256)->Arg(4096);
+
+static void
+BM_SpiWriteBufReuse(benchmark::State& state)
+{
+    mraa_spi_context spi = bench_spi(state);
+    if (spi == NULL)
+        return;
+    int length = state.range(0);
+    uint8_t tx[4096];
+    memset(tx, 0x55, sizeof(tx));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_spi_write_buf_reuse(spi, tx, length));
+    state.SetBytesProcessed(state.iterations() * length);
+    mraa_spi_stop(spi);
+}
+BENCHMARK(BM_SpiWriteBufReuse)->Arg(16)->Arg(256);
+
+static void
+BM_SpiTransferBatch(benchmark::State& state)
+{
+    mraa_spi_context spi = bench_spi(state);
+    if (spi == NULL)
+        return;
+    uint8_t cmd[1] = { 0x03 };
+    uint8_t rx[32];
+    mraa_spi_segment_t segments[2] = {};
+    segments[0].tx_buf = cmd;
+    segments[0].len = sizeof(cmd);
+    segments[1].rx_buf = rx;
+    segments[1].len = sizeof(rx);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_spi_transfer_batch(spi, segments, 2));
+    state.SetBytesProcessed(state.iterations() * (sizeof(cmd) + sizeof(rx)));
+    mraa_spi_stop(spi);
+}
+BENCHMARK(BM_SpiTransferBatch);
+
+static void
+BM_AioRead(benchmark::State& state)
+{
+    int pin;
+    if (!bench_resource("MRAA_BENCH_AIO", 0, &pin)) {
+        state.SkipWithError("MRAA_BENCH_AIO not set");
+        return;
+    }
+    mraa_aio_context aio = mraa_aio_init(pin);
+    if (aio == NULL) {
+        state.SkipWithError("aio init failed");
+        return;
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_aio_read(aio));
+    state.SetItemsProcessed(state.iterations());
+    mraa_aio_close(aio);
+}
+BENCHMARK(BM_AioRead);
+
+static mraa_uart_context
+bench_uart(benchmark::State& state)
+{
+    int index;
+    if (!bench_resource("MRAA_BENCH_UART", 0, &index)) {
+        state.SkipWithError("MRAA_BENCH_UART not set");
+        return NULL;
+    }
+    mraa_uart_context uart = mraa_uart_init(index);
+    if (uart == NULL)
+        state.SkipWithError("uart init failed");
+    return uart;
+}
+
+static void
+BM_UartWrite(benchmark::State& state)
+{
+    mraa_uart_context uart = bench_uart(state);
+    if (uart == NULL)
+        return;
+    int length = state.range(0);
+    char buf[256];
+    memset(buf, 0x55, sizeof(buf));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mraa_uart_write(uart, buf, length));
+    state.SetBytesProcessed(state.iterations() * length);
+    mraa_uart_stop(uart);
+}
+BENCHMARK(BM_UartWrite)->Arg(1)->Arg(64);
+
+static void
+BM_UartRead(benchmark::State& state)
+{
+    mraa_uart_context uart = bench_uart(state);
+    if (uart == NULL)
+        return;
+    int length = state.range(0);
+    char buf[256];
+    for (auto _ : state) {
+        // Without a loopback on a real board reads would block forever
+        if (!is_mock())
+            mraa_uart_write(uart, buf, length);
+        benchmark::DoNotOptimize(mraa_uart_read(uart, buf, length));
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+    mraa_uart_stop(uart);
+}
+BENCHMARK(BM_UartRead)->Arg(1)->Arg(64);
+
+static void
+BM_PlatformInit(benchmark::State& state)
+{
+    for (auto _ : state) {
+        mraa_deinit();
+        benchmark::DoNotOptimize(mraa_init());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlatformInit)->Unit(benchmark::kMicrosecond);
+
+/* Startup of a program that only uses one gpio, the platform is set up on the
+ * way while iio and sub platforms are left alone */
+static void
+BM_StartupFirstGpio(benchmark::State& state)
+{
+    int pin;
+    if (!bench_resource("MRAA_BENCH_GPIO", 0, &pin)) {
+        state.SkipWithError("MRAA_BENCH_GPIO not set");
+        return;
+    }
+    for (auto _ : state) {
+        mraa_deinit();
+        mraa_gpio_context gpio = mraa_gpio_init(pin);
+        if (gpio == NULL) {
+            state.SkipWithError("gpio init failed");
+            break;
+        }
+        mraa_gpio_close(gpio);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StartupFirstGpio)->Unit(benchmark::kMicrosecond);
+
+/* Startup doing everything library load used to do: the platform, the iio
+ * scan, the sub platform discovery and the platform name */
+static void
+BM_StartupEager(benchmark::State& state)
+{
+    for (auto _ : state) {
+        mraa_deinit();
+        benchmark::DoNotOptimize(mraa_init());
+        benchmark::DoNotOptimize(mraa_iio_get_device_num_by_name("mraa-bench"));
+        benchmark::DoNotOptimize(mraa_get_platform_name());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StartupEager)->Unit(benchmark::kMicrosecond);
+
+/* Resolving every pin name of the platform, as config-driven programs do at
+ * startup, plus a name that is not there */
+static void
+BM_GpioLookup(benchmark::State& state)
+{
+    std::vector<std::string> names;
+    for (unsigned int i = 0; i < mraa_get_pin_count(); i++) {
+        const char* name = mraa_get_pin_name(i);
+        if (name != NULL)
+            names.push_back(name);
+    }
+    names.push_back("mraa-bench");
+    for (auto _ : state) {
+        for (const std::string& name : names)
+            benchmark::DoNotOptimize(mraa_gpio_lookup(name.c_str()));
+    }
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_GpioLookup);
+
+int
+main(int argc, char** argv)
+{
+    if (mraa_init() != MRAA_SUCCESS) {
+        fprintf(stderr, "mraa-bench: mraa_init() failed\n");
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    // Recorded in the context section of the JSON output
+    benchmark::AddCustomContext("mraa_version", mraa_get_version());
+    benchmark::AddCustomContext("mraa_platform", mraa_get_platform_name());
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    mraa_deinit();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/aio.h"
+
+/* Must match MOCK_AIO_STREAM_SCANS */
+#define MOCK_SCANS 16
+
+/* MRAA API aio test fixture */
+class api_aio_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_aio_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_aio_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            aio = mraa_aio_init(0);
+            ASSERT_TRUE(aio != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_aio_close(aio);
+        }
+
+        mraa_aio_context aio;
+};
+
+/* Scans are decoded, scaled to 10 bits and delivered in order */
+TEST_F(api_aio_h_unit, test_stream_single_channel)
+{
+    int ring[MOCK_SCANS];
+    int values[MOCK_SCANS];
+    mraa_aio_stream_stats_t stats;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start(&aio, 1, NULL, ring, MOCK_SCANS));
+    ASSERT_NE(MRAA_SUCCESS, mraa_aio_stream_start(&aio, 1, NULL, ring, MOCK_SCANS));
+
+    int got = 0;
+    while (got < MOCK_SCANS) {
+        int num = mraa_aio_stream_read(aio, values + got, MOCK_SCANS - got, 1000);
+        ASSERT_GT(num, 0);
+        got += num;
+    }
+    for (int s = 0; s < MOCK_SCANS; ++s) {
+        ASSERT_EQ(s * 16, values[s]);
+    }
+    ASSERT_EQ(0, mraa_aio_stream_read(aio, values, MOCK_SCANS, 10));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stats(aio, &stats));
+    ASSERT_EQ(MOCK_SCANS, stats.scans);
+    ASSERT_EQ(MOCK_SCANS, stats.delivered);
+    ASSERT_EQ(0, stats.overflows);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stop(aio));
+    ASSERT_NE(MRAA_SUCCESS, mraa_aio_stream_stop(aio));
+}
+
+/* Multi-channel scans are interleaved, a small ring keeps the oldest scans */
+TEST_F(api_aio_h_unit, test_stream_multi_channel_overflow)
+{
+    mraa_aio_context second = mraa_aio_init(0);
+    ASSERT_TRUE(second != NULL);
+    mraa_aio_context devs[2] = { aio, second };
+    int ring[4 * 2];
+    int values[4 * 2];
+    mraa_aio_stream_stats_t stats;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_bit(second, 12));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start(devs, 2, NULL, ring, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_close(second));
+
+    // Wait until the whole mock stream went through the ring
+    do {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stats(aio, &stats));
+    } while (stats.scans < MOCK_SCANS);
+
+    ASSERT_EQ(4, mraa_aio_stream_read(aio, values, 4, 0));
+    for (int s = 0; s < 4; ++s) {
+        ASSERT_EQ(s * 16, values[2 * s]);
+        ASSERT_EQ((s * 16 + 1) << 2, values[2 * s + 1]);
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stats(aio, &stats));
+    ASSERT_EQ(MOCK_SCANS - 4, stats.overflows);
+    ASSERT_EQ(4, stats.max_fill);
+}
+
+/* Invalid arguments are rejected */
+TEST_F(api_aio_h_unit, test_stream_invalid)
+{
+    int ring[4];
+    int values[4];
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_stream_start(NULL, 1, NULL, ring, 4));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_stream_start(&aio, 1, NULL, NULL, 4));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_stream_start(&aio, 1, NULL, ring, 0));
+    ASSERT_EQ(-1, mraa_aio_stream_read(aio, values, 4, 0));
+}
+
+/* A group reads every pin in one call, in init order */
+TEST_F(api_aio_h_unit, test_read_multi)
+{
+    int pins[3] = { 0, 0, 0 };
+    int values[3];
+    float fvalues[3];
+
+    mraa_aio_context group = mraa_aio_init_multi(pins, 3);
+    ASSERT_TRUE(group != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_read_multi(group, values));
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_GE(values[i], 0);
+        ASSERT_LE(values[i], 1023);
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_read_float_multi(group, fvalues));
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_GE(fvalues[i], 0.0f);
+        ASSERT_LE(fvalues[i], 1.0f);
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_close(group));
+}
+
+/* Invalid groups are rejected */
+TEST_F(api_aio_h_unit, test_read_multi_invalid)
+{
+    int pins[2] = { 0, 42 };
+    int values[2];
+
+    ASSERT_TRUE(mraa_aio_init_multi(NULL, 1) == NULL);
+    ASSERT_TRUE(mraa_aio_init_multi(pins, 0) == NULL);
+    ASSERT_TRUE(mraa_aio_init_multi(pins, 2) == NULL);
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_read_multi(NULL, values));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_read_multi(aio, NULL));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_read_multi(aio, values));
+}
@@ -9,6 +9,11 @@
 #include "gtest/gtest.h"
 #include "mraa/common.h"
 #include "include/mraa_internal_types.h"
+#include "lookup/lookup.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 /* MRAA API common test fixture */
 class api_common_h_unit : public ::testing::Test
@@ -40,6 +45,81 @@ TEST_F(api_common_h_unit, test_libmraa_init_deinit)
     mraa_deinit();
 }
 
+/* The platform is set up by the first call that needs it */
+TEST_F(api_common_h_unit, test_libmraa_lazy_init)
+{
+    mraa_deinit();
+
+    /* Mock platform tests */
+    if (mraa_get_platform_type() == MRAA_MOCK_PLATFORM)
+    {
+        mraa_deinit();
+        ASSERT_EQ(10, mraa_get_pin_count());
+
+        mraa_deinit();
+        ASSERT_STREQ("MRAA mock platform", mraa_get_platform_name());
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+}
+
+/* Concurrent first calls set the platform up once */
+TEST_F(api_common_h_unit, test_libmraa_init_threads)
+{
+    const int count = 8;
+    std::vector<std::thread> threads;
+    std::vector<mraa_result_t> results(count, MRAA_ERROR_UNSPECIFIED);
+    std::vector<const char*> names(count, NULL);
+
+    mraa_deinit();
+    for (int i = 0; i < count; i++) {
+        threads.push_back(std::thread([&results, &names, i]() {
+            results[i] = mraa_init();
+            names[i] = mraa_get_platform_name();
+        }));
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(MRAA_SUCCESS, results[i]) << "Thread " << i;
+        EXPECT_TRUE(names[i] != NULL) << "Thread " << i;
+        EXPECT_EQ(names[0], names[i]) << "Thread " << i;
+    }
+}
+
+/* Lookups racing the index being dropped never see a freed table */
+TEST_F(api_common_h_unit, test_libmraa_lookup_reset_threads)
+{
+    const int count = 4;
+    std::vector<std::thread> threads;
+    std::vector<int> misses(count, 0);
+    std::atomic<int> running(count);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    /* GPIO0 is a pin of the mock platform */
+    if (mraa_get_platform_type() != MRAA_MOCK_PLATFORM)
+        return;
+
+    for (int i = 0; i < count; i++) {
+        threads.push_back(std::thread([&misses, &running, i]() {
+            for (int j = 0; j < 100000; j++) {
+                if (mraa_gpio_lookup("GPIO0") != 0)
+                    misses[i]++;
+            }
+            running--;
+        }));
+    }
+    while (running > 0) {
+        mraa_lookup_reset();
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int i = 0; i < count; i++)
+        EXPECT_EQ(0, misses[i]) << "Thread " << i;
+}
+
 /* Test the C exposed common methods */
 TEST_F(api_common_h_unit, test_libmraa_common_methods)
 {
@@ -91,6 +171,16 @@ TEST_F(api_common_h_unit, test_libmraa_common_methods)
 
         /* Test the lookup method/s */
         ASSERT_EQ(0, mraa_gpio_lookup("GPIO0"));
+        /* Only gpio capable pins are found by name */
+        EXPECT_EQ(-1, mraa_gpio_lookup("ADC0"));
+        EXPECT_EQ(-1, mraa_gpio_lookup("GPIO"));
+        EXPECT_EQ(-1, mraa_gpio_lookup(""));
+        EXPECT_EQ(-1, mraa_gpio_lookup(NULL));
+        /* MOCK buses have no names */
+        EXPECT_EQ(-1, mraa_i2c_lookup("GPIO0"));
+        EXPECT_EQ(-1, mraa_spi_lookup("SPI0"));
+        EXPECT_EQ(-1, mraa_pwm_lookup("PWM0"));
+        EXPECT_EQ(-1, mraa_uart_lookup("UART0"));
 
         /* MOCK does NOT have a subplatform */
         ASSERT_FALSE(mraa_has_sub_platform());
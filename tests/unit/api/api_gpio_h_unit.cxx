@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/gpio.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/* MRAA API gpio test fixture */
+class api_gpio_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_gpio_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_gpio_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp() {}
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_gpio_isr_dispatch_mode(MRAA_GPIO_ISR_DISPATCH_THREAD, 1);
+        }
+};
+
+/* Test the isr dispatch mode setters and getters */
+TEST_F(api_gpio_h_unit, test_isr_dispatch_mode)
+{
+    /* Handlers get their own thread by default */
+    ASSERT_EQ(MRAA_GPIO_ISR_DISPATCH_THREAD, mraa_gpio_get_isr_dispatch_mode());
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr_dispatch_mode(MRAA_GPIO_ISR_DISPATCH_SHARED, 0));
+    ASSERT_EQ(MRAA_GPIO_ISR_DISPATCH_SHARED, mraa_gpio_get_isr_dispatch_mode());
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr_dispatch_mode(MRAA_GPIO_ISR_DISPATCH_SHARED, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr_dispatch_mode(MRAA_GPIO_ISR_DISPATCH_THREAD, 0));
+    ASSERT_EQ(MRAA_GPIO_ISR_DISPATCH_THREAD, mraa_gpio_get_isr_dispatch_mode());
+
+    /* Unknown modes and too many loops are rejected */
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER,
+              mraa_gpio_isr_dispatch_mode((mraa_gpio_isr_dispatch_t) 2, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER,
+              mraa_gpio_isr_dispatch_mode(MRAA_GPIO_ISR_DISPATCH_SHARED, 1000));
+    ASSERT_EQ(MRAA_GPIO_ISR_DISPATCH_THREAD, mraa_gpio_get_isr_dispatch_mode());
+}
+
+/* Test moving handlers between dispatchers */
+TEST_F(api_gpio_h_unit, test_isr_dispatch_join_leave)
+{
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_gpio_isr_dispatch_join(NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_gpio_isr_dispatch_leave(NULL));
+
+    mraa_gpio_context gpio = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio != NULL);
+
+    /* The mock platform replaces the isr functions */
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_gpio_isr_dispatch_join(gpio));
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_gpio_isr_dispatch_leave(gpio));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+}
+
+/* Test the register backend against the mock register file */
+TEST_F(api_gpio_h_unit, test_gpio_mmap)
+{
+    mraa_gpio_context gpio = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(gpio, MRAA_GPIO_OUT));
+
+    /* Disabling requires mmap to be enabled */
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_gpio_use_mmaped(gpio, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_use_mmaped(gpio, 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_gpio_use_mmaped(gpio, 1));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    ASSERT_EQ(1, mraa_gpio_read(gpio));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 0));
+    ASSERT_EQ(0, mraa_gpio_read(gpio));
+
+    /* A second context shares the mapping of the first one */
+    mraa_gpio_context gpio2 = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio2 != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_use_mmaped(gpio2, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    ASSERT_EQ(1, mraa_gpio_read(gpio2));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio2));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_use_mmaped(gpio, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+}
+
+/* Edges are recorded in order and overflowing events are counted */
+TEST_F(api_gpio_h_unit, test_event_stream)
+{
+    mraa_gpio_context gpio = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(gpio, MRAA_GPIO_OUT));
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_gpio_event_stream_start(gpio, MRAA_GPIO_EDGE_NONE, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_start(gpio, MRAA_GPIO_EDGE_BOTH, 4));
+    ASSERT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_gpio_event_stream_start(gpio, MRAA_GPIO_EDGE_BOTH, 4));
+
+    for (int i = 0; i < 6; i++)
+        ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, (i + 1) % 2));
+
+    /* Wait for the drain thread to catch up */
+    mraa_gpio_event_stats_t stats;
+    for (int retry = 0; retry < 1000; retry++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_stats(gpio, &stats));
+        if (stats.received == 6)
+            break;
+        usleep(1000);
+    }
+    ASSERT_EQ(6, stats.received);
+    ASSERT_EQ(2, stats.overflows);
+    ASSERT_EQ(4, stats.max_fill);
+
+    mraa_gpio_edge_event_t events[8];
+    ASSERT_EQ(4, mraa_gpio_event_stream_read(gpio, events, 8, 100));
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(0, events[i].pin);
+        ASSERT_EQ(i % 2 ? MRAA_GPIO_EDGE_FALLING : MRAA_GPIO_EDGE_RISING, events[i].edge);
+        if (i > 0) {
+            ASSERT_LE(events[i - 1].timestamp, events[i].timestamp);
+        }
+    }
+    ASSERT_EQ(0, mraa_gpio_event_stream_read(gpio, events, 8, 0));
+    ASSERT_EQ(0, mraa_gpio_event_stream_read(gpio, events, 8, 10));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_stats(gpio, &stats));
+    ASSERT_EQ(4, stats.delivered);
+
+    /* Only the configured edges are recorded */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_stop(gpio));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_start(gpio, MRAA_GPIO_EDGE_FALLING, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 0));
+    ASSERT_EQ(1, mraa_gpio_event_stream_read(gpio, events, 8, 1000));
+    ASSERT_EQ(MRAA_GPIO_EDGE_FALLING, events[0].edge);
+
+    /* Closing the context stops the stream */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+}
+
+/* Every pin of a multi pin context gets an event source of its own */
+TEST_F(api_gpio_h_unit, test_event_stream_multi)
+{
+    /* The mock board has a single gpio, link two contexts on it */
+    int pins[] = { 0, 0 };
+    int high[] = { 1, 1 };
+    int mixed[] = { 0, 1 };
+    int stdin_flags = fcntl(0, F_GETFD);
+    mraa_gpio_context gpio = mraa_gpio_init_multi(pins, 2);
+    ASSERT_TRUE(gpio != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(gpio, MRAA_GPIO_OUT));
+
+    /* Every linked context reports through its own fd */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_start(gpio, MRAA_GPIO_EDGE_BOTH, 8));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write_multi(gpio, high));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write_multi(gpio, mixed));
+
+    mraa_gpio_edge_event_t events[8];
+    int count = 0;
+    for (int retry = 0; retry < 100 && count < 3; retry++) {
+        int ret = mraa_gpio_event_stream_read(gpio, events + count, 8 - count, 10);
+        ASSERT_LE(0, ret);
+        count += ret;
+    }
+    ASSERT_EQ(3, count);
+    int rising = 0;
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(0, events[i].pin);
+        if (events[i].edge == MRAA_GPIO_EDGE_RISING)
+            rising++;
+    }
+    EXPECT_EQ(2, rising);
+
+    /* Stopping closes the pipes of the pins and nothing else */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_event_stream_stop(gpio));
+    EXPECT_EQ(stdin_flags, fcntl(0, F_GETFD));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/i2c.h"
+
+#include <unistd.h>
+
+/* Must match MOCK_I2C_DEV_ADDR and MOCK_I2C_DEV_DATA_INIT_BYTE */
+#define MOCK_ADDR 0x33
+#define MOCK_INIT_BYTE 0xAB
+
+/* MRAA API i2c test fixture */
+class api_i2c_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_i2c_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_i2c_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            i2c = mraa_i2c_init(0);
+            ASSERT_TRUE(i2c != NULL);
+            ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(i2c, MOCK_ADDR));
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_i2c_stop(i2c);
+        }
+
+        mraa_i2c_context i2c;
+};
+
+/* Write registers, then read them back with a repeated start */
+TEST_F(api_i2c_h_unit, test_transfer_write_read)
+{
+    uint8_t reg_write[1] = { 0x02 };
+    uint8_t payload[3] = { 0x10, 0x20, 0x30 };
+    uint8_t reg_read[1] = { 0x01 };
+    uint8_t readback[5] = { 0 };
+    mraa_i2c_msg_t msgs[4] = {};
+
+    msgs[0].addr = MOCK_ADDR;
+    msgs[0].len = sizeof(reg_write);
+    msgs[0].buf = reg_write;
+    msgs[1].addr = MOCK_ADDR;
+    msgs[1].flags = MRAA_I2C_MSG_NOSTART;
+    msgs[1].len = sizeof(payload);
+    msgs[1].buf = payload;
+    msgs[2].addr = MOCK_ADDR;
+    msgs[2].len = sizeof(reg_read);
+    msgs[2].buf = reg_read;
+    msgs[3].addr = MOCK_ADDR;
+    msgs[3].flags = MRAA_I2C_MSG_READ;
+    msgs[3].len = sizeof(readback);
+    msgs[3].buf = readback;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_transfer(i2c, msgs, 4));
+    ASSERT_EQ(MOCK_INIT_BYTE, readback[0]);
+    ASSERT_EQ(0x10, readback[1]);
+    ASSERT_EQ(0x20, readback[2]);
+    ASSERT_EQ(0x30, readback[3]);
+    ASSERT_EQ(MOCK_INIT_BYTE, readback[4]);
+    ASSERT_EQ(0x20, mraa_i2c_read_byte_data(i2c, 0x03));
+}
+
+/* Invalid message lists are rejected and unknown slaves fail the transfer */
+TEST_F(api_i2c_h_unit, test_transfer_invalid)
+{
+    uint8_t reg[1] = { 0x00 };
+    mraa_i2c_msg_t msgs[MRAA_I2C_MAX_MSGS + 1] = {};
+
+    msgs[0].addr = MOCK_ADDR;
+    msgs[0].len = sizeof(reg);
+    msgs[0].buf = reg;
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_i2c_transfer(NULL, msgs, 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_transfer(i2c, msgs, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_transfer(i2c, msgs, MRAA_I2C_MAX_MSGS + 1));
+
+    msgs[0].flags = MRAA_I2C_MSG_NOSTART;
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_transfer(i2c, msgs, 1));
+
+    msgs[0].flags = MRAA_I2C_MSG_WRITE;
+    msgs[0].addr = MOCK_ADDR + 1;
+    ASSERT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_i2c_transfer(i2c, msgs, 1));
+}
+
+static void
+count_completion(mraa_async_request_t request, mraa_result_t result, void* args)
+{
+    if (result == MRAA_SUCCESS)
+        (*(int*) args)++;
+}
+
+/* Queued requests complete in order and signal the bus eventfd */
+TEST_F(api_i2c_h_unit, test_transfer_async)
+{
+    uint8_t write_buf[2] = { 0x04, 0x5A };
+    uint8_t reg[1] = { 0x04 };
+    uint8_t readback[1] = { 0 };
+    mraa_i2c_msg_t write_msgs[1] = {};
+    mraa_i2c_msg_t read_msgs[2] = {};
+    int completed = 0;
+
+    write_msgs[0].addr = MOCK_ADDR;
+    write_msgs[0].len = sizeof(write_buf);
+    write_msgs[0].buf = write_buf;
+    read_msgs[0].addr = MOCK_ADDR;
+    read_msgs[0].len = sizeof(reg);
+    read_msgs[0].buf = reg;
+    read_msgs[1].addr = MOCK_ADDR;
+    read_msgs[1].flags = MRAA_I2C_MSG_READ;
+    read_msgs[1].len = sizeof(readback);
+    read_msgs[1].buf = readback;
+
+    int efd = mraa_i2c_async_fd(i2c);
+    ASSERT_LE(0, efd);
+
+    mraa_async_request_t first = mraa_i2c_transfer_async(i2c, write_msgs, 1, count_completion, &completed);
+    mraa_async_request_t second = mraa_i2c_transfer_async(i2c, read_msgs, 2, count_completion, &completed);
+    ASSERT_TRUE(first != NULL);
+    ASSERT_TRUE(second != NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_async_wait(second));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_async_wait(first));
+    ASSERT_TRUE(mraa_async_done(first));
+    ASSERT_EQ(2, completed);
+    ASSERT_EQ(0x5A, readback[0]);
+
+    uint64_t signalled = 0;
+    ASSERT_EQ((ssize_t) sizeof(signalled), read(efd, &signalled, sizeof(signalled)));
+    ASSERT_EQ(2, signalled);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_async_free(first));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_async_free(second));
+
+    /* Failures are reported through the request */
+    write_msgs[0].addr = MOCK_ADDR + 1;
+    mraa_async_request_t failed = mraa_i2c_transfer_async(i2c, write_msgs, 1, NULL, NULL);
+    ASSERT_TRUE(failed != NULL);
+    ASSERT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_async_wait(failed));
+    mraa_async_free(failed);
+
+    ASSERT_TRUE(mraa_i2c_transfer_async(i2c, write_msgs, 0, NULL, NULL) == NULL);
+    write_msgs[0].addr = MOCK_ADDR;
+    write_msgs[0].flags = MRAA_I2C_MSG_NOSTART;
+    ASSERT_TRUE(mraa_i2c_transfer_async(i2c, write_msgs, 1, NULL, NULL) == NULL);
+}
+
+/* Every request is a transaction of its own that ends with a STOP */
+TEST_F(api_i2c_h_unit, test_transfer_async_not_merged)
+{
+    uint8_t write_buf[2] = { 0x04, 0x5A };
+    mraa_i2c_msg_t good[1] = {};
+    mraa_i2c_msg_t bad[1] = {};
+
+    good[0].addr = MOCK_ADDR;
+    good[0].len = sizeof(write_buf);
+    good[0].buf = write_buf;
+    bad[0] = good[0];
+    bad[0].addr = MOCK_ADDR + 1;
+
+    for (int i = 0; i < 50; i++) {
+        mraa_async_request_t first = mraa_i2c_transfer_async(i2c, good, 1, NULL, NULL);
+        mraa_async_request_t second = mraa_i2c_transfer_async(i2c, bad, 1, NULL, NULL);
+        ASSERT_TRUE(first != NULL);
+        ASSERT_TRUE(second != NULL);
+        ASSERT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_async_wait(second));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_async_wait(first)) << "Round " << i;
+        mraa_async_free(first);
+        mraa_async_free(second);
+    }
+}
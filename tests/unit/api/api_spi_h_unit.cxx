@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/spi.h"
+
+/* Must match MOCK_SPI_REPLY_DATA_MODIFIER_BYTE */
+#define REPLY_MODIFIER 0xAB
+
+/* MRAA API spi test fixture */
+class api_spi_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_spi_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_spi_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            spi = mraa_spi_init(0);
+            ASSERT_TRUE(spi != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_spi_stop(spi);
+        }
+
+        mraa_spi_context spi;
+};
+
+/* Test a command, payload and readback sequence as one transfer */
+TEST_F(api_spi_h_unit, test_transfer_batch)
+{
+    uint8_t cmd[1] = { 0x03 };
+    uint8_t payload[3] = { 0x10, 0x20, 0x30 };
+    uint8_t readback[4] = { 0 };
+    mraa_spi_segment_t segments[3] = {};
+
+    segments[0].tx_buf = cmd;
+    segments[0].len = sizeof(cmd);
+    segments[1].tx_buf = payload;
+    segments[1].len = sizeof(payload);
+    segments[1].speed_hz = 1000000;
+    segments[1].delay_usecs = 10;
+    segments[2].rx_buf = readback;
+    segments[2].len = sizeof(readback);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_batch(spi, segments, 3));
+    for (int i = 0; i < 4; i++)
+        ASSERT_EQ(REPLY_MODIFIER, readback[i]) << "Readback byte " << i;
+}
+
+/* Test argument checking */
+TEST_F(api_spi_h_unit, test_transfer_batch_invalid)
+{
+    uint8_t data[1] = { 0 };
+    mraa_spi_segment_t segments[MRAA_SPI_MAX_SEGMENTS + 1] = {};
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_spi_transfer_batch(NULL, segments, 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_batch(spi, NULL, 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_batch(spi, segments, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER,
+              mraa_spi_transfer_batch(spi, segments, MRAA_SPI_MAX_SEGMENTS + 1));
+
+    /* Empty segments are rejected */
+    segments[0].tx_buf = data;
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_batch(spi, segments, 1));
+}
+
+/* Test writes into the context owned receive buffer */
+TEST_F(api_spi_h_unit, test_write_buf_reuse)
+{
+    uint8_t small[2] = { 0x01, 0x02 };
+    uint8_t large[64];
+    uint16_t words[2] = { 0x1234, 0x5678 };
+
+    for (int i = 0; i < 64; i++)
+        large[i] = i;
+
+    const uint8_t* recv = mraa_spi_write_buf_reuse(spi, large, sizeof(large));
+    ASSERT_TRUE(recv != NULL);
+    for (int i = 0; i < 64; i++)
+        ASSERT_EQ(i ^ REPLY_MODIFIER, recv[i]) << "Byte " << i;
+
+    /* A shorter transfer reuses the same buffer */
+    const uint8_t* recv2 = mraa_spi_write_buf_reuse(spi, small, sizeof(small));
+    ASSERT_EQ(recv, recv2);
+    ASSERT_EQ(0x01 ^ REPLY_MODIFIER, recv2[0]);
+    ASSERT_EQ(0x02 ^ REPLY_MODIFIER, recv2[1]);
+
+    const uint16_t* wrecv = mraa_spi_write_buf_word_reuse(spi, words, sizeof(words));
+    ASSERT_TRUE(wrecv != NULL);
+    ASSERT_EQ(0x1234 ^ 0xABBA, wrecv[0]);
+
+    ASSERT_TRUE(mraa_spi_write_buf_reuse(NULL, small, sizeof(small)) == NULL);
+    ASSERT_TRUE(mraa_spi_write_buf_reuse(spi, small, 0) == NULL);
+}
+
+/* Requests queued back to back complete in order, merged or not */
+TEST_F(api_spi_h_unit, test_transfer_batch_async)
+{
+    uint8_t tx[2][4] = { { 0x01, 0x02, 0x03, 0x04 }, { 0x05, 0x06, 0x07, 0x08 } };
+    uint8_t rx[2][4] = { { 0 } };
+    mraa_spi_segment_t segments[2][1] = {};
+    mraa_async_request_t requests[2];
+
+    for (int r = 0; r < 2; r++) {
+        segments[r][0].tx_buf = tx[r];
+        segments[r][0].rx_buf = rx[r];
+        segments[r][0].len = sizeof(tx[r]);
+        requests[r] = mraa_spi_transfer_batch_async(spi, segments[r], 1, NULL, NULL);
+        ASSERT_TRUE(requests[r] != NULL);
+    }
+
+    for (int r = 0; r < 2; r++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_async_wait(requests[r]));
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(tx[r][i] ^ REPLY_MODIFIER, rx[r][i]) << "Request " << r << " byte " << i;
+        mraa_async_free(requests[r]);
+    }
+
+    ASSERT_LE(0, mraa_spi_async_fd(spi));
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/gpio.h"
+#include "mraa/i2c.h"
+#include "mraa/stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match MOCK_I2C_DEV_ADDR */
+#define MOCK_ADDR 0x33
+
+#define MAX_RECORDS 8
+
+/* MRAA API stats test fixture */
+class api_stats_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_stats_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_stats_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            gpio = mraa_gpio_init(0);
+            ASSERT_TRUE(gpio != NULL);
+            ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(gpio, MRAA_GPIO_OUT));
+            i2c = mraa_i2c_init(0);
+            ASSERT_TRUE(i2c != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_stats_enable(0);
+            mraa_i2c_stop(i2c);
+            mraa_gpio_close(gpio);
+        }
+
+        /* Find the record of an operation, NULL if absent */
+        const mraa_stats_record_t* find(mraa_stats_op_t op)
+        {
+            count = mraa_stats_get(records, MAX_RECORDS);
+            for (int i = 0; i < count && i < MAX_RECORDS; ++i) {
+                if (records[i].op == op) {
+                    return &records[i];
+                }
+            }
+            return NULL;
+        }
+
+        mraa_gpio_context gpio;
+        mraa_i2c_context i2c;
+        mraa_stats_record_t records[MAX_RECORDS];
+        int count;
+};
+
+/* Nothing is recorded while collection is off */
+TEST_F(api_stats_h_unit, test_disabled)
+{
+    ASSERT_FALSE(mraa_stats_enabled());
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    ASSERT_TRUE(find(MRAA_STATS_GPIO_WRITE) == NULL);
+}
+
+/* Calls, bytes, errors and latencies are accounted per operation */
+TEST_F(api_stats_h_unit, test_counters)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_stats_enable(1));
+    ASSERT_TRUE(mraa_stats_enabled());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, i & 1));
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(i2c, MOCK_ADDR));
+    uint8_t data[4];
+    ASSERT_EQ(4, mraa_i2c_read_bytes_data(i2c, 0, data, sizeof(data)));
+    ASSERT_NE(-1, mraa_i2c_read_byte(i2c));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(i2c, MOCK_ADDR + 1));
+    ASSERT_EQ(-1, mraa_i2c_read_byte(i2c));
+
+    const mraa_stats_record_t* rec = find(MRAA_STATS_GPIO_WRITE);
+    ASSERT_TRUE(rec != NULL);
+    ASSERT_EQ(10, rec->calls);
+    ASSERT_EQ(10, rec->bytes);
+    ASSERT_EQ(0, rec->errors);
+    ASSERT_LE(rec->p50_ns, rec->p99_ns);
+    ASSERT_LE(rec->max_ns, rec->total_ns);
+
+    rec = find(MRAA_STATS_I2C_READ);
+    ASSERT_TRUE(rec != NULL);
+    ASSERT_EQ(3, rec->calls);
+    ASSERT_EQ(5, rec->bytes);
+    ASSERT_EQ(1, rec->errors);
+    ASSERT_EQ(0, rec->id);
+}
+
+/* The snapshot has a header and one line per measured operation */
+TEST_F(api_stats_h_unit, test_snapshot)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_stats_enable(1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+
+    char* text = mraa_stats_snapshot();
+    ASSERT_TRUE(text != NULL);
+    ASSERT_TRUE(strncmp(text, "op ", 3) == 0);
+    ASSERT_TRUE(strstr(text, "\ngpio_write ") != NULL);
+    ASSERT_TRUE(strstr(text, "i2c_read") == NULL);
+    free(text);
+
+    ASSERT_STREQ("spi_transfer", mraa_stats_op_name(MRAA_STATS_SPI_TRANSFER));
+    ASSERT_TRUE(mraa_stats_op_name(MRAA_STATS_OP_COUNT) == NULL);
+}
+
+/* Reset clears the counters, closing a context drops its records */
+TEST_F(api_stats_h_unit, test_reset_and_close)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_stats_enable(1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    ASSERT_TRUE(find(MRAA_STATS_GPIO_WRITE) != NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_stats_reset());
+    ASSERT_TRUE(find(MRAA_STATS_GPIO_WRITE) == NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 0));
+    ASSERT_EQ(1, find(MRAA_STATS_GPIO_WRITE)->calls);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+    gpio = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio != NULL);
+    ASSERT_TRUE(find(MRAA_STATS_GPIO_WRITE) == NULL);
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/uart.h"
+
+#include <errno.h>
+#include <mutex>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+/* Must match MOCK_UART_DATA_BYTE */
+#define MOCK_BYTE 'Z'
+
+/* MRAA API uart test fixture */
+class api_uart_h_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        api_uart_h_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~api_uart_h_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            uart = mraa_uart_init(0);
+            ASSERT_TRUE(uart != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_uart_stop(uart);
+        }
+
+        /* Send through the mock loopback and wait until the engine got it */
+        void send(const std::string& data)
+        {
+            mraa_uart_rx_stats_t stats;
+            ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+            uint64_t expected = stats.bytes + data.size();
+            ASSERT_EQ((int) data.size(), mraa_uart_write(uart, data.data(), data.size()));
+            do {
+                ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+            } while (stats.bytes < expected);
+        }
+
+        static void on_frame(const char* frame, size_t length, void* args)
+        {
+            api_uart_h_unit* self = (api_uart_h_unit*) args;
+            std::lock_guard<std::mutex> guard(self->lock);
+            self->frames.push_back(std::string(frame, length));
+        }
+
+        /* Take count bytes from the receive engine, waiting for them */
+        std::string receive(size_t count)
+        {
+            std::string data(count, '\0');
+            size_t got = 0;
+            while (got < count) {
+                got += mraa_uart_read(uart, &data[got], count - got);
+            }
+            return data;
+        }
+
+        static void on_drained(void* args)
+        {
+            api_uart_h_unit* self = (api_uart_h_unit*) args;
+            __atomic_fetch_add(&self->drained, 1, __ATOMIC_SEQ_CST);
+        }
+
+        mraa_uart_context uart;
+        int drained = 0;
+        std::mutex lock;
+        std::vector<std::string> frames;
+};
+
+/* Without an engine reads go to the driver */
+TEST_F(api_uart_h_unit, test_read_direct)
+{
+    char buf[4];
+    ASSERT_EQ(4, mraa_uart_read(uart, buf, sizeof(buf)));
+    ASSERT_EQ(MOCK_BYTE, buf[3]);
+}
+
+/* Reads are served from the ring, oldest data first */
+TEST_F(api_uart_h_unit, test_rx_ring)
+{
+    char buf[16] = { 0 };
+    mraa_uart_rx_stats_t stats;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 10, NULL));
+    ASSERT_NE(MRAA_SUCCESS, mraa_uart_rx_start(uart, 10, NULL));
+    ASSERT_FALSE(mraa_uart_data_available(uart, 0));
+
+    send("hello");
+    send("world!");
+    ASSERT_TRUE(mraa_uart_data_available(uart, 0));
+    ASSERT_EQ(7, mraa_uart_read(uart, buf, 7));
+    ASSERT_EQ(std::string("hellowo"), std::string(buf, 7));
+    send("123456");
+    // the ring was rounded up to 16 bytes and wraps around here
+    ASSERT_EQ(10, mraa_uart_read(uart, buf, sizeof(buf)));
+    ASSERT_EQ(std::string("rld!123456"), std::string(buf, 10));
+    ASSERT_FALSE(mraa_uart_data_available(uart, 10));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+    ASSERT_EQ(17, stats.bytes);
+    ASSERT_EQ(0, stats.overruns);
+    ASSERT_EQ(0, stats.frames);
+    ASSERT_GE(stats.latency_max_ns, stats.latency_avg_ns);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(uart));
+    ASSERT_NE(MRAA_SUCCESS, mraa_uart_rx_stop(uart));
+}
+
+/* A non blocking read of an empty ring returns at once */
+TEST_F(api_uart_h_unit, test_rx_non_blocking)
+{
+    char buf[16];
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 16, NULL));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_non_blocking(uart, 1));
+    errno = 0;
+    ASSERT_EQ(-1, mraa_uart_read(uart, buf, sizeof(buf)));
+    ASSERT_EQ(EAGAIN, errno);
+
+    send("abc");
+    ASSERT_TRUE(mraa_uart_data_available(uart, 1000));
+    ASSERT_EQ(3, mraa_uart_read(uart, buf, sizeof(buf)));
+    ASSERT_EQ(std::string("abc"), std::string(buf, 3));
+    ASSERT_EQ(-1, mraa_uart_read(uart, buf, sizeof(buf)));
+
+    /* Blocking again waits for the data */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_non_blocking(uart, 0));
+    send("d");
+    ASSERT_EQ(1, mraa_uart_read(uart, buf, sizeof(buf)));
+    ASSERT_EQ('d', buf[0]);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(uart));
+}
+
+/* A full ring keeps the oldest bytes and counts the dropped ones */
+TEST_F(api_uart_h_unit, test_rx_overrun)
+{
+    char buf[64];
+    mraa_uart_rx_stats_t stats;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 16, NULL));
+    send(std::string(40, 'a'));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+    ASSERT_EQ(40, stats.bytes);
+    ASSERT_EQ(24, stats.overruns);
+    ASSERT_EQ(16, mraa_uart_read(uart, buf, sizeof(buf)));
+}
+
+/* Delimited frames are cut at the delimiter, oversized frames are dropped */
+TEST_F(api_uart_h_unit, test_rx_frame_delimiter)
+{
+    mraa_uart_framer_t framer = { MRAA_UART_FRAME_DELIMITER, '\n', on_frame, this };
+    mraa_uart_rx_stats_t stats;
+    char buf[4];
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 8, &framer));
+    send("ab\nc");
+    send("d\n\ntoo long frame\nok\n");
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+    ASSERT_EQ(4, stats.frames);
+    ASSERT_EQ(1, stats.framing_errors);
+    ASSERT_EQ(4, frames.size());
+    ASSERT_EQ("ab", frames[0]);
+    ASSERT_EQ("cd", frames[1]);
+    ASSERT_EQ("", frames[2]);
+    ASSERT_EQ("ok", frames[3]);
+    ASSERT_EQ(-1, mraa_uart_read(uart, buf, sizeof(buf)));
+}
+
+/* Fixed size and length prefixed frames */
+TEST_F(api_uart_h_unit, test_rx_frame_length)
+{
+    mraa_uart_framer_t framer = { MRAA_UART_FRAME_FIXED, 3, on_frame, this };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 8, &framer));
+    send("abcdefg");
+    ASSERT_EQ(2, frames.size());
+    ASSERT_EQ("def", frames[1]);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(uart));
+
+    frames.clear();
+    framer.type = MRAA_UART_FRAME_LENGTH_PREFIXED;
+    framer.param = 2;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 8, &framer));
+    send(std::string("\x00\x03xyz\x00", 6));
+    send(std::string("\x00\x00\x09", 3) + std::string(9, 'n') + std::string("\x00\x02hi", 4));
+    ASSERT_EQ(3, frames.size());
+    ASSERT_EQ("xyz", frames[0]);
+    ASSERT_EQ("", frames[1]);
+    ASSERT_EQ("hi", frames[2]);
+
+    mraa_uart_rx_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(uart, &stats));
+    ASSERT_EQ(1, stats.framing_errors);
+}
+
+/* Invalid arguments are rejected */
+TEST_F(api_uart_h_unit, test_rx_invalid)
+{
+    mraa_uart_framer_t framer = { MRAA_UART_FRAME_FIXED, 0, on_frame, this };
+    mraa_uart_rx_stats_t stats;
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_rx_start(NULL, 16, NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_rx_start(uart, 0, NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_rx_start(uart, 16, &framer));
+    framer.type = MRAA_UART_FRAME_LENGTH_PREFIXED;
+    framer.param = 3;
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_rx_start(uart, 16, &framer));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_rx_stats(uart, &stats));
+}
+
+/* Any rate up to the mock limit is accepted and read back */
+TEST_F(api_uart_h_unit, test_baudrate)
+{
+    unsigned int baud = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_get_baudrate(uart, &baud));
+    ASSERT_EQ(9600, baud);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(uart, 250000));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_get_baudrate(uart, &baud));
+    ASSERT_EQ(250000, baud);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(uart, 12000000));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_get_baudrate(uart, &baud));
+    ASSERT_EQ(12000000, baud);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_set_baudrate(uart, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_set_baudrate(uart, 12000001));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_get_baudrate(uart, &baud));
+    ASSERT_EQ(12000000, baud);
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_get_baudrate(uart, NULL));
+}
+
+/* Without an engine the segments are written in one go */
+TEST_F(api_uart_h_unit, test_writev_direct)
+{
+    mraa_uart_iovec_t iov[3] = { { "abc", 3 }, { "", 0 }, { "defg", 4 } };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 64, NULL));
+    ASSERT_EQ(7, mraa_uart_writev(uart, iov, 3));
+    ASSERT_EQ("abcdefg", receive(7));
+    ASSERT_EQ(0, mraa_uart_writev(uart, NULL, 0));
+    ASSERT_EQ(-1, mraa_uart_writev(uart, NULL, 1));
+}
+
+/* Queued writes larger than the queue arrive in order and get drained */
+TEST_F(api_uart_h_unit, test_tx_queue)
+{
+    mraa_uart_iovec_t iov[2] = { { "<head>", 6 }, { "<body>", 6 } };
+    mraa_uart_tx_stats_t stats;
+    std::string expected;
+    uint64_t drains = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(uart, 1024, NULL));
+    ASSERT_EQ(-1, mraa_uart_tx_drain_fd(uart));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_start(uart, 16, on_drained, this));
+    ASSERT_NE(MRAA_SUCCESS, mraa_uart_tx_start(uart, 16, NULL, NULL));
+
+    for (int i = 0; i < 10; ++i) {
+        std::string frame = "frame" + std::to_string(i);
+        ASSERT_EQ((int) frame.size(), mraa_uart_write(uart, frame.data(), frame.size()));
+        expected += frame;
+    }
+    ASSERT_EQ(12, mraa_uart_writev(uart, iov, 2));
+    expected += "<head><body>";
+    std::string big(100, 'x');
+    ASSERT_EQ(100, mraa_uart_write(uart, big.data(), big.size()));
+    expected += big;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(uart));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_stats(uart, &stats));
+    ASSERT_EQ(expected.size(), stats.bytes);
+    ASSERT_EQ(12, stats.requests);
+    ASSERT_LE(stats.max_fill, 16);
+    ASSERT_GE(stats.drains, 1);
+    ASSERT_GE(__atomic_load_n(&drained, __ATOMIC_SEQ_CST), 1);
+    ASSERT_EQ((ssize_t) sizeof(drains), read(mraa_uart_tx_drain_fd(uart), &drains, sizeof(drains)));
+    ASSERT_GE(drains, 1);
+    ASSERT_EQ(expected, receive(expected.size()));
+
+    // Stopping sends what is still queued
+    ASSERT_EQ(5, mraa_uart_write(uart, "tail!", 5));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_stop(uart));
+    ASSERT_EQ("tail!", receive(5));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_tx_stop(uart));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_tx_stats(uart, &stats));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_tx_start(uart, 0, NULL, NULL));
+}
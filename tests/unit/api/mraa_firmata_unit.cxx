@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "firmata/firmata.h"
+#include "mraa/firmata.h"
+#include "mraa/gpio.h"
+#include "mraa/i2c.h"
+#include "mraa_internal.h"
+
+#include <atomic>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+static long
+now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Waits up to 2s for the counter to reach count */
+static bool
+wait_count(std::atomic<int>* counter, int count)
+{
+    for (int i = 0; i < 2000; i++) {
+        if (*counter >= count)
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+/*
+ * A StandardFirmata board behind the master side of a pty. It answers the
+ * firmware query and I2C reads from its register files, and logs the
+ * messages the host sent.
+ */
+class firmata_board
+{
+  public:
+    firmata_board() : read_requests(0), master(-1), stop(false)
+    {
+        memset(regs, 0, sizeof(regs));
+        memset(silent, 0, sizeof(silent));
+    }
+
+    bool open_pty()
+    {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master == -1 || grantpt(master) != 0 || unlockpt(master) != 0)
+            return false;
+        thread = std::thread(&firmata_board::run, this);
+        return true;
+    }
+
+    const char* slave_path()
+    {
+        return ptsname(master);
+    }
+
+    void close_pty()
+    {
+        stop = true;
+        if (thread.joinable())
+            thread.join();
+        if (master != -1)
+            close(master);
+        master = -1;
+    }
+
+    /* Sends raw bytes to the host */
+    void send(const std::vector<uint8_t>& msg)
+    {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        for (size_t done = 0; done < msg.size();) {
+            ssize_t w = write(master, msg.data() + done, msg.size() - done);
+            if (w <= 0)
+                break;
+            done += w;
+        }
+    }
+
+    /* An I2C_REPLY with registers reg to reg + len - 1 of addr */
+    void reply(int addr, int reg, int len)
+    {
+        std::vector<uint8_t> msg = { FIRMATA_START_SYSEX, FIRMATA_I2C_REPLY, (uint8_t) (addr & 0x7f),
+                                     (uint8_t) (addr >> 7), (uint8_t) (reg & 0x7f), (uint8_t) (reg >> 7) };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int i = 0; i < len; i++) {
+                msg.push_back(regs[addr][reg + i] & 0x7f);
+                msg.push_back(regs[addr][reg + i] >> 7);
+            }
+        }
+        msg.push_back(FIRMATA_END_SYSEX);
+        send(msg);
+    }
+
+    void set_reg(int addr, int reg, uint8_t value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        regs[addr][reg] = value;
+    }
+
+    /* Requests to addr are never answered */
+    void set_silent(int addr, bool on)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        silent[addr] = on;
+    }
+
+    /* Sysex messages of a kind the host sent, without start, kind and end */
+    std::vector<std::vector<uint8_t> > sysex(uint8_t kind)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::vector<uint8_t> > found;
+        for (size_t i = 0; i < messages.size(); i++) {
+            if (messages[i].size() >= 3 && messages[i][0] == FIRMATA_START_SYSEX && messages[i][1] == kind)
+                found.push_back(std::vector<uint8_t>(messages[i].begin() + 2, messages[i].end() - 1));
+        }
+        return found;
+    }
+
+    /* I2C requests of a mode the host sent */
+    int requests(int mode)
+    {
+        std::vector<std::vector<uint8_t> > found = sysex(FIRMATA_I2C_REQUEST);
+        int count = 0;
+        for (size_t i = 0; i < found.size(); i++) {
+            if (found[i].size() >= 2 && ((found[i][1] >> 3) & 0x03) == mode)
+                count++;
+        }
+        return count;
+    }
+
+    /* Waits up to 2s for count requests of a mode, then settles a little
+     * so extra ones show up too */
+    int requests(int mode, int count)
+    {
+        for (int i = 0; i < 2000 && requests(mode) < count; i++)
+            usleep(1000);
+        usleep(20000);
+        return requests(mode);
+    }
+
+    /* Digital messages the host sent */
+    std::vector<std::vector<uint8_t> > digital()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::vector<uint8_t> > found;
+        for (size_t i = 0; i < messages.size(); i++) {
+            if ((messages[i][0] & 0xf0) == FIRMATA_DIGITAL_MESSAGE)
+                found.push_back(messages[i]);
+        }
+        return found;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.clear();
+        read_requests = 0;
+    }
+
+    std::atomic<int> read_requests;
+
+  protected:
+    /* Answers a complete message of the host */
+    void handle(const std::vector<uint8_t>& msg)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.push_back(msg);
+        }
+        if (msg[0] != FIRMATA_START_SYSEX || msg.size() < 3)
+            return;
+        if (msg[1] == FIRMATA_REPORT_FIRMWARE) {
+            send({ FIRMATA_START_SYSEX, FIRMATA_REPORT_FIRMWARE, 2, 5, 's', 0, 'i', 0, 'm', 0, FIRMATA_END_SYSEX });
+        } else if (msg[1] == FIRMATA_I2C_REQUEST && msg.size() >= 5) {
+            int addr = msg[2];
+            int mode = (msg[3] >> 3) & 0x03;
+            std::vector<int> args;
+            for (size_t i = 4; i + 1 < msg.size() - 0 && msg[i] != FIRMATA_END_SYSEX; i += 2)
+                args.push_back(msg[i] | (msg[i + 1] << 7));
+            bool quiet;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                quiet = silent[addr];
+            }
+            if (mode == I2C_MODE_READ) {
+                read_requests++;
+                if (quiet)
+                    return;
+                if (args.size() == 1)
+                    reply(addr, 0, args[0]);
+                else if (args.size() == 2)
+                    reply(addr, args[0], args[1]);
+            } else if (mode == I2C_CONTINUOUSREAD && args.size() == 2 && !quiet) {
+                // the first report of the sampling loop
+                reply(addr, args[0], args[1]);
+            }
+        }
+    }
+
+    void run()
+    {
+        std::vector<uint8_t> msg;
+        size_t need = 0;
+        uint8_t buf[512];
+        while (!stop) {
+            struct pollfd pfd = { master, POLLIN, 0 };
+            if (poll(&pfd, 1, 10) <= 0)
+                continue;
+            ssize_t n = read(master, buf, sizeof(buf));
+            if (n <= 0) {
+                // the slave is not open
+                usleep(1000);
+                continue;
+            }
+            for (ssize_t i = 0; i < n; i++) {
+                uint8_t b = buf[i];
+                if ((b & 0x80) && b != FIRMATA_END_SYSEX) {
+                    msg.clear();
+                    uint8_t msn = b & 0xf0;
+                    if (b == FIRMATA_START_SYSEX)
+                        need = 0;
+                    else if (msn == FIRMATA_DIGITAL_MESSAGE || msn == FIRMATA_ANALOG_MESSAGE || b == FIRMATA_SET_PIN_MODE)
+                        need = 3;
+                    else if (msn == FIRMATA_REPORT_ANALOG || msn == FIRMATA_REPORT_DIGITAL)
+                        need = 2;
+                    else
+                        need = 1;
+                }
+                msg.push_back(b);
+                if ((need == 0 && b == FIRMATA_END_SYSEX) || (need != 0 && msg.size() == need)) {
+                    handle(msg);
+                    msg.clear();
+                }
+            }
+        }
+    }
+
+    int master;
+    std::atomic<bool> stop;
+    std::thread thread;
+    std::mutex mutex;
+    std::mutex write_mutex;
+    std::vector<std::vector<uint8_t> > messages;
+    uint8_t regs[128][256];
+    bool silent[128];
+};
+
+static firmata_board board;
+
+/* MRAA firmata sub platform test fixture, the board is simulated behind a
+ * pty and added once per process */
+class mraa_firmata_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_firmata_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_firmata_unit() {}
+
+        static void SetUpTestCase()
+        {
+            ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+            /* the mock uart would never reach the pty, the firmata reader
+             * thread keeps using these until the process ends */
+            plat->adv_func->uart_init_raw_replace = NULL;
+            plat->adv_func->uart_flush_replace = NULL;
+            plat->adv_func->uart_set_non_blocking_replace = NULL;
+            plat->adv_func->uart_read_replace = NULL;
+            plat->adv_func->uart_write_replace = NULL;
+            plat->adv_func->uart_data_available_replace = NULL;
+            ASSERT_TRUE(board.open_pty());
+            ASSERT_EQ(MRAA_SUCCESS, mraa_add_subplatform(MRAA_GENERIC_FIRMATA, board.slave_path()));
+            ASSERT_TRUE(mraa_has_sub_platform());
+        }
+
+        static void TearDownTestCase()
+        {
+            board.close_pty();
+        }
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            ASSERT_TRUE(mraa_has_sub_platform());
+            board.clear();
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown() {}
+
+        mraa_i2c_context i2c(uint8_t addr)
+        {
+            mraa_i2c_context dev = mraa_i2c_init(MRAA_SUB_PLATFORM_MASK | 0);
+            if (dev != NULL)
+                mraa_i2c_address(dev, addr);
+            return dev;
+        }
+};
+
+/* A reply already parsed when the read starts waiting is taken as is */
+TEST_F(mraa_firmata_unit, test_i2c_early_reply)
+{
+    mraa_i2c_context dev = i2c(0x20);
+    ASSERT_TRUE(dev != NULL);
+    for (int reg = 0; reg < 4; reg++)
+        board.set_reg(0x20, reg, 0x40 + reg);
+
+    /* the board sends the first report right away, well before the read */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(dev, 0, 4));
+    usleep(50000);
+    long start = now_ms();
+    EXPECT_EQ(0x42, mraa_i2c_read_byte_data(dev, 2));
+    EXPECT_LT(now_ms() - start, 100);
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(dev));
+
+    /* replies racing the start of the wait are never lost either */
+    for (int i = 0; i < 200; i++) {
+        board.set_reg(0x20, 8, (uint8_t) i);
+        ASSERT_EQ(i & 0xff, mraa_i2c_read_byte_data(dev, 8)) << "Read " << i;
+    }
+    mraa_i2c_stop(dev);
+}
+
+/* A board that does not answer fails the read after 100ms */
+TEST_F(mraa_firmata_unit, test_i2c_timeout)
+{
+    mraa_i2c_context dev = i2c(0x21);
+    ASSERT_TRUE(dev != NULL);
+    board.set_silent(0x21, true);
+
+    long start = now_ms();
+    EXPECT_EQ(-1, mraa_i2c_read_byte_data(dev, 0));
+    long elapsed = now_ms() - start;
+    EXPECT_GE(elapsed, 95);
+    EXPECT_LT(elapsed, 1000);
+    EXPECT_EQ(1, board.read_requests);
+
+    uint8_t data[4];
+    start = now_ms();
+    EXPECT_EQ(-1, mraa_i2c_read(dev, data, sizeof(data)));
+    EXPECT_GE(now_ms() - start, 95);
+
+    /* the next answered read is not confused by the missing reply */
+    board.set_silent(0x21, false);
+    board.set_reg(0x21, 0, 0x5a);
+    EXPECT_EQ(0x5a, mraa_i2c_read_byte_data(dev, 0));
+    mraa_i2c_stop(dev);
+}
+
+static void
+count_isr(void* arg)
+{
+    (*(std::atomic<int>*) arg)++;
+}
+
+/* An input edge wakes the waiter of its pin only, and once */
+TEST_F(mraa_firmata_unit, test_gpio_edge)
+{
+    std::atomic<int> count_a(0), count_b(0);
+    mraa_gpio_context a = mraa_gpio_init(MRAA_SUB_PLATFORM_MASK | 10);
+    mraa_gpio_context b = mraa_gpio_init(MRAA_SUB_PLATFORM_MASK | 11);
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(b != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(a, MRAA_GPIO_IN));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(b, MRAA_GPIO_IN));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr(a, MRAA_GPIO_EDGE_BOTH, count_isr, &count_a));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr(b, MRAA_GPIO_EDGE_BOTH, count_isr, &count_b));
+
+    /* pin 10 is bit 2 of port 1, sent while the isr threads may still be
+     * coming up. They fire at all because they wait on the board instead of
+     * opening sysfs value files. */
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x04, 0x00 });
+    EXPECT_TRUE(wait_count(&count_a, 1));
+    usleep(50000);
+    EXPECT_EQ(1, count_a);
+    EXPECT_EQ(0, count_b);
+    EXPECT_EQ(1, mraa_gpio_read(a));
+
+    /* the wakeup for pin 11 finds the bit of pin 10 cleared */
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x0c, 0x00 });
+    EXPECT_TRUE(wait_count(&count_b, 1));
+    usleep(50000);
+    EXPECT_EQ(1, count_a);
+    EXPECT_EQ(1, count_b);
+
+    /* a report without changes wakes nobody */
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x0c, 0x00 });
+    usleep(50000);
+    EXPECT_EQ(1, count_a);
+    EXPECT_EQ(1, count_b);
+
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x00, 0x00 });
+    EXPECT_TRUE(wait_count(&count_a, 2));
+    EXPECT_TRUE(wait_count(&count_b, 2));
+
+    /* the waiters are cancelled in the condition wait and let go of the lock */
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_isr_exit(a));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_isr_exit(b));
+    EXPECT_EQ(0, mraa_gpio_read(a));
+    EXPECT_EQ(0, mraa_gpio_read(b));
+
+    /* edges before the isr is set up again do not count */
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x04, 0x00 });
+    usleep(50000);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_isr(a, MRAA_GPIO_EDGE_BOTH, count_isr, &count_a));
+    usleep(50000);
+    EXPECT_EQ(2, count_a);
+    board.send({ FIRMATA_DIGITAL_MESSAGE | 1, 0x00, 0x00 });
+    EXPECT_TRUE(wait_count(&count_a, 3));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_isr_exit(a));
+
+    mraa_gpio_close(a);
+    mraa_gpio_close(b);
+}
+
+/* Word reads return the register at command in the low byte like SMBus */
+TEST_F(mraa_firmata_unit, test_i2c_word_order)
+{
+    mraa_i2c_context dev = i2c(0x22);
+    ASSERT_TRUE(dev != NULL);
+    board.set_reg(0x22, 4, 0x34);
+    board.set_reg(0x22, 5, 0x12);
+
+    EXPECT_EQ(0x1234, mraa_i2c_read_word_data(dev, 4));
+    EXPECT_EQ(1, board.read_requests);
+
+    /* the same from the cache */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(dev, 4, 2));
+    EXPECT_EQ(0x1234, mraa_i2c_read_word_data(dev, 4));
+    EXPECT_EQ(1, board.read_requests);
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(dev));
+    mraa_i2c_stop(dev);
+}
+
+/* Registers the board reports continuously are read without a request */
+TEST_F(mraa_firmata_unit, test_i2c_continuous_cache)
+{
+    mraa_i2c_context dev = i2c(0x23);
+    ASSERT_TRUE(dev != NULL);
+    for (int reg = 0x10; reg < 0x14; reg++)
+        board.set_reg(0x23, reg, reg);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(dev, 0x10, 4));
+    EXPECT_EQ(1, board.requests(I2C_CONTINUOUSREAD, 1));
+    EXPECT_EQ(0x11, mraa_i2c_read_byte_data(dev, 0x11));
+    EXPECT_EQ(0x1312, mraa_i2c_read_word_data(dev, 0x12));
+    uint8_t data[4];
+    EXPECT_EQ(4, mraa_i2c_read_bytes_data(dev, 0x10, data, 4));
+    EXPECT_EQ(0x10, data[0]);
+    EXPECT_EQ(0x13, data[3]);
+    EXPECT_EQ(0, board.read_requests);
+
+    /* the next sample of the board replaces the cached one */
+    board.set_reg(0x23, 0x11, 0x77);
+    board.reply(0x23, 0x10, 4);
+    int value = -1;
+    for (int i = 0; i < 200 && value != 0x77; i++) {
+        usleep(1000);
+        value = mraa_i2c_read_byte_data(dev, 0x11);
+    }
+    EXPECT_EQ(0x77, value);
+    EXPECT_EQ(0, board.read_requests);
+
+    /* registers outside the range still go to the board */
+    EXPECT_EQ(0, mraa_i2c_read_byte_data(dev, 0x14));
+    EXPECT_EQ(1, board.read_requests);
+
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(dev));
+    EXPECT_EQ(1, board.requests(I2C_STOP_READING, 1));
+    EXPECT_EQ(0x77, mraa_i2c_read_byte_data(dev, 0x11));
+    EXPECT_EQ(2, board.read_requests);
+    mraa_i2c_stop(dev);
+}
+
+/* StandardFirmata serves 8 continuous reads, covered ranges are not sent */
+TEST_F(mraa_firmata_unit, test_i2c_continuous_limit)
+{
+    mraa_i2c_context dev = i2c(0x24);
+    mraa_i2c_context other = i2c(0x25);
+    ASSERT_TRUE(dev != NULL);
+    ASSERT_TRUE(other != NULL);
+
+    for (int i = 0; i < FIRMATA_I2C_MAX_QUERIES; i++)
+        ASSERT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(dev, i * 4, 2)) << "Query " << i;
+    EXPECT_EQ(FIRMATA_I2C_MAX_QUERIES, board.requests(I2C_CONTINUOUSREAD, FIRMATA_I2C_MAX_QUERIES));
+
+    EXPECT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_firmata_i2c_read_continuous(dev, 0x40, 2));
+    EXPECT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_firmata_i2c_read_continuous(other, 0, 2));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(dev, 5, 1));
+    EXPECT_EQ(FIRMATA_I2C_MAX_QUERIES, board.requests(I2C_CONTINUOUSREAD, FIRMATA_I2C_MAX_QUERIES));
+
+    /* the board drops one query of the address per stop message */
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(other));
+    EXPECT_EQ(0, board.requests(I2C_STOP_READING, 0));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(dev));
+    EXPECT_EQ(FIRMATA_I2C_MAX_QUERIES, board.requests(I2C_STOP_READING, FIRMATA_I2C_MAX_QUERIES));
+
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_read_continuous(other, 0, 2));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_firmata_i2c_stop_reading(other));
+    mraa_i2c_stop(dev);
+    mraa_i2c_stop(other);
+}
+
+/* Writing several pins sends one 3 byte message per port they are on */
+TEST_F(mraa_firmata_unit, test_gpio_write_multi)
+{
+    int pins[] = { MRAA_SUB_PLATFORM_MASK | 2, MRAA_SUB_PLATFORM_MASK | 3, MRAA_SUB_PLATFORM_MASK | 17 };
+    int values[] = { 1, 0, 1 };
+    mraa_gpio_context dev = mraa_gpio_init_multi(pins, 3);
+    ASSERT_TRUE(dev != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(dev, MRAA_GPIO_OUT));
+    usleep(20000);
+    board.clear();
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write_multi(dev, values));
+    usleep(50000);
+    std::vector<std::vector<uint8_t> > sent = board.digital();
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(std::vector<uint8_t>({ FIRMATA_DIGITAL_MESSAGE | 0, 0x04, 0x00 }), sent[0]);
+    EXPECT_EQ(std::vector<uint8_t>({ FIRMATA_DIGITAL_MESSAGE | 2, 0x02, 0x00 }), sent[1]);
+
+    /* the message carries the pins of the port written before */
+    int high[] = { 1, 1, 0 };
+    board.clear();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write_multi(dev, high));
+    usleep(50000);
+    sent = board.digital();
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(std::vector<uint8_t>({ FIRMATA_DIGITAL_MESSAGE | 0, 0x0c, 0x00 }), sent[0]);
+    EXPECT_EQ(std::vector<uint8_t>({ FIRMATA_DIGITAL_MESSAGE | 2, 0x00, 0x00 }), sent[1]);
+}
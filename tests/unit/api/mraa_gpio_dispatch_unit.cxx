@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "gpio/gpio_dispatch.h"
+#include "linux/gpio.h"
+#include "mraa/common.h"
+#include "mraa_internal.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* A chardev line whose event handle is the read end of a pipe */
+struct fake_line {
+    struct _gpio dev;
+    struct _gpio_group group;
+    mraa_gpio_event event;
+    int fds[2];
+    int count;
+    int entered;
+    int left;
+    int active; /* isrs running right now */
+    useconds_t hold; /* time the isr takes */
+    mraa_boolean_t remove_self;
+};
+
+static void
+fake_isr(void* arg)
+{
+    struct fake_line* line = (struct fake_line*) arg;
+
+    __atomic_store_n(&line->entered, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&line->active, 1, __ATOMIC_ACQ_REL);
+    if (line->hold != 0) {
+        usleep(line->hold);
+    }
+    __atomic_add_fetch(&line->count, 1, __ATOMIC_RELEASE);
+    if (line->remove_self) {
+        mraa_gpio_dispatch_remove(&line->dev);
+    }
+    __atomic_sub_fetch(&line->active, 1, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&line->left, 1, __ATOMIC_RELEASE);
+}
+
+static void
+fake_line_init(struct fake_line* line, int pin)
+{
+    memset(line, 0, sizeof(*line));
+    ASSERT_EQ(0, pipe2(line->fds, O_CLOEXEC));
+    line->group.is_required = 1;
+    line->group.num_gpio_lines = 1;
+    line->group.event_handles = &line->fds[0];
+    line->dev.pin = pin;
+    line->dev.num_chips = 1;
+    line->dev.gpio_group = &line->group;
+    line->dev.num_pins = 1;
+    line->dev.events = &line->event;
+    line->dev.isr = fake_isr;
+    line->dev.isr_args = line;
+}
+
+static void
+fake_line_close(struct fake_line* line)
+{
+    close(line->fds[0]);
+    close(line->fds[1]);
+}
+
+/* Queues one edge record on the line */
+static void
+fake_edge(struct fake_line* line, uint64_t timestamp)
+{
+    struct gpioevent_data data;
+    memset(&data, 0, sizeof(data));
+    data.timestamp = timestamp;
+    data.id = GPIOEVENT_EVENT_RISING_EDGE;
+    ASSERT_EQ((ssize_t) sizeof(data), write(line->fds[1], &data, sizeof(data)));
+}
+
+/* Waits up to 2s for the counter to reach count */
+static bool
+wait_count(int* counter, int count)
+{
+    for (int i = 0; i < 2000; i++) {
+        if (__atomic_load_n(counter, __ATOMIC_ACQUIRE) >= count)
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+/* MRAA gpio shared dispatcher test fixture */
+class mraa_gpio_dispatch_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_gpio_dispatch_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_gpio_dispatch_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+            chardev_capable = plat->chardev_capable;
+            /* event sources are taken from the chardev event handles */
+            plat->chardev_capable = 1;
+            ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_configure(MRAA_GPIO_ISR_DISPATCH_SHARED, 2));
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            plat->chardev_capable = chardev_capable;
+            mraa_gpio_dispatch_configure(MRAA_GPIO_ISR_DISPATCH_THREAD, 1);
+            mraa_deinit();
+        }
+
+        mraa_boolean_t chardev_capable;
+};
+
+/* Every queued edge calls the isr of its line once */
+TEST_F(mraa_gpio_dispatch_unit, test_dispatch_fires)
+{
+    struct fake_line a, b;
+    fake_line_init(&a, 1);
+    fake_line_init(&b, 2);
+
+    ASSERT_TRUE(mraa_gpio_dispatch_enabled());
+    ASSERT_TRUE(mraa_gpio_dispatch_eligible(&a.dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&a.dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&b.dev));
+    /* a context is only served once */
+    EXPECT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_gpio_dispatch_add(&a.dev));
+
+    for (int i = 1; i <= 5; i++)
+        fake_edge(&a, 1000 * i);
+    for (int i = 1; i <= 3; i++)
+        fake_edge(&b, 7);
+
+    EXPECT_TRUE(wait_count(&a.count, 5));
+    EXPECT_TRUE(wait_count(&b.count, 3));
+    usleep(20000);
+    EXPECT_EQ(5, a.count);
+    EXPECT_EQ(3, b.count);
+    /* the record of the last edge is passed on */
+    EXPECT_EQ(0, a.event.id);
+    EXPECT_EQ(5000, a.event.timestamp);
+    EXPECT_EQ(7, b.event.timestamp);
+
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&a.dev));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&b.dev));
+    EXPECT_TRUE(a.dev.isr_dispatch == NULL);
+    /* removing twice is harmless */
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&a.dev));
+
+    fake_edge(&a, 1);
+    usleep(20000);
+    EXPECT_EQ(5, a.count);
+
+    fake_line_close(&a);
+    fake_line_close(&b);
+}
+
+/* An isr may remove its own context, pending edges are dropped */
+TEST_F(mraa_gpio_dispatch_unit, test_dispatch_remove_from_isr)
+{
+    struct fake_line a;
+    fake_line_init(&a, 1);
+    a.remove_self = 1;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&a.dev));
+    fake_edge(&a, 1);
+    fake_edge(&a, 2);
+    fake_edge(&a, 3);
+
+    EXPECT_TRUE(wait_count(&a.left, 1));
+    usleep(20000);
+    EXPECT_EQ(1, a.count);
+    EXPECT_TRUE(a.dev.isr_dispatch == NULL);
+
+    fake_line_close(&a);
+}
+
+/* Removal waits for an isr in flight and no isr runs after it returned */
+TEST_F(mraa_gpio_dispatch_unit, test_dispatch_remove_while_firing)
+{
+    struct fake_line a;
+    fake_line_init(&a, 1);
+    a.hold = 100000;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&a.dev));
+    fake_edge(&a, 1);
+    fake_edge(&a, 2);
+    ASSERT_TRUE(wait_count(&a.entered, 1));
+
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&a.dev));
+    /* the second edge may or may not have made it before the removal */
+    EXPECT_EQ(0, __atomic_load_n(&a.active, __ATOMIC_ACQUIRE));
+    EXPECT_EQ(1, __atomic_load_n(&a.left, __ATOMIC_ACQUIRE));
+    int count = __atomic_load_n(&a.count, __ATOMIC_ACQUIRE);
+    EXPECT_GE(count, 1);
+    EXPECT_LE(count, 2);
+
+    fake_edge(&a, 3);
+    usleep(150000);
+    EXPECT_EQ(count, __atomic_load_n(&a.count, __ATOMIC_ACQUIRE));
+
+    fake_line_close(&a);
+}
+
+/* Loops in use survive a shutdown, idle ones are stopped */
+TEST_F(mraa_gpio_dispatch_unit, test_dispatch_shutdown)
+{
+    struct fake_line a;
+    fake_line_init(&a, 1);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&a.dev));
+    mraa_gpio_dispatch_shutdown();
+    fake_edge(&a, 1);
+    EXPECT_TRUE(wait_count(&a.count, 1));
+
+    /* the number of loops is fixed while they are in use */
+    EXPECT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_gpio_dispatch_configure(MRAA_GPIO_ISR_DISPATCH_SHARED, 4));
+
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&a.dev));
+    mraa_gpio_dispatch_shutdown();
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_configure(MRAA_GPIO_ISR_DISPATCH_SHARED, 4));
+
+    /* loops start again on demand */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_add(&a.dev));
+    fake_edge(&a, 2);
+    EXPECT_TRUE(wait_count(&a.count, 2));
+    EXPECT_EQ(MRAA_SUCCESS, mraa_gpio_dispatch_remove(&a.dev));
+
+    fake_line_close(&a);
+}
@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "iio/iio_attr.h"
+#include "iio/iio_capture.h"
+#include "mraa/iio.h"
+#include "mraa_internal.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+/* Stores the low bytes bytes of value at p in the given byte order */
+static void
+put_bytes(uint8_t* p, uint64_t value, unsigned int bytes, bool lendian)
+{
+    for (unsigned int i = 0; i < bytes; i++) {
+        uint8_t b = (uint8_t) (value >> (8 * i));
+        p[lendian ? i : bytes - 1 - i] = b;
+    }
+}
+
+static mraa_iio_channel
+make_channel(unsigned int bytes, unsigned int bits_used, unsigned int shift, bool lendian, bool signedd, unsigned int location)
+{
+    mraa_iio_channel chan;
+    memset(&chan, 0, sizeof(chan));
+    chan.enabled = 1;
+    chan.bytes = bytes;
+    chan.bits_used = bits_used;
+    chan.shift = shift;
+    chan.lendian = lendian;
+    chan.signedd = signedd;
+    chan.location = location;
+    return chan;
+}
+
+/* MRAA iio scan decoding test fixture */
+class mraa_iio_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_iio_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_iio_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp() {}
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown() {}
+};
+
+/* Values are read at the channel location of every scan */
+TEST_F(mraa_iio_unit, test_demux_stride)
+{
+    const unsigned int scan_size = 3;
+    uint8_t scans[4 * scan_size];
+    int32_t out[4];
+
+    memset(scans, 0xaa, sizeof(scans));
+    for (int s = 0; s < 4; s++)
+        scans[s * scan_size + 1] = (uint8_t) (10 * s + 7);
+
+    mraa_iio_channel chan = make_channel(1, 8, 0, true, false, 1);
+    mraa_iio_demux(scans, 4, scan_size, &chan, out);
+    EXPECT_EQ(7, out[0]);
+    EXPECT_EQ(17, out[1]);
+    EXPECT_EQ(27, out[2]);
+    EXPECT_EQ(37, out[3]);
+}
+
+/* One byte storage, shifted and masked, unsigned and signed */
+TEST_F(mraa_iio_unit, test_demux_1_byte)
+{
+    uint8_t scan = 0xfc; /* 1111 1100 */
+    int32_t out;
+
+    mraa_iio_channel chan = make_channel(1, 4, 2, true, false, 0);
+    mraa_iio_demux(&scan, 1, 1, &chan, &out);
+    EXPECT_EQ(0xf, out);
+
+    chan.signedd = 1;
+    mraa_iio_demux(&scan, 1, 1, &chan, &out);
+    EXPECT_EQ(-1, out);
+
+    scan = 0x7f;
+    chan = make_channel(1, 8, 0, true, true, 0);
+    mraa_iio_demux(&scan, 1, 1, &chan, &out);
+    EXPECT_EQ(127, out);
+    scan = 0x80;
+    mraa_iio_demux(&scan, 1, 1, &chan, &out);
+    EXPECT_EQ(-128, out);
+}
+
+/* Two byte storage, a 12 bit accelerometer in the top bits and a 10 bit adc */
+TEST_F(mraa_iio_unit, test_demux_2_bytes)
+{
+    uint8_t scan[2];
+    int32_t out;
+
+    for (int le = 0; le < 2; le++) {
+        put_bytes(scan, (uint16_t) ((unsigned int) -5 << 4) | 0x3, 2, le);
+        mraa_iio_channel chan = make_channel(2, 12, 4, le, true, 0);
+        mraa_iio_demux(scan, 1, 2, &chan, &out);
+        EXPECT_EQ(-5, out) << (le ? "le" : "be");
+
+        chan.signedd = 0;
+        mraa_iio_demux(scan, 1, 2, &chan, &out);
+        EXPECT_EQ(0xffb, out) << (le ? "le" : "be");
+
+        /* bits above realbits are not part of the value */
+        put_bytes(scan, 0xfc05, 2, le);
+        chan = make_channel(2, 10, 0, le, false, 0);
+        mraa_iio_demux(scan, 1, 2, &chan, &out);
+        EXPECT_EQ(5, out) << (le ? "le" : "be");
+    }
+
+    /* the byte order matters */
+    scan[0] = 0x12;
+    scan[1] = 0x34;
+    mraa_iio_channel chan = make_channel(2, 16, 0, true, false, 0);
+    mraa_iio_demux(scan, 1, 2, &chan, &out);
+    EXPECT_EQ(0x3412, out);
+    chan.lendian = 0;
+    mraa_iio_demux(scan, 1, 2, &chan, &out);
+    EXPECT_EQ(0x1234, out);
+}
+
+/* Four byte storage, a 24 bit signed value shifted by 8 and a full word */
+TEST_F(mraa_iio_unit, test_demux_4_bytes)
+{
+    uint8_t scan[4];
+    int32_t out;
+
+    for (int le = 0; le < 2; le++) {
+        put_bytes(scan, ((uint32_t) -100000 << 8) | 0xee, 4, le);
+        mraa_iio_channel chan = make_channel(4, 24, 8, le, true, 0);
+        mraa_iio_demux(scan, 1, 4, &chan, &out);
+        EXPECT_EQ(-100000, out) << (le ? "le" : "be");
+
+        put_bytes(scan, 0xdeadbeef, 4, le);
+        chan = make_channel(4, 32, 0, le, false, 0);
+        mraa_iio_demux(scan, 1, 4, &chan, &out);
+        EXPECT_EQ(0xdeadbeefu, (uint32_t) out) << (le ? "le" : "be");
+
+        chan.signedd = 1;
+        mraa_iio_demux(scan, 1, 4, &chan, &out);
+        EXPECT_EQ((int32_t) 0xdeadbeef, out) << (le ? "le" : "be");
+    }
+}
+
+/* Eight byte storage decodes to int64_t, like the timestamp channel */
+TEST_F(mraa_iio_unit, test_demux_8_bytes)
+{
+    uint8_t scans[2 * 16];
+    int64_t out[2];
+
+    for (int le = 0; le < 2; le++) {
+        memset(scans, 0x55, sizeof(scans));
+        put_bytes(scans + 8, (uint64_t) INT64_MIN + 5, 8, le);
+        put_bytes(scans + 16 + 8, 1234567890123ULL, 8, le);
+        mraa_iio_channel chan = make_channel(8, 64, 0, le, true, 8);
+        mraa_iio_demux(scans, 2, 16, &chan, out);
+        EXPECT_EQ(INT64_MIN + 5, out[0]) << (le ? "le" : "be");
+        EXPECT_EQ(1234567890123LL, out[1]) << (le ? "le" : "be");
+
+        /* 40 significant bits above 8 bits of noise */
+        put_bytes(scans, ((uint64_t) -3 << 8) | 0x99, 8, le);
+        chan = make_channel(8, 40, 8, le, true, 0);
+        mraa_iio_demux(scans, 1, 16, &chan, out);
+        EXPECT_EQ(-3, out[0]) << (le ? "le" : "be");
+        chan.signedd = 0;
+        mraa_iio_demux(scans, 1, 16, &chan, out);
+        EXPECT_EQ((1LL << 40) - 3, out[0]) << (le ? "le" : "be");
+    }
+}
+
+/* Storage sizes the kernel never uses decode as 0 */
+TEST_F(mraa_iio_unit, test_demux_odd_size)
+{
+    uint8_t scan[3] = { 1, 2, 3 };
+    int32_t out = 42;
+
+    mraa_iio_channel chan = make_channel(3, 24, 0, true, false, 0);
+    mraa_iio_demux(scan, 1, 3, &chan, &out);
+    EXPECT_EQ(0, out);
+}
+
+/* Enabled channels are naturally aligned in index order, disabled ones take
+ * no room and the scan is padded to its largest element */
+TEST_F(mraa_iio_unit, test_scan_layout)
+{
+    std::vector<mraa_iio_channel> channels;
+    struct _iio dev;
+
+    memset(&dev, 0, sizeof(dev));
+    channels.push_back(make_channel(2, 12, 4, true, true, 0)); /* accel x */
+    channels.push_back(make_channel(8, 64, 0, true, true, 0)); /* disabled */
+    channels.back().enabled = 0;
+    channels.push_back(make_channel(4, 32, 0, true, true, 0)); /* pressure */
+    channels.push_back(make_channel(8, 64, 0, true, true, 0)); /* timestamp */
+    dev.channels = channels.data();
+    dev.chan_num = channels.size();
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_update_scan_layout(&dev));
+    EXPECT_EQ(0u, channels[0].location);
+    EXPECT_EQ(4u, channels[2].location);
+    EXPECT_EQ(8u, channels[3].location);
+    EXPECT_EQ(16, dev.datasize);
+
+    /* 1 + pad + 2 + 1, padded to 2 byte alignment */
+    channels.clear();
+    channels.push_back(make_channel(1, 8, 0, true, false, 0));
+    channels.push_back(make_channel(2, 16, 0, true, false, 0));
+    channels.push_back(make_channel(1, 8, 0, true, false, 0));
+    dev.channels = channels.data();
+    dev.chan_num = channels.size();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_update_scan_layout(&dev));
+    EXPECT_EQ(0u, channels[0].location);
+    EXPECT_EQ(2u, channels[1].location);
+    EXPECT_EQ(4u, channels[2].location);
+    EXPECT_EQ(6, dev.datasize);
+
+    /* with the middle channel disabled the last one moves up */
+    channels[1].enabled = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_update_scan_layout(&dev));
+    EXPECT_EQ(1u, channels[2].location);
+    EXPECT_EQ(2, dev.datasize);
+
+    /* nothing enabled, nothing to read */
+    channels[0].enabled = 0;
+    channels[2].enabled = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_update_scan_layout(&dev));
+    EXPECT_EQ(0, dev.datasize);
+}
+
+/* Indexes without a scan element are skipped, a broken element is refused */
+TEST_F(mraa_iio_unit, test_scan_layout_gaps)
+{
+    mraa_iio_channel channels[3];
+    char name[] = "in_voltage";
+    char* scan_elements[3] = { name, NULL, name };
+    struct _iio dev;
+
+    memset(&dev, 0, sizeof(dev));
+    channels[0] = make_channel(2, 16, 0, true, false, 0);
+    memset(&channels[1], 0, sizeof(channels[1]));
+    channels[2] = make_channel(4, 32, 0, true, false, 0);
+    dev.channels = channels;
+    dev.chan_num = 3;
+    dev.scan_elements = scan_elements;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_update_scan_layout(&dev));
+    EXPECT_EQ(4u, channels[2].location);
+    EXPECT_EQ(8, dev.datasize);
+
+    scan_elements[1] = name;
+    EXPECT_EQ(MRAA_IO_SETUP_FAILURE, mraa_iio_update_scan_layout(&dev));
+}
+
+/* MRAA iio attribute test fixture, device 0 lives in a fake sysfs tree */
+class mraa_iio_attr_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_iio_attr_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_iio_attr_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            char tmpl[] = "/tmp/mraa_iio_XXXXXX";
+            ASSERT_TRUE(mkdtemp(tmpl) != NULL);
+            top = tmpl;
+            root = top + "/iio:device";
+            dir = root + "0";
+            ASSERT_EQ(0, mkdir(dir.c_str(), 0755));
+            mraa_iio_attr_set_root(root.c_str());
+
+            memset(&dev, 0, sizeof(dev));
+            dev.num = 0;
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_iio_attr_release_all(&dev);
+            mraa_iio_attr_set_root(NULL);
+            for (size_t i = 0; i < files.size(); i++)
+                unlink((dir + "/" + files[i]).c_str());
+            rmdir(dir.c_str());
+            rmdir(top.c_str());
+        }
+
+        /* Creates or rewrites an attribute in place, like sysfs does */
+        void attr(const char* name, const char* content)
+        {
+            std::string path = dir + "/" + name;
+            FILE* fp = fopen(path.c_str(), "w");
+            ASSERT_TRUE(fp != NULL) << path;
+            fputs(content, fp);
+            fclose(fp);
+            for (size_t i = 0; i < files.size(); i++)
+                if (files[i] == name)
+                    return;
+            files.push_back(name);
+        }
+
+        std::string content(const char* name)
+        {
+            char buf[64] = { 0 };
+            FILE* fp = fopen((dir + "/" + name).c_str(), "r");
+            if (fp == NULL)
+                return "";
+            size_t len = fread(buf, 1, sizeof(buf) - 1, fp);
+            fclose(fp);
+            return std::string(buf, len);
+        }
+
+        std::string top, root, dir;
+        std::vector<std::string> files;
+        struct _iio dev;
+};
+
+/* A handle is opened once and every read sees the current content */
+TEST_F(mraa_iio_attr_unit, test_attr_prepare)
+{
+    attr("in_temp_raw", "21\n");
+
+    mraa_iio_attr a = mraa_iio_attr_prepare(&dev, "in_temp_raw");
+    ASSERT_TRUE(a != NULL);
+    EXPECT_EQ(a, mraa_iio_attr_prepare(&dev, "in_temp_raw"));
+    EXPECT_TRUE(mraa_iio_attr_prepare(&dev, "in_temp_input") == NULL);
+    EXPECT_TRUE(mraa_iio_attr_prepare(&dev, NULL) == NULL);
+
+    int value = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_int(a, &value));
+    EXPECT_EQ(21, value);
+    attr("in_temp_raw", "-7\n");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_int(a, &value));
+    EXPECT_EQ(-7, value);
+
+    attr("in_temp_raw", "garbage\n");
+    EXPECT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_iio_attr_read_int(a, &value));
+    EXPECT_EQ(-7, value);
+    float f;
+    EXPECT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_iio_attr_read_float(a, &f));
+
+    /* an attribute created later is found on the next prepare */
+    attr("in_temp_input", "21500\n");
+    EXPECT_TRUE(mraa_iio_attr_prepare(&dev, "in_temp_input") != NULL);
+}
+
+/* The read and write calls of the context go through the cached handles */
+TEST_F(mraa_iio_attr_unit, test_attr_read_write)
+{
+    attr("sampling_frequency", "100\n");
+    attr("in_accel_scale", "0.000598\n");
+    attr("name", "fake-accel\n");
+
+    int i = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_read_int(&dev, "sampling_frequency", &i));
+    EXPECT_EQ(100, i);
+    float f = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_read_float(&dev, "in_accel_scale", &f));
+    EXPECT_FLOAT_EQ(0.000598f, f);
+    char buf[32];
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_read_string(&dev, "name", buf, sizeof(buf)));
+    EXPECT_STREQ("fake-accel\n", buf);
+    EXPECT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_iio_read_int(&dev, "missing", &i));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_write_int(&dev, "sampling_frequency", 400));
+    EXPECT_EQ("400", content("sampling_frequency").substr(0, 3));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_read_int(&dev, "sampling_frequency", &i));
+    EXPECT_EQ(400, i);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_write_float(&dev, "in_accel_scale", 0.5f));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_read_float(&dev, "in_accel_scale", &f));
+    EXPECT_FLOAT_EQ(0.5f, f);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_write_string(&dev, "name", "other"));
+    EXPECT_EQ("other", content("name").substr(0, 5));
+    EXPECT_EQ(MRAA_ERROR_UNSPECIFIED, mraa_iio_write_string(&dev, "missing", "1"));
+}
+
+/* Only the shared scale of the channel type exists */
+TEST_F(mraa_iio_attr_unit, test_attr_shared_scale)
+{
+    attr("in_accel_x_raw", "100\n");
+    attr("in_accel_scale", "0.5\n");
+    attr("in_voltage0_raw", "10\n");
+    attr("in_voltage_scale", "2\n");
+    attr("in_voltage_offset", "5\n");
+
+    double value = 0;
+    mraa_iio_attr x = mraa_iio_attr_prepare(&dev, "in_accel_x_raw");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(x, &value));
+    EXPECT_DOUBLE_EQ(50.0, value);
+
+    /* (raw + offset) * scale */
+    mraa_iio_attr v = mraa_iio_attr_prepare(&dev, "in_voltage0_raw");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(v, &value));
+    EXPECT_DOUBLE_EQ(30.0, value);
+}
+
+/* A scale of the channel itself wins over the shared one */
+TEST_F(mraa_iio_attr_unit, test_attr_own_scale)
+{
+    attr("in_accel_x_raw", "100\n");
+    attr("in_accel_x_scale", "0.25\n");
+    attr("in_accel_scale", "0.5\n");
+    attr("in_accel_y_raw", "100\n");
+
+    double value = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(mraa_iio_attr_prepare(&dev, "in_accel_x_raw"), &value));
+    EXPECT_DOUBLE_EQ(25.0, value);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(mraa_iio_attr_prepare(&dev, "in_accel_y_raw"), &value));
+    EXPECT_DOUBLE_EQ(50.0, value);
+}
+
+/* Without a scale the raw value is taken as is, attributes that are not
+ * _raw are never scaled */
+TEST_F(mraa_iio_attr_unit, test_attr_no_scale)
+{
+    attr("in_proximity_raw", "-12\n");
+    attr("in_temp_input", "21500\n");
+    attr("in_temp_scale", "1000\n");
+
+    double value = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(mraa_iio_attr_prepare(&dev, "in_proximity_raw"), &value));
+    EXPECT_DOUBLE_EQ(-12.0, value);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(mraa_iio_attr_prepare(&dev, "in_temp_input"), &value));
+    EXPECT_DOUBLE_EQ(21500.0, value);
+    EXPECT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_iio_attr_read_scaled(NULL, &value));
+}
+
+/* The scale is cached until it is looked up again */
+TEST_F(mraa_iio_attr_unit, test_attr_update_scale)
+{
+    attr("in_accel_x_raw", "100\n");
+    attr("in_accel_scale", "0.5\n");
+
+    double value = 0;
+    mraa_iio_attr x = mraa_iio_attr_prepare(&dev, "in_accel_x_raw");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(x, &value));
+    EXPECT_DOUBLE_EQ(50.0, value);
+
+    /* a new range, the raw value is still read every time */
+    attr("in_accel_scale", "0.125\n");
+    attr("in_accel_x_raw", "200\n");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(x, &value));
+    EXPECT_DOUBLE_EQ(100.0, value);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_update_scale(x));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(x, &value));
+    EXPECT_DOUBLE_EQ(25.0, value);
+
+    /* an offset showing up later is picked up as well */
+    attr("in_accel_offset", "-100\n");
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_update_scale(x));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_iio_attr_read_scaled(x, &value));
+    EXPECT_DOUBLE_EQ(12.5, value);
+    EXPECT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_iio_attr_update_scale(NULL));
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/common.h"
+#include "mraa/gpio.h"
+#include "mraa_internal.h"
+#include "snapshot/snapshot.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static std::vector<char>
+read_file(const char* path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/* MRAA platform snapshot test fixture */
+class mraa_snapshot_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_snapshot_unit() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_snapshot_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            int fd = mkstemp(path);
+            ASSERT_NE(-1, fd);
+            close(fd);
+            unlink(path);
+            strcpy(board_path, path);
+            strcat(board_path, ".board");
+            setenv(MRAA_SNAPSHOT_ENV_VAR, path, 1);
+            mraa_deinit();
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            mraa_deinit();
+            unlink(path);
+            unlink(board_path);
+            unsetenv(MRAA_SNAPSHOT_ENV_VAR);
+            unsetenv(MRAA_JSONPLAT_ENV_VAR);
+            mraa_init();
+        }
+
+        /* A board as the json loader sets it up */
+        void make_board(mraa_board_t* board, mraa_pininfo_t* pins)
+        {
+            memset(board, 0, sizeof(*board));
+            memset(pins, 0, 2 * sizeof(*pins));
+            board->platform_type = MRAA_JSON_PLATFORM;
+            board->platform_name = (char*) "Test carrier";
+            board->phy_pin_count = 2;
+            board->gpio_count = 1;
+            board->pins = pins;
+            strcpy(pins[0].name, "GPIO7");
+            pins[0].capabilities.valid = 1;
+            pins[0].capabilities.gpio = 1;
+            pins[0].gpio.pinmap = 7;
+            strcpy(pins[1].name, "SDA");
+            pins[1].capabilities.valid = 1;
+            pins[1].capabilities.i2c = 1;
+            board->i2c_bus_count = 1;
+            board->i2c_bus[0].bus_id = 3;
+            board->i2c_bus[0].sda = 1;
+            board->i2c_bus[0].scl = -1;
+            board->i2c_bus[0].name = (char*) "I2C3";
+            board->uart_dev_count = 1;
+            board->uart_dev[0].device_path = (char*) "/dev/ttyS9";
+        }
+
+        char path[32] = "/tmp/mraa_snapshot_XXXXXX";
+        char board_path[40];
+};
+
+/* The first init writes the snapshot, the next one maps it */
+TEST_F(mraa_snapshot_unit, test_snapshot_round_trip)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    ASSERT_EQ(0, access(path, R_OK));
+
+    std::string name = mraa_get_platform_name();
+    int pins = mraa_get_pin_count();
+    std::vector<std::string> pin_names;
+    for (int i = 0; i < pins; i++)
+        pin_names.push_back(mraa_get_pin_name(i));
+    mraa_deinit();
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    EXPECT_EQ(MRAA_MOCK_PLATFORM, mraa_get_platform_type());
+    EXPECT_EQ(name, mraa_get_platform_name());
+    ASSERT_EQ(pins, mraa_get_pin_count());
+    for (int i = 0; i < pins; i++)
+        EXPECT_EQ(pin_names[i], mraa_get_pin_name(i)) << "Pin " << i;
+    EXPECT_EQ(0, mraa_get_i2c_bus_id(0));
+    EXPECT_EQ(0, mraa_gpio_lookup("GPIO0"));
+
+    /* The mock hooks still work from the mapped board */
+    mraa_gpio_context gpio = mraa_gpio_init(0);
+    ASSERT_TRUE(gpio != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(gpio, MRAA_GPIO_OUT));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_write(gpio, 1));
+    EXPECT_EQ(1, mraa_gpio_read(gpio));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_close(gpio));
+}
+
+/* A damaged snapshot is ignored and written again */
+TEST_F(mraa_snapshot_unit, test_snapshot_corrupt)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    mraa_deinit();
+    std::vector<char> good = read_file(path);
+    ASSERT_FALSE(good.empty());
+
+    std::vector<char> bad = good;
+    bad[bad.size() / 2] ^= 0x5a;
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bad.data(), bad.size());
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    EXPECT_EQ(MRAA_MOCK_PLATFORM, mraa_get_platform_type());
+    EXPECT_STREQ("GPIO0", mraa_get_pin_name(0));
+
+    /* Rewritten in place of the damaged one */
+    std::vector<char> again = read_file(path);
+    EXPECT_EQ(good.size(), again.size());
+    EXPECT_NE(bad, again);
+}
+
+/* An empty location disables the snapshot */
+TEST_F(mraa_snapshot_unit, test_snapshot_disabled)
+{
+    setenv(MRAA_SNAPSHOT_ENV_VAR, "", 1);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    EXPECT_NE(0, access(path, F_OK));
+}
+
+/* The mock board is only cached where asked to, never in /run/mraa */
+TEST_F(mraa_snapshot_unit, test_snapshot_mock_default_location)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    ASSERT_EQ(0, access(path, R_OK));
+    mraa_deinit();
+    unlink(path);
+
+    unsetenv(MRAA_SNAPSHOT_ENV_VAR);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    EXPECT_FALSE(mraa_snapshot_owns(plat));
+    EXPECT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_snapshot_save(plat));
+}
+
+/* A board file is mapped in place of the detected platform */
+TEST_F(mraa_snapshot_unit, test_board_file)
+{
+    mraa_board_t board;
+    mraa_pininfo_t pins[2];
+    struct stat st;
+
+    make_board(&board, pins);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_snapshot_write_board(&board, board_path));
+    ASSERT_EQ(0, stat(board_path, &st));
+    EXPECT_EQ(0644, st.st_mode & 0777);
+
+    setenv(MRAA_JSONPLAT_ENV_VAR, board_path, 1);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    EXPECT_EQ(MRAA_JSON_PLATFORM, mraa_get_platform_type());
+    EXPECT_STREQ("Test carrier", mraa_get_platform_name());
+    ASSERT_EQ(2, mraa_get_pin_count());
+    EXPECT_STREQ("SDA", mraa_get_pin_name(1));
+    EXPECT_EQ(0, mraa_gpio_lookup("GPIO7"));
+    EXPECT_EQ(3, mraa_get_i2c_bus_id(0));
+    EXPECT_EQ(3, mraa_i2c_lookup("I2C3"));
+    EXPECT_EQ(-1, mraa_gpio_lookup("SDA"));
+    EXPECT_STREQ("/dev/ttyS9", plat->uart_dev[0].device_path);
+    EXPECT_TRUE(plat->adv_func == NULL);
+
+    /* Board files never end up in the snapshot */
+    EXPECT_NE(0, access(path, F_OK));
+}
+
+/* Boards with hooks only make sense to the library that set them */
+TEST_F(mraa_snapshot_unit, test_board_file_hooks)
+{
+    mraa_board_t board;
+    mraa_pininfo_t pins[2];
+    mraa_adv_func_t hooks;
+
+    make_board(&board, pins);
+    memset(&hooks, 0, sizeof(hooks));
+    board.adv_func = &hooks;
+    EXPECT_EQ(MRAA_SUCCESS, mraa_snapshot_write_board(&board, board_path));
+
+    hooks.gpio_init_pre = (mraa_result_t(*)(int)) & mraa_init;
+    EXPECT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_snapshot_write_board(&board, board_path));
+}
+
+/* Boards allocate their hook table even when they set no hook, such a
+ * board is cached like one without a table */
+TEST_F(mraa_snapshot_unit, test_snapshot_empty_hooks)
+{
+    mraa_board_t board;
+    mraa_pininfo_t pins[2];
+    mraa_adv_func_t hooks;
+
+    make_board(&board, pins);
+    board.platform_type = MRAA_ADLINK_IPI;
+    memset(&hooks, 0, sizeof(hooks));
+    board.adv_func = &hooks;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_snapshot_save(&board));
+    ASSERT_EQ(0, access(path, R_OK));
+
+    mraa_board_t* loaded = mraa_snapshot_load();
+    ASSERT_TRUE(loaded != NULL);
+    EXPECT_EQ(MRAA_ADLINK_IPI, loaded->platform_type);
+    EXPECT_STREQ("Test carrier", loaded->platform_name);
+    EXPECT_STREQ("GPIO7", loaded->pins[0].name);
+    mraa_snapshot_release();
+
+    /* a single hook of a board that keeps state makes it uncacheable */
+    unlink(path);
+    hooks.gpio_init_pre = (mraa_result_t(*)(int)) & mraa_init;
+    EXPECT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_snapshot_save(&board));
+    EXPECT_NE(0, access(path, F_OK));
+}
+
+/* Anything but a board file is left to the json loader */
+TEST_F(mraa_snapshot_unit, test_board_file_fallback)
+{
+    mraa_board_t* board = NULL;
+
+    std::ofstream(board_path) << "{ \"Platform\": [] }";
+    EXPECT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE, mraa_snapshot_load_board(board_path, &board));
+    EXPECT_TRUE(board == NULL);
+
+    /* A snapshot is not a board file */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+    mraa_deinit();
+    EXPECT_EQ(MRAA_ERROR_INVALID_PLATFORM, mraa_snapshot_load_board(path, &board));
+    EXPECT_TRUE(board == NULL);
+}
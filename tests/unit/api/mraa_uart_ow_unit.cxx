@@ -0,0 +1,683 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+
+#include "gtest/gtest.h"
+#include "mraa/uart_ow.h"
+#include "mraa_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#define OW_CMD_WRITE_SCRATCHPAD 0x4e
+#define OW_CMD_READ_SCRATCHPAD 0xbe
+#define OW_CMD_READ_POWER_SUPPLY 0xb4
+
+/* The Maxim bitwise algorithm, as a reference for the table driven one */
+static uint8_t
+ow_crc8(const uint8_t* data, size_t len)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8c;
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+static bool
+ow_bit(const uint8_t* data, int n)
+{
+    return (data[n / 8] >> (n % 8)) & 1;
+}
+
+struct ow_device {
+    uint8_t rom[8];
+    uint8_t scratchpad[9];
+    bool parasite;
+};
+
+/*
+ * A 1-Wire bus behind the master side of a pty. The uart sends 0xf0 for a
+ * reset and 0xff or 0x00 for every time slot, each byte is answered with
+ * what the wired-AND bus would have echoed.
+ */
+class ow_bus
+{
+  public:
+    ow_bus() : master(-1), stop(false) {}
+
+    bool open_pty()
+    {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master == -1 || grantpt(master) != 0 || unlockpt(master) != 0)
+            return false;
+        thread = std::thread(&ow_bus::run, this);
+        return true;
+    }
+
+    const char* slave_path()
+    {
+        return ptsname(master);
+    }
+
+    void close_pty()
+    {
+        stop = true;
+        if (thread.joinable())
+            thread.join();
+        if (master != -1)
+            close(master);
+        master = -1;
+    }
+
+    /* Adds a device, its rom crc is filled in unless crc_ok is false */
+    void add(const uint8_t* rom, bool crc_ok = true)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ow_device dev;
+        memcpy(dev.rom, rom, 7);
+        dev.rom[7] = ow_crc8(rom, 7) ^ (crc_ok ? 0 : 0x5a);
+        memset(dev.scratchpad, 0, sizeof(dev.scratchpad));
+        dev.scratchpad[8] = ow_crc8(dev.scratchpad, 8);
+        dev.parasite = false;
+        devices.push_back(dev);
+    }
+
+    void set_parasite(size_t index, bool parasite)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        devices[index].parasite = parasite;
+    }
+
+    /* Sets the first 8 bytes of a scratchpad, the crc is filled in unless
+     * crc_ok is false */
+    void set_scratchpad(size_t index, const uint8_t* sp, bool crc_ok = true)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        memcpy(devices[index].scratchpad, sp, 8);
+        devices[index].scratchpad[8] = ow_crc8(sp, 8) ^ (crc_ok ? 0 : 0x5a);
+    }
+
+    std::vector<ow_device> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return devices;
+    }
+
+    /* Slots the bus answered, resets not counted */
+    int slots()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return slot_count;
+    }
+
+  protected:
+    enum state_t { IDLE, ROM_CMD, SEARCH, MATCH, FUNC_CMD, READ_SP, WRITE_SP, READ_POWER };
+
+    uint8_t reset()
+    {
+        state = ROM_CMD;
+        bits = 0;
+        cmd = 0;
+        active.assign(devices.size(), true);
+        // presence pulses shorten the echoed start bit
+        return devices.empty() ? 0xf0 : 0xe0;
+    }
+
+    /* The bus level of one slot, low when the master or a device pulls it */
+    bool slot(bool level)
+    {
+        bool released = level;
+        slot_count++;
+        switch (state) {
+            case ROM_CMD:
+            case FUNC_CMD:
+                cmd |= level << bits;
+                if (++bits == 8)
+                    command();
+                break;
+            case SEARCH:
+                for (size_t i = 0; i < devices.size(); i++) {
+                    if (!active[i])
+                        continue;
+                    bool b = ow_bit(devices[i].rom, bits);
+                    if (phase == 0 && !b)
+                        level = false;
+                    else if (phase == 1 && b)
+                        level = false;
+                    else if (phase == 2 && b != released)
+                        active[i] = false;
+                }
+                if (++phase == 3) {
+                    phase = 0;
+                    if (++bits == 64)
+                        state = IDLE;
+                }
+                break;
+            case MATCH:
+                for (size_t i = 0; i < devices.size(); i++) {
+                    if (active[i] && ow_bit(devices[i].rom, bits) != released)
+                        active[i] = false;
+                }
+                if (++bits == 64) {
+                    state = FUNC_CMD;
+                    bits = 0;
+                    cmd = 0;
+                }
+                break;
+            case READ_SP:
+                for (size_t i = 0; i < devices.size(); i++) {
+                    if (active[i] && !ow_bit(devices[i].scratchpad, bits))
+                        level = false;
+                }
+                if (++bits == 72)
+                    state = IDLE;
+                break;
+            case WRITE_SP:
+                if (bits % 8 == 0)
+                    data[bits / 8] = 0;
+                data[bits / 8] |= level << (bits % 8);
+                if (++bits == 24) {
+                    for (size_t i = 0; i < devices.size(); i++) {
+                        if (!active[i])
+                            continue;
+                        memcpy(devices[i].scratchpad + 2, data, 3);
+                        devices[i].scratchpad[8] = ow_crc8(devices[i].scratchpad, 8);
+                    }
+                    state = IDLE;
+                }
+                break;
+            case READ_POWER:
+                // parasite powered devices pull the slot low
+                for (size_t i = 0; i < devices.size(); i++) {
+                    if (active[i] && devices[i].parasite)
+                        level = false;
+                }
+                state = IDLE;
+                break;
+            default:
+                break;
+        }
+        return level;
+    }
+
+    void command()
+    {
+        bits = 0;
+        if (state == ROM_CMD) {
+            switch (cmd) {
+                case MRAA_UART_OW_CMD_SEARCH_ROM:
+                    state = SEARCH;
+                    phase = 0;
+                    return;
+                case MRAA_UART_OW_CMD_MATCH_ROM:
+                    state = MATCH;
+                    return;
+                case MRAA_UART_OW_CMD_SKIP_ROM:
+                    state = FUNC_CMD;
+                    cmd = 0;
+                    return;
+            }
+        } else {
+            switch (cmd) {
+                case OW_CMD_READ_SCRATCHPAD:
+                    state = READ_SP;
+                    return;
+                case OW_CMD_WRITE_SCRATCHPAD:
+                    state = WRITE_SP;
+                    return;
+                case OW_CMD_READ_POWER_SUPPLY:
+                    state = READ_POWER;
+                    return;
+            }
+        }
+        state = IDLE;
+    }
+
+    void run()
+    {
+        uint8_t buf[512];
+        while (!stop) {
+            struct pollfd pfd = { master, POLLIN, 0 };
+            if (poll(&pfd, 1, 10) <= 0)
+                continue;
+            ssize_t n = read(master, buf, sizeof(buf));
+            if (n <= 0) {
+                // the slave is not open
+                usleep(1000);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (ssize_t i = 0; i < n; i++)
+                    buf[i] = buf[i] == 0xf0 ? reset() : (slot(buf[i] == 0xff) ? 0xff : 0x00);
+            }
+            for (ssize_t done = 0; done < n;) {
+                ssize_t w = write(master, buf + done, n - done);
+                if (w <= 0)
+                    break;
+                done += w;
+            }
+        }
+    }
+
+    int master;
+    std::atomic<bool> stop;
+    std::thread thread;
+    std::mutex mutex;
+    std::vector<ow_device> devices;
+    std::vector<bool> active;
+    state_t state = IDLE;
+    int bits = 0;
+    int phase = 0;
+    uint8_t cmd = 0;
+    uint8_t data[3];
+    int slot_count = 0;
+};
+
+/* MRAA uart 1-Wire test fixture, the bus is simulated behind a pty */
+class mraa_uart_ow_unit : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_uart_ow_unit() : ow(NULL) {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_uart_ow_unit() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+            /* the mock uart would never reach the pty */
+            hooks = *plat->adv_func;
+            plat->adv_func->uart_init_raw_replace = NULL;
+            plat->adv_func->uart_flush_replace = NULL;
+            plat->adv_func->uart_set_non_blocking_replace = NULL;
+            plat->adv_func->uart_read_replace = NULL;
+            plat->adv_func->uart_write_replace = NULL;
+            plat->adv_func->uart_data_available_replace = NULL;
+            ASSERT_TRUE(bus.open_pty());
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (ow != NULL)
+                mraa_uart_ow_stop(ow);
+            bus.close_pty();
+            *plat->adv_func = hooks;
+            mraa_deinit();
+        }
+
+        void open_bus()
+        {
+            ow = mraa_uart_ow_init_raw(bus.slave_path());
+            ASSERT_TRUE(ow != NULL);
+        }
+
+        mraa_adv_func_t hooks;
+        ow_bus bus;
+        mraa_uart_ow_context ow;
+};
+
+/* Presence pulses tell an empty bus from one with devices */
+TEST_F(mraa_uart_ow_unit, test_ow_reset)
+{
+    open_bus();
+    EXPECT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_reset(ow));
+    EXPECT_EQ(0, mraa_uart_ow_enumerate(ow, 1));
+
+    const uint8_t rom[7] = { 0x28, 0xff, 0x4b, 0x46, 0x7f, 0xff, 0x0c };
+    bus.add(rom);
+    EXPECT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(ow));
+    /* an empty bus is remembered until a refresh */
+    EXPECT_EQ(0, mraa_uart_ow_enumerate(ow, 0));
+    EXPECT_EQ(1, mraa_uart_ow_enumerate(ow, 1));
+}
+
+/* Devices differing in the family code, in the middle and in the last
+ * serial bit are each found once, in the order of their bits */
+TEST_F(mraa_uart_ow_unit, test_ow_search_discrepancies)
+{
+    const uint8_t roms[5][7] = {
+        { 0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0x28, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x80 },
+        { 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0x22, 0x5a, 0xa5, 0x01, 0x02, 0x03, 0x04 },
+    };
+    for (int i = 0; i < 5; i++)
+        bus.add(roms[i]);
+    open_bus();
+
+    std::vector<ow_device> devices = bus.snapshot();
+    std::vector<std::vector<uint8_t> > expected;
+    for (size_t i = 0; i < devices.size(); i++)
+        expected.push_back(std::vector<uint8_t>(devices[i].rom, devices[i].rom + 8));
+    /* a search takes the 0 branch first, bit 0 of byte 0 is compared first */
+    std::sort(expected.begin(), expected.end(), [](const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+        for (int n = 0; n < 64; n++) {
+            if (ow_bit(a.data(), n) != ow_bit(b.data(), n))
+                return !ow_bit(a.data(), n);
+        }
+        return false;
+    });
+
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+    std::vector<std::vector<uint8_t> > found;
+    mraa_result_t rv = mraa_uart_ow_rom_search(ow, 1, id);
+    while (rv == MRAA_SUCCESS && found.size() < 10) {
+        found.push_back(std::vector<uint8_t>(id, id + 8));
+        rv = mraa_uart_ow_rom_search(ow, 0, id);
+    }
+    EXPECT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, rv);
+    EXPECT_EQ(expected, found);
+
+    /* a new search starts over */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_rom_search(ow, 1, id));
+    EXPECT_EQ(expected[0], std::vector<uint8_t>(id, id + 8));
+
+    ASSERT_EQ(5, mraa_uart_ow_enumerate(ow, 1));
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_get_rom(ow, i, id));
+        EXPECT_EQ(expected[i], std::vector<uint8_t>(id, id + 8)) << "Device " << i;
+    }
+}
+
+/* Bytes written with write_bytes come back with read_bytes */
+TEST_F(mraa_uart_ow_unit, test_ow_write_read_bytes)
+{
+    const uint8_t rom_a[7] = { 0x28, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    const uint8_t rom_b[7] = { 0x28, 0x11, 0x22, 0x33, 0x44, 0x55, 0x67 };
+    bus.add(rom_a);
+    bus.add(rom_b);
+    open_bus();
+    std::vector<ow_device> devices = bus.snapshot();
+
+    /* skip rom and write scratchpad in one go, to both devices */
+    const uint8_t all[] = { MRAA_UART_OW_CMD_SKIP_ROM, OW_CMD_WRITE_SCRATCHPAD, 0x4b, 0x46, 0x7f };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(ow));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_write_bytes(ow, all, sizeof(all)));
+
+    /* then only to the second one */
+    const uint8_t one[] = { 0x01, 0x02, 0x1f };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(ow, OW_CMD_WRITE_SCRATCHPAD, devices[1].rom));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_write_bytes(ow, one, sizeof(one)));
+
+    uint8_t sp[9];
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(ow, OW_CMD_READ_SCRATCHPAD, devices[0].rom));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_read_bytes(ow, sp, sizeof(sp)));
+    EXPECT_EQ(0x4b, sp[2]);
+    EXPECT_EQ(0x46, sp[3]);
+    EXPECT_EQ(0x7f, sp[4]);
+    EXPECT_EQ(ow_crc8(sp, 8), sp[8]);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(ow, OW_CMD_READ_SCRATCHPAD, devices[1].rom));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_read_bytes(ow, sp, sizeof(sp)));
+    EXPECT_EQ(0x01, sp[2]);
+    EXPECT_EQ(0x02, sp[3]);
+    EXPECT_EQ(0x1f, sp[4]);
+    EXPECT_EQ(ow_crc8(sp, 8), sp[8]);
+
+    EXPECT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_ow_write_bytes(ow, NULL, 1));
+    EXPECT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_uart_ow_read_bytes(ow, NULL, 1));
+}
+
+/* Transfers longer than one write of slots are split, write and read
+ * slots of a byte are least significant bit first */
+TEST_F(mraa_uart_ow_unit, test_ow_transfer)
+{
+    const uint8_t rom[7] = { 0x28, 0xff, 0x4b, 0x46, 0x7f, 0xff, 0x0c };
+    bus.add(rom);
+    open_bus();
+
+    const uint8_t set[] = { 0x5a, 0x01, 0x80 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(ow, OW_CMD_WRITE_SCRATCHPAD, NULL));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_write_bytes(ow, set, sizeof(set)));
+
+    /* skip rom, read scratchpad, 9 bytes of it and idle read slots, 40 in all */
+    uint8_t tx[40], rx[40];
+    memset(tx, 0xff, sizeof(tx));
+    tx[0] = MRAA_UART_OW_CMD_SKIP_ROM;
+    tx[1] = OW_CMD_READ_SCRATCHPAD;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(ow));
+    int before = bus.slots();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_transfer(ow, tx, rx, sizeof(tx)));
+    EXPECT_EQ(40 * 8, bus.slots() - before);
+
+    /* written bits are echoed as they are */
+    EXPECT_EQ(MRAA_UART_OW_CMD_SKIP_ROM, rx[0]);
+    EXPECT_EQ(OW_CMD_READ_SCRATCHPAD, rx[1]);
+    EXPECT_EQ(0x5a, rx[2 + 2]);
+    EXPECT_EQ(0x01, rx[2 + 3]);
+    EXPECT_EQ(0x80, rx[2 + 4]);
+    EXPECT_EQ(ow_crc8(rx + 2, 8), rx[2 + 8]);
+    for (size_t i = 2 + 9; i < sizeof(rx); i++)
+        EXPECT_EQ(0xff, rx[i]) << "Byte " << i;
+
+    /* single bytes and bits */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(ow));
+    EXPECT_EQ(MRAA_UART_OW_CMD_SKIP_ROM, mraa_uart_ow_write_byte(ow, MRAA_UART_OW_CMD_SKIP_ROM));
+    EXPECT_EQ(OW_CMD_READ_SCRATCHPAD, mraa_uart_ow_write_byte(ow, OW_CMD_READ_SCRATCHPAD));
+    EXPECT_EQ(0, mraa_uart_ow_read_byte(ow));
+    EXPECT_EQ(0, mraa_uart_ow_read_byte(ow));
+    EXPECT_EQ(0, mraa_uart_ow_bit(ow, 1));
+    EXPECT_EQ(1, mraa_uart_ow_bit(ow, 1));
+}
+
+/* The crc table agrees with the bitwise algorithm and known codes */
+TEST_F(mraa_uart_ow_unit, test_ow_crc8)
+{
+    /* the example rom code of Maxim application note 27 */
+    uint8_t rom[8] = { 0x02, 0x1c, 0xb8, 0x01, 0x00, 0x00, 0x00, 0xa2 };
+    EXPECT_EQ(0xa2, mraa_uart_ow_crc8(rom, 7));
+    /* a code followed by its crc sums up to 0 */
+    EXPECT_EQ(0x00, mraa_uart_ow_crc8(rom, 8));
+    rom[3] ^= 0x10;
+    EXPECT_NE(0xa2, mraa_uart_ow_crc8(rom, 7));
+
+    /* power on scratchpads of a DS18B20 and a DS18S20 */
+    uint8_t ds18b20[9] = { 0x50, 0x05, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10, 0x1c };
+    EXPECT_EQ(0x1c, mraa_uart_ow_crc8(ds18b20, 8));
+    uint8_t ds18s20[9] = { 0xaa, 0x00, 0x4b, 0x46, 0xff, 0xff, 0x0c, 0x10, 0x87 };
+    EXPECT_EQ(0x87, mraa_uart_ow_crc8(ds18s20, 8));
+
+    EXPECT_EQ(0x00, mraa_uart_ow_crc8(rom, 0));
+    for (int i = 0; i < 256; i++) {
+        uint8_t byte = (uint8_t) i;
+        ASSERT_EQ(ow_crc8(&byte, 1), mraa_uart_ow_crc8(&byte, 1)) << "Byte " << i;
+    }
+    uint8_t buf[64];
+    for (size_t i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t) (i * 37 + 11);
+    EXPECT_EQ(ow_crc8(buf, sizeof(buf)), mraa_uart_ow_crc8(buf, sizeof(buf)));
+}
+
+/* Rom codes with a bad crc are left out of the enumeration */
+TEST_F(mraa_uart_ow_unit, test_ow_enumerate_bad_crc)
+{
+    const uint8_t roms[3][7] = {
+        { 0x28, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 },
+        { 0x28, 0x81, 0x02, 0x03, 0x04, 0x05, 0x06 },
+        { 0x10, 0x41, 0x02, 0x03, 0x04, 0x05, 0x06 },
+    };
+    bus.add(roms[0]);
+    bus.add(roms[1], false);
+    bus.add(roms[2]);
+    open_bus();
+
+    /* the search itself still finds it */
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+    int found = 0;
+    for (mraa_result_t rv = mraa_uart_ow_rom_search(ow, 1, id); rv == MRAA_SUCCESS && found < 10;
+         rv = mraa_uart_ow_rom_search(ow, 0, id))
+        found++;
+    EXPECT_EQ(3, found);
+
+    ASSERT_EQ(2, mraa_uart_ow_enumerate(ow, 1));
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_get_rom(ow, i, id));
+        EXPECT_EQ(id[7], mraa_uart_ow_crc8(id, 7));
+        EXPECT_NE(0x81, id[1]);
+    }
+    EXPECT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_ow_get_rom(ow, 2, id));
+}
+
+/* DS18B20 readings at every resolution, the undefined low bits of the
+ * lower resolutions are ignored */
+TEST_F(mraa_uart_ow_unit, test_ow_temperature_resolution)
+{
+    const uint8_t rom[7] = { 0x28, 0xff, 0x4b, 0x46, 0x7f, 0xff, 0x0c };
+    bus.add(rom);
+    open_bus();
+
+    struct {
+        uint16_t raw;
+        uint8_t config;
+        float celsius;
+    } cases[] = {
+        { 0x0550, 0x7f, 85.0f },     /* power on value */
+        { 0x07d0, 0x7f, 125.0f },
+        { 0x0197, 0x7f, 25.4375f },  /* 12 bit */
+        { 0x0197, 0x5f, 25.375f },   /* 11 bit */
+        { 0x0197, 0x3f, 25.25f },    /* 10 bit */
+        { 0x0197, 0x1f, 25.0f },     /* 9 bit */
+        { 0xff5f, 0x7f, -10.0625f },
+        { 0xff5f, 0x5f, -10.125f },
+        { 0xff5f, 0x3f, -10.25f },
+        { 0xff5f, 0x1f, -10.5f },
+        { 0xfff8, 0x7f, -0.5f },
+        { 0xfc90, 0x7f, -55.0f },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint8_t sp[8] = { (uint8_t) cases[i].raw, (uint8_t) (cases[i].raw >> 8), 0x4b, 0x46, cases[i].config, 0xff, 0x0c, 0x10 };
+        bus.set_scratchpad(0, sp);
+
+        mraa_uart_ow_temperature_t result;
+        ASSERT_EQ(1, mraa_uart_ow_temperature_sweep(ow, &result, 1));
+        EXPECT_EQ(MRAA_SUCCESS, result.status);
+        EXPECT_EQ(0x28, result.id[0]);
+        EXPECT_FLOAT_EQ(cases[i].celsius, result.celsius)
+        << "raw 0x" << std::hex << cases[i].raw << " config 0x" << (int) cases[i].config;
+    }
+}
+
+/* DS18S20 readings are extended with COUNT_REMAIN and COUNT_PER_C */
+TEST_F(mraa_uart_ow_unit, test_ow_temperature_ds18s20)
+{
+    const uint8_t rom[7] = { 0x10, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10 };
+    bus.add(rom);
+    open_bus();
+
+    struct {
+        uint16_t raw;
+        uint8_t remain;
+        uint8_t per_c;
+        float celsius;
+    } cases[] = {
+        { 0x00aa, 0x0c, 0x10, 85.0f }, /* power on value */
+        { 0x0032, 0x0d, 0x10, 24.9375f },
+        { 0xffce, 0x04, 0x10, -24.5f },
+        { 0xffff, 0x08, 0x10, -0.75f },
+        { 0xffcf, 0x00, 0x00, -24.5f }, /* half degrees only */
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint8_t sp[8] = { (uint8_t) cases[i].raw, (uint8_t) (cases[i].raw >> 8), 0x4b, 0x46, 0xff, 0xff, cases[i].remain, cases[i].per_c };
+        bus.set_scratchpad(0, sp);
+
+        mraa_uart_ow_temperature_t result;
+        ASSERT_EQ(1, mraa_uart_ow_temperature_sweep(ow, &result, 1));
+        EXPECT_EQ(MRAA_SUCCESS, result.status);
+        EXPECT_FLOAT_EQ(cases[i].celsius, result.celsius) << "raw 0x" << std::hex << cases[i].raw;
+    }
+}
+
+/* A sweep reads thermometers only and flags scratchpads with a bad crc */
+TEST_F(mraa_uart_ow_unit, test_ow_temperature_sweep)
+{
+    const uint8_t roms[4][7] = {
+        { 0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 }, /* DS1990, no thermometer */
+        { 0x22, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0x10, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    };
+    for (int i = 0; i < 4; i++)
+        bus.add(roms[i]);
+    const uint8_t sp_a[8] = { 0x91, 0x01, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10 };
+    const uint8_t sp_c[8] = { 0x50, 0x05, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10 };
+    const uint8_t sp_d[8] = { 0x32, 0x00, 0x4b, 0x46, 0xff, 0xff, 0x0c, 0x10 };
+    bus.set_scratchpad(0, sp_a);
+    bus.set_scratchpad(2, sp_c, false);
+    bus.set_scratchpad(3, sp_d);
+    open_bus();
+
+    mraa_uart_ow_temperature_t results[8];
+    ASSERT_EQ(3, mraa_uart_ow_temperature_sweep(ow, results, 8));
+    int seen = 0;
+    for (int i = 0; i < 3; i++) {
+        switch (results[i].id[0]) {
+            case 0x28:
+                EXPECT_EQ(MRAA_SUCCESS, results[i].status);
+                EXPECT_FLOAT_EQ(25.0625f, results[i].celsius);
+                seen |= 1;
+                break;
+            case 0x22:
+                EXPECT_EQ(MRAA_ERROR_UART_OW_DATA_ERROR, results[i].status);
+                seen |= 2;
+                break;
+            case 0x10:
+                EXPECT_EQ(MRAA_SUCCESS, results[i].status);
+                EXPECT_FLOAT_EQ(25.0f, results[i].celsius);
+                seen |= 4;
+                break;
+        }
+    }
+    EXPECT_EQ(7, seen);
+
+    /* the results end where the caller's array does */
+    EXPECT_EQ(1, mraa_uart_ow_temperature_sweep(ow, results, 1));
+    EXPECT_EQ(0, mraa_uart_ow_temperature_sweep(ow, results, 0));
+}
+
+/* Parasite powered sensors get the whole conversion time */
+TEST_F(mraa_uart_ow_unit, test_ow_temperature_parasite)
+{
+    const uint8_t rom[7] = { 0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    bus.add(rom);
+    bus.set_parasite(0, true);
+    const uint8_t sp[8] = { 0x50, 0x05, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10 };
+    bus.set_scratchpad(0, sp);
+    open_bus();
+
+    struct timespec start, end;
+    mraa_uart_ow_temperature_t result;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ASSERT_EQ(1, mraa_uart_ow_temperature_sweep(ow, &result, 1));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    EXPECT_EQ(MRAA_SUCCESS, result.status);
+    EXPECT_FLOAT_EQ(85.0f, result.celsius);
+    long ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+    EXPECT_GE(ms, 750);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 ADLINK Technology Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Compiles a json platform description into a board file libmraa maps at
+ * startup without parsing. Point MRAA_JSON_PLATFORM at either of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <syslog.h>
+
+#include "mraa/common.h"
+#include "mraa_internal.h"
+#include "snapshot/snapshot.h"
+
+void
+print_help(const char* name)
+{
+    fprintf(stdout, "Usage: %s platform.json board-file\n", name);
+    fprintf(stdout, "Compile a json platform description into a board file for this libmraa.\n");
+    fprintf(stdout, "Board files only fit the libmraa version and architecture that wrote them.\n");
+}
+
+int
+main(int argc, char** argv)
+{
+    if (argc != 3) {
+        print_help(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // the parser reports through syslog, show it here as well
+    openlog("mraa-platform-compile", LOG_PERROR, LOG_USER);
+    mraa_set_log_level(LOG_ERR);
+
+    // plat is only set up from the json, the board this runs on is never detected
+    if (mraa_init_json_platform(argv[1]) != MRAA_SUCCESS || plat == NULL) {
+        fprintf(stderr, "%s: could not load %s\n", argv[0], argv[1]);
+        return EXIT_FAILURE;
+    }
+    if (mraa_snapshot_write_board(plat, argv[2]) != MRAA_SUCCESS) {
+        fprintf(stderr, "%s: could not write %s\n", argv[0], argv[2]);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "%s: %d pins, %d i2c, %d spi, %d uart written to %s\n", plat->platform_name,
+            plat->phy_pin_count, plat->i2c_bus_count, plat->spi_bus_count, plat->uart_dev_count, argv[2]);
+    return EXIT_SUCCESS;
+}